@@ -2,14 +2,27 @@
  * Simple benchmark application that runs queries against a postgres
  * server and measures the respond times.
  *
+ * Benchmark mode (any of -r, -w, -V, -g, -j or -S) runs each query of the
+ * workload in several provenance variants (plain, PROVENANCE, ON CONTRIBUTION
+ * and TRANSPROV) for each combination of a set of boolean GUCs. Each query is
+ * warmed up and repeated by a number of concurrent clients and one CSV line
+ * with latency percentiles, result size and the server side
+ * parse/rewrite/plan/execute split is printed per query, variant and GUC
+ * combination. E.g.:
  *
+ *	mybenchpsql -d tpch -i tpch-data/queries/queries.txt -V plain,prov,contr,trans \
+ *		-g 'prov_use_%' -w 1 -r 10 -j 4 -S
  *
+ * The phase split (-S) uses log_parser_stats, log_planner_stats and
+ * log_executor_stats and therefore requires a superuser.
  *
  * @ Boris Glavic
  */
 
 
 #include <ctype.h>
+#include <math.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -18,8 +31,58 @@
 #include <string.h>
 #include "libpq-fe.h"
 
+/* limits */
+#define MAX_OPTIONS 20
+#define MAX_SWEEP_GUCS 10
+#define MAX_VARIANTS 4
+
+/* provenance variants of a query */
+typedef enum BenchVariant
+{
+	VARIANT_PLAIN,
+	VARIANT_PROV,
+	VARIANT_CONTR,
+	VARIANT_TRANS
+} BenchVariant;
+
+/* server side phases reported by the log_*_stats options */
+typedef enum BenchPhase
+{
+	PHASE_PARSE,
+	PHASE_REWRITE,
+	PHASE_PLAN,
+	PHASE_EXEC,
+	PHASE_NUM
+} BenchPhase;
+
+/* measurements of one execution of a query */
+typedef struct BenchSample
+{
+	int failed;
+	double wall;
+	double phase[PHASE_NUM];
+	long rows;
+	long bytes;
+} BenchSample;
+
+/* all samples for one query, variant and GUC combination */
+typedef struct BenchCell
+{
+	int skipped;
+	BenchSample *samples;
+} BenchCell;
+
+/* a benchmark client thread with its own connection */
+typedef struct BenchClient
+{
+	int id;
+	PGconn *conn;
+	pthread_t thread;
+	double phase[PHASE_NUM];
+} BenchClient;
+
 /* database connection and query execution */
-static void connectToDB (void);
+static PGconn *connectToDB (void);
 static void executeQuery (char *query);
 static void executeExplain (char *query);
 static void readAndExecuteQueries (void);
@@ -39,6 +102,25 @@ static void printUsage(void);
 static void getOpts (int argc, char **argv);
 /* set Optimization options */
 static void setOptions(int true);
+/* benchmark mode */
+static void runBenchmark (void);
+static void loadQueries (void);
+static void expandSweepGucs (void);
+static void parseVariants (char *list);
+static void *runClient (void *arg);
+static void waitForClients (void);
+static void execCommand (PGconn *con, char *command);
+static void setConfiguration (BenchClient *client, int config);
+static char *getVariantQuery (char *query, BenchVariant variant);
+static void runBenchQuery (BenchClient *client, char *query, BenchSample *sample);
+static void phaseNoticeReceiver (void *arg, const PGresult *res);
+static long getResultBytes (PGresult *result);
+static double getTimeDiffMs (struct timeval start, struct timeval stop);
+static BenchCell *getCell (int config, int variant, int query);
+static void printBenchResults (void);
+static char *getConfigString (int config);
+static int compareDoubles (const void *left, const void *right);
+static double getPercentile (double *sorted, int num, double percent);
 
 
 /* connection parameters */
@@ -49,8 +131,8 @@ char *db;
 char *port;
 
 /* optimization options */
-char *trueOptions[20];
-char *falseOptions[20];
+char *trueOptions[MAX_OPTIONS];
+char *falseOptions[MAX_OPTIONS];
 
 /* connection */
 PGconn *conn;
@@ -67,6 +149,30 @@ int optionsTrueNum;
 int useExplain;
 int outputExplainPlan;
 
+/* benchmark mode options */
+int benchMode;
+int numReps;
+int numWarmups;
+int numClients;
+int usePhaseStats;
+char *contributionType;
+BenchVariant variants[MAX_VARIANTS];
+int numVariants;
+char *sweepGucs[MAX_OPTIONS];
+int numSweepGucs;
+
+/* benchmark mode state */
+char **queries;
+int numQueries;
+int numConfigs;
+BenchCell *cells;
+pthread_mutex_t barrierLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t barrierCond = PTHREAD_COND_INITIALIZER;
+int barrierCount;
+int barrierGeneration;
+
+static const char *variantNames[] = { "plain", "prov", "contr", "trans" };
+
 /*
  * Main method.
  */
@@ -81,10 +187,24 @@ main (int argc, char** argv)
 	optionsTrueNum = 0;
 	useExplain = 0;
 	outputExplainPlan = 0;
+	benchMode = 0;
+	numReps = 1;
+	numWarmups = 0;
+	numClients = 1;
+	usePhaseStats = 0;
+	contributionType = "COPY";
+	numVariants = 0;
+	numSweepGucs = 0;
 
 	getOpts(argc, argv);
 
-	connectToDB();
+	if (benchMode)
+	{
+		runBenchmark();
+		return 0;
+	}
+
+	conn = connectToDB();
 
 	setOptions(1);
 	setOptions(0);
@@ -124,21 +244,45 @@ readAndExecuteQueries ()
 	}
 }
 
+/*
+ * Read the next query from the input file (-i) or stdin. Queries are separated by comment lines.
+ */
+
 static char *
 readQuery ()
 {
 	char *result;
-	char line[160];
+	char line[1024];
 	char *errorcode;
-
-	result = (char *) malloc(10000);
+	char *c;
+	size_t len;
+	size_t size;
+	FILE *in;
+
+	in = file ? file : stdin;
+	size = 10000;
+	len = 0;
+	result = (char *) malloc(size);
 	result[0] = '\0';
-	while((errorcode = fgets(line, 160, stdin)) != NULL && !isComment(line))
+	while((errorcode = fgets(line, sizeof(line), in)) != NULL && !isComment(line))
 	{
-		result = strcat(result, line);
+		if (len + strlen(line) + 1 > size)
+		{
+			size = size * 2 + strlen(line);
+			result = (char *) realloc(result, size);
+		}
+		strcpy(result + len, line);
+		len += strlen(line);
 	}
 	if (errorcode == NULL)
 	{
+		/* return the last query even if it is not followed by a comment */
+		for (c = result; *c != '\0' && isWhiteSpace(*c); c++)
+			;
+		if (*c != '\0')
+			return result;
+
+		free(result);
 		return NULL;
 	}
 	return result;
@@ -172,6 +316,7 @@ isWhiteSpace(char c) {
 	{
 	case ' ':
 	case '\n':
+	case '\r':
 	case '\t':
 		return 1;
 	default:
@@ -452,7 +597,7 @@ getOpts (int argc, char **argv)
 	/* set default values */
 
 	/* parse options */
-	while ((c = getopt(argc, argv, "h:u:p:d:n:s:ct:f:i:P:eo")) != -1)
+	while ((c = getopt(argc, argv, "h:u:p:d:n:s:ct:f:i:P:eor:w:V:C:g:j:S")) != -1)
 	{
 		switch (c)
 		{
@@ -478,12 +623,12 @@ getOpts (int argc, char **argv)
 				useCursor = 1;
 				break;
 			case 't':
-				trueOptions[optionsTrueNum] = optarg;
-				optionsTrueNum++;
+				if (optionsTrueNum < MAX_OPTIONS)
+					trueOptions[optionsTrueNum++] = optarg;
 				break;
 			case 'f':
-				falseOptions[optionsFalseNum] = optarg;
-				optionsFalseNum++;
+				if (optionsFalseNum < MAX_OPTIONS)
+					falseOptions[optionsFalseNum++] = optarg;
 				break;
 			case 'i':
 				createFile(optarg);
@@ -497,6 +642,38 @@ getOpts (int argc, char **argv)
 			case 'o':
 				outputExplainPlan = 1;
 				break;
+			case 'r':
+				numReps = atoi(optarg);
+				benchMode = 1;
+				break;
+			case 'w':
+				numWarmups = atoi(optarg);
+				benchMode = 1;
+				break;
+			case 'V':
+				parseVariants(optarg);
+				benchMode = 1;
+				break;
+			case 'C':
+				contributionType = optarg;
+				break;
+			case 'g':
+				if (numSweepGucs >= MAX_OPTIONS)
+				{
+					fprintf(stderr, "$Q(-2): too many GUCs to sweep\n");
+					exit(1);
+				}
+				sweepGucs[numSweepGucs++] = optarg;
+				benchMode = 1;
+				break;
+			case 'j':
+				numClients = atoi(optarg);
+				benchMode = 1;
+				break;
+			case 'S':
+				usePhaseStats = 1;
+				benchMode = 1;
+				break;
 			default:
 				printUsage();
 				exit(1);
@@ -504,21 +681,40 @@ getOpts (int argc, char **argv)
 		}
 	}
 
+	if (numReps < 1 || numWarmups < 0 || numClients < 1)
+	{
+		printUsage();
+		exit(1);
+	}
+
+	if (useExplain && benchMode)
+	{
+		fprintf(stderr, "$Q(-2): -e can not be combined with benchmark mode\n");
+		exit(1);
+	}
 }
 
 static void
 createFile (char *name) {
 	file = fopen(name, "r");
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "$Q(-2): could not open query file \"%s\"\n", name);
+		exit(1);
+	}
 }
 
-static void
+static PGconn *
 connectToDB ()
 {
 	char *connStr;
+	PGconn *con;
 
 	/* create connection string */
 	connStr = (char *) malloc(sizeof(char) * 400);
 	connStr[0] = ' ';
+	connStr[1] = '\0';
 
 	if (host)
 	{
@@ -547,16 +743,20 @@ connectToDB ()
 	}
 
 	/* try to connect to db */
-	conn = PQconnectdb(connStr);
+	con = PQconnectdb(connStr);
 
 	/* check to see that the backend connection was successfully made */
-	if (conn == NULL || PQstatus(conn) == CONNECTION_BAD)
+	if (con == NULL || PQstatus(con) == CONNECTION_BAD)
 	{
 		fprintf(stderr, "$Q(-2):  Connection to database \"%s\" failed:\n%s",
-				connStr, PQerrorMessage(conn));
-		PQfinish(conn);
+				connStr, PQerrorMessage(con));
+		PQfinish(con);
 		exit(1);
 	}
+
+	free(connStr);
+
+	return con;
 }
 
 static void setOptions (int true)
@@ -598,5 +798,733 @@ static void
 printUsage()
 {
 	fprintf(stderr, "$Q(-2): Usage is: mybench [-c] [-h hostname] [-u username] [-p password] [-d database] "
-			"[-n stopAfterNQueries] [-s skipFirstNQueries] [-t option to set true] [-f option to set false] [-e] [-o] \n");
+			"[-n stopAfterNQueries] [-s skipFirstNQueries] [-t option to set true] [-f option to set false] [-e] [-o] "
+			"[-i queryfile] [-r repetitions] [-w warmups] [-V plain,prov,contr,trans] [-C contributiontype] "
+			"[-g option to sweep] [-j clients] [-S] \n");
+}
+
+/*
+ * ---------------------------------------------------------------------------
+ * Benchmark mode: run a workload in several provenance variants and GUC
+ * combinations with warmups, repetitions and concurrent clients and print
+ * the aggregated measurements as CSV.
+ * ---------------------------------------------------------------------------
+ */
+
+static void
+runBenchmark (void)
+{
+	BenchClient *clients;
+	int numCells;
+	int i;
+
+	if (numVariants == 0)
+		variants[numVariants++] = VARIANT_PLAIN;
+
+	loadQueries();
+	expandSweepGucs();
+
+	numConfigs = 1 << numSweepGucs;
+
+	/* allocate sample slots for each client and repetition of each cell */
+	numCells = numConfigs * numVariants * numQueries;
+	cells = (BenchCell *) calloc(numCells, sizeof(BenchCell));
+
+	for (i = 0; i < numCells; i++)
+		cells[i].samples = (BenchSample *) calloc(numClients * numReps, sizeof(BenchSample));
+
+	/* connect all clients before starting any of them */
+	clients = (BenchClient *) calloc(numClients, sizeof(BenchClient));
+
+	for (i = 0; i < numClients; i++)
+	{
+		clients[i].id = i;
+		clients[i].conn = connectToDB();
+
+		if (usePhaseStats)
+		{
+			PQsetNoticeReceiver(clients[i].conn, phaseNoticeReceiver, &clients[i]);
+			execCommand(clients[i].conn, "SET log_parser_stats TO on");
+			execCommand(clients[i].conn, "SET log_planner_stats TO on");
+			execCommand(clients[i].conn, "SET log_executor_stats TO on");
+			execCommand(clients[i].conn, "SET client_min_messages TO log");
+		}
+	}
+
+	for (i = 0; i < numClients; i++)
+	{
+		if (pthread_create(&clients[i].thread, NULL, runClient, &clients[i]) != 0)
+		{
+			fprintf(stderr, "$Q(-2): could not create client thread\n");
+			exit(1);
+		}
+	}
+
+	for (i = 0; i < numClients; i++)
+	{
+		pthread_join(clients[i].thread, NULL);
+		PQfinish(clients[i].conn);
+	}
+
+	printBenchResults();
+}
+
+/*
+ * Read the complete workload. Statements that are not queries (e.g., SET or
+ * CREATE VIEW) are kept and run once by each client, but are not measured.
+ */
+
+static void
+loadQueries (void)
+{
+	char *query;
+	char *c;
+	int size;
+	int skip;
+
+	size = 64;
+	numQueries = 0;
+	skip = 0;
+	queries = (char **) malloc(size * sizeof(char *));
+
+	while((query = readQuery()) != NULL && numQueries < maxNumQueries)
+	{
+		for (c = query; *c != '\0' && isWhiteSpace(*c); c++)
+			;
+
+		if (*c == '\0' || skip++ < startQuery)
+		{
+			free(query);
+			continue;
+		}
+
+		if (numQueries == size)
+		{
+			size *= 2;
+			queries = (char **) realloc(queries, size * sizeof(char *));
+		}
+		queries[numQueries++] = query;
+	}
+
+	if (numQueries == 0)
+	{
+		fprintf(stderr, "$Q(-2): no queries in workload\n");
+		exit(1);
+	}
+}
+
+/*
+ * Replace sweep options that contain a "%" with all boolean options whose
+ * names match this pattern (e.g., "prov_use_%").
+ */
+
+static void
+expandSweepGucs (void)
+{
+	char *expanded[MAX_OPTIONS];
+	int numExpanded;
+	const char *params[1];
+	PGconn *con;
+	PGresult *result;
+	int i;
+	int j;
+
+	numExpanded = 0;
+	con = NULL;
+
+	for (i = 0; i < numSweepGucs; i++)
+	{
+		if (strchr(sweepGucs[i], '%') == NULL)
+		{
+			if (numExpanded < MAX_OPTIONS)
+				expanded[numExpanded++] = sweepGucs[i];
+			continue;
+		}
+
+		if (con == NULL)
+			con = connectToDB();
+
+		params[0] = sweepGucs[i];
+		result = PQexecParams(con, "SELECT name FROM pg_settings WHERE name LIKE $1 "
+				"AND vartype = 'bool' ORDER BY name", 1, NULL, params, NULL, NULL, 0);
+
+		if (PQresultStatus(result) != PGRES_TUPLES_OK)
+		{
+			fprintf(stderr, "$Q(-2): could not expand option pattern %s\n%s", sweepGucs[i],
+					PQresultErrorMessage(result));
+			exit(1);
+		}
+
+		for (j = 0; j < PQntuples(result) && numExpanded < MAX_OPTIONS; j++)
+			expanded[numExpanded++] = strdup(PQgetvalue(result, j, 0));
+
+		PQclear(result);
+	}
+
+	if (con != NULL)
+		PQfinish(con);
+
+	if (numExpanded > MAX_SWEEP_GUCS)
+	{
+		fprintf(stderr, "$Q(-2): can not sweep more than %i options (got %i)\n", MAX_SWEEP_GUCS, numExpanded);
+		exit(1);
+	}
+
+	for (i = 0; i < numExpanded; i++)
+		sweepGucs[i] = expanded[i];
+	numSweepGucs = numExpanded;
+}
+
+/*
+ * Parse a comma separated list of variant names.
+ */
+
+static void
+parseVariants (char *list)
+{
+	char *name;
+	int i;
+
+	for (name = strtok(list, ","); name != NULL; name = strtok(NULL, ","))
+	{
+		for (i = 0; i < MAX_VARIANTS; i++)
+		{
+			if (strcmp(name, variantNames[i]) == 0)
+				break;
+		}
+
+		if (i == MAX_VARIANTS || numVariants == MAX_VARIANTS)
+		{
+			fprintf(stderr, "$Q(-2): unknown or repeated variant %s (use plain, prov, contr or trans)\n", name);
+			exit(1);
+		}
+
+		variants[numVariants++] = (BenchVariant) i;
+	}
+}
+
+/*
+ * Main loop of a client thread. All clients run the same query at the same
+ * time. Warmups and measured repetitions are separated by a barrier, so the
+ * measured runs of all clients overlap.
+ */
+
+static void *
+runClient (void *arg)
+{
+	BenchClient *client = (BenchClient *) arg;
+	BenchSample warmup;
+	BenchCell *cell;
+	char *query;
+	int config;
+	int variant;
+	int q;
+	int i;
+
+	for (config = 0; config < numConfigs; config++)
+	{
+		setConfiguration(client, config);
+
+		for (variant = 0; variant < numVariants; variant++)
+		{
+			for (q = 0; q < numQueries; q++)
+			{
+				cell = getCell(config, variant, q);
+
+				/* not a query, run it once per client without measuring */
+				if (!isSelect(queries[q]))
+				{
+					cell->skipped = 1;
+					if (config == 0 && variant == 0)
+						runBenchQuery(client, queries[q], &warmup);
+					continue;
+				}
+
+				query = getVariantQuery(queries[q], variants[variant]);
+
+				/* variant does not apply to this query */
+				if (query == NULL)
+				{
+					cell->skipped = 1;
+					continue;
+				}
+
+				waitForClients();
+
+				for (i = 0; i < numWarmups; i++)
+					runBenchQuery(client, query, &warmup);
+
+				waitForClients();
+
+				for (i = 0; i < numReps; i++)
+					runBenchQuery(client, query, &cell->samples[client->id * numReps + i]);
+
+				free(query);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Barrier for all client threads.
+ */
+
+static void
+waitForClients (void)
+{
+	int generation;
+
+	pthread_mutex_lock(&barrierLock);
+
+	generation = barrierGeneration;
+
+	if (++barrierCount == numClients)
+	{
+		barrierCount = 0;
+		barrierGeneration++;
+		pthread_cond_broadcast(&barrierCond);
+	}
+	else
+	{
+		while (generation == barrierGeneration)
+			pthread_cond_wait(&barrierCond, &barrierLock);
+	}
+
+	pthread_mutex_unlock(&barrierLock);
+}
+
+/*
+ * Run a utility command and exit if it fails.
+ */
+
+static void
+execCommand (PGconn *con, char *command)
+{
+	PGresult *result;
+
+	result = PQexec(con, command);
+
+	if (PQresultStatus(result) != PGRES_COMMAND_OK)
+	{
+		fprintf(stderr, "$Q(-2): %s\n\nERROR:\n%s\n%s", command, PQerrorMessage(con), PQresultErrorMessage(result));
+		exit(1);
+	}
+
+	PQclear(result);
+}
+
+/*
+ * Set the fixed options (-t, -f) and the swept options for a GUC combination.
+ * Bit i of config is the value of the i-th swept option.
+ */
+
+static void
+setConfiguration (BenchClient *client, int config)
+{
+	char command[500];
+	int i;
+
+	for (i = 0; i < optionsTrueNum; i++)
+	{
+		snprintf(command, sizeof(command), "SET %s TO TRUE", trueOptions[i]);
+		execCommand(client->conn, command);
+	}
+
+	for (i = 0; i < optionsFalseNum; i++)
+	{
+		snprintf(command, sizeof(command), "SET %s TO FALSE", falseOptions[i]);
+		execCommand(client->conn, command);
+	}
+
+	for (i = 0; i < numSweepGucs; i++)
+	{
+		snprintf(command, sizeof(command), "SET %s TO %s", sweepGucs[i], (config & (1 << i)) ? "TRUE" : "FALSE");
+		execCommand(client->conn, command);
+	}
+}
+
+/*
+ * Create the text of a query for a provenance variant by adding the variant's
+ * keywords after the leading SELECT. Returns NULL if the variant does not apply
+ * to the statement, e.g., because it is not a query or already computes
+ * provenance.
+ */
+
+static char *
+getVariantQuery (char *query, BenchVariant variant)
+{
+	char *result;
+	char *keywords;
+	char *c;
+	int prefix;
+	int i;
+
+	if (variant == VARIANT_PLAIN)
+		return strdup(query);
+
+	if (!isSelect(query))
+		return NULL;
+
+	for (c = query; isWhiteSpace(*c); c++)
+		;
+	prefix = (c - query) + 6;
+
+	/* already a provenance query? */
+	for (c = query + prefix; isWhiteSpace(*c); c++)
+		;
+	for (i = 0; c[i] != '\0' && !isWhiteSpace(c[i]); i++)
+		;
+	if ((i == 10 && strncasecmp(c, "PROVENANCE", 10) == 0)
+			|| (i == 9 && strncasecmp(c, "TRANSPROV", 9) == 0))
+		return NULL;
+
+	switch(variant)
+	{
+		case VARIANT_PROV:
+			keywords = strdup(" PROVENANCE");
+			break;
+		case VARIANT_CONTR:
+			keywords = (char *) malloc(strlen(contributionType) + 40);
+			sprintf(keywords, " PROVENANCE ON CONTRIBUTION (%s)", contributionType);
+			break;
+		case VARIANT_TRANS:
+			keywords = strdup(" TRANSPROV");
+			break;
+		default:
+			return NULL;
+	}
+
+	result = (char *) malloc(strlen(query) + strlen(keywords) + 1);
+	memcpy(result, query, prefix);
+	strcpy(result + prefix, keywords);
+	strcat(result, query + prefix);
+
+	free(keywords);
+
+	return result;
+}
+
+/*
+ * Run a query once and record wall clock time, server side phase times,
+ * number of rows and result bytes in sample.
+ */
+
+static void
+runBenchQuery (BenchClient *client, char *query, BenchSample *sample)
+{
+	struct timeval startSecs;
+	struct timeval stopSecs;
+	PGresult *result;
+	char *cursorQuery;
+	int i;
+
+	memset(sample, 0, sizeof(BenchSample));
+	for (i = 0; i < PHASE_NUM; i++)
+		client->phase[i] = 0.0;
+
+	gettimeofday(&startSecs, NULL);
+
+	if (useCursor && isSelect(query))
+	{
+		result = PQexec(client->conn, "BEGIN TRANSACTION");
+		PQclear(result);
+
+		cursorQuery = (char *) malloc(80 + strlen(query));
+		sprintf(cursorQuery, "DECLARE mycursor BINARY NO SCROLL CURSOR FOR %s", query);
+		result = PQexec(client->conn, cursorQuery);
+		free(cursorQuery);
+
+		if (PQresultStatus(result) == PGRES_COMMAND_OK)
+		{
+			PQclear(result);
+
+			/* fetch results in steps of 1000 */
+			result = PQexec(client->conn, "FETCH 1000 FROM mycursor");
+			while(PQresultStatus(result) == PGRES_TUPLES_OK && PQntuples(result) > 0)
+			{
+				sample->rows += PQntuples(result);
+				sample->bytes += getResultBytes(result);
+				PQclear(result);
+				result = PQexec(client->conn, "FETCH 1000 FROM mycursor");
+			}
+		}
+
+		if (PQresultStatus(result) != PGRES_TUPLES_OK && PQresultStatus(result) != PGRES_COMMAND_OK)
+		{
+			sample->failed = 1;
+			fprintf(stderr, "$Q(%i): %s\n\nERROR:\n%s", client->id, query, PQresultErrorMessage(result));
+		}
+		PQclear(result);
+
+		result = PQexec(client->conn, sample->failed ? "ROLLBACK" : "END TRANSACTION");
+		PQclear(result);
+
+		gettimeofday(&stopSecs, NULL);
+	}
+	else
+	{
+		result = PQexec(client->conn, query);
+
+		gettimeofday(&stopSecs, NULL);
+
+		if (PQresultStatus(result) == PGRES_TUPLES_OK)
+		{
+			sample->rows = PQntuples(result);
+			sample->bytes = getResultBytes(result);
+		}
+		else if (PQresultStatus(result) != PGRES_COMMAND_OK)
+		{
+			sample->failed = 1;
+			fprintf(stderr, "$Q(%i): %s\n\nERROR:\n%s", client->id, query, PQresultErrorMessage(result));
+		}
+		PQclear(result);
+	}
+
+	sample->wall = getTimeDiffMs(startSecs, stopSecs);
+	for (i = 0; i < PHASE_NUM; i++)
+		sample->phase[i] = client->phase[i];
+}
+
+/*
+ * Notice receiver that adds the elapsed time of statistics messages produced
+ * by the log_*_stats options to the phase timers of a client. Other notices
+ * that are not LOG messages are printed to stderr.
+ */
+
+static void
+phaseNoticeReceiver (void *arg, const PGresult *res)
+{
+	BenchClient *client = (BenchClient *) arg;
+	char *severity;
+	char *title;
+	char *detail;
+	char *elapsed;
+	long secs;
+	long usecs;
+	int phase;
+
+	severity = PQresultErrorField(res, PG_DIAG_SEVERITY);
+	title = PQresultErrorField(res, PG_DIAG_MESSAGE_PRIMARY);
+	detail = PQresultErrorField(res, PG_DIAG_MESSAGE_DETAIL);
+
+	if (title == NULL)
+		return;
+
+	if (strcmp(title, "PARSER STATISTICS") == 0 || strcmp(title, "PARSE ANALYSIS STATISTICS") == 0)
+		phase = PHASE_PARSE;
+	else if (strcmp(title, "REWRITER STATISTICS") == 0 || strcmp(title, "PROVENANCE REWRITER STATISTICS") == 0)
+		phase = PHASE_REWRITE;
+	else if (strcmp(title, "PLANNER STATISTICS") == 0)
+		phase = PHASE_PLAN;
+	else if (strcmp(title, "EXECUTOR STATISTICS") == 0)
+		phase = PHASE_EXEC;
+	else
+	{
+		if (severity == NULL || strcmp(severity, "LOG") != 0)
+			fprintf(stderr, "%s", PQresultErrorMessage(res));
+		return;
+	}
+
+	/* the first line of the detail is "! system usage stats:" followed by "!\t<secs>.<usecs> elapsed ..." */
+	if (detail == NULL || (elapsed = strstr(detail, "!\t")) == NULL)
+		return;
+
+	if (sscanf(elapsed + 2, "%ld.%ld elapsed", &secs, &usecs) == 2)
+		client->phase[phase] += secs * 1000.0 + usecs / 1000.0;
+}
+
+/*
+ * Number of bytes of the values in a result.
+ */
+
+static long
+getResultBytes (PGresult *result)
+{
+	long bytes;
+	int numRows;
+	int numFields;
+	int i;
+	int j;
+
+	bytes = 0;
+	numRows = PQntuples(result);
+	numFields = PQnfields(result);
+
+	for (i = 0; i < numRows; i++)
+		for (j = 0; j < numFields; j++)
+			bytes += PQgetlength(result, i, j);
+
+	return bytes;
+}
+
+static double
+getTimeDiffMs (struct timeval start, struct timeval stop)
+{
+	return (stop.tv_sec - start.tv_sec) * 1000.0 + (stop.tv_usec - start.tv_usec) / 1000.0;
+}
+
+static BenchCell *
+getCell (int config, int variant, int query)
+{
+	return &cells[(config * numVariants + variant) * numQueries + query];
+}
+
+/*
+ * Print one CSV line for each measured query, variant and GUC combination.
+ * Phase times, rows and bytes are averages over the successful runs.
+ */
+
+static void
+printBenchResults (void)
+{
+	BenchCell *cell;
+	BenchSample *sample;
+	double *walls;
+	double phaseSum[PHASE_NUM];
+	double wallSum;
+	double rowSum;
+	double byteSum;
+	char *configString;
+	int numSamples;
+	int numOk;
+	int config;
+	int variant;
+	int q;
+	int i;
+	int j;
+
+	numSamples = numClients * numReps;
+	walls = (double *) malloc(numSamples * sizeof(double));
+
+	printf("config,variant,query,clients,runs,errors,rows,result_bytes,"
+			"min_ms,avg_ms,p50_ms,p95_ms,p99_ms,max_ms,parse_ms,rewrite_ms,plan_ms,exec_ms\n");
+
+	for (config = 0; config < numConfigs; config++)
+	{
+		configString = getConfigString(config);
+
+		for (variant = 0; variant < numVariants; variant++)
+		{
+			for (q = 0; q < numQueries; q++)
+			{
+				cell = getCell(config, variant, q);
+
+				if (cell->skipped)
+					continue;
+
+				numOk = 0;
+				wallSum = rowSum = byteSum = 0.0;
+				for (j = 0; j < PHASE_NUM; j++)
+					phaseSum[j] = 0.0;
+
+				for (i = 0; i < numSamples; i++)
+				{
+					sample = &cell->samples[i];
+
+					if (sample->failed)
+						continue;
+
+					walls[numOk++] = sample->wall;
+					wallSum += sample->wall;
+					rowSum += sample->rows;
+					byteSum += sample->bytes;
+					for (j = 0; j < PHASE_NUM; j++)
+						phaseSum[j] += sample->phase[j];
+				}
+
+				printf("%s,%s,%i,%i,%i,%i,", configString, variantNames[variants[variant]],
+						q + startQuery + 1, numClients, numOk, numSamples - numOk);
+
+				if (numOk == 0)
+				{
+					printf(",,,,,,,,,,,\n");
+					continue;
+				}
+
+				qsort(walls, numOk, sizeof(double), compareDoubles);
+
+				printf("%.0f,%.0f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,", rowSum / numOk, byteSum / numOk,
+						walls[0], wallSum / numOk, getPercentile(walls, numOk, 50.0),
+						getPercentile(walls, numOk, 95.0), getPercentile(walls, numOk, 99.0),
+						walls[numOk - 1]);
+
+				if (usePhaseStats)
+					printf("%.3f,%.3f,%.3f,%.3f\n", phaseSum[PHASE_PARSE] / numOk, phaseSum[PHASE_REWRITE] / numOk,
+							phaseSum[PHASE_PLAN] / numOk, phaseSum[PHASE_EXEC] / numOk);
+				else
+					printf(",,,\n");
+			}
+		}
+
+		free(configString);
+	}
+
+	fflush(stdout);
+	free(walls);
+}
+
+/*
+ * Encode a GUC combination as "name=on;name=off" (or "default" if no options are swept).
+ */
+
+static char *
+getConfigString (int config)
+{
+	char *result;
+	int size;
+	int i;
+
+	if (numSweepGucs == 0)
+		return strdup("default");
+
+	size = 1;
+	for (i = 0; i < numSweepGucs; i++)
+		size += strlen(sweepGucs[i]) + 6;
+
+	result = (char *) malloc(size);
+	result[0] = '\0';
+
+	for (i = 0; i < numSweepGucs; i++)
+	{
+		if (i > 0)
+			strcat(result, ";");
+		strcat(result, sweepGucs[i]);
+		strcat(result, (config & (1 << i)) ? "=on" : "=off");
+	}
+
+	return result;
+}
+
+static int
+compareDoubles (const void *left, const void *right)
+{
+	double l = *((const double *) left);
+	double r = *((const double *) right);
+
+	if (l < r)
+		return -1;
+	if (l > r)
+		return 1;
+	return 0;
+}
+
+/*
+ * Nearest rank percentile of a sorted array.
+ */
+
+static double
+getPercentile (double *sorted, int num, double percent)
+{
+	int rank;
+
+	rank = (int) ceil(percent / 100.0 * num);
+
+	if (rank < 1)
+		rank = 1;
+	if (rank > num)
+		rank = num;
+
+	return sorted[rank - 1];
 }
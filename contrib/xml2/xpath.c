@@ -3,10 +3,12 @@
 
 #include "postgres.h"
 #include "fmgr.h"
+#include "access/hash.h"
 #include "executor/spi.h"
 #include "funcapi.h"
 #include "miscadmin.h"
 #include "lib/stringinfo.h"
+#include "utils/memutils.h"
 
 /* libxml includes */
 
@@ -29,6 +31,18 @@ static void pgxml_errorHandler(void *ctxt, const char *msg,...);
 
 void		elog_error(int level, char *explain, int force);
 void		pgxml_parser_init(void);
+void		pgxml_parser_cleanup(void);
+
+typedef struct pgxml_cache pgxml_cache;
+
+pgxml_cache *pgxml_cache_create(int size, void (*freefunc) (void *));
+void	   *pgxml_cache_lookup(pgxml_cache *cache, text *key, uint32 *hash);
+MemoryContext pgxml_cache_begin(void);
+void	   *pgxml_cache_end(pgxml_cache *cache, text *key, uint32 hash,
+				void *value, MemoryContext oldcxt);
+void		pgxml_cache_abort(MemoryContext oldcxt);
+
+static void pgxml_free_doc(void *doc);
 
 static xmlChar *pgxmlNodeSetToText(xmlNodeSetPtr nodeset,
 				   xmlChar * toptagname, xmlChar * septagname,
@@ -51,10 +65,45 @@ Datum		xpath_bool(PG_FUNCTION_ARGS);
 Datum		xpath_list(PG_FUNCTION_ARGS);
 Datum		xpath_table(PG_FUNCTION_ARGS);
 
+/*
+ * Backend local cache of objects built from a text argument, e.g. parsed
+ * documents or compiled stylesheets.  Functions are often called once per
+ * row with the same document or stylesheet, so we keep the most recently
+ * used objects instead of building them again.  The entries are ordered by
+ * their last use; when the cache is full the least recently used entry is
+ * freed.
+ *
+ * libxml allocates with palloc (see pgxml_parser_init), so each cached
+ * object is built in a memory context of its own that lives until the
+ * entry is evicted.
+ */
+typedef struct pgxml_cache_entry
+{
+	uint32		hash;			/* hash value of the key */
+	text	   *key;			/* the text the value was built from */
+	void	   *value;			/* the cached object */
+	MemoryContext context;		/* holds key and value */
+} pgxml_cache_entry;
+
+struct pgxml_cache
+{
+	int			size;			/* maximal number of entries */
+	int			nentries;		/* current number of entries */
+	void		(*freefunc) (void *);	/* releases a cached object */
+	pgxml_cache_entry entries[1];		/* VARIABLE LENGTH ARRAY */
+};
+
+/* number of parsed documents kept for the xpath functions */
+#define PGXML_DOC_CACHE_SIZE 4
+
 /* Global variables */
 char	   *errbuf;				/* per line error buffer */
 char	   *pgxml_errorMsg = NULL;		/* overall error message */
 
+static pgxml_cache *pgxml_doc_cache = NULL;	/* parsed documents */
+static int	pgxml_cached_objects = 0;	/* entries of all caches */
+static MemoryContext pgxml_entrycxt = NULL;	/* entry being built */
+
 /* Convenience macros */
 
 #define GET_TEXT(cstrp) DatumGetTextP(DirectFunctionCall1(textin, CStringGetDatum(cstrp)))
@@ -163,6 +212,172 @@ pgxml_parser_init()
 
 }
 
+/*
+ * Cleans up the global state of the parser at the end of a call.  Cached
+ * objects may refer to this state, so it is kept while any cache has an
+ * entry.
+ */
+void
+pgxml_parser_cleanup(void)
+{
+	if (pgxml_cached_objects == 0)
+		xmlCleanupParser();
+}
+
+
+/* Creates an empty cache for at most size objects in TopMemoryContext */
+
+pgxml_cache *
+pgxml_cache_create(int size, void (*freefunc) (void *))
+{
+	pgxml_cache *cache;
+
+	cache = MemoryContextAllocZero(TopMemoryContext,
+								   offsetof(pgxml_cache, entries) +
+								   size * sizeof(pgxml_cache_entry));
+	cache->size = size;
+	cache->freefunc = freefunc;
+
+	return cache;
+}
+
+/*
+ * Returns the object cached for key or NULL.  The hash value of key is
+ * returned in *hash, it has to be passed to pgxml_cache_end if a new object
+ * is stored.
+ */
+
+void *
+pgxml_cache_lookup(pgxml_cache *cache, text *key, uint32 *hash)
+{
+	int32		keysize = VARSIZE(key) - VARHDRSZ;
+	int			i;
+
+	*hash = DatumGetUInt32(hash_any((unsigned char *) VARDATA(key), keysize));
+
+	for (i = 0; i < cache->nentries; i++)
+	{
+		pgxml_cache_entry entry = cache->entries[i];
+
+		if (entry.hash == *hash && VARSIZE(entry.key) == VARSIZE(key) &&
+			memcmp(VARDATA(entry.key), VARDATA(key), keysize) == 0)
+		{
+			/* move the entry to the front */
+			memmove(&cache->entries[1], &cache->entries[0],
+					i * sizeof(pgxml_cache_entry));
+			cache->entries[0] = entry;
+
+			return entry.value;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Creates the memory context for a new cache entry and switches to it.  The
+ * object to cache has to be built in this context.  Returns the previous
+ * memory context.
+ */
+
+MemoryContext
+pgxml_cache_begin(void)
+{
+	MemoryContext entrycxt;
+
+	entrycxt = AllocSetContextCreate(TopMemoryContext,
+									 "XML cache entry",
+									 ALLOCSET_SMALL_MINSIZE,
+									 ALLOCSET_SMALL_INITSIZE,
+									 ALLOCSET_DEFAULT_MAXSIZE);
+	pgxml_entrycxt = entrycxt;
+
+	return MemoryContextSwitchTo(entrycxt);
+}
+
+/*
+ * Switches back to oldcxt after an object has been built in the entry
+ * context created by pgxml_cache_begin.  If value is not NULL it is stored
+ * in the cache under key, otherwise the entry context is deleted.  Returns
+ * value.
+ */
+
+void *
+pgxml_cache_end(pgxml_cache *cache, text *key, uint32 hash, void *value,
+				MemoryContext oldcxt)
+{
+	pgxml_cache_entry *entry;
+	MemoryContext entrycxt;
+
+	entrycxt = MemoryContextSwitchTo(oldcxt);
+	pgxml_entrycxt = NULL;
+
+	/*
+	 * Error messages of the parser must survive the entry context, libxml's
+	 * copy of the last error is not used and must not refer to it.
+	 */
+	if (pgxml_errorMsg != NULL)
+		pgxml_errorMsg = pstrdup(pgxml_errorMsg);
+	xmlResetLastError();
+
+	if (value == NULL)
+	{
+		MemoryContextDelete(entrycxt);
+		return NULL;
+	}
+
+	/* evict the least recently used entry */
+	if (cache->nentries == cache->size)
+	{
+		entry = &cache->entries[--cache->nentries];
+		(*cache->freefunc) (entry->value);
+		MemoryContextDelete(entry->context);
+		pgxml_cached_objects--;
+	}
+
+	memmove(&cache->entries[1], &cache->entries[0],
+			cache->nentries * sizeof(pgxml_cache_entry));
+	cache->nentries++;
+	pgxml_cached_objects++;
+
+	entry = &cache->entries[0];
+	entry->hash = hash;
+	entry->key = MemoryContextAlloc(entrycxt, VARSIZE(key));
+	memcpy(entry->key, key, VARSIZE(key));
+	entry->value = value;
+	entry->context = entrycxt;
+
+	return value;
+}
+
+/*
+ * Has to be called instead of pgxml_cache_end if an error is raised while
+ * the object is built.  Deletes the entry context, which would otherwise be
+ * left behind in TopMemoryContext, and switches back to oldcxt.
+ */
+
+void
+pgxml_cache_abort(MemoryContext oldcxt)
+{
+	MemoryContextSwitchTo(oldcxt);
+
+	/* the error message may have been allocated in the entry context */
+	pgxml_errorMsg = NULL;
+	xmlResetLastError();
+
+	if (pgxml_entrycxt != NULL)
+	{
+		MemoryContextDelete(pgxml_entrycxt);
+		pgxml_entrycxt = NULL;
+	}
+}
+
+static void
+pgxml_free_doc(void *doc)
+{
+	xmlFreeDoc((xmlDocPtr) doc);
+}
+
 
 /* Returns true if document is well-formed */
 
@@ -181,10 +396,10 @@ xml_is_well_formed(PG_FUNCTION_ARGS)
 	doctree = xmlParseMemory((char *) VARDATA(t), docsize);
 	if (doctree == NULL)
 	{
-		xmlCleanupParser();
+		pgxml_parser_cleanup();
 		PG_RETURN_BOOL(false);	/* i.e. not well-formed */
 	}
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 	xmlFreeDoc(doctree);
 	PG_RETURN_BOOL(true);
 }
@@ -431,7 +646,7 @@ xpath_string(PG_FUNCTION_ARGS)
 								 pgxml_xpath(PG_GETARG_TEXT_P(0), xpath),
 								 NULL, NULL, NULL);
 
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 	pfree(xpath);
 
 	if (xpres == NULL)
@@ -466,12 +681,12 @@ xpath_number(PG_FUNCTION_ARGS)
 
 	if (res == NULL)
 	{
-		xmlCleanupParser();
+		pgxml_parser_cleanup();
 		PG_RETURN_NULL();
 	}
 
 	fRes = xmlXPathCastToNumber(res);
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 	if (xmlXPathIsNaN(fRes))
 		PG_RETURN_NULL();
 
@@ -506,12 +721,12 @@ xpath_bool(PG_FUNCTION_ARGS)
 
 	if (res == NULL)
 	{
-		xmlCleanupParser();
+		pgxml_parser_cleanup();
 		PG_RETURN_BOOL(false);
 	}
 
 	bRes = xmlXPathCastToBoolean(res);
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 	PG_RETURN_BOOL(bRes);
 
 }
@@ -531,13 +746,37 @@ pgxml_xpath(text *document, xmlChar * xpath)
 	xmlXPathCompExprPtr comppath;
 
 	int32		docsize;
+	uint32		hash;
 
 
 	docsize = VARSIZE(document) - VARHDRSZ;
 
 	pgxml_parser_init();
 
-	doctree = xmlParseMemory((char *) VARDATA(document), docsize);
+	if (pgxml_doc_cache == NULL)
+		pgxml_doc_cache = pgxml_cache_create(PGXML_DOC_CACHE_SIZE,
+											 pgxml_free_doc);
+
+	/* The document is kept, so the xpath result must not free it */
+	doctree = pgxml_cache_lookup(pgxml_doc_cache, document, &hash);
+	if (doctree == NULL)
+	{
+		MemoryContext oldcxt;
+
+		oldcxt = pgxml_cache_begin();
+		PG_TRY();
+		{
+			doctree = xmlParseMemory((char *) VARDATA(document), docsize);
+		}
+		PG_CATCH();
+		{
+			pgxml_cache_abort(oldcxt);
+			PG_RE_THROW();
+		}
+		PG_END_TRY();
+		doctree = pgxml_cache_end(pgxml_doc_cache, document, hash, doctree,
+								  oldcxt);
+	}
 	if (doctree == NULL)
 	{							/* not well-formed */
 		return NULL;
@@ -551,8 +790,7 @@ pgxml_xpath(text *document, xmlChar * xpath)
 	comppath = xmlXPathCompile(xpath);
 	if (comppath == NULL)
 	{
-		xmlCleanupParser();
-		xmlFreeDoc(doctree);
+		pgxml_parser_cleanup();
 		elog_error(ERROR, "XPath Syntax Error", 1);
 
 		return NULL;
@@ -566,11 +804,9 @@ pgxml_xpath(text *document, xmlChar * xpath)
 	{
 		xmlXPathFreeContext(ctxt);
 		/* xmlCleanupParser(); */
-		xmlFreeDoc(doctree);
 
 		return NULL;
 	}
-	/* xmlFreeDoc(doctree); */
 	return res;
 }
 
@@ -587,7 +823,7 @@ pgxml_result_to_text(xmlXPathObjectPtr res,
 
 	if (res == NULL)
 	{
-		xmlCleanupParser();
+		pgxml_parser_cleanup();
 		return NULL;
 	}
 	switch (res->type)
@@ -615,7 +851,7 @@ pgxml_result_to_text(xmlXPathObjectPtr res,
 	SET_VARSIZE(xpres, ressize + VARHDRSZ);
 
 	/* Free various storage */
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 	/* xmlFreeDoc(doctree);  -- will die at end of tuple anyway */
 
 	xmlFree(xpresstr);
@@ -858,7 +1094,7 @@ xpath_table(PG_FUNCTION_ARGS)
 					comppath = xmlXPathCompile(xpaths[j]);
 					if (comppath == NULL)
 					{
-						xmlCleanupParser();
+						pgxml_parser_cleanup();
 						xmlFreeDoc(doctree);
 
 						elog_error(ERROR, "XPath Syntax Error", 1);
@@ -927,7 +1163,7 @@ xpath_table(PG_FUNCTION_ARGS)
 		pfree(xmldoc);
 	}
 
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 /* Needed to flag completeness in 7.3.1. 7.4 defines it as a no-op. */
 	tuplestore_donestoring(tupstore);
 
@@ -6,6 +6,7 @@
 #include "executor/spi.h"
 #include "funcapi.h"
 #include "miscadmin.h"
+#include "utils/memutils.h"
 
 /* libxml includes */
 
@@ -19,24 +20,41 @@
 #include <libxslt/xsltInternals.h>
 #include <libxslt/transform.h>
 #include <libxslt/xsltutils.h>
+#include <libxslt/extensions.h>
 
 
 /* declarations to come from xpath.c */
 
 extern void elog_error(int level, char *explain, int force);
 extern void pgxml_parser_init();
+extern void pgxml_parser_cleanup(void);
 extern xmlChar *pgxml_texttoxmlchar(text *textstring);
 
+typedef struct pgxml_cache pgxml_cache;
+
+extern pgxml_cache *pgxml_cache_create(int size, void (*freefunc) (void *));
+extern void *pgxml_cache_lookup(pgxml_cache *cache, text *key, uint32 *hash);
+extern MemoryContext pgxml_cache_begin(void);
+extern void *pgxml_cache_end(pgxml_cache *cache, text *key, uint32 hash,
+				void *value, MemoryContext oldcxt);
+extern void pgxml_cache_abort(MemoryContext oldcxt);
+
 #define GET_STR(textp) DatumGetCString(DirectFunctionCall1(textout, PointerGetDatum(textp)))
 
 /* local defs */
 static void parse_params(const char **params, text *paramstr);
+static void xslt_free_stylesheet(void *stylesheet);
 
 Datum		xslt_process(PG_FUNCTION_ARGS);
 
 
 #define MAXPARAMS 20
 
+/* number of compiled stylesheets kept across calls */
+#define XSLT_CACHE_SIZE 16
+
+static pgxml_cache *xslt_cache = NULL;
+
 PG_FUNCTION_INFO_V1(xslt_process);
 
 Datum
@@ -52,6 +70,7 @@ xslt_process(PG_FUNCTION_ARGS)
 	xmlChar    *resstr;
 	int			resstat;
 	int			reslen;
+	uint32		hash;
 
 	text	   *doct = PG_GETARG_TEXT_P(0);
 	text	   *ssheet = PG_GETARG_TEXT_P(1);
@@ -71,6 +90,22 @@ xslt_process(PG_FUNCTION_ARGS)
 	/* Setup parser */
 	pgxml_parser_init();
 
+	/*
+	 * Compiled stylesheets are kept across calls, so the global state of
+	 * libxslt they refer to has to live as long.  It is set up once in
+	 * TopMemoryContext and never cleaned up.
+	 */
+	if (xslt_cache == NULL)
+	{
+		MemoryContext oldcxt = MemoryContextSwitchTo(TopMemoryContext);
+
+		xsltInitGlobals();
+		xsltInit();
+		MemoryContextSwitchTo(oldcxt);
+
+		xslt_cache = pgxml_cache_create(XSLT_CACHE_SIZE, xslt_free_stylesheet);
+	}
+
 	/* Check to see if document is a file or a literal */
 
 	if (VARDATA(doct)[0] == '<')
@@ -80,26 +115,48 @@ xslt_process(PG_FUNCTION_ARGS)
 
 	if (doctree == NULL)
 	{
-		xmlCleanupParser();
+		pgxml_parser_cleanup();
 		elog_error(ERROR, "error parsing XML document", 0);
 
 		PG_RETURN_NULL();
 	}
 
-	/* Same for stylesheet */
+	/*
+	 * Same for stylesheet.  Literal stylesheets are compiled once and looked
+	 * up in the cache afterwards, files may change and are always read.
+	 */
 	if (VARDATA(ssheet)[0] == '<')
 	{
-		ssdoc = xmlParseMemory((char *) VARDATA(ssheet),
-							   VARSIZE(ssheet) - VARHDRSZ);
-		if (ssdoc == NULL)
+		stylesheet = pgxml_cache_lookup(xslt_cache, ssheet, &hash);
+		if (stylesheet == NULL)
+		{
+			MemoryContext oldcxt;
+
+			oldcxt = pgxml_cache_begin();
+			PG_TRY();
+			{
+				ssdoc = xmlParseMemory((char *) VARDATA(ssheet),
+									   VARSIZE(ssheet) - VARHDRSZ);
+				if (ssdoc != NULL)
+					stylesheet = xsltParseStylesheetDoc(ssdoc);
+			}
+			PG_CATCH();
+			{
+				xmlFreeDoc(doctree);
+				pgxml_cache_abort(oldcxt);
+				PG_RE_THROW();
+			}
+			PG_END_TRY();
+			stylesheet = pgxml_cache_end(xslt_cache, ssheet, hash, stylesheet,
+										 oldcxt);
+		}
+		if (ssdoc == NULL && stylesheet == NULL)
 		{
 			xmlFreeDoc(doctree);
-			xmlCleanupParser();
+			pgxml_parser_cleanup();
 			elog_error(ERROR, "error parsing stylesheet as XML document", 0);
 			PG_RETURN_NULL();
 		}
-
-		stylesheet = xsltParseStylesheetDoc(ssdoc);
 	}
 	else
 		stylesheet = xsltParseStylesheetFile((xmlChar *) GET_STR(ssheet));
@@ -108,8 +165,7 @@ xslt_process(PG_FUNCTION_ARGS)
 	if (stylesheet == NULL)
 	{
 		xmlFreeDoc(doctree);
-		xsltCleanupGlobals();
-		xmlCleanupParser();
+		pgxml_parser_cleanup();
 		elog_error(ERROR, "failed to parse stylesheet", 0);
 		PG_RETURN_NULL();
 	}
@@ -117,12 +173,13 @@ xslt_process(PG_FUNCTION_ARGS)
 	restree = xsltApplyStylesheet(stylesheet, doctree, params);
 	resstat = xsltSaveResultToString(&resstr, &reslen, restree, stylesheet);
 
-	xsltFreeStylesheet(stylesheet);
+	/* cached stylesheets are freed on eviction */
+	if (VARDATA(ssheet)[0] != '<')
+		xsltFreeStylesheet(stylesheet);
 	xmlFreeDoc(restree);
 	xmlFreeDoc(doctree);
 
-	xsltCleanupGlobals();
-	xmlCleanupParser();
+	pgxml_parser_cleanup();
 
 	if (resstat < 0)
 		PG_RETURN_NULL();
@@ -135,6 +192,13 @@ xslt_process(PG_FUNCTION_ARGS)
 }
 
 
+static void
+xslt_free_stylesheet(void *stylesheet)
+{
+	xsltFreeStylesheet((xsltStylesheetPtr) stylesheet);
+}
+
+
 void
 parse_params(const char **params, text *paramstr)
 {
@@ -2219,6 +2219,15 @@ GetTempToastNamespace(void)
 	return myTempToastNamespace;
 }
 
+/*
+ * GetTempNamespace - get the OID of my temporary-table namespace, or
+ * InvalidOid if it has not been set up in this backend
+ */
+Oid
+GetTempNamespace(void)
+{
+	return myTempNamespace;
+}
 
 /*
  * GetOverrideSearchPath - fetch current search path definition in form
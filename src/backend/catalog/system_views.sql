@@ -386,6 +386,11 @@ CREATE VIEW pg_stat_bgwriter AS
         pg_stat_get_buf_written_backend() AS buffers_backend,
         pg_stat_get_buf_alloc() AS buffers_alloc;
 
+CREATE VIEW pg_stat_provenance AS
+    SELECT *
+    FROM pg_stat_get_provenance() AS P
+    (phase text, calls int8, total_time float8, nodes int8, bytes int8);
+
 -- Tsearch debug function.  Defined here because it'd be pretty unwieldy
 -- to put it into pg_proc.h
 
@@ -36,6 +36,7 @@
 #include "provrewrite/prov_dotnode.h"
 #include "provrewrite/prov_nodes.h"
 #include "provrewrite/parse_back_db2.h"
+#include "provrewrite/prov_stats.h"
 
 /* Hook for plugins to get control in ExplainOneQuery() */
 ExplainOneQuery_hook_type ExplainOneQuery_hook = NULL;
@@ -79,6 +80,8 @@ static void show_sort_keys(Plan *sortplan, int nkeys, AttrNumber *keycols,
 			   StringInfo str, int indent, ExplainState *es);
 static void show_sort_info(SortState *sortstate,
 			   StringInfo str, int indent, ExplainState *es);
+static void show_prov_join_info(Join *join,
+					StringInfo str, int indent, ExplainState *es);
 static const char *explain_get_index_name(Oid indexId);
 
 
@@ -434,6 +437,10 @@ ExplainOnePlanProv (Query *query, PlannedStmt *plannedstmt, ParamListInfo params
 
 		totaltime += elapsed_time(&starttime);
 
+		/* show the statistics of the provenance rewrite */
+		if (stmt->analyze && query && provStatementStats.calls[PROV_PHASE_REWRITE] > 0)
+			provStatsExplain(&buf);
+
 		if (stmt->analyze)
 			appendStringInfo(&buf, "Total runtime: %.3f ms\n",
 							 1000.0 * totaltime);
@@ -591,6 +598,9 @@ explain_outNode(StringInfo str,
 				case JOIN_IN:
 					pname = "Nested Loop IN Join";
 					break;
+				case JOIN_ANTI:
+					pname = "Nested Loop Anti Join";
+					break;
 				default:
 					pname = "Nested Loop ??? Join";
 					break;
@@ -614,6 +624,9 @@ explain_outNode(StringInfo str,
 				case JOIN_IN:
 					pname = "Merge IN Join";
 					break;
+				case JOIN_ANTI:
+					pname = "Merge Anti Join";
+					break;
 				default:
 					pname = "Merge ??? Join";
 					break;
@@ -637,6 +650,9 @@ explain_outNode(StringInfo str,
 				case JOIN_IN:
 					pname = "Hash IN Join";
 					break;
+				case JOIN_ANTI:
+					pname = "Hash Anti Join";
+					break;
 				default:
 					pname = "Hash ??? Join";
 					break;
@@ -679,10 +695,16 @@ explain_outNode(StringInfo str,
 			switch (((Agg *) plan)->aggstrategy)
 			{
 				case AGG_PLAIN:
-					pname = "Aggregate";
+					if (((Agg *) plan)->provEmitInput)
+						pname = "Provenance Aggregate";
+					else
+						pname = "Aggregate";
 					break;
 				case AGG_SORTED:
-					pname = "GroupAggregate";
+					if (((Agg *) plan)->provEmitInput)
+						pname = "Provenance GroupAggregate";
+					else
+						pname = "GroupAggregate";
 					break;
 				case AGG_HASHED:
 					pname = "HashAggregate";
@@ -718,6 +740,9 @@ explain_outNode(StringInfo str,
 		case T_Limit:
 			pname = "Limit";
 			break;
+		case T_ProvNormalize:
+			pname = "Provenance Normalize";
+			break;
 		case T_Hash:
 			pname = "Hash";
 			break;
@@ -924,6 +949,8 @@ explain_outNode(StringInfo str,
 			show_upper_qual(((NestLoop *) plan)->join.joinqual,
 							"Join Filter", plan,
 							str, indent, es);
+			show_prov_join_info((Join *) plan,
+								str, indent, es);
 			show_upper_qual(plan->qual,
 							"Filter", plan,
 							str, indent, es);
@@ -935,6 +962,8 @@ explain_outNode(StringInfo str,
 			show_upper_qual(((MergeJoin *) plan)->join.joinqual,
 							"Join Filter", plan,
 							str, indent, es);
+			show_prov_join_info((Join *) plan,
+								str, indent, es);
 			show_upper_qual(plan->qual,
 							"Filter", plan,
 							str, indent, es);
@@ -946,6 +975,8 @@ explain_outNode(StringInfo str,
 			show_upper_qual(((HashJoin *) plan)->join.joinqual,
 							"Join Filter", plan,
 							str, indent, es);
+			show_prov_join_info((Join *) plan,
+								str, indent, es);
 			show_upper_qual(plan->qual,
 							"Filter", plan,
 							str, indent, es);
@@ -1138,6 +1169,18 @@ explain_outNode(StringInfo str,
 			SubPlanState *sps = (SubPlanState *) lfirst(lst);
 			SubPlan    *sp = (SubPlan *) sps->xprstate.expr;
 
+			if (sp->useMemoization)
+			{
+				for (i = 0; i < indent; i++)
+					appendStringInfo(str, "  ");
+				if (es->printAnalyze)
+					appendStringInfo(str, "    Memoized (hits=%ld misses=%ld evictions=%ld)\n",
+									 sps->memoHits, sps->memoMisses,
+									 sps->memoEvictions);
+				else
+					appendStringInfo(str, "    Memoized\n");
+			}
+
 			for (i = 0; i < indent; i++)
 				appendStringInfo(str, "  ");
 			appendStringInfo(str, "    ->  ");
@@ -1292,6 +1335,24 @@ show_sort_info(SortState *sortstate,
 	}
 }
 
+/*
+ * Show the size estimate of a join created by the provenance rewriter
+ */
+static void
+show_prov_join_info(Join *join,
+					StringInfo str, int indent, ExplainState *es)
+{
+	int			i;
+
+	if (join->provGroups <= 0)
+		return;
+
+	for (i = 0; i < indent; i++)
+		appendStringInfo(str, "  ");
+	appendStringInfo(str, "  Provenance Join: groups=%.0f fan-out=%.2f\n",
+					 join->provGroups, join->provFanout);
+}
+
 /*
  * Fetch the name of an index in an EXPLAIN
  *
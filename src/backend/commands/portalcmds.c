@@ -26,6 +26,7 @@
 #include "access/xact.h"
 #include "commands/portalcmds.h"
 #include "executor/executor.h"
+#include "provrewrite/prov_lazy.h"
 #include "tcop/pquery.h"
 #include "utils/memutils.h"
 
@@ -169,11 +170,14 @@ PerformPortalFetch(FetchStmt *stmt,
 	if (stmt->ismove)
 		dest = None_Receiver;
 
-	/* Do it */
-	nprocessed = PortalRunFetch(portal,
-								stmt->direction,
-								stmt->howMany,
-								dest);
+	/* Do it, lazy provenance cursors return the provenance of the fetched rows */
+	if (!stmt->ismove && getLazyProvCursorTupleDesc(portal) != NULL)
+		nprocessed = lazyProvCursorFetch(portal, stmt, dest);
+	else
+		nprocessed = PortalRunFetch(portal,
+									stmt->direction,
+									stmt->howMany,
+									dest);
 
 	/* Return command status if wanted */
 	if (completionTag)
@@ -242,6 +246,9 @@ PortalCleanup(Portal portal)
 	AssertArg(PortalIsValid(portal));
 	AssertArg(portal->cleanup == PortalCleanup);
 
+	/* release the state of a lazy provenance cursor */
+	releaseLazyProvCursor(portal);
+
 	/*
 	 * Shut down executor, if still running.  We skip this during error abort,
 	 * since other mechanisms will take care of releasing executor resources,
@@ -35,6 +35,8 @@
 #include "utils/lsyscache.h"
 #include "provrewrite/provrewrite.h"
 #include "provrewrite/prov_plan_all.h"
+#include "provrewrite/prov_matview.h"
+#include "provrewrite/prov_nodes.h"
 #include "provrewrite/prov_util.h"
 
 static void checkViewTupleDesc(TupleDesc newdesc, TupleDesc olddesc);
@@ -359,6 +361,13 @@ DefineView(ViewStmt *stmt, const char *queryString)
 	Oid			viewOid;
 	RangeVar   *view;
 
+	/* materialized provenance views are stored as a table plus a view */
+	if (stmt->materialized)
+	{
+		DefineMaterializedProvView(stmt, queryString);
+		return;
+	}
+
 	/*
 	 * Run parse analysis to convert the raw parse tree to a Query.  Note this
 	 * also acquires sufficient locks on the source table(s).
@@ -369,6 +378,12 @@ DefineView(ViewStmt *stmt, const char *queryString)
 	viewParse = parse_analyze((Node *) copyObject(stmt->query),
 							  queryString, NULL, 0);
 
+	/* the normalized provenance output is produced by the plan, it has no query representation */
+	if (IsProvNormalized(viewParse))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("FORMAT NORMALIZED is not supported in view definitions")));
+
 	/*
 	 * If the view's SELECT statement is marked for provenance rewrite
 	 * we have to rewrite the statement before passing it to
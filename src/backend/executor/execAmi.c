@@ -32,6 +32,7 @@
 #include "executor/nodeNestloop.h"
 #include "executor/nodeResult.h"
 #include "executor/nodeSeqscan.h"
+#include "executor/nodeProvNormalize.h"
 #include "executor/nodeSetOp.h"
 #include "executor/nodeSort.h"
 #include "executor/nodeSubplan.h"
@@ -193,6 +194,10 @@ ExecReScan(PlanState *node, ExprContext *exprCtxt)
 			ExecReScanLimit((LimitState *) node, exprCtxt);
 			break;
 
+		case T_ProvNormalizeState:
+			ExecReScanProvNormalize((ProvNormalizeState *) node, exprCtxt);
+			break;
+
 		default:
 			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(node));
 			break;
@@ -42,6 +42,7 @@
 #include "commands/tablespace.h"
 #include "commands/trigger.h"
 #include "executor/execdebug.h"
+#include "executor/execProvLineage.h"
 #include "executor/instrument.h"
 #include "executor/nodeSubplan.h"
 #include "miscadmin.h"
@@ -842,6 +843,15 @@ InitPlan(QueryDesc *queryDesc, int eflags)
 		}
 	}
 
+	/*
+	 * Initialize lineage capture of a provenance query that stores its
+	 * result (INSERT ... SELECT PROVENANCE or SELECT PROVENANCE ... INTO).
+	 */
+	if (plannedstmt->provLineage != NULL && !(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+		estate->es_provLineage =
+			ExecInitProvLineage((ProvLineageInfo *) plannedstmt->provLineage,
+								planstate, estate);
+
 	queryDesc->tupDesc = tupType;
 	queryDesc->planstate = planstate;
 
@@ -1138,6 +1148,12 @@ ExecEndPlan(PlanState *planstate, EState *estate)
 		heap_close(resultRelInfo->ri_RelationDesc, NoLock);
 	}
 
+	/*
+	 * close the lineage relation, again keeping the lock
+	 */
+	if (estate->es_provLineage != NULL)
+		ExecEndProvLineage(estate->es_provLineage);
+
 	/*
 	 * close any relations selected FOR UPDATE/FOR SHARE, again keeping locks
 	 */
@@ -1365,6 +1381,18 @@ lnext:	;
 				slot = ExecFilterJunk(junkfilter, slot);
 		}
 
+		/*
+		 * When capturing lineage, the plan returns a row for each witness of
+		 * a result row.  Only the first witness of a result row stores it,
+		 * the others only add lineage records.
+		 */
+		if (estate->es_provLineage != NULL &&
+			!ExecProvLineageNewTarget(estate->es_provLineage, planSlot))
+		{
+			ExecProvLineageRecord(estate->es_provLineage, planSlot);
+			continue;
+		}
+
 		/*
 		 * now that we have a tuple, do the appropriate thing with it.. either
 		 * return it to the user, add it to a relation someplace, delete it
@@ -1399,6 +1427,9 @@ lnext:	;
 				break;
 		}
 
+		if (estate->es_provLineage != NULL)
+			ExecProvLineageRecord(estate->es_provLineage, planSlot);
+
 		/*
 		 * check our tuple count.. if we've processed the proper number then
 		 * quit, else loop again and process more tuples.  Zero numberTuples
@@ -1534,6 +1565,11 @@ ExecInsert(TupleTableSlot *slot,
 	estate->es_lastoid = newId;
 	setLastTid(&(tuple->t_self));
 
+	/* remember where the result row is stored for its lineage records */
+	if (estate->es_provLineage != NULL)
+		ExecProvLineageSetTarget(estate->es_provLineage, resultRelationDesc,
+								 &(tuple->t_self));
+
 	/*
 	 * insert index entries for tuple
 	 */
@@ -2743,6 +2779,12 @@ intorel_receive(TupleTableSlot *slot, DestReceiver *self)
 
 	/* We know this is a newly created relation, so there are no indexes */
 
+	/* remember where the result row is stored for its lineage records */
+	if (estate->es_provLineage != NULL)
+		ExecProvLineageSetTarget(estate->es_provLineage,
+								 estate->es_into_relation_descriptor,
+								 &(tuple->t_self));
+
 	heap_freetuple(tuple);
 
 	IncrAppended();
@@ -94,6 +94,7 @@
 #include "executor/nodeMaterial.h"
 #include "executor/nodeMergejoin.h"
 #include "executor/nodeNestloop.h"
+#include "executor/nodeProvNormalize.h"
 #include "executor/nodeResult.h"
 #include "executor/nodeSeqscan.h"
 #include "executor/nodeSetOp.h"
@@ -261,6 +262,11 @@ ExecInitNode(Plan *node, EState *estate, int eflags)
 												 estate, eflags);
 			break;
 
+		case T_ProvNormalize:
+			result = (PlanState *) ExecInitProvNormalize((ProvNormalize *) node,
+														 estate, eflags);
+			break;
+
 		default:
 			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(node));
 			result = NULL;		/* keep compiler quiet */
@@ -410,6 +416,10 @@ ExecProcNode(PlanState *node)
 			result = ExecLimit((LimitState *) node);
 			break;
 
+		case T_ProvNormalizeState:
+			result = ExecProvNormalize((ProvNormalizeState *) node);
+			break;
+
 		default:
 			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(node));
 			result = NULL;
@@ -573,6 +583,9 @@ ExecCountSlotsNode(Plan *node)
 		case T_Limit:
 			return ExecCountSlotsLimit((Limit *) node);
 
+		case T_ProvNormalize:
+			return ExecCountSlotsProvNormalize((ProvNormalize *) node);
+
 		default:
 			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(node));
 			break;
@@ -713,6 +726,10 @@ ExecEndNode(PlanState *node)
 			ExecEndLimit((LimitState *) node);
 			break;
 
+		case T_ProvNormalizeState:
+			ExecEndProvNormalize((ProvNormalizeState *) node);
+			break;
+
 		default:
 			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(node));
 			break;
@@ -0,0 +1,461 @@
+/*-------------------------------------------------------------------------
+ *
+ * execProvLineage.c
+ *	  Lineage capture of provenance queries that store their result
+ *
+ * INSERT ... SELECT PROVENANCE and SELECT PROVENANCE ... INTO store the
+ * result of the original query and record its lineage in the relation named
+ * by prov_lineage_relation: for each stored row and each base tuple in its
+ * provenance a record
+ *
+ *		(target relation, target tid, source relation, source tid)
+ *
+ * The rewriter (see provrewrite/main/prov_lineage.c) computes the provenance
+ * with tuple ids and adds junk attributes prov_lineage_<i> with the tid of
+ * the i-th base relation access to the target list. The plan returns a row
+ * for each witness of a result row. If a result row can have more than one
+ * witness, the rewriter also adds junk attributes prov_lineage_key_<i> with
+ * the values of the result row. A hash table on these attributes remembers
+ * the tid of each stored result row, so the result row is stored for its
+ * first witness only and the other witnesses only add lineage records.
+ * Because different witnesses of a result row often share base tuples, a
+ * second hash table remembers the records that have been inserted, so each
+ * base tuple is recorded once per result row. Otherwise each row of the plan
+ * is a result row with a single witness.
+ *
+ * ExecutePlan calls ExecProvLineageNewTarget for each row of the plan. If it
+ * returns true, the row is stored and ExecInsert or the SELECT INTO receiver
+ * report the tid of the new tuple with ExecProvLineageSetTarget. Afterwards
+ * ExecProvLineageRecord inserts the lineage records of the row. A row that
+ * is not stored (e.g., suppressed by a BEFORE trigger) has no lineage.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/executor/execProvLineage.c,v 1.1 2008/01/01 19:45:49 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+/*
+ * INTERFACE ROUTINES
+ *		ExecInitProvLineage			- open the lineage relation
+ *		ExecProvLineageNewTarget	- is a plan row a new result row?
+ *		ExecProvLineageSetTarget	- remember the tid of the stored result row
+ *		ExecProvLineageRecord		- insert the lineage records of a plan row
+ *		ExecEndProvLineage			- close the lineage relation
+ */
+
+#include "postgres.h"
+
+#include "access/heapam.h"
+#include "catalog/pg_class.h"
+#include "catalog/pg_type.h"
+#include "executor/execProvLineage.h"
+#include "executor/executor.h"
+#include "nodes/makefuncs.h"
+#include "parser/parse_expr.h"
+#include "parser/parse_oper.h"
+#include "parser/parsetree.h"
+#include "utils/builtins.h"
+#include "utils/hsearch.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
+
+/* attributes of a lineage record */
+#define LINEAGE_NATTS			4
+#define LINEAGE_TARGET_REL		0
+#define LINEAGE_TARGET_TID		1
+#define LINEAGE_SOURCE_REL		2
+#define LINEAGE_SOURCE_TID		3
+
+typedef struct ProvLineageEntryData *ProvLineageEntry;
+
+typedef struct ProvLineageEntryData
+{
+	/* the hash table code requires this to be the first field */
+	TupleHashEntryData shared;	/* common header for hash table entries */
+	ItemPointerData target;		/* tid of the stored result row */
+} ProvLineageEntryData;
+
+/* a lineage record of a target relation (key of the records hash table) */
+typedef struct ProvLineageRecordKey
+{
+	ItemPointerData target;		/* tid of the result row */
+	ItemPointerData source;		/* tid of the base tuple */
+	Oid			sourceRelid;	/* base relation */
+} ProvLineageRecordKey;
+
+struct ProvLineageState
+{
+	EState	   *estate;
+	ResultRelInfo *lineageRelInfo;	/* lineage relation and its indexes */
+	TupleTableSlot *recordSlot;	/* lineage record to index, or NULL */
+	AttrNumber	recordAttNos[LINEAGE_NATTS];	/* attributes of a record */
+	int			numSources;
+	AttrNumber *sourceAttNos;	/* prov_lineage_<i> attributes of the plan */
+	Oid		   *sourceRelids;	/* base relation of each prov_lineage_<i> */
+	TupleHashTable hashtable;	/* result rows seen so far, or NULL */
+	TupleTableSlot *keyslot;	/* prov_lineage_key_<i> of the current row */
+	AttrNumber *keyAttNos;		/* prov_lineage_key_<i> attributes of the plan */
+	HTAB	   *records;		/* records inserted so far, or NULL */
+	MemoryContext tableContext; /* memory of the hash tables */
+	ProvLineageEntry curEntry;	/* hash table entry of a new result row */
+	Oid			targetRelid;	/* relation the result rows are stored in */
+	ItemPointerData target;		/* tid of the current result row, invalid if
+								 * it has not been stored */
+};
+
+static AttrNumber findLineageAttribute(List *targetList, char *prefix, int num);
+static void checkLineageRelation(ProvLineageState *state);
+static void buildLineageHashTable(ProvLineageState *state, ProvLineageInfo *info,
+					  PlanState *planstate);
+
+
+/*
+ * Open the lineage relation of a query and find the lineage attributes in the
+ * target list of its plan.
+ */
+ProvLineageState *
+ExecInitProvLineage(ProvLineageInfo *info, PlanState *planstate, EState *estate)
+{
+	ProvLineageState *state;
+	ResultRelInfo *relInfo;
+	ListCell   *lc;
+	int			i;
+
+	state = (ProvLineageState *) palloc0(sizeof(ProvLineageState));
+	state->estate = estate;
+	state->targetRelid = InvalidOid;
+	ItemPointerSetInvalid(&state->target);
+
+	/* lineage records are not checked by constraints or triggers, but indexed */
+	relInfo = makeNode(ResultRelInfo);
+	relInfo->ri_RelationDesc = heap_open(info->lineageRelid, RowExclusiveLock);
+	state->lineageRelInfo = relInfo;
+	checkLineageRelation(state);
+
+	if (relInfo->ri_RelationDesc->rd_rel->relhasindex)
+		ExecOpenIndices(relInfo);
+	if (relInfo->ri_NumIndices > 0)
+		state->recordSlot = MakeSingleTupleTableSlot(RelationGetDescr(relInfo->ri_RelationDesc));
+
+	/* the tuple ids of the base relation accesses */
+	state->numSources = list_length(info->sourceRelids);
+	state->sourceAttNos = (AttrNumber *) palloc(Max(state->numSources, 1) * sizeof(AttrNumber));
+	state->sourceRelids = (Oid *) palloc(Max(state->numSources, 1) * sizeof(Oid));
+
+	i = 0;
+	foreach(lc, info->sourceRelids)
+	{
+		state->sourceAttNos[i] = findLineageAttribute(planstate->plan->targetlist,
+													  "prov_lineage", i + 1);
+		state->sourceRelids[i] = lfirst_oid(lc);
+		i++;
+	}
+
+	/* result rows with more than one witness */
+	if (info->numKeys > 0)
+		buildLineageHashTable(state, info, planstate);
+
+	return state;
+}
+
+/*
+ * Find the junk attribute <prefix>_<num> in the target list of a plan.
+ */
+static AttrNumber
+findLineageAttribute(List *targetList, char *prefix, int num)
+{
+	ListCell   *lc;
+	char		name[NAMEDATALEN];
+
+	snprintf(name, NAMEDATALEN, "%s_%d", prefix, num);
+
+	foreach(lc, targetList)
+	{
+		TargetEntry *te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk && te->resname && strcmp(te->resname, name) == 0)
+			return te->resno;
+	}
+
+	elog(ERROR, "could not find junk \"%s\" column", name);
+	return InvalidAttrNumber;	/* keep compiler quiet */
+}
+
+/*
+ * The lineage relation has to have the attributes (target_rel oid,
+ * target_tid tid, source_rel oid, source_tid tid), the names do not matter.
+ * Remember the attribute numbers, the relation might have dropped columns.
+ */
+static void
+checkLineageRelation(ProvLineageState *state)
+{
+	static const Oid recordTypes[LINEAGE_NATTS] = {OIDOID, TIDOID, OIDOID, TIDOID};
+	Relation	rel = state->lineageRelInfo->ri_RelationDesc;
+	TupleDesc	desc = RelationGetDescr(rel);
+	int			numAtts = 0;
+	int			i;
+
+	if (rel->rd_rel->relkind != RELKIND_RELATION)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("lineage relation \"%s\" is not a table",
+						RelationGetRelationName(rel))));
+
+	for (i = 0; i < desc->natts; i++)
+	{
+		if (desc->attrs[i]->attisdropped)
+			continue;
+
+		if (numAtts == LINEAGE_NATTS || desc->attrs[i]->atttypid != recordTypes[numAtts])
+		{
+			numAtts = -1;
+			break;
+		}
+
+		state->recordAttNos[numAtts++] = i;
+	}
+
+	if (numAtts != LINEAGE_NATTS)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("relation \"%s\" cannot store lineage records",
+						RelationGetRelationName(rel)),
+				 errdetail("A lineage relation has the columns (target_rel oid, target_tid tid, "
+						   "source_rel oid, source_tid tid).")));
+}
+
+/*
+ * Create the hash table that maps the values of a result row to the tid it
+ * has been stored at.
+ */
+static void
+buildLineageHashTable(ProvLineageState *state, ProvLineageInfo *info, PlanState *planstate)
+{
+	List	   *keyTargetList = NIL;
+	Oid		   *eqOperators;
+	FmgrInfo   *eqfunctions;
+	FmgrInfo   *hashfunctions;
+	HASHCTL		ctl;
+	AttrNumber *keyColIdx;
+	TargetEntry *te;
+	Operator	op;
+	Oid			type;
+	int			nbuckets;
+	int			i;
+
+	state->keyAttNos = (AttrNumber *) palloc(info->numKeys * sizeof(AttrNumber));
+	keyColIdx = (AttrNumber *) palloc(info->numKeys * sizeof(AttrNumber));
+	eqOperators = (Oid *) palloc(info->numKeys * sizeof(Oid));
+
+	for (i = 0; i < info->numKeys; i++)
+	{
+		state->keyAttNos[i] = findLineageAttribute(planstate->plan->targetlist,
+												   "prov_lineage_key", i + 1);
+		keyColIdx[i] = i + 1;
+
+		te = get_tle_by_resno(planstate->plan->targetlist, state->keyAttNos[i]);
+		keyTargetList = lappend(keyTargetList,
+								makeTargetEntry(te->expr, i + 1, NULL, false));
+
+		/* result rows are compared like SELECT DISTINCT compares them */
+		type = exprType((Node *) te->expr);
+		op = equality_oper(type, true);
+		eqOperators[i] = InvalidOid;
+		if (op != NULL)
+		{
+			eqOperators[i] = oprid(op);
+			ReleaseSysCache(op);
+		}
+
+		if (!OidIsValid(eqOperators[i]) || !op_hashjoinable(eqOperators[i]))
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_FUNCTION),
+					 errmsg("could not identify a hashable equality operator for type %s",
+							format_type_be(type)),
+					 errdetail("Lineage capture compares the result rows of the query.")));
+	}
+
+	state->keyslot = MakeSingleTupleTableSlot(ExecTypeFromTL(keyTargetList, false));
+
+	execTuplesHashPrepare(info->numKeys, eqOperators, &eqfunctions, &hashfunctions);
+
+	state->tableContext =
+		AllocSetContextCreate(CurrentMemoryContext,
+							  "ProvLineage",
+							  ALLOCSET_DEFAULT_MINSIZE,
+							  ALLOCSET_DEFAULT_INITSIZE,
+							  ALLOCSET_DEFAULT_MAXSIZE);
+
+	/* the table grows as needed, the number of plan rows is an upper bound */
+	nbuckets = (int) Min(Max(planstate->plan->plan_rows, 1.0), 1024.0);
+
+	state->hashtable = BuildTupleHashTable(info->numKeys, keyColIdx,
+										   eqfunctions, hashfunctions,
+										   nbuckets, sizeof(ProvLineageEntryData),
+										   state->tableContext,
+										   GetPerTupleMemoryContext(state->estate));
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(ProvLineageRecordKey);
+	ctl.entrysize = sizeof(ProvLineageRecordKey);
+	ctl.hash = tag_hash;
+	ctl.hcxt = state->tableContext;
+
+	state->records = hash_create("ProvLineage records", nbuckets, &ctl,
+								 HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+}
+
+/*
+ * Returns true if a row of the plan is the first witness of its result row
+ * and the result row has to be stored.
+ */
+bool
+ExecProvLineageNewTarget(ProvLineageState *state, TupleTableSlot *planSlot)
+{
+	TupleTableSlot *keyslot = state->keyslot;
+	ProvLineageEntry entry;
+	bool		isnew;
+	int			i;
+
+	ItemPointerSetInvalid(&state->target);
+	state->curEntry = NULL;
+
+	/* each row is a result row */
+	if (state->hashtable == NULL)
+		return true;
+
+	ExecClearTuple(keyslot);
+	for (i = 0; i < keyslot->tts_tupleDescriptor->natts; i++)
+		keyslot->tts_values[i] = slot_getattr(planSlot, state->keyAttNos[i],
+											  &keyslot->tts_isnull[i]);
+	ExecStoreVirtualTuple(keyslot);
+
+	entry = (ProvLineageEntry) LookupTupleHashEntry(state->hashtable, keyslot, &isnew);
+
+	if (isnew)
+	{
+		ItemPointerSetInvalid(&entry->target);
+		state->curEntry = entry;
+		return true;
+	}
+
+	state->target = entry->target;
+	return false;
+}
+
+/*
+ * Remember the tid of the stored result row. Called by ExecInsert and the
+ * SELECT INTO receiver after they have inserted the row.
+ */
+void
+ExecProvLineageSetTarget(ProvLineageState *state, Relation rel, ItemPointer tid)
+{
+	state->targetRelid = RelationGetRelid(rel);
+	state->target = *tid;
+
+	if (state->curEntry != NULL)
+		state->curEntry->target = *tid;
+}
+
+/*
+ * Insert a lineage record for each base tuple in a witness of the current
+ * result row. An access without a base tuple in this witness (e.g., the
+ * inner side of an outer join without a join partner) has no record.
+ */
+void
+ExecProvLineageRecord(ProvLineageState *state, TupleTableSlot *planSlot)
+{
+	EState	   *estate = state->estate;
+	ResultRelInfo *relInfo = state->lineageRelInfo;
+	Relation	rel = relInfo->ri_RelationDesc;
+	TupleDesc	desc = RelationGetDescr(rel);
+	TupleTableSlot *slot = state->recordSlot;
+	ResultRelInfo *savedRelInfo;
+	ProvLineageRecordKey key;
+	MemoryContext oldContext;
+	bool		found;
+	HeapTuple	tuple;
+	Datum	   *values;
+	bool	   *isnull;
+	Datum		sourceTid;
+	bool		sourceIsNull;
+	int			i;
+
+	/* the result row has not been stored */
+	if (!ItemPointerIsValid(&state->target))
+		return;
+
+	oldContext = MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
+
+	values = (Datum *) palloc(desc->natts * sizeof(Datum));
+	isnull = (bool *) palloc(desc->natts * sizeof(bool));
+	memset(isnull, true, desc->natts * sizeof(bool));
+
+	values[state->recordAttNos[LINEAGE_TARGET_REL]] = ObjectIdGetDatum(state->targetRelid);
+	values[state->recordAttNos[LINEAGE_TARGET_TID]] = PointerGetDatum(&state->target);
+	for (i = 0; i < LINEAGE_NATTS; i++)
+		isnull[state->recordAttNos[i]] = false;
+
+	for (i = 0; i < state->numSources; i++)
+	{
+		sourceTid = slot_getattr(planSlot, state->sourceAttNos[i], &sourceIsNull);
+		if (sourceIsNull)
+			continue;
+
+		/* another witness of the result row has the same base tuple */
+		if (state->records != NULL)
+		{
+			key.target = state->target;
+			key.source = *((ItemPointer) DatumGetPointer(sourceTid));
+			key.sourceRelid = state->sourceRelids[i];
+
+			hash_search(state->records, &key, HASH_ENTER, &found);
+			if (found)
+				continue;
+		}
+
+		values[state->recordAttNos[LINEAGE_SOURCE_REL]] = ObjectIdGetDatum(state->sourceRelids[i]);
+		values[state->recordAttNos[LINEAGE_SOURCE_TID]] = sourceTid;
+
+		tuple = heap_form_tuple(desc, values, isnull);
+		heap_insert(rel, tuple, estate->es_output_cid, true, true);
+
+		/* ExecInsertIndexTuples inserts into the indexes of the current result relation */
+		if (slot != NULL)
+		{
+			ExecStoreTuple(tuple, slot, InvalidBuffer, false);
+
+			savedRelInfo = estate->es_result_relation_info;
+			estate->es_result_relation_info = relInfo;
+			ExecInsertIndexTuples(slot, &(tuple->t_self), estate, false);
+			estate->es_result_relation_info = savedRelInfo;
+
+			ExecClearTuple(slot);
+		}
+	}
+
+	MemoryContextSwitchTo(oldContext);
+}
+
+/*
+ * Close the lineage relation, but keep the lock until commit.
+ */
+void
+ExecEndProvLineage(ProvLineageState *state)
+{
+	ExecCloseIndices(state->lineageRelInfo);
+	heap_close(state->lineageRelInfo->ri_RelationDesc, NoLock);
+
+	if (state->recordSlot != NULL)
+		ExecDropSingleTupleTableSlot(state->recordSlot);
+
+	if (state->hashtable != NULL)
+	{
+		ExecDropSingleTupleTableSlot(state->keyslot);
+		MemoryContextDelete(state->tableContext);
+	}
+}
@@ -207,6 +207,8 @@ CreateExecutorState(void)
 	estate->es_select_into = false;
 	estate->es_into_oids = false;
 
+	estate->es_provLineage = NULL;
+
 	estate->es_exprcontexts = NIL;
 
 	estate->es_subplanstates = NIL;
@@ -56,6 +56,14 @@
  *	  example.	Notice that advance_transition_function() is coded to avoid a
  *	  data copy step when the previous transition value pointer is returned.
  *
+ *	  Perm: If the plan node has provEmitInput set, the input tuples of each
+ *	  group are buffered in a tuplestore (which spills to disk if the group
+ *	  exceeds work_mem) while the aggregates are advanced.  After the group
+ *	  has been finalized we emit one output tuple per buffered input tuple,
+ *	  so that ungrouped (provenance) attributes in the targetlist are taken
+ *	  from the input tuple.  This computes the provenance of an aggregation
+ *	  in a single pass over its input.
+ *
  *
  * Portions Copyright (c) 1996-2008, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -86,6 +94,7 @@
 #include "utils/memutils.h"
 #include "utils/syscache.h"
 #include "utils/tuplesort.h"
+#include "utils/tuplestore.h"
 #include "utils/datum.h"
 
 
@@ -232,6 +241,8 @@ static void build_hash_table(AggState *aggstate);
 static AggHashEntry lookup_hash_entry(AggState *aggstate,
 				  TupleTableSlot *inputslot);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
+static TupleTableSlot *agg_retrieve_prov_input(AggState *aggstate);
+static void agg_release_prov_input(AggState *aggstate);
 static void agg_fill_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static Datum GetAggInitVal(Datum textInitVal, Oid transtype);
@@ -803,7 +814,7 @@ lookup_hash_entry(AggState *aggstate, TupleTableSlot *inputslot)
 TupleTableSlot *
 ExecAgg(AggState *node)
 {
-	if (node->agg_done)
+	if (node->agg_done && !node->prov_emitting)
 		return NULL;
 
 	if (((Agg *) node->ss.ps.plan)->aggstrategy == AGG_HASHED)
@@ -850,6 +861,18 @@ agg_retrieve_direct(AggState *aggstate)
 	pergroup = aggstate->pergroup;
 	firstSlot = aggstate->ss.ss_ScanTupleSlot;
 
+	/*
+	 * If we are still emitting the input tuples of the previous group, return
+	 * the next one of them.
+	 */
+	if (aggstate->prov_emitting)
+	{
+		TupleTableSlot *result = agg_retrieve_prov_input(aggstate);
+
+		if (result != NULL)
+			return result;
+	}
+
 	/*
 	 * We loop retrieving groups until we find one matching
 	 * aggstate->ss.ps.qual
@@ -904,6 +927,11 @@ agg_retrieve_direct(AggState *aggstate)
 						   true);
 			aggstate->grp_firstTuple = NULL;	/* don't keep two pointers */
 
+			/* buffer the input tuples of the group if we have to emit them */
+			if (node->provEmitInput)
+				aggstate->prov_store = tuplestore_begin_heap(false, false,
+															 work_mem);
+
 			/* set up for first advance_aggregates call */
 			tmpcontext->ecxt_outertuple = firstSlot;
 
@@ -913,6 +941,10 @@ agg_retrieve_direct(AggState *aggstate)
 			 */
 			for (;;)
 			{
+				if (aggstate->prov_store)
+					tuplestore_puttupleslot(aggstate->prov_store,
+											tmpcontext->ecxt_outertuple);
+
 				advance_aggregates(aggstate, pergroup);
 
 				/* Reset per-input-tuple context after each tuple */
@@ -975,12 +1007,34 @@ agg_retrieve_direct(AggState *aggstate)
 		 */
 		econtext->ecxt_outertuple = firstSlot;
 
+		/*
+		 * When emitting the input tuples a plain aggregation without any
+		 * input still produces one tuple, its input attributes are null.
+		 */
+		if (node->provEmitInput && TupIsNull(firstSlot))
+			ExecStoreAllNullTuple(firstSlot);
+
 		/*
 		 * Check the qual (HAVING clause); if the group does not match, ignore
 		 * it and loop back to try to process another group.
 		 */
 		if (ExecQual(aggstate->ss.ps.qual, econtext, false))
 		{
+			/*
+			 * If the group's input tuples have been buffered, return a
+			 * projection for each of them.
+			 */
+			if (aggstate->prov_store)
+			{
+				TupleTableSlot *result;
+
+				aggstate->prov_emitting = true;
+				result = agg_retrieve_prov_input(aggstate);
+				if (result != NULL)
+					return result;
+				continue;
+			}
+
 			/*
 			 * Form and return a projection tuple using the aggregate results
 			 * and the representative input tuple.	Note we do not support
@@ -988,12 +1042,55 @@ agg_retrieve_direct(AggState *aggstate)
 			 */
 			return ExecProject(projInfo, NULL);
 		}
+
+		/* group does not qualify, throw away its input tuples */
+		agg_release_prov_input(aggstate);
 	}
 
 	/* No more groups */
 	return NULL;
 }
 
+/*
+ * Return a projection of the aggregation results of the current group and
+ * the next buffered input tuple of this group. If all input tuples of the
+ * group have been returned, the buffer is released and NULL is returned.
+ */
+static TupleTableSlot *
+agg_retrieve_prov_input(AggState *aggstate)
+{
+	ExprContext *econtext = aggstate->ss.ps.ps_ExprContext;
+
+	if (tuplestore_gettupleslot(aggstate->prov_store, true,
+								aggstate->prov_slot))
+	{
+		econtext->ecxt_outertuple = aggstate->prov_slot;
+		return ExecProject(aggstate->ss.ps.ps_ProjInfo, NULL);
+	}
+
+	agg_release_prov_input(aggstate);
+
+	return NULL;
+}
+
+/*
+ * Release the buffered input tuples of the current group (if any).
+ */
+static void
+agg_release_prov_input(AggState *aggstate)
+{
+	if (aggstate->prov_slot)
+		ExecClearTuple(aggstate->prov_slot);
+
+	if (aggstate->prov_store)
+	{
+		tuplestore_end(aggstate->prov_store);
+		aggstate->prov_store = NULL;
+	}
+
+	aggstate->prov_emitting = false;
+}
+
 /*
  * ExecAgg for hashed case: phase 1, read input and build hash table
  */
@@ -1173,6 +1270,9 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	aggstate->agg_done = false;
 	aggstate->pergroup = NULL;
 	aggstate->grp_firstTuple = NULL;
+	aggstate->prov_store = NULL;
+	aggstate->prov_slot = NULL;
+	aggstate->prov_emitting = false;
 	aggstate->hashtable = NULL;
 
 	/*
@@ -1198,7 +1298,7 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 							  ALLOCSET_DEFAULT_INITSIZE,
 							  ALLOCSET_DEFAULT_MAXSIZE);
 
-#define AGG_NSLOTS 3
+#define AGG_NSLOTS 4
 
 	/*
 	 * tuple table initialization
@@ -1239,6 +1339,17 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	 */
 	ExecAssignScanTypeFromOuterPlan(&aggstate->ss);
 
+	/*
+	 * The slot for reading buffered input tuples has the same type.
+	 */
+	if (node->provEmitInput)
+	{
+		Assert(node->aggstrategy != AGG_HASHED);
+		aggstate->prov_slot = ExecInitExtraTupleSlot(estate);
+		ExecSetSlotDescriptor(aggstate->prov_slot,
+							  aggstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor);
+	}
+
 	/*
 	 * Initialize result tuple type and projection info.
 	 */
@@ -1579,6 +1690,9 @@ ExecEndAgg(AggState *node)
 			tuplesort_end(peraggstate->sortstate);
 	}
 
+	/* Release buffered input tuples */
+	agg_release_prov_input(node);
+
 	/*
 	 * Free both the expr contexts.
 	 */
@@ -1643,6 +1757,9 @@ ExecReScanAgg(AggState *node, ExprContext *exprCtxt)
 		node->grp_firstTuple = NULL;
 	}
 
+	/* Release buffered input tuples of the current group */
+	agg_release_prov_input(node);
+
 	/* Forget current agg values */
 	MemSet(econtext->ecxt_aggvalues, 0, sizeof(Datum) * node->numaggs);
 	MemSet(econtext->ecxt_aggnulls, 0, sizeof(bool) * node->numaggs);
@@ -117,7 +117,8 @@ ExecHashJoin(HashJoinState *node)
 		 * best to build the hash table first and see if the inner relation is
 		 * empty.  (When it's an outer join, we should always make this check,
 		 * since we aren't going to be able to skip the join on the strength
-		 * of an empty inner relation anyway.)
+		 * of an empty inner relation anyway.  The same holds for an anti
+		 * join.)
 		 *
 		 * If we are rescanning the join, we make use of information gained on
 		 * the previous scan: don't bother to try the prefetch if the previous
@@ -130,6 +131,7 @@ ExecHashJoin(HashJoinState *node)
 		 * consumption by ExecHashJoinOuterGetTuple.
 		 */
 		if (node->js.jointype == JOIN_LEFT ||
+			node->js.jointype == JOIN_ANTI ||
 			(outerNode->plan->startup_cost < hashNode->ps.plan->total_cost &&
 			 !node->hj_OuterNotEmpty))
 		{
@@ -160,9 +162,12 @@ ExecHashJoin(HashJoinState *node)
 
 		/*
 		 * If the inner relation is completely empty, and we're not doing an
-		 * outer join, we can quit without scanning the outer relation.
+		 * outer or anti join, we can quit without scanning the outer
+		 * relation.
 		 */
-		if (hashtable->totalTuples == 0 && node->js.jointype != JOIN_LEFT)
+		if (hashtable->totalTuples == 0 &&
+			node->js.jointype != JOIN_LEFT &&
+			node->js.jointype != JOIN_ANTI)
 			return NULL;
 
 		/*
@@ -263,6 +268,13 @@ ExecHashJoin(HashJoinState *node)
 			{
 				node->hj_MatchedOuter = true;
 
+				/* In an anti join, we never return a matched tuple */
+				if (node->js.jointype == JOIN_ANTI)
+				{
+					node->hj_NeedNewOuter = true;
+					break;		/* out of loop over hash bucket */
+				}
+
 				if (otherqual == NIL || ExecQual(otherqual, econtext, false))
 				{
 					TupleTableSlot *result;
@@ -296,11 +308,12 @@ ExecHashJoin(HashJoinState *node)
 		node->hj_NeedNewOuter = true;
 
 		if (!node->hj_MatchedOuter &&
-			node->js.jointype == JOIN_LEFT)
+			(node->js.jointype == JOIN_LEFT ||
+			 node->js.jointype == JOIN_ANTI))
 		{
 			/*
-			 * We are doing an outer join and there were no join matches for
-			 * this outer tuple.  Generate a fake join tuple with nulls for
+			 * We are doing an outer or anti join and there were no join
+			 * matches for this outer tuple.  Generate a fake join tuple with nulls for
 			 * the inner tuple, and return it if it passes the non-join quals.
 			 */
 			econtext->ecxt_innertuple = node->hj_NullInnerTupleSlot;
@@ -404,6 +417,7 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 		case JOIN_IN:
 			break;
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 			hjstate->hj_NullInnerTupleSlot =
 				ExecInitNullTupleSlot(estate,
 								 ExecGetResultType(innerPlanState(hjstate)));
@@ -570,7 +584,8 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 			if (ExecHashGetHashValue(hashtable, econtext,
 									 hjstate->hj_OuterHashKeys,
 									 true,		/* outer tuple */
-									 (hjstate->js.jointype == JOIN_LEFT),
+									 (hjstate->js.jointype == JOIN_LEFT ||
+									  hjstate->js.jointype == JOIN_ANTI),
 									 hashvalue))
 			{
 				/* remember outer relation is not empty for possible rescan */
@@ -650,8 +665,8 @@ start_over:
 	 * sides.  We can sometimes skip over batches that are empty on only one
 	 * side, but there are exceptions:
 	 *
-	 * 1. In a LEFT JOIN, we have to process outer batches even if the inner
-	 * batch is empty.
+	 * 1. In a LEFT JOIN or an anti join, we have to process outer batches
+	 * even if the inner batch is empty.
 	 *
 	 * 2. If we have increased nbatch since the initial estimate, we have to
 	 * scan inner batches since they might contain tuples that need to be
@@ -667,7 +682,8 @@ start_over:
 			hashtable->innerBatchFile[curbatch] == NULL))
 	{
 		if (hashtable->outerBatchFile[curbatch] &&
-			hjstate->js.jointype == JOIN_LEFT)
+			(hjstate->js.jointype == JOIN_LEFT ||
+			 hjstate->js.jointype == JOIN_ANTI))
 			break;				/* must process due to rule 1 */
 		if (hashtable->innerBatchFile[curbatch] &&
 			nbatch != hashtable->nbatch_original)
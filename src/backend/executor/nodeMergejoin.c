@@ -760,7 +760,8 @@ ExecMergeJoin(MergeJoinState *node)
 				innerTupleSlot = node->mj_InnerTupleSlot;
 				econtext->ecxt_innertuple = innerTupleSlot;
 
-				if (node->js.jointype == JOIN_IN &&
+				if ((node->js.jointype == JOIN_IN ||
+					 node->js.jointype == JOIN_ANTI) &&
 					node->mj_MatchedOuter)
 					qualResult = false;
 				else
@@ -775,6 +776,13 @@ ExecMergeJoin(MergeJoinState *node)
 					node->mj_MatchedOuter = true;
 					node->mj_MatchedInner = true;
 
+					/* In an anti join, we never return a matched tuple */
+					if (node->js.jointype == JOIN_ANTI)
+					{
+						node->mj_JoinState = EXEC_MJ_NEXTOUTER;
+						break;
+					}
+
 					qualResult = (otherqual == NIL ||
 								  ExecQual(otherqual, econtext, false));
 					MJ_DEBUG_QUAL(otherqual, qualResult);
@@ -1480,6 +1488,7 @@ ExecInitMergeJoin(MergeJoin *node, EState *estate, int eflags)
 			mergestate->mj_FillInner = false;
 			break;
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 			mergestate->mj_FillOuter = true;
 			mergestate->mj_FillInner = false;
 			mergestate->mj_NullInnerTupleSlot =
@@ -177,11 +177,12 @@ ExecNestLoop(NestLoopState *node)
 			node->nl_NeedNewOuter = true;
 
 			if (!node->nl_MatchedOuter &&
-				node->js.jointype == JOIN_LEFT)
+				(node->js.jointype == JOIN_LEFT ||
+				 node->js.jointype == JOIN_ANTI))
 			{
 				/*
-				 * We are doing an outer join and there were no join matches
-				 * for this outer tuple.  Generate a fake join tuple with
+				 * We are doing an outer or anti join and there were no join
+				 * matches for this outer tuple.  Generate a fake join tuple with
 				 * nulls for the inner tuple, and return it if it passes the
 				 * non-join quals.
 				 */
@@ -232,6 +233,13 @@ ExecNestLoop(NestLoopState *node)
 		{
 			node->nl_MatchedOuter = true;
 
+			/* In an anti join, we never return a matched tuple */
+			if (node->js.jointype == JOIN_ANTI)
+			{
+				node->nl_NeedNewOuter = true;
+				continue;
+			}
+
 			if (otherqual == NIL || ExecQual(otherqual, econtext, false))
 			{
 				/*
@@ -336,6 +344,7 @@ ExecInitNestLoop(NestLoop *node, EState *estate, int eflags)
 		case JOIN_IN:
 			break;
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 			nlstate->nl_NullInnerTupleSlot =
 				ExecInitNullTupleSlot(estate,
 								 ExecGetResultType(innerPlanState(nlstate)));
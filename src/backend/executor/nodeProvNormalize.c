@@ -0,0 +1,459 @@
+/*-------------------------------------------------------------------------
+ *
+ * nodeProvNormalize.c
+ *	  Routines to produce the normalized output of a provenance query
+ *
+ * The input of a ProvNormalize node is the result of a rewritten provenance
+ * query: the result attributes followed by the provenance attributes of each
+ * base relation access. Each input tuple is a witness for a result tuple.
+ * Because a result tuple usually has many witnesses and a base tuple is part
+ * of many witnesses, this output repeats the same values many times.
+ *
+ * The node removes these duplicates. Each distinct result tuple and each
+ * distinct base tuple of an access is assigned an id the first time it is
+ * seen, using one hash table per access and one for the result tuples. For
+ * an input tuple we output
+ *
+ *		an 'r' row with the result tuple and its id, if it is new,
+ *		a 'b' row with the base tuple and its id for each access that
+ *		contributes a new base tuple, and
+ *		a 'w' row with the result id and the base tuple ids of the witness.
+ *
+ * The rewriter has already arranged the input in the layout of the output
+ * (see provrewrite/main/prov_normalize.c), the kind and id attributes of the
+ * input are null placeholders. The id attribute of an access immediately
+ * precedes its provenance attributes. A base tuple row carries its id in
+ * both prov_id and the id attribute of its access. An access whose
+ * provenance attributes are all null (e.g., the inner side of an outer join
+ * without a join partner) contributes no base tuple, its id is null in the
+ * witness row.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/executor/nodeProvNormalize.c,v 1.1 2008/01/01 19:45:49 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+/*
+ * INTERFACE ROUTINES
+ *		ExecProvNormalize		- output the next row of the normalized provenance
+ *		ExecInitProvNormalize	- initialize node and subnodes
+ *		ExecEndProvNormalize	- shutdown node and subnodes
+ */
+
+#include "postgres.h"
+
+#include "executor/executor.h"
+#include "executor/nodeProvNormalize.h"
+#include "utils/builtins.h"
+#include "utils/memutils.h"
+
+/* output attributes that precede the result attributes */
+#define PROVNORM_KIND	0
+#define PROVNORM_ID		1
+
+/* values of the kind attribute */
+#define PROVNORM_RESULT		0
+#define PROVNORM_BASE		1
+#define PROVNORM_WITNESS	2
+
+typedef struct ProvNormalizeEntryData *ProvNormalizeEntry;
+
+typedef struct ProvNormalizeEntryData
+{
+	/* the hash table code requires this to be the first field */
+	TupleHashEntryData shared;	/* common header for hash table entries */
+	int64		id;				/* id of the tuple */
+} ProvNormalizeEntryData;
+
+static void build_hash_tables(ProvNormalizeState *node);
+static void lookup_input(ProvNormalizeState *node, TupleTableSlot *slot);
+static TupleTableSlot *build_tuple_output(ProvNormalizeState *node, int table);
+static TupleTableSlot *build_witness_output(ProvNormalizeState *node);
+
+
+/* ----------------------------------------------------------------
+ *		ExecProvNormalize
+ * ----------------------------------------------------------------
+ */
+TupleTableSlot *				/* return: a tuple or NULL */
+ExecProvNormalize(ProvNormalizeState *node)
+{
+	ProvNormalize *plannode = (ProvNormalize *) node->ps.plan;
+	TupleTableSlot *slot;
+	int			table;
+
+	/* free the ids of the previously returned row */
+	ResetExprContext(node->ps.ps_ExprContext);
+
+	for (;;)
+	{
+		/* fetch the next witness and look up its result and base tuples */
+		if (node->curSlot == NULL)
+		{
+			slot = ExecProcNode(outerPlanState(node));
+			if (TupIsNull(slot))
+				return ExecClearTuple(node->ps.ps_ResultTupleSlot);
+
+			lookup_input(node, slot);
+			node->curSlot = slot;
+			node->nextOutput = -1;
+		}
+
+		/*
+		 * Output the result tuple (table 0) and the base tuples (tables 1 ..
+		 * numGroups) if they have not been seen before, then the witness.
+		 */
+		table = ++node->nextOutput;
+
+		if (table <= plannode->numGroups)
+		{
+			if (node->curIsNew[table])
+				return build_tuple_output(node, table);
+		}
+		else
+		{
+			node->curSlot = NULL;
+			return build_witness_output(node);
+		}
+	}
+}
+
+/*
+ * Look up the result tuple and the base tuples of an input tuple in the hash
+ * tables and store their ids in curIds.
+ */
+static void
+lookup_input(ProvNormalizeState *node, TupleTableSlot *slot)
+{
+	ProvNormalize *plannode = (ProvNormalize *) node->ps.plan;
+	TupleTableSlot *keyslot;
+	ProvNormalizeEntry entry;
+	bool		allNull;
+	int			table;
+	int			i;
+	int			col;
+
+	slot_getallattrs(slot);
+
+	for (table = 0; table <= plannode->numGroups; table++)
+	{
+		keyslot = node->keyslots[table];
+		allNull = true;
+
+		ExecClearTuple(keyslot);
+		for (i = 0; i < keyslot->tts_tupleDescriptor->natts; i++)
+		{
+			col = plannode->colIdx[node->firstCols[table] + i] - 1;
+
+			keyslot->tts_values[i] = slot->tts_values[col];
+			keyslot->tts_isnull[i] = slot->tts_isnull[col];
+			if (!slot->tts_isnull[col])
+				allNull = false;
+		}
+		ExecStoreVirtualTuple(keyslot);
+
+		/* an access without a base tuple in this witness */
+		if (table > 0 && allNull)
+		{
+			node->curIds[table] = 0;
+			node->curIsNew[table] = false;
+			continue;
+		}
+
+		entry = (ProvNormalizeEntry) LookupTupleHashEntry(node->hashtables[table],
+														  keyslot,
+														  &node->curIsNew[table]);
+		if (node->curIsNew[table])
+			entry->id = ++node->nextIds[table];
+		node->curIds[table] = entry->id;
+	}
+}
+
+/*
+ * Build the output row for the current result tuple (table 0) or for the
+ * current base tuple of an access (table > 0). The values of the tuple are
+ * taken from its key slot, which still references the input tuple.
+ */
+static TupleTableSlot *
+build_tuple_output(ProvNormalizeState *node, int table)
+{
+	ProvNormalize *plannode = (ProvNormalize *) node->ps.plan;
+	TupleTableSlot *result = node->ps.ps_ResultTupleSlot;
+	TupleTableSlot *keyslot = node->keyslots[table];
+	AttrNumber *colIdx = plannode->colIdx + node->firstCols[table];
+	MemoryContext oldContext;
+	int			i;
+
+	ExecClearTuple(result);
+	MemSet(result->tts_isnull, true,
+		   result->tts_tupleDescriptor->natts * sizeof(bool));
+
+	oldContext = MemoryContextSwitchTo(node->ps.ps_ExprContext->ecxt_per_tuple_memory);
+
+	result->tts_values[PROVNORM_KIND] =
+		node->kindValues[table == 0 ? PROVNORM_RESULT : PROVNORM_BASE];
+	result->tts_isnull[PROVNORM_KIND] = false;
+	result->tts_values[PROVNORM_ID] = Int64GetDatum(node->curIds[table]);
+	result->tts_isnull[PROVNORM_ID] = false;
+
+	/* a base tuple also carries its id in the id attribute of its access */
+	if (table > 0)
+	{
+		result->tts_values[colIdx[0] - 2] = result->tts_values[PROVNORM_ID];
+		result->tts_isnull[colIdx[0] - 2] = false;
+	}
+
+	MemoryContextSwitchTo(oldContext);
+
+	for (i = 0; i < keyslot->tts_tupleDescriptor->natts; i++)
+	{
+		result->tts_values[colIdx[i] - 1] = keyslot->tts_values[i];
+		result->tts_isnull[colIdx[i] - 1] = keyslot->tts_isnull[i];
+	}
+
+	return ExecStoreVirtualTuple(result);
+}
+
+/*
+ * Build the witness row for the current input tuple.
+ */
+static TupleTableSlot *
+build_witness_output(ProvNormalizeState *node)
+{
+	ProvNormalize *plannode = (ProvNormalize *) node->ps.plan;
+	TupleTableSlot *result = node->ps.ps_ResultTupleSlot;
+	MemoryContext oldContext;
+	int			table;
+	int			col;
+
+	ExecClearTuple(result);
+	MemSet(result->tts_isnull, true,
+		   result->tts_tupleDescriptor->natts * sizeof(bool));
+
+	oldContext = MemoryContextSwitchTo(node->ps.ps_ExprContext->ecxt_per_tuple_memory);
+
+	result->tts_values[PROVNORM_KIND] = node->kindValues[PROVNORM_WITNESS];
+	result->tts_isnull[PROVNORM_KIND] = false;
+	result->tts_values[PROVNORM_ID] = Int64GetDatum(node->curIds[0]);
+	result->tts_isnull[PROVNORM_ID] = false;
+
+	for (table = 1; table <= plannode->numGroups; table++)
+	{
+		if (node->curIds[table] == 0)
+			continue;
+
+		col = plannode->colIdx[node->firstCols[table]] - 2;
+		result->tts_values[col] = Int64GetDatum(node->curIds[table]);
+		result->tts_isnull[col] = false;
+	}
+
+	MemoryContextSwitchTo(oldContext);
+
+	return ExecStoreVirtualTuple(result);
+}
+
+/*
+ * (Re)create the empty hash tables in the table context.
+ */
+static void
+build_hash_tables(ProvNormalizeState *node)
+{
+	ProvNormalize *plannode = (ProvNormalize *) node->ps.plan;
+	int			nbuckets;
+	int			first;
+	int			table;
+
+	/* the tables grow as needed, the number of input tuples is an upper bound */
+	nbuckets = (int) Min(Max(outerPlan(plannode)->plan_rows, 1.0), 1024.0);
+
+	for (table = 0; table <= plannode->numGroups; table++)
+	{
+		first = node->firstCols[table];
+
+		node->hashtables[table] =
+			BuildTupleHashTable(node->keyslots[table]->tts_tupleDescriptor->natts,
+								node->keyColIdx,
+								node->eqfunctions + first,
+								node->hashfunctions + first,
+								nbuckets,
+								sizeof(ProvNormalizeEntryData),
+								node->tableContext,
+								node->ps.ps_ExprContext->ecxt_per_tuple_memory);
+		node->nextIds[table] = 0;
+	}
+}
+
+/* ----------------------------------------------------------------
+ *		ExecInitProvNormalize
+ *
+ *		This initializes the provenance normalize node state structures and
+ *		the node's subplan.
+ * ----------------------------------------------------------------
+ */
+ProvNormalizeState *
+ExecInitProvNormalize(ProvNormalize *node, EState *estate, int eflags)
+{
+	ProvNormalizeState *normstate;
+	TupleDesc	inputDesc;
+	TupleDesc	keyDesc;
+	Form_pg_attribute attr;
+	int			numTables = node->numGroups + 1;
+	int			numKeys;
+	int			table;
+	int			col;
+	int			i;
+
+	/* check for unsupported flags */
+	Assert(!(eflags & (EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK)));
+
+	/*
+	 * create state structure
+	 */
+	normstate = makeNode(ProvNormalizeState);
+	normstate->ps.plan = (Plan *) node;
+	normstate->ps.state = estate;
+
+	normstate->curSlot = NULL;
+	normstate->nextOutput = 0;
+
+	/*
+	 * Miscellaneous initialization
+	 *
+	 * The node never calls ExecQual or ExecProject, the expression context
+	 * provides the per-tuple memory for hashing and for the output ids.
+	 */
+	ExecAssignExprContext(estate, &normstate->ps);
+
+	normstate->tableContext =
+		AllocSetContextCreate(CurrentMemoryContext,
+							  "ProvNormalize",
+							  ALLOCSET_DEFAULT_MINSIZE,
+							  ALLOCSET_DEFAULT_INITSIZE,
+							  ALLOCSET_DEFAULT_MAXSIZE);
+
+#define PROVNORMALIZE_NSLOTS 1
+
+	/*
+	 * Tuple table initialization
+	 */
+	ExecInitResultTupleSlot(estate, &normstate->ps);
+
+	/*
+	 * then initialize outer plan
+	 */
+	outerPlanState(normstate) = ExecInitNode(outerPlan(node), estate, eflags);
+
+	/*
+	 * the output rows are built directly in the result slot, the target list
+	 * only determines the result type
+	 */
+	ExecAssignResultTypeFromTL(&normstate->ps);
+	normstate->ps.ps_ProjInfo = NULL;
+
+	/*
+	 * Precompute fmgr lookup data for the hash tables
+	 */
+	execTuplesHashPrepare(node->numCols,
+						  node->eqOperators,
+						  &normstate->eqfunctions,
+						  &normstate->hashfunctions);
+
+	/*
+	 * Create a key slot for each hash table that holds only the attributes
+	 * of the result or base tuple, so that the tables store no other values.
+	 */
+	inputDesc = ExecGetResultType(outerPlanState(normstate));
+
+	normstate->keyslots = (TupleTableSlot **) palloc(numTables * sizeof(TupleTableSlot *));
+	normstate->firstCols = (int *) palloc(numTables * sizeof(int));
+	normstate->keyColIdx = (AttrNumber *) palloc(Max(node->numCols, 1) * sizeof(AttrNumber));
+
+	for (i = 0; i < node->numCols; i++)
+		normstate->keyColIdx[i] = i + 1;
+
+	col = 0;
+	for (table = 0; table < numTables; table++)
+	{
+		numKeys = (table == 0) ? node->numResultCols : node->groupNumCols[table - 1];
+
+		normstate->firstCols[table] = col;
+		keyDesc = CreateTemplateTupleDesc(numKeys, false);
+
+		for (i = 0; i < numKeys; i++, col++)
+		{
+			attr = inputDesc->attrs[node->colIdx[col] - 1];
+			TupleDescInitEntry(keyDesc, (AttrNumber) (i + 1), NULL,
+							   attr->atttypid, attr->atttypmod, 0);
+		}
+
+		normstate->keyslots[table] = MakeSingleTupleTableSlot(keyDesc);
+	}
+
+	normstate->hashtables = (TupleHashTable *) palloc(numTables * sizeof(TupleHashTable));
+	normstate->nextIds = (int64 *) palloc0(numTables * sizeof(int64));
+	normstate->curIds = (int64 *) palloc0(numTables * sizeof(int64));
+	normstate->curIsNew = (bool *) palloc0(numTables * sizeof(bool));
+
+	build_hash_tables(normstate);
+
+	normstate->kindValues[PROVNORM_RESULT] = DirectFunctionCall1(textin, CStringGetDatum("r"));
+	normstate->kindValues[PROVNORM_BASE] = DirectFunctionCall1(textin, CStringGetDatum("b"));
+	normstate->kindValues[PROVNORM_WITNESS] = DirectFunctionCall1(textin, CStringGetDatum("w"));
+
+	return normstate;
+}
+
+int
+ExecCountSlotsProvNormalize(ProvNormalize *node)
+{
+	return ExecCountSlotsNode(outerPlan(node)) +
+		ExecCountSlotsNode(innerPlan(node)) +
+		PROVNORMALIZE_NSLOTS;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecEndProvNormalize
+ *
+ *		This shuts down the subplan and frees resources allocated
+ *		to this node.
+ * ----------------------------------------------------------------
+ */
+void
+ExecEndProvNormalize(ProvNormalizeState *node)
+{
+	ProvNormalize *plannode = (ProvNormalize *) node->ps.plan;
+	int			table;
+
+	ExecFreeExprContext(&node->ps);
+
+	/* clean up tuple table */
+	ExecClearTuple(node->ps.ps_ResultTupleSlot);
+	for (table = 0; table <= plannode->numGroups; table++)
+		ExecDropSingleTupleTableSlot(node->keyslots[table]);
+
+	MemoryContextDelete(node->tableContext);
+
+	ExecEndNode(outerPlanState(node));
+}
+
+
+void
+ExecReScanProvNormalize(ProvNormalizeState *node, ExprContext *exprCtxt)
+{
+	ExecClearTuple(node->ps.ps_ResultTupleSlot);
+	node->curSlot = NULL;
+
+	/* forget the tuples seen so far, ids start again at 1 */
+	MemoryContextResetAndDeleteChildren(node->tableContext);
+	build_hash_tables(node);
+
+	/*
+	 * if chgParam of subnode is not null then plan will be re-scanned by
+	 * first ExecProcNode.
+	 */
+	if (((PlanState *) node)->lefttree->chgParam == NULL)
+		ExecReScan(((PlanState *) node)->lefttree, exprCtxt);
+}
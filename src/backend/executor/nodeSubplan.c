@@ -20,16 +20,64 @@
 
 #include <math.h>
 
+#include "access/hash.h"
 #include "access/heapam.h"
 #include "executor/executor.h"
 #include "executor/nodeSubplan.h"
+#include "lib/dllist.h"
+#include "miscadmin.h"
 #include "nodes/makefuncs.h"
 #include "optimizer/clauses.h"
+#include "parser/parse_expr.h"
 #include "utils/array.h"
+#include "utils/datum.h"
+#include "utils/hsearch.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 
 
+/*
+ * The memoized output rows of a correlated subplan for one combination of
+ * parameter values.
+ */
+typedef struct SubPlanMemoEntry
+{
+	Dlelem		lru;			/* link in the LRU list of the memo */
+	uint32		hash;			/* hash value of the parameter values */
+	Datum	   *values;			/* parameter values */
+	bool	   *isnull;
+	List	   *rows;			/* output rows of the subplan (MinimalTuple) */
+	Size		size;			/* memory used by the entry */
+	bool		stored;			/* is the entry in the memo? */
+} SubPlanMemoEntry;
+
+/* the entries of the memo with the same hash value */
+typedef struct SubPlanMemoBucket
+{
+	uint32		hash;			/* hash key */
+	List	   *entries;		/* SubPlanMemoEntry */
+} SubPlanMemoBucket;
+
+/*
+ * Memoized output of a correlated subplan.  The memo is limited to work_mem,
+ * the least recently used entries are evicted to make room for new ones.
+ */
+typedef struct SubPlanMemo
+{
+	MemoryContext memocxt;		/* memory context containing the entries */
+	HTAB	   *buckets;		/* hash table of SubPlanMemoBucket */
+	Dllist		lru;			/* entries, most recently used first */
+	Size		size;			/* memory used by all entries */
+	int			numParams;		/* number of parameters */
+	int16	   *typLen;			/* type properties of the parameters */
+	bool	   *typByVal;
+	Datum	   *values;			/* parameter values of the current execution */
+	bool	   *isnull;
+	uint32		hash;			/* hash value of values */
+	TupleTableSlot *slot;		/* slot for reading memoized rows */
+} SubPlanMemo;
+
+
 static Datum ExecHashSubPlan(SubPlanState *node,
 				ExprContext *econtext,
 				bool *isNull);
@@ -40,6 +88,15 @@ static void buildSubPlanHash(SubPlanState *node, ExprContext *econtext);
 static bool findPartialMatch(TupleHashTable hashtable, TupleTableSlot *slot);
 static bool slotAllNulls(TupleTableSlot *slot);
 static bool slotNoNulls(TupleTableSlot *slot);
+static void initSubPlanMemo(SubPlanState *sstate);
+static void resetSubPlanMemo(SubPlanMemo *memo);
+static SubPlanMemoEntry *lookupSubPlanMemo(SubPlanState *node,
+				  ExprContext *econtext);
+static SubPlanMemoEntry *fillSubPlanMemo(SubPlanState *node);
+static void evictSubPlanMemo(SubPlanState *node);
+static void freeSubPlanMemoEntry(SubPlanMemo *memo, SubPlanMemoEntry *entry);
+static TupleTableSlot *nextSubPlanRow(SubPlanState *node,
+			   SubPlanMemoEntry *entry, ListCell **row);
 
 
 /* ----------------------------------------------------------------
@@ -215,6 +272,9 @@ ExecScanSubPlan(SubPlanState *node,
 	ListCell   *pvar;
 	ListCell   *l;
 	ArrayBuildState *astate = NULL;
+	SubPlanMemoEntry *memoEntry = NULL;
+	ListCell   *memoRow = NULL;
+	int			i;
 
 	/*
 	 * We are probably in a short-lived expression-evaluation context. Switch
@@ -224,28 +284,54 @@ ExecScanSubPlan(SubPlanState *node,
 	oldcontext = MemoryContextSwitchTo(econtext->ecxt_per_query_memory);
 
 	/*
-	 * Set Params of this plan from parent plan correlation values. (Any
-	 * calculation we have to do is done in the parent econtext, since the
-	 * Param values don't need to have per-query lifetime.)
+	 * If the output of the subplan is memoized, look for the output for the
+	 * current correlation values first.  This evaluates the parameter values
+	 * into the memo.
 	 */
-	Assert(list_length(subplan->parParam) == list_length(node->args));
+	if (node->memo != NULL)
+		memoEntry = lookupSubPlanMemo(node, econtext);
 
-	forboth(l, subplan->parParam, pvar, node->args)
+	if (memoEntry == NULL)
 	{
-		int			paramid = lfirst_int(l);
-		ParamExecData *prm = &(econtext->ecxt_param_exec_vals[paramid]);
+		/*
+		 * Set Params of this plan from parent plan correlation values. (Any
+		 * calculation we have to do is done in the parent econtext, since the
+		 * Param values don't need to have per-query lifetime.)
+		 */
+		Assert(list_length(subplan->parParam) == list_length(node->args));
+
+		i = 0;
+		forboth(l, subplan->parParam, pvar, node->args)
+		{
+			int			paramid = lfirst_int(l);
+			ParamExecData *prm = &(econtext->ecxt_param_exec_vals[paramid]);
 
-		prm->value = ExecEvalExprSwitchContext((ExprState *) lfirst(pvar),
-											   econtext,
-											   &(prm->isnull),
-											   NULL);
-		planstate->chgParam = bms_add_member(planstate->chgParam, paramid);
+			if (node->memo != NULL)
+			{
+				prm->value = node->memo->values[i];
+				prm->isnull = node->memo->isnull[i];
+			}
+			else
+				prm->value = ExecEvalExprSwitchContext((ExprState *) lfirst(pvar),
+													   econtext,
+													   &(prm->isnull),
+													   NULL);
+			planstate->chgParam = bms_add_member(planstate->chgParam, paramid);
+			i++;
+		}
+
+		/*
+		 * Now that we've set up its parameters, we can reset the subplan.
+		 */
+		ExecReScan(planstate, NULL);
+
+		/* read the output of the subplan into the memo */
+		if (node->memo != NULL)
+			memoEntry = fillSubPlanMemo(node);
 	}
 
-	/*
-	 * Now that we've set up its parameters, we can reset the subplan.
-	 */
-	ExecReScan(planstate, NULL);
+	if (memoEntry != NULL)
+		memoRow = list_head(memoEntry->rows);
 
 	/*
 	 * For all sublink types except EXPR_SUBLINK and ARRAY_SUBLINK, the result
@@ -271,9 +357,9 @@ ExecScanSubPlan(SubPlanState *node,
 	result = BoolGetDatum(subLinkType == ALL_SUBLINK);
 	*isNull = false;
 
-	for (slot = ExecProcNode(planstate);
+	for (slot = nextSubPlanRow(node, memoEntry, &memoRow);
 		 !TupIsNull(slot);
-		 slot = ExecProcNode(planstate))
+		 slot = nextSubPlanRow(node, memoEntry, &memoRow))
 	{
 		TupleDesc	tdesc = slot->tts_tupleDescriptor;
 		Datum		rowresult;
@@ -391,6 +477,10 @@ ExecScanSubPlan(SubPlanState *node,
 
 	MemoryContextSwitchTo(oldcontext);
 
+	/* output that was too large to be memoized is only used once */
+	if (memoEntry != NULL && !memoEntry->stored)
+		freeSubPlanMemoEntry(node->memo, memoEntry);
+
 	if (subLinkType == ARRAY_SUBLINK)
 	{
 		/* We return the result in the caller's context */
@@ -634,6 +724,314 @@ slotNoNulls(TupleTableSlot *slot)
 	return true;
 }
 
+/*
+ * initSubPlanMemo: set up the memo for the output of a correlated subplan.
+ */
+static void
+initSubPlanMemo(SubPlanState *sstate)
+{
+	SubPlan    *subplan = (SubPlan *) sstate->xprstate.expr;
+	SubPlanMemo *memo;
+	TupleTable	tupTable;
+	ListCell   *l;
+	int			i;
+
+	memo = (SubPlanMemo *) palloc0(sizeof(SubPlanMemo));
+	memo->memocxt = AllocSetContextCreate(CurrentMemoryContext,
+										  "Subplan Memo Context",
+										  ALLOCSET_DEFAULT_MINSIZE,
+										  ALLOCSET_DEFAULT_INITSIZE,
+										  ALLOCSET_DEFAULT_MAXSIZE);
+
+	memo->numParams = list_length(subplan->args);
+	memo->typLen = (int16 *) palloc(memo->numParams * sizeof(int16));
+	memo->typByVal = (bool *) palloc(memo->numParams * sizeof(bool));
+	memo->values = (Datum *) palloc(memo->numParams * sizeof(Datum));
+	memo->isnull = (bool *) palloc(memo->numParams * sizeof(bool));
+
+	i = 0;
+	foreach(l, subplan->args)
+	{
+		get_typlenbyval(exprType((Node *) lfirst(l)),
+						&memo->typLen[i], &memo->typByVal[i]);
+		i++;
+	}
+
+	/*
+	 * Memoized rows are returned in a slot of their own.  As for the hash
+	 * tables we never bother to free the tupletable explicitly.
+	 */
+	tupTable = ExecCreateTupleTable(1);
+	memo->slot = ExecAllocTableSlot(tupTable);
+	ExecSetSlotDescriptor(memo->slot, ExecGetResultType(sstate->planstate));
+
+	resetSubPlanMemo(memo);
+
+	sstate->memo = memo;
+}
+
+/*
+ * resetSubPlanMemo: forget all memoized output.
+ */
+static void
+resetSubPlanMemo(SubPlanMemo *memo)
+{
+	HASHCTL		hash_ctl;
+
+	if (memo->buckets != NULL)
+		hash_destroy(memo->buckets);
+	MemoryContextReset(memo->memocxt);
+
+	MemSet(&hash_ctl, 0, sizeof(hash_ctl));
+	hash_ctl.keysize = sizeof(uint32);
+	hash_ctl.entrysize = sizeof(SubPlanMemoBucket);
+	hash_ctl.hash = oid_hash;
+	hash_ctl.hcxt = memo->memocxt;
+	memo->buckets = hash_create("Subplan Memo", 256, &hash_ctl,
+								HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+	DLInitList(&memo->lru);
+	memo->size = 0;
+}
+
+/*
+ * lookupSubPlanMemo: evaluate the correlation values of the subplan and
+ * return the memoized output for them, or NULL if there is none.
+ *
+ * The memoized output is only valid as long as no parameter the subplan
+ * depends on besides its own correlation values changes; if one did the
+ * whole memo is thrown away.
+ */
+static SubPlanMemoEntry *
+lookupSubPlanMemo(SubPlanState *node, ExprContext *econtext)
+{
+	SubPlanMemo *memo = node->memo;
+	SubPlanMemoBucket *bucket;
+	ListCell   *l;
+	uint32		hashkey = 0;
+	int			i;
+
+	if (node->planstate->chgParam != NULL)
+		resetSubPlanMemo(memo);
+
+	i = 0;
+	foreach(l, node->args)
+	{
+		memo->values[i] = ExecEvalExprSwitchContext((ExprState *) lfirst(l),
+													econtext,
+													&memo->isnull[i],
+													NULL);
+
+		/* rotate hashkey left 1 bit at each step */
+		hashkey = (hashkey << 1) | ((hashkey & 0x80000000) ? 1 : 0);
+
+		if (!memo->isnull[i])
+		{
+			uint32		hkey;
+
+			if (memo->typByVal[i])
+				hkey = DatumGetUInt32(hash_any((unsigned char *) &memo->values[i],
+											   sizeof(Datum)));
+			else
+				hkey = DatumGetUInt32(hash_any((unsigned char *) DatumGetPointer(memo->values[i]),
+											   datumGetSize(memo->values[i],
+															false,
+															memo->typLen[i])));
+			hashkey ^= hkey;
+		}
+		i++;
+	}
+	memo->hash = hashkey;
+
+	bucket = (SubPlanMemoBucket *) hash_search(memo->buckets, &hashkey,
+											   HASH_FIND, NULL);
+	if (bucket == NULL)
+		return NULL;
+
+	foreach(l, bucket->entries)
+	{
+		SubPlanMemoEntry *entry = (SubPlanMemoEntry *) lfirst(l);
+		bool		match = true;
+
+		for (i = 0; i < memo->numParams && match; i++)
+		{
+			if (entry->isnull[i] || memo->isnull[i])
+				match = (entry->isnull[i] && memo->isnull[i]);
+			else
+				match = datumIsEqual(entry->values[i], memo->values[i],
+									 memo->typByVal[i], memo->typLen[i]);
+		}
+
+		if (match)
+		{
+			DLMoveToFront(&entry->lru);
+			node->memoHits++;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * fillSubPlanMemo: read the output of the freshly rescanned subplan into a
+ * new memo entry for the current correlation values.  The entry is stored in
+ * the memo if it fits into work_mem; otherwise the caller has to free it
+ * after use.
+ */
+static SubPlanMemoEntry *
+fillSubPlanMemo(SubPlanState *node)
+{
+	SubPlan    *subplan = (SubPlan *) node->xprstate.expr;
+	SubPlanMemo *memo = node->memo;
+	SubPlanMemoEntry *entry;
+	SubPlanMemoBucket *bucket;
+	TupleTableSlot *slot;
+	MemoryContext oldcontext;
+	long		maxSize = work_mem * 1024L;
+	bool		found;
+	int			i;
+
+	node->memoMisses++;
+
+	oldcontext = MemoryContextSwitchTo(memo->memocxt);
+
+	entry = (SubPlanMemoEntry *) palloc(sizeof(SubPlanMemoEntry));
+	DLInitElem(&entry->lru, entry);
+	entry->hash = memo->hash;
+	entry->values = (Datum *) palloc(memo->numParams * sizeof(Datum));
+	entry->isnull = (bool *) palloc(memo->numParams * sizeof(bool));
+	entry->rows = NIL;
+	entry->stored = false;
+
+	for (i = 0; i < memo->numParams; i++)
+	{
+		entry->isnull[i] = memo->isnull[i];
+		if (memo->isnull[i])
+			entry->values[i] = (Datum) 0;
+		else
+			entry->values[i] = datumCopy(memo->values[i], memo->typByVal[i],
+										 memo->typLen[i]);
+	}
+	entry->size = GetMemoryChunkSpace(entry) +
+		GetMemoryChunkSpace(entry->values) +
+		GetMemoryChunkSpace(entry->isnull);
+
+	/*
+	 * EXISTS only needs to know whether there is a row at all; all other
+	 * sublink types may look at every row.
+	 */
+	for (slot = ExecProcNode(node->planstate);
+		 !TupIsNull(slot);
+		 slot = ExecProcNode(node->planstate))
+	{
+		MinimalTuple tuple = ExecCopySlotMinimalTuple(slot);
+
+		entry->rows = lappend(entry->rows, tuple);
+		entry->size += GetMemoryChunkSpace(tuple) + sizeof(ListCell);
+
+		if (subplan->subLinkType == EXISTS_SUBLINK)
+			break;
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+
+	/* don't let a single huge output flush the whole memo */
+	if (entry->size > maxSize)
+		return entry;
+
+	while (memo->size + entry->size > maxSize)
+		evictSubPlanMemo(node);
+
+	oldcontext = MemoryContextSwitchTo(memo->memocxt);
+
+	bucket = (SubPlanMemoBucket *) hash_search(memo->buckets, &entry->hash,
+											   HASH_ENTER, &found);
+	if (!found)
+		bucket->entries = NIL;
+	bucket->entries = lappend(bucket->entries, entry);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	DLAddHead(&memo->lru, &entry->lru);
+	memo->size += entry->size;
+	entry->stored = true;
+
+	return entry;
+}
+
+/*
+ * evictSubPlanMemo: remove the least recently used entry from the memo.
+ */
+static void
+evictSubPlanMemo(SubPlanState *node)
+{
+	SubPlanMemo *memo = node->memo;
+	Dlelem	   *elem = DLGetTail(&memo->lru);
+	SubPlanMemoEntry *entry;
+	SubPlanMemoBucket *bucket;
+
+	Assert(elem != NULL);
+	entry = (SubPlanMemoEntry *) DLE_VAL(elem);
+
+	bucket = (SubPlanMemoBucket *) hash_search(memo->buckets, &entry->hash,
+											   HASH_FIND, NULL);
+	Assert(bucket != NULL);
+	bucket->entries = list_delete_ptr(bucket->entries, entry);
+	if (bucket->entries == NIL)
+		hash_search(memo->buckets, &entry->hash, HASH_REMOVE, NULL);
+
+	DLRemove(elem);
+	memo->size -= entry->size;
+	node->memoEvictions++;
+
+	freeSubPlanMemoEntry(memo, entry);
+}
+
+/*
+ * freeSubPlanMemoEntry: release the memory of an entry that is not (or no
+ * longer) in the memo.
+ */
+static void
+freeSubPlanMemoEntry(SubPlanMemo *memo, SubPlanMemoEntry *entry)
+{
+	int			i;
+
+	/* the memo slot might still point to one of the rows */
+	ExecClearTuple(memo->slot);
+
+	list_free_deep(entry->rows);
+	for (i = 0; i < memo->numParams; i++)
+	{
+		if (!entry->isnull[i] && !memo->typByVal[i])
+			pfree(DatumGetPointer(entry->values[i]));
+	}
+	pfree(entry->values);
+	pfree(entry->isnull);
+	pfree(entry);
+}
+
+/*
+ * nextSubPlanRow: return the next output row of the subplan, either by
+ * running it or from its memoized output.
+ */
+static TupleTableSlot *
+nextSubPlanRow(SubPlanState *node, SubPlanMemoEntry *entry, ListCell **row)
+{
+	MinimalTuple tuple;
+
+	if (entry == NULL)
+		return ExecProcNode(node->planstate);
+
+	if (*row == NULL)
+		return NULL;
+
+	tuple = (MinimalTuple) lfirst(*row);
+	*row = lnext(*row);
+
+	return ExecStoreMinimalTuple(tuple, node->memo->slot, false);
+}
+
 /* ----------------------------------------------------------------
  *		ExecInitSubPlan
  *
@@ -676,6 +1074,16 @@ ExecInitSubPlan(SubPlan *subplan, PlanState *parent)
 	sstate->tab_eq_funcs = NULL;
 	sstate->lhs_hash_funcs = NULL;
 	sstate->cur_eq_funcs = NULL;
+	sstate->memo = NULL;
+	sstate->memoHits = 0;
+	sstate->memoMisses = 0;
+	sstate->memoEvictions = 0;
+
+	/*
+	 * If the output of the subplan is to be memoized, set up the memo.
+	 */
+	if (subplan->useMemoization)
+		initSubPlanMemo(sstate);
 
 	/*
 	 * If this plan is un-correlated or undirect correlated one and want to
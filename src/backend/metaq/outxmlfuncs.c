@@ -390,6 +390,8 @@ _outJoinPlanInfo(StringInfo str, Join *node, int depth)
 
 	WRITE_ENUM_ELEM(jointype, JoinType);
 	WRITE_NODE_ELEM(joinqual);
+	WRITE_FLOAT_ELEM(provGroups, "%.0f");
+	WRITE_FLOAT_ELEM(provFanout, "%.2f");
 }
 
 
@@ -1353,6 +1355,7 @@ _outJoinExpr(StringInfo str, JoinExpr *node, int depth)
 	WRITE_NODE_ELEM(quals);
 	WRITE_NODE_ELEM(alias);
 	WRITE_INT_ELEM(rtindex);
+	WRITE_BOOL_ELEM(isProvJoin);
 
 	WRITE_NODE_END("JOINEXPR");
 }
@@ -3166,3 +3169,24 @@ nodeToXmlStringInfo(void *obj)
 	return str;
 }
 
+/*
+ * Returns the XML representation of a node as a varlena value (e.g., xml). The space for the
+ * varlena header is reserved at the start of the buffer and the XML is written behind it, so the
+ * output does not have to be copied into the result value.
+ */
+struct varlena *
+nodeToXmlVarlena(void *obj)
+{
+	StringInfoData str;
+
+	initStringInfo(&str);
+	str.len = VARHDRSZ;
+
+	_outXmlHeader(&str);
+	_outNodeXml(&str, obj, 0);
+
+	SET_VARSIZE(str.data, str.len);
+
+	return (struct varlena *) str.data;
+}
+
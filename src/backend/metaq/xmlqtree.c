@@ -12,28 +12,65 @@
  *	  $PostgreSQL: /postgres/src/backend/metaq/xmlqtree.c,v 1.542 15.07.2009 11:13:59 bglav Exp $
  *
  * NOTES
- *
+ *		query_sql_to_xml and query_sql_to_simple_xml are often called repeatedly for the same query
+ *		text. The analyzed and rewritten query trees are kept in a backend local cache keyed on the
+ *		query text, the user, the search_path and the provenance rewriter settings (the same key as
+ *		used by the provenance rewrite cache). The query trees are stored as CachedPlanSources that
+ *		are not planned, so they are analyzed and rewritten again if a relation they use is changed.
+ *		At most prov_xml_query_cache_size queries are cached, the least recently used entry is
+ *		dropped first.
  *
  *-------------------------------------------------------------------------
  */
 
 #include "postgres.h"
+#include "access/hash.h"
+#include "lib/dllist.h"
 #include "utils/xml.h"
 #include "utils/lsyscache.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/plancache.h"
 #include "parser/parse_type.h"
 #include "nodes/parsenodes.h"
 #include "nodes/makefuncs.h"
 #include "tcop/tcopprot.h"
+#include "tcop/utility.h"
 #include "fmgr.h"
 
 
 #include "metaq/xmlqtree.h"
 #include "metaq/outxmlfuncs.h"
+#include "provrewrite/prov_cache.h"
 #include "provrewrite/prov_trans_parse_back_xml.h"
 
+/*
+ * An entry of the query tree cache. Entries are hashed on the hash value of their key, collisions
+ * are detected by comparing the full key.
+ */
+typedef struct XmlQueryCacheEntry
+{
+	uint32				hash;			/* hash value of the key (hash table key) */
+	char			   *key;			/* fingerprint of the query and the rewriter settings */
+	CachedPlanSource   *plansource;		/* the analyzed and rewritten query trees */
+	Dlelem				lruElem;		/* position in the LRU list */
+} XmlQueryCacheEntry;
+
+#define INITIAL_CACHE_SIZE 16
+
+/* global variables */
+static HTAB *xmlQueryCache = NULL;
+static Dllist xmlQueryCacheLRU;
+
 /* functions */
 static xmltype *stringinfo_to_xmltype(StringInfo buf);
 static xmltype *queryToXmlWorker (char *queryText, bool simple);
+static CachedPlanSource *xmlQueryCacheLookup (const char *key, uint32 hash);
+static CachedPlanSource *xmlQueryCacheStore (const char *key, uint32 hash, const char *queryText,
+		Node *rawParseTree, List *queries);
+static bool queriesAreCacheable (List *queries);
+static void removeXmlQueryCacheEntry (XmlQueryCacheEntry *entry);
 
 /*
  * Converts a query node into its xml representation (text).
@@ -46,17 +83,14 @@ queryTreeToXmlText (Query *query) {
 
 
 /*
- * Converts a query node into its xml representation and returns it as a xml data type value.
+ * Converts a query node into its xml representation and returns it as a xml data type value. The
+ * XML is written directly into the result value.
  */
 
 xmltype *
 queryTreeToXml (Query *query)
 {
-	StringInfo str;
-
-	str = queryTreeToXmlText (query);
-
-	return stringinfo_to_xmltype(str);
+	return (xmltype *) nodeToXmlVarlena((Node *) query);
 }
 
 
@@ -102,7 +136,8 @@ query_sql_to_simple_xml (PG_FUNCTION_ARGS)
 }
 
 /*
- *
+ * Creates the XML representation of the queries generated by parse analysis and rewrite of the
+ * SQL query queryText. The query trees are taken from the cache if possible.
  */
 
 static xmltype *
@@ -113,18 +148,56 @@ queryToXmlWorker (char *queryText, bool simple)
 	List *parseTrees;
 	List *queries;
 	ListCell *lc;
+	CachedPlanSource *plansource = NULL;
+	CachedPlan *cplan = NULL;
+	Node *rawParseTree;
+	char *key = NULL;
+	uint32 hash = 0;
 
-	/* parse and analyze */
-	parseTrees = pg_parse_query(queryText);
+	if (prov_xml_query_cache_size > 0)
+	{
+		key = buildProvCacheKey(queryText);
+		hash = DatumGetUInt32(hash_any((unsigned char *) key, strlen(key)));
+		plansource = xmlQueryCacheLookup(key, hash);
+	}
 
-	/* TODO error if more than one statement */
-	queries = pg_analyze_and_rewrite((Node *) linitial(parseTrees), queryText, NULL, 0);
+	if (plansource == NULL)
+	{
+		/* parse and analyze */
+		parseTrees = pg_parse_query(queryText);
+
+		/* TODO error if more than one statement */
+		rawParseTree = (Node *) linitial(parseTrees);
+
+		/* parse analysis scribbles on its input, keep a copy to cache */
+		if (key)
+			rawParseTree = copyObject(rawParseTree);
+
+		queries = pg_analyze_and_rewrite((Node *) linitial(parseTrees), queryText, NULL, 0);
+
+		if (key && queriesAreCacheable(queries))
+			plansource = xmlQueryCacheStore(key, hash, queryText, rawParseTree, queries);
+	}
+
+	/*
+	 * The cached query trees are analyzed and rewritten again if they have been invalidated. The
+	 * resource owner releases the reference to the cached plan if the serialization fails.
+	 */
+	if (plansource)
+	{
+		cplan = RevalidateCachedPlan(plansource, true);
+		queries = cplan->stmt_list;
+	}
 
 	/* create the xml representation for each generated query */
 	foreach(lc, queries)
 	{
 		query = (Query *) lfirst(lc);
 
+		/* the simple representation modifies the query tree, don't scribble on the cached copy */
+		if (simple && cplan)
+			query = (Query *) copyObject(query);
+
 		if (simple)
 		{
 			if (xml)
@@ -141,9 +214,125 @@ queryToXmlWorker (char *queryText, bool simple)
 		}
 	}
 
+	if (cplan)
+		ReleaseCachedPlan(cplan, true);
+	if (key)
+		pfree(key);
+
 	return xml;
 }
 
+/*
+ * Returns the cached query trees for the key or NULL if the query is not cached.
+ */
+
+static CachedPlanSource *
+xmlQueryCacheLookup (const char *key, uint32 hash)
+{
+	XmlQueryCacheEntry *entry;
+
+	if (xmlQueryCache == NULL)
+		return NULL;
+
+	entry = (XmlQueryCacheEntry *) hash_search(xmlQueryCache, &hash, HASH_FIND, NULL);
+
+	if (entry == NULL || strcmp(entry->key, key) != 0)
+		return NULL;
+
+	DLMoveToFront(&entry->lruElem);
+
+	return entry->plansource;
+}
+
+/*
+ * Stores the analyzed and rewritten query trees of a query in the cache. rawParseTree has to be an
+ * unmodified copy of the output of raw_parser.
+ */
+
+static CachedPlanSource *
+xmlQueryCacheStore (const char *key, uint32 hash, const char *queryText, Node *rawParseTree,
+		List *queries)
+{
+	XmlQueryCacheEntry *entry;
+	CachedPlanSource *plansource;
+	bool found;
+
+	if (xmlQueryCache == NULL)
+	{
+		HASHCTL ctl;
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(uint32);
+		ctl.entrysize = sizeof(XmlQueryCacheEntry);
+		ctl.hash = oid_hash;
+
+		xmlQueryCache = hash_create("Query XML cache", INITIAL_CACHE_SIZE, &ctl,
+				HASH_ELEM | HASH_FUNCTION);
+		DLInitList(&xmlQueryCacheLRU);
+	}
+
+	/* create the plan cache entry first, so an error does not leave a half filled entry behind */
+	plansource = CreateCachedPlan(rawParseTree, queryText, CreateCommandTag(rawParseTree), NULL, 0, 0,
+			queries, false, false);
+
+	/* a colliding entry is replaced */
+	entry = (XmlQueryCacheEntry *) hash_search(xmlQueryCache, &hash, HASH_FIND, NULL);
+	if (entry != NULL)
+		removeXmlQueryCacheEntry(entry);
+
+	entry = (XmlQueryCacheEntry *) hash_search(xmlQueryCache, &hash, HASH_ENTER, &found);
+	Assert(!found);
+
+	entry->key = MemoryContextStrdup(CacheMemoryContext, key);
+	entry->plansource = plansource;
+	DLInitElem(&entry->lruElem, entry);
+	DLAddHead(&xmlQueryCacheLRU, &entry->lruElem);
+
+	/* evict least recently used entries */
+	while (hash_get_num_entries(xmlQueryCache) > prov_xml_query_cache_size)
+		removeXmlQueryCacheEntry((XmlQueryCacheEntry *)
+				DLE_VAL(DLGetTail(&xmlQueryCacheLRU)));
+
+	return plansource;
+}
+
+/*
+ * Only plain queries are cached. Lineage capture (INSERT ... SELECT PROVENANCE or SELECT PROVENANCE
+ * ... INTO) depends on settings that are not part of the cache key.
+ */
+
+static bool
+queriesAreCacheable (List *queries)
+{
+	ListCell *lc;
+
+	foreach(lc, queries)
+	{
+		Query *query = (Query *) lfirst(lc);
+
+		if (query->commandType != CMD_SELECT || query->utilityStmt || query->intoClause)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Removes an entry from the cache and releases its query trees.
+ */
+
+static void
+removeXmlQueryCacheEntry (XmlQueryCacheEntry *entry)
+{
+	uint32 hash = entry->hash;
+
+	DLRemove(&entry->lruElem);
+	DropCachedPlan(entry->plansource);
+	pfree(entry->key);
+
+	hash_search(xmlQueryCache, &hash, HASH_REMOVE, NULL);
+}
+
 /*
  *
  */
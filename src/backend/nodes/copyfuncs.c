@@ -85,6 +85,7 @@ _copyPlannedStmt(PlannedStmt *from)
 	COPY_NODE_FIELD(rowMarks);
 	COPY_NODE_FIELD(relationOids);
 	COPY_SCALAR_FIELD(nParamExec);
+	COPY_NODE_FIELD(provLineage);
 
 	return newnode;
 }
@@ -433,6 +434,8 @@ CopyJoinFields(Join *from, Join *newnode)
 
 	COPY_SCALAR_FIELD(jointype);
 	COPY_NODE_FIELD(joinqual);
+	COPY_SCALAR_FIELD(provGroups);
+	COPY_SCALAR_FIELD(provFanout);
 }
 
 
@@ -592,6 +595,7 @@ _copyAgg(Agg *from)
 		COPY_POINTER_FIELD(grpOperators, from->numCols * sizeof(Oid));
 	}
 	COPY_SCALAR_FIELD(numGroups);
+	COPY_SCALAR_FIELD(provEmitInput);
 
 	return newnode;
 }
@@ -686,6 +690,32 @@ _copyLimit(Limit *from)
 	return newnode;
 }
 
+/*
+ * _copyProvNormalize
+ */
+static ProvNormalize *
+_copyProvNormalize(ProvNormalize *from)
+{
+	ProvNormalize *newnode = makeNode(ProvNormalize);
+
+	/*
+	 * copy node superclass fields
+	 */
+	CopyPlanFields((Plan *) from, (Plan *) newnode);
+
+	/*
+	 * copy remainder of node
+	 */
+	COPY_SCALAR_FIELD(numResultCols);
+	COPY_SCALAR_FIELD(numGroups);
+	COPY_POINTER_FIELD(groupNumCols, from->numGroups * sizeof(int));
+	COPY_SCALAR_FIELD(numCols);
+	COPY_POINTER_FIELD(colIdx, from->numCols * sizeof(AttrNumber));
+	COPY_POINTER_FIELD(eqOperators, from->numCols * sizeof(Oid));
+
+	return newnode;
+}
+
 /* ****************************************************************
  *					   primnodes.h copy functions
  * ****************************************************************
@@ -970,6 +1000,7 @@ _copySubPlan(SubPlan *from)
 	COPY_SCALAR_FIELD(firstColType);
 	COPY_SCALAR_FIELD(useHashTable);
 	COPY_SCALAR_FIELD(unknownEqFalse);
+	COPY_SCALAR_FIELD(useMemoization);
 	COPY_NODE_FIELD(setParam);
 	COPY_NODE_FIELD(parParam);
 	COPY_NODE_FIELD(args);
@@ -1366,6 +1397,7 @@ _copyJoinExpr(JoinExpr *from)
 	COPY_NODE_FIELD(quals);
 	COPY_NODE_FIELD(alias);
 	COPY_SCALAR_FIELD(rtindex);
+	COPY_SCALAR_FIELD(isProvJoin);
 
 	return newnode;
 }
@@ -1460,6 +1492,7 @@ _copyOuterJoinInfo(OuterJoinInfo *from)
 	COPY_BITMAPSET_FIELD(syn_lefthand);
 	COPY_BITMAPSET_FIELD(syn_righthand);
 	COPY_SCALAR_FIELD(is_full_join);
+	COPY_SCALAR_FIELD(is_anti_join);
 	COPY_SCALAR_FIELD(lhs_strict);
 	COPY_SCALAR_FIELD(delay_upper_joins);
 
@@ -2427,6 +2460,7 @@ _copyViewStmt(ViewStmt *from)
 	COPY_NODE_FIELD(aliases);
 	COPY_NODE_FIELD(query);
 	COPY_SCALAR_FIELD(replace);
+	COPY_SCALAR_FIELD(materialized);
 
 	return newnode;
 }
@@ -3086,6 +3120,9 @@ copyObject(void *from)
 		case T_Limit:
 			retval = _copyLimit(from);
 			break;
+		case T_ProvNormalize:
+			retval = _copyProvNormalize(from);
+			break;
 
 			/*
 			 * PRIMITIVE NODES
@@ -252,6 +252,7 @@ _outPlannedStmt(StringInfo str, PlannedStmt *node)
 	WRITE_NODE_FIELD(rowMarks);
 	WRITE_NODE_FIELD(relationOids);
 	WRITE_INT_FIELD(nParamExec);
+	WRITE_NODE_FIELD(provLineage);
 }
 
 /*
@@ -294,6 +295,8 @@ _outJoinPlanInfo(StringInfo str, Join *node)
 
 	WRITE_ENUM_FIELD(jointype, JoinType);
 	WRITE_NODE_FIELD(joinqual);
+	WRITE_FLOAT_FIELD(provGroups, "%.0f");
+	WRITE_FLOAT_FIELD(provFanout, "%.2f");
 }
 
 
@@ -519,6 +522,7 @@ _outAgg(StringInfo str, Agg *node)
 		appendStringInfo(str, " %u", node->grpOperators[i]);
 
 	WRITE_LONG_FIELD(numGroups);
+	WRITE_BOOL_FIELD(provEmitInput);
 }
 
 static void
@@ -627,6 +631,33 @@ _outLimit(StringInfo str, Limit *node)
 	WRITE_NODE_FIELD(limitCount);
 }
 
+static void
+_outProvNormalize(StringInfo str, ProvNormalize *node)
+{
+	int			i;
+
+	WRITE_NODE_TYPE("PROVNORMALIZE");
+
+	_outPlanInfo(str, (Plan *) node);
+
+	WRITE_INT_FIELD(numResultCols);
+	WRITE_INT_FIELD(numGroups);
+
+	appendStringInfo(str, " :groupNumCols");
+	for (i = 0; i < node->numGroups; i++)
+		appendStringInfo(str, " %d", node->groupNumCols[i]);
+
+	WRITE_INT_FIELD(numCols);
+
+	appendStringInfo(str, " :colIdx");
+	for (i = 0; i < node->numCols; i++)
+		appendStringInfo(str, " %d", node->colIdx[i]);
+
+	appendStringInfo(str, " :eqOperators");
+	for (i = 0; i < node->numCols; i++)
+		appendStringInfo(str, " %u", node->eqOperators[i]);
+}
+
 static void
 _outHash(StringInfo str, Hash *node)
 {
@@ -847,6 +878,7 @@ _outSubPlan(StringInfo str, SubPlan *node)
 	WRITE_OID_FIELD(firstColType);
 	WRITE_BOOL_FIELD(useHashTable);
 	WRITE_BOOL_FIELD(unknownEqFalse);
+	WRITE_BOOL_FIELD(useMemoization);
 	WRITE_NODE_FIELD(setParam);
 	WRITE_NODE_FIELD(parParam);
 	WRITE_NODE_FIELD(args);
@@ -1118,6 +1150,7 @@ _outJoinExpr(StringInfo str, JoinExpr *node)
 	WRITE_NODE_FIELD(quals);
 	WRITE_NODE_FIELD(alias);
 	WRITE_INT_FIELD(rtindex);
+	WRITE_BOOL_FIELD(isProvJoin);
 }
 
 static void
@@ -1491,6 +1524,7 @@ _outOuterJoinInfo(StringInfo str, OuterJoinInfo *node)
 	WRITE_BITMAPSET_FIELD(syn_lefthand);
 	WRITE_BITMAPSET_FIELD(syn_righthand);
 	WRITE_BOOL_FIELD(is_full_join);
+	WRITE_BOOL_FIELD(is_anti_join);
 	WRITE_BOOL_FIELD(lhs_strict);
 	WRITE_BOOL_FIELD(delay_upper_joins);
 }
@@ -2159,6 +2193,9 @@ _outNode(StringInfo str, void *obj)
 			case T_Limit:
 				_outLimit(str, obj);
 				break;
+			case T_ProvNormalize:
+				_outProvNormalize(str, obj);
+				break;
 			case T_Hash:
 				_outHash(str, obj);
 				break;
@@ -937,6 +937,7 @@ _readJoinExpr(void)
 	READ_NODE_FIELD(quals);
 	READ_NODE_FIELD(alias);
 	READ_INT_FIELD(rtindex);
+	READ_BOOL_FIELD(isProvJoin);
 
 	READ_DONE();
 }
@@ -474,6 +474,7 @@ clause_selectivity(PlannerInfo *root,
 				case JOIN_LEFT:
 				case JOIN_FULL:
 				case JOIN_RIGHT:
+				case JOIN_ANTI:
 					/* Cacheable --- do we already have the result? */
 					if (rinfo->this_selec >= 0)
 						return rinfo->this_selec;
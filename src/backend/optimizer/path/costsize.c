@@ -121,6 +121,12 @@ static bool cost_qual_eval_walker(Node *node, cost_qual_eval_context *context);
 static Selectivity approx_selectivity(PlannerInfo *root, List *quals,
 				   JoinType jointype);
 static Selectivity join_in_selectivity(JoinPath *path, PlannerInfo *root);
+static List *prov_join_restrictlist(PlannerInfo *root, RelOptInfo *rel,
+					   RelOptInfo *outer_rel, RelOptInfo *inner_rel,
+					   List *restrictlist, Selectivity *provselec);
+static double estimate_prov_join_groups(PlannerInfo *root,
+						  ProvJoinInfo *pjinfo,
+						  RelOptInfo *result_rel, RelOptInfo *input_rel);
 static void set_rel_width(PlannerInfo *root, RelOptInfo *rel);
 static double relation_byte_size(double tuples, int width);
 static double page_size(double tuples, int width);
@@ -1497,7 +1503,8 @@ cost_mergejoin(MergePath *path, PlannerInfo *root)
 			innerstartsel = cache->leftstartsel;
 			innerendsel = cache->leftendsel;
 		}
-		if (path->jpath.jointype == JOIN_LEFT)
+		if (path->jpath.jointype == JOIN_LEFT ||
+			path->jpath.jointype == JOIN_ANTI)
 		{
 			outerstartsel = 0.0;
 			outerendsel = 1.0;
@@ -2306,9 +2313,15 @@ set_joinrel_size_estimates(PlannerInfo *root, RelOptInfo *rel,
 {
 	Selectivity jselec;
 	Selectivity pselec;
+	Selectivity provselec = 1.0;
 	double		nrows;
 	UniquePath *upath;
 
+	/* Perm: joins created by the provenance rewriter are estimated apart */
+	if (root->prov_join_list != NIL)
+		restrictlist = prov_join_restrictlist(root, rel, outer_rel, inner_rel,
+											  restrictlist, &provselec);
+
 	/*
 	 * Compute joinclause selectivity.	Note that we are only considering
 	 * clauses that become restriction clauses at this join level; we are not
@@ -2360,6 +2373,9 @@ set_joinrel_size_estimates(PlannerInfo *root, RelOptInfo *rel,
 		pselec = 0.0;			/* not used, keep compiler quiet */
 	}
 
+	/* Perm: selectivity of the provenance joins completed by this join */
+	jselec *= provselec;
+
 	/*
 	 * Basically, we multiply size of Cartesian product by selectivity.
 	 *
@@ -2398,6 +2414,18 @@ set_joinrel_size_estimates(PlannerInfo *root, RelOptInfo *rel,
 				nrows = inner_rel->rows;
 			nrows *= pselec;
 			break;
+		case JOIN_ANTI:
+
+			/*
+			 * The outer rows that find a match are removed.  Estimate their
+			 * number from the size of the inner join, assuming that the
+			 * matches are spread evenly over the outer rows.
+			 */
+			nrows = outer_rel->rows * inner_rel->rows * jselec;
+			if (nrows > outer_rel->rows)
+				nrows = outer_rel->rows;
+			nrows = (outer_rel->rows - nrows) * pselec;
+			break;
 		case JOIN_IN:
 		case JOIN_UNIQUE_INNER:
 			upath = create_unique_path(root, inner_rel,
@@ -2423,6 +2451,158 @@ set_joinrel_size_estimates(PlannerInfo *root, RelOptInfo *rel,
 	rel->rows = clamp_row_est(nrows);
 }
 
+/*
+ * prov_join_restrictlist
+ *		Remove the conditions of joins of an operator result with its
+ *		rewritten input created by the provenance rewriter (see ProvJoinInfo)
+ *		from the restriction clauses of a join, and compute the selectivity
+ *		of the provenance joins that rel completes.
+ *
+ * Each input tuple joins with the result tuple of its group.  Like
+ * eqjoinsel, we use one over the larger of the number of distinct values on
+ * both sides as selectivity.  The number of groups of the input is estimated
+ * from the number of distinct values of the input attributes of the join
+ * condition, i.e., from the n_distinct statistics of the group-by columns.
+ * The result tuples are distinct on the join attributes, so we use their
+ * number for the other side.  The generic estimate multiplies the
+ * selectivities of the IS NOT DISTINCT FROM conditions of all attributes as
+ * if they were independent, which underestimates the join size by orders of
+ * magnitude if there is more than one group-by attribute.
+ *
+ * The join order may split the input or the join condition over several
+ * joins, and the size of a join rel is estimated from the first pair of
+ * rels that builds it.  To give every join rel the same estimate whichever
+ * pair that is, the conditions of a provenance join never count in the
+ * generic selectivity, and its selectivity is applied exactly once: by the
+ * join rel that contains the result and the input while neither of its
+ * input rels does.
+ *
+ * Returns the remaining restriction clauses; *provselec is multiplied with
+ * the selectivity of the completed provenance joins.
+ */
+static List *
+prov_join_restrictlist(PlannerInfo *root, RelOptInfo *rel,
+					   RelOptInfo *outer_rel, RelOptInfo *inner_rel,
+					   List *restrictlist, Selectivity *provselec)
+{
+	List	   *result = restrictlist;
+	ListCell   *l;
+	ListCell   *lc;
+
+	foreach(l, root->prov_join_list)
+	{
+		ProvJoinInfo *pjinfo = (ProvJoinInfo *) lfirst(l);
+		Relids		join_relids;
+		RelOptInfo *input_rel;
+		RelOptInfo *result_rel;
+		double		groups;
+		double		result_rows;
+		Selectivity selec;
+
+		join_relids = bms_union(pjinfo->result_relids, pjinfo->input_relids);
+
+		/* the conditions of the provenance join are estimated below */
+		if (bms_overlap(rel->relids, pjinfo->result_relids) &&
+			bms_overlap(rel->relids, pjinfo->input_relids))
+		{
+			List	   *remaining = NIL;
+
+			foreach(lc, result)
+			{
+				RestrictInfo *rinfo = (RestrictInfo *) lfirst(lc);
+
+				if (!bms_is_subset(rinfo->clause_relids, join_relids) ||
+					!bms_overlap(rinfo->clause_relids, pjinfo->result_relids) ||
+					!bms_overlap(rinfo->clause_relids, pjinfo->input_relids))
+					remaining = lappend(remaining, rinfo);
+			}
+			result = remaining;
+		}
+
+		if (!bms_is_subset(join_relids, rel->relids) ||
+			bms_is_subset(join_relids, outer_rel->relids) ||
+			bms_is_subset(join_relids, inner_rel->relids))
+		{
+			bms_free(join_relids);
+			continue;
+		}
+		bms_free(join_relids);
+
+		/* the operator result is a single subquery most of the time */
+		if (bms_membership(pjinfo->result_relids) == BMS_SINGLETON)
+			result_rel = find_base_rel(root,
+								bms_singleton_member(pjinfo->result_relids));
+		else
+			result_rel = find_join_rel(root, pjinfo->result_relids);
+
+		if (bms_membership(pjinfo->input_relids) == BMS_SINGLETON)
+			input_rel = find_base_rel(root,
+								bms_singleton_member(pjinfo->input_relids));
+		else
+			input_rel = find_join_rel(root, pjinfo->input_relids);
+
+		/*
+		 * The join order never joined the result or the input on their own
+		 * (e.g., because of join_collapse_limit).  The missing size leaves
+		 * us with the generic estimate of a cross product, which is an
+		 * upper bound of the join size.
+		 */
+		if (result_rel == NULL || input_rel == NULL)
+			continue;
+
+		groups = estimate_prov_join_groups(root, pjinfo, result_rel, input_rel);
+		result_rows = Max(result_rel->rows, 1.0);
+		selec = 1.0 / Max(groups, result_rows);
+
+		rel->prov_groups = groups;
+		rel->prov_fanout = input_rel->rows * selec;
+
+		*provselec *= selec;
+	}
+
+	return result;
+}
+
+/*
+ * estimate_prov_join_groups
+ *		Estimate the number of groups of the input of a provenance join.
+ *
+ * Statistics are only available for the columns of base tables.  If the
+ * input attributes are not all base table columns (e.g., the rewritten input
+ * is a subquery that could not be pulled up) we assume that each result
+ * tuple is a group of its own.
+ */
+static double
+estimate_prov_join_groups(PlannerInfo *root, ProvJoinInfo *pjinfo,
+						  RelOptInfo *result_rel, RelOptInfo *input_rel)
+{
+	ListCell   *l;
+	double		groups;
+
+	/* no group-by attributes, all input tuples belong to a single group */
+	if (pjinfo->input_exprs == NIL)
+		return 1.0;
+
+	groups = result_rel->rows;
+	foreach(l, pjinfo->input_exprs)
+	{
+		Var		   *var = (Var *) lfirst(l);
+
+		if (rt_fetch(var->varno, root->parse->rtable)->rtekind != RTE_RELATION)
+			break;
+	}
+	if (l == NULL)
+		groups = estimate_num_groups(root, pjinfo->input_exprs,
+									 input_rel->rows);
+
+	if (groups > input_rel->rows)
+		groups = input_rel->rows;
+	if (groups < 1.0)
+		groups = 1.0;
+
+	return groups;
+}
+
 /*
  * join_in_selectivity
  *	  Determines the factor by which a JOIN_IN join's result is expected
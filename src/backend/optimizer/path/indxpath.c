@@ -1631,7 +1631,7 @@ best_inner_indexscan(PlannerInfo *root, RelOptInfo *rel,
 	*cheapest_startup = *cheapest_total = NULL;
 
 	/*
-	 * Nestloop only supports inner, left, and IN joins.
+	 * Nestloop only supports inner, left, anti, and IN joins.
 	 */
 	switch (jointype)
 	{
@@ -1641,6 +1641,7 @@ best_inner_indexscan(PlannerInfo *root, RelOptInfo *rel,
 			isouterjoin = false;
 			break;
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 			isouterjoin = true;
 			break;
 		default:
@@ -155,6 +155,7 @@ sort_inner_and_outer(PlannerInfo *root,
 	{
 		case JOIN_INNER:
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 		case JOIN_IN:
 		case JOIN_UNIQUE_OUTER:
 		case JOIN_UNIQUE_INNER:
@@ -333,16 +334,17 @@ match_unsorted_outer(PlannerInfo *root,
 	ListCell   *l;
 
 	/*
-	 * Nestloop only supports inner, left, and IN joins.  Also, if we are
-	 * doing a right or full join, we must use *all* the mergeclauses as join
-	 * clauses, else we will not have a valid plan.  (Although these two flags
-	 * are currently inverses, keep them separate for clarity and possible
-	 * future changes.)
+	 * Nestloop only supports inner, left, anti, and IN joins.  Also, if we
+	 * are doing a right or full join, we must use *all* the mergeclauses as
+	 * join clauses, else we will not have a valid plan.  (Although these two
+	 * flags are currently inverses, keep them separate for clarity and
+	 * possible future changes.)
 	 */
 	switch (jointype)
 	{
 		case JOIN_INNER:
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 		case JOIN_IN:
 		case JOIN_UNIQUE_OUTER:
 		case JOIN_UNIQUE_INNER:
@@ -694,7 +696,7 @@ hash_inner_and_outer(PlannerInfo *root,
 	ListCell   *l;
 
 	/*
-	 * Hashjoin only supports inner, left, and IN joins.
+	 * Hashjoin only supports inner, left, anti, and IN joins.
 	 */
 	switch (jointype)
 	{
@@ -705,6 +707,7 @@ hash_inner_and_outer(PlannerInfo *root,
 			isouterjoin = false;
 			break;
 		case JOIN_LEFT:
+		case JOIN_ANTI:
 			isouterjoin = true;
 			break;
 		default:
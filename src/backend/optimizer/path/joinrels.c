@@ -335,11 +335,13 @@ make_rels_by_clauseless_joins(PlannerInfo *root,
  * (We could simplify the API by computing joinrelids locally, but this
  * would be redundant work in the normal path through make_join_rel.)
  *
- * On success, *jointype_p is set to the required join type.
+ * On success, *jointype_p is set to the required join type.  Since an anti
+ * join has no reverse form, *reversed_p is set TRUE if the join is an anti
+ * join that must be done with rel2 as its outer rel.
  */
 static bool
 join_is_legal(PlannerInfo *root, RelOptInfo *rel1, RelOptInfo *rel2,
-			  Relids joinrelids, JoinType *jointype_p)
+			  Relids joinrelids, JoinType *jointype_p, bool *reversed_p)
 {
 	JoinType	jointype;
 	bool		is_valid_inner;
@@ -350,6 +352,7 @@ join_is_legal(PlannerInfo *root, RelOptInfo *rel1, RelOptInfo *rel2,
 	 * uninitialized-variable warnings from overly anal compilers.
 	 */
 	*jointype_p = JOIN_INNER;
+	*reversed_p = false;
 
 	/*
 	 * If we have any outer joins, the proposed join might be illegal; and in
@@ -399,14 +402,23 @@ join_is_legal(PlannerInfo *root, RelOptInfo *rel1, RelOptInfo *rel2,
 		{
 			if (jointype != JOIN_INNER)
 				return false;	/* invalid join path */
-			jointype = ojinfo->is_full_join ? JOIN_FULL : JOIN_LEFT;
+			if (ojinfo->is_anti_join)
+				jointype = JOIN_ANTI;
+			else
+				jointype = ojinfo->is_full_join ? JOIN_FULL : JOIN_LEFT;
 		}
 		else if (bms_is_subset(ojinfo->min_lefthand, rel2->relids) &&
 				 bms_is_subset(ojinfo->min_righthand, rel1->relids))
 		{
 			if (jointype != JOIN_INNER)
 				return false;	/* invalid join path */
-			jointype = ojinfo->is_full_join ? JOIN_FULL : JOIN_RIGHT;
+			if (ojinfo->is_anti_join)
+			{
+				jointype = JOIN_ANTI;
+				*reversed_p = true;
+			}
+			else
+				jointype = ojinfo->is_full_join ? JOIN_FULL : JOIN_RIGHT;
 		}
 		else
 		{
@@ -546,6 +558,7 @@ make_join_rel(PlannerInfo *root, RelOptInfo *rel1, RelOptInfo *rel2)
 {
 	Relids		joinrelids;
 	JoinType	jointype;
+	bool		reversed;
 	RelOptInfo *joinrel;
 	List	   *restrictlist;
 
@@ -556,13 +569,22 @@ make_join_rel(PlannerInfo *root, RelOptInfo *rel1, RelOptInfo *rel2)
 	joinrelids = bms_union(rel1->relids, rel2->relids);
 
 	/* Check validity and determine join type. */
-	if (!join_is_legal(root, rel1, rel2, joinrelids, &jointype))
+	if (!join_is_legal(root, rel1, rel2, joinrelids, &jointype, &reversed))
 	{
 		/* invalid join path */
 		bms_free(joinrelids);
 		return NULL;
 	}
 
+	/* An anti join is only done with its LHS as the outer rel */
+	if (reversed)
+	{
+		RelOptInfo *tmp = rel1;
+
+		rel1 = rel2;
+		rel2 = tmp;
+	}
+
 	/*
 	 * Find or build the join RelOptInfo, and compute the restrictlist that
 	 * goes with this particular joining.
@@ -629,6 +651,11 @@ make_join_rel(PlannerInfo *root, RelOptInfo *rel1, RelOptInfo *rel2)
 			add_paths_to_joinrel(root, joinrel, rel2, rel1, JOIN_UNIQUE_OUTER,
 								 restrictlist);
 			break;
+		case JOIN_ANTI:
+			/* there is no reverse form of an anti join */
+			add_paths_to_joinrel(root, joinrel, rel1, rel2, JOIN_ANTI,
+								 restrictlist);
+			break;
 		default:
 			elog(ERROR, "unrecognized join type: %d",
 				 (int) jointype);
@@ -866,11 +893,13 @@ has_legal_joinclause(PlannerInfo *root, RelOptInfo *rel)
 		{
 			Relids		joinrelids;
 			JoinType	jointype;
+			bool		reversed;
 
 			/* join_is_legal needs relids of the union */
 			joinrelids = bms_union(rel->relids, rel2->relids);
 
-			if (join_is_legal(root, rel, rel2, joinrelids, &jointype))
+			if (join_is_legal(root, rel, rel2, joinrelids, &jointype,
+							  &reversed))
 			{
 				/* Yes, this will work */
 				bms_free(joinrelids);
@@ -471,6 +471,10 @@ create_join_plan(PlannerInfo *root, JoinPath *best_path)
 			break;
 	}
 
+	/* Perm: remember the size estimate of a provenance join for EXPLAIN */
+	((Join *) plan)->provGroups = best_path->path.parent->prov_groups;
+	((Join *) plan)->provFanout = best_path->path.parent->prov_fanout;
+
 	/*
 	 * If there are any pseudoconstant clauses attached to this node, insert a
 	 * gating Result node that evaluates the pseudoconstants as one-time
@@ -3058,6 +3062,7 @@ make_agg(PlannerInfo *root, List *tlist, List *qual,
 	node->grpColIdx = grpColIdx;
 	node->grpOperators = grpOperators;
 	node->numGroups = numGroups;
+	node->provEmitInput = false;
 
 	copy_plan_costsize(plan, lefttree); /* only care about copying size */
 	cost_agg(&agg_path, root,
@@ -43,7 +43,9 @@ static List *deconstruct_recurse(PlannerInfo *root, Node *jtnode,
 static OuterJoinInfo *make_outerjoininfo(PlannerInfo *root,
 				   Relids left_rels, Relids right_rels,
 				   Relids inner_join_rels,
-				   bool is_full_join, Node *clause);
+				   bool is_full_join, bool is_anti_join, Node *clause);
+static ProvJoinInfo *make_provjoininfo(Relids result_rels, Relids input_rels,
+				  Node *clause);
 static void distribute_qual_to_rels(PlannerInfo *root, Node *clause,
 						bool is_deduced,
 						bool below_outer_join,
@@ -267,7 +269,8 @@ deconstruct_jointree(PlannerInfo *root)
  *		or free this, either)
  *	Return value is the appropriate joinlist for this jointree node
  *
- * In addition, entries will be added to root->oj_info_list for outer joins.
+ * In addition, entries will be added to root->oj_info_list for outer joins
+ * and to root->prov_join_list for joins marked by the provenance rewriter.
  */
 static List *
 deconstruct_recurse(PlannerInfo *root, Node *jtnode, bool below_outer_join,
@@ -386,6 +389,7 @@ deconstruct_recurse(PlannerInfo *root, Node *jtnode, bool below_outer_join,
 				nonnullable_rels = NULL;
 				break;
 			case JOIN_LEFT:
+			case JOIN_ANTI:
 				leftjoinlist = deconstruct_recurse(root, j->larg,
 												   below_outer_join,
 												   &leftids, &left_inners);
@@ -440,6 +444,7 @@ deconstruct_recurse(PlannerInfo *root, Node *jtnode, bool below_outer_join,
 										leftids, rightids,
 										*inner_join_rels,
 										(j->jointype == JOIN_FULL),
+										(j->jointype == JOIN_ANTI),
 										j->quals);
 			ojscope = bms_union(ojinfo->min_lefthand, ojinfo->min_righthand);
 		}
@@ -459,6 +464,21 @@ deconstruct_recurse(PlannerInfo *root, Node *jtnode, bool below_outer_join,
 		if (ojinfo)
 			root->oj_info_list = lappend(root->oj_info_list, ojinfo);
 
+		/*
+		 * Perm: for the join of an operator result (larg) with its rewritten
+		 * input (rarg) remember the sides for the size estimation.
+		 */
+		if (j->isProvJoin)
+		{
+			ProvJoinInfo *pjinfo;
+
+			if (j->jointype == JOIN_RIGHT)
+				pjinfo = make_provjoininfo(rightids, leftids, j->quals);
+			else
+				pjinfo = make_provjoininfo(leftids, rightids, j->quals);
+			root->prov_join_list = lappend(root->prov_join_list, pjinfo);
+		}
+
 		/*
 		 * Finally, compute the output joinlist.  We fold subproblems together
 		 * except at a FULL JOIN or where join_collapse_limit would be
@@ -511,11 +531,12 @@ deconstruct_recurse(PlannerInfo *root, Node *jtnode, bool below_outer_join,
  *	right_rels: the base Relids syntactically on inner side of join
  *	inner_join_rels: base Relids participating in inner joins below this one
  *	is_full_join: what it says
+ *	is_anti_join: what it says
  *	clause: the outer join's join condition
  *
  * If the join is a RIGHT JOIN, left_rels and right_rels are switched by
  * the caller, so that left_rels is always the nonnullable side.  Hence
- * we need only distinguish the LEFT and FULL cases.
+ * we need only distinguish the LEFT, FULL and anti join cases.
  *
  * The node should eventually be appended to root->oj_info_list, but we
  * do not do that here.
@@ -528,7 +549,7 @@ static OuterJoinInfo *
 make_outerjoininfo(PlannerInfo *root,
 				   Relids left_rels, Relids right_rels,
 				   Relids inner_join_rels,
-				   bool is_full_join, Node *clause)
+				   bool is_full_join, bool is_anti_join, Node *clause)
 {
 	OuterJoinInfo *ojinfo = makeNode(OuterJoinInfo);
 	Relids		clause_relids;
@@ -567,6 +588,7 @@ make_outerjoininfo(PlannerInfo *root,
 	ojinfo->syn_lefthand = left_rels;
 	ojinfo->syn_righthand = right_rels;
 	ojinfo->is_full_join = is_full_join;
+	ojinfo->is_anti_join = is_anti_join;
 	if (is_full_join)
 	{
 		ojinfo->min_lefthand = left_rels;
@@ -575,6 +597,19 @@ make_outerjoininfo(PlannerInfo *root,
 		return ojinfo;
 	}
 
+	/*
+	 * Likewise for an anti join: requiring its full syntactic inputs keeps
+	 * other outer joins from being interchanged with it.  Upper outer joins
+	 * see a non-strict join and preserve their ordering with it, too.
+	 */
+	if (is_anti_join)
+	{
+		ojinfo->min_lefthand = left_rels;
+		ojinfo->min_righthand = right_rels;
+		ojinfo->lhs_strict = false;
+		return ojinfo;
+	}
+
 	/*
 	 * Retrieve all relids mentioned within the join clause.
 	 */
@@ -686,6 +721,49 @@ make_outerjoininfo(PlannerInfo *root,
 }
 
 
+/*
+ * make_provjoininfo
+ *	  Build a ProvJoinInfo for a join marked by the provenance rewriter
+ *
+ * The input side Vars of the join condition are the group-by attributes of
+ * an aggregation or the attributes of a set operation input.  The other
+ * Vars of the condition belong to the operator result.  The joins for a set
+ * operation with more than two inputs are nested, but each condition only
+ * references the operator result, so we record the rels referenced by the
+ * condition instead of the whole left side.
+ */
+static ProvJoinInfo *
+make_provjoininfo(Relids result_rels, Relids input_rels, Node *clause)
+{
+	ProvJoinInfo *pjinfo = makeNode(ProvJoinInfo);
+	List	   *vars;
+	ListCell   *l;
+
+	pjinfo->result_relids = NULL;
+	pjinfo->input_relids = input_rels;
+	pjinfo->input_exprs = NIL;
+
+	vars = pull_var_clause(clause, false);
+	foreach(l, vars)
+	{
+		Var		   *var = (Var *) lfirst(l);
+
+		if (bms_is_member(var->varno, input_rels))
+			pjinfo->input_exprs = lappend(pjinfo->input_exprs, var);
+		else
+			pjinfo->result_relids = bms_add_member(pjinfo->result_relids,
+												   var->varno);
+	}
+	list_free(vars);
+
+	/* no condition (aggregation without GROUP BY) */
+	if (bms_is_empty(pjinfo->result_relids))
+		pjinfo->result_relids = result_rels;
+
+	return pjinfo;
+}
+
+
 /*****************************************************************************
  *
  *	  QUALIFICATIONS
@@ -38,6 +38,8 @@
 #include "parser/parse_expr.h"
 #include "parser/parse_oper.h"
 #include "parser/parsetree.h"
+#include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_normalize.h"
 #include "utils/lsyscache.h"
 #include "utils/syscache.h"
 
@@ -112,6 +114,7 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	double		tuple_fraction;
 	PlannerInfo *root;
 	Plan	   *top_plan;
+	ProvNormalize *normalize = NULL;
 	ListCell   *lp,
 			   *lr;
 
@@ -154,9 +157,20 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 		tuple_fraction = 0.0;
 	}
 
+	/*
+	 * Normalized provenance output of a rewritten provenance query (see
+	 * addNormalizedTopQuery), needs the target list before it is changed by
+	 * planning
+	 */
+	if (IsProvNormalized(parse) && !IsProvRewrite(parse))
+		normalize = makeProvNormalize(parse);
+
 	/* primary planning entry point (may recurse for subqueries) */
 	top_plan = subquery_planner(glob, parse, 1, tuple_fraction, &root);
 
+	if (normalize != NULL)
+		top_plan = addProvNormalizePlan(normalize, top_plan);
+
 	/*
 	 * If creating a plan for a scrollable cursor, make sure it can run
 	 * backwards on demand.  Add a Material node at the top at need.
@@ -197,6 +211,7 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	result->rowMarks = parse->rowMarks;
 	result->relationOids = glob->relationOids;
 	result->nParamExec = list_length(glob->paramlist);
+	result->provLineage = GetProvLineage(parse);
 
 	return result;
 }
@@ -907,11 +922,19 @@ grouping_planner(PlannerInfo *root, double tuple_fraction)
 		if (parse->groupClause)
 		{
 			groupOperators = extract_grouping_ops(parse->groupClause);
-			use_hashed_grouping =
-				choose_hashed_grouping(root, tuple_fraction, limit_tuples,
-									   cheapest_path, sorted_path,
-									   groupOperators, dNumGroups,
-									   &agg_counts);
+
+			/*
+			 * Single pass provenance aggregation has to see the input
+			 * tuples of each group together, so never hash.
+			 */
+			if (IsAggSinglePass(parse))
+				use_hashed_grouping = false;
+			else
+				use_hashed_grouping =
+					choose_hashed_grouping(root, tuple_fraction, limit_tuples,
+										   cheapest_path, sorted_path,
+										   groupOperators, dNumGroups,
+										   &agg_counts);
 
 			/* Also convert # groups to long int --- but 'ware overflow! */
 			numGroups = (long) Min(dNumGroups, (double) LONG_MAX);
@@ -931,11 +954,15 @@ grouping_planner(PlannerInfo *root, double tuple_fraction)
 		 * Check to see if it's possible to optimize MIN/MAX aggregates. If
 		 * so, we will forget all the work we did so far to choose a "regular"
 		 * path ... but we had to do it anyway to be able to tell which way is
-		 * cheaper.
+		 * cheaper. This is not possible if we have to emit the input tuples
+		 * of the aggregation for provenance computation.
 		 */
-		result_plan = optimize_minmax_aggregates(root,
-												 tlist,
-												 best_path);
+		if (IsAggSinglePass(parse))
+			result_plan = NULL;
+		else
+			result_plan = optimize_minmax_aggregates(root,
+													 tlist,
+													 best_path);
 		if (result_plan != NULL)
 		{
 			/*
@@ -1081,6 +1108,17 @@ grouping_planner(PlannerInfo *root, double tuple_fraction)
 												numGroups,
 												agg_counts.numAggs,
 												result_plan);
+
+				/*
+				 * For single pass provenance aggregation the Agg node
+				 * returns each of its input tuples.
+				 */
+				if (IsAggSinglePass(parse))
+				{
+					((Agg *) result_plan)->provEmitInput = true;
+					result_plan->plan_rows =
+						Max(result_plan->lefttree->plan_rows, 1.0);
+				}
 			}
 			else if (parse->groupClause)
 			{
@@ -337,6 +337,7 @@ set_plan_refs(PlannerGlobal *glob, Plan *plan, int rtoffset)
 		case T_Sort:
 		case T_Unique:
 		case T_SetOp:
+		case T_ProvNormalize:
 
 			/*
 			 * These plan types don't actually bother to evaluate their
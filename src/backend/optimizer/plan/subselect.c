@@ -28,6 +28,7 @@
 #include "parser/parsetree.h"
 #include "rewrite/rewriteManip.h"
 #include "utils/builtins.h"
+#include "utils/guc.h"
 #include "utils/lsyscache.h"
 #include "utils/syscache.h"
 
@@ -63,6 +64,8 @@ static Node *convert_testexpr_mutator(Node *node,
 						 convert_testexpr_context *context);
 static bool subplan_is_hashable(SubLink *slink, SubPlan *node, Plan *plan);
 static bool hash_ok_operator(OpExpr *expr);
+static bool subquery_is_volatile_walker(Node *node, void *context);
+static bool sublink_subquery_walker(Node *node, void *context);
 static Node *replace_correlation_vars_mutator(Node *node, PlannerInfo *root);
 static Node *process_sublinks_mutator(Node *node,
 						 process_sublinks_context *context);
@@ -251,6 +254,7 @@ make_subplan(PlannerInfo *root, SubLink *slink, Node *testexpr, bool isTopQual)
 	Bitmapset  *tmpset;
 	int			paramid;
 	Node	   *result;
+	bool		memoizable;
 
 	/*
 	 * Copy the source Query node.	This is a quick and dirty kluge to resolve
@@ -260,6 +264,14 @@ make_subplan(PlannerInfo *root, SubLink *slink, Node *testexpr, bool isTopQual)
 	 */
 	subquery = (Query *) copyObject(subquery);
 
+	/*
+	 * The output of a correlated subplan can only be memoized if the
+	 * sub-select returns the same rows for the same parameter values.  Check
+	 * this before the planner scribbles on the Query.
+	 */
+	memoizable = prov_use_sublink_memoization &&
+		!subquery_is_volatile_walker((Node *) subquery, NULL);
+
 	/*
 	 * For an EXISTS subplan, tell lower-level planner to expect that only the
 	 * first tuple will be retrieved.  For ALL and ANY subplans, we will be
@@ -307,6 +319,7 @@ make_subplan(PlannerInfo *root, SubLink *slink, Node *testexpr, bool isTopQual)
 	splan->useHashTable = false;
 	/* At top level of a qual, can treat UNKNOWN the same as FALSE */
 	splan->unknownEqFalse = isTopQual;
+	splan->useMemoization = false;
 	splan->setParam = NIL;
 	splan->parParam = NIL;
 	splan->args = NIL;
@@ -443,6 +456,15 @@ make_subplan(PlannerInfo *root, SubLink *slink, Node *testexpr, bool isTopQual)
 				plan = materialize_finished_plan(plan);
 		}
 
+		/*
+		 * A direct-correlated subplan is re-executed for each outer tuple.
+		 * Unless it is volatile, we can instead memoize its output for each
+		 * combination of the correlation values, which pays off if the same
+		 * values are passed repeatedly.
+		 */
+		else if (memoizable)
+			splan->useMemoization = true;
+
 		/*
 		 * Make splan->args from parParam.
 		 */
@@ -491,6 +513,35 @@ make_subplan(PlannerInfo *root, SubLink *slink, Node *testexpr, bool isTopQual)
 	return result;
 }
 
+/*
+ * subquery_is_volatile_walker: does a sub-select, including the sub-selects
+ * of its own sublinks and range table, contain volatile functions?
+ */
+static bool
+subquery_is_volatile_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node,
+								 subquery_is_volatile_walker,
+								 context, 0);
+	if (contain_volatile_functions(node))
+		return true;
+	/* contain_volatile_functions doesn't look into sublinks */
+	return expression_tree_walker(node, sublink_subquery_walker, context);
+}
+
+static bool
+sublink_subquery_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, Query))
+		return subquery_is_volatile_walker(node, context);
+	return expression_tree_walker(node, sublink_subquery_walker, context);
+}
+
 /*
  * generate_subquery_params: build a list of Params representing the output
  * columns of a sublink's sub-select, given the sub-select's targetlist.
@@ -1265,6 +1316,7 @@ finalize_plan(PlannerInfo *root, Plan *plan,
 		case T_Unique:
 		case T_SetOp:
 		case T_Group:
+		case T_ProvNormalize:
 			break;
 
 		default:
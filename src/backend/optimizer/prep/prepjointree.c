@@ -225,6 +225,7 @@ pull_up_subqueries(PlannerInfo *root, Node *jtnode,
 											 below_outer_join, false);
 				break;
 			case JOIN_LEFT:
+			case JOIN_ANTI:
 				j->larg = pull_up_subqueries(root, j->larg,
 											 below_outer_join, false);
 				j->rarg = pull_up_subqueries(root, j->rarg,
@@ -1135,6 +1136,15 @@ reduce_outer_joins_pass2(Node *jtnode,
 			{
 				if (jointype == JOIN_INNER || jointype == JOIN_LEFT)
 					pass_nonnullable = local_nonnullable;
+				else if (jointype == JOIN_ANTI)
+				{
+					/*
+					 * An anti join is never reduced, so constraints from
+					 * above don't apply to its nullable side; but only inner
+					 * rows that satisfy its own quals matter.
+					 */
+					pass_nonnullable = find_nonnullable_rels(j->quals);
+				}
 				else
 					pass_nonnullable = nonnullable_rels;
 				reduce_outer_joins_pass2(j->rarg, right_state, root,
@@ -756,6 +756,19 @@ transformSelectStmt(ParseState *pstate, SelectStmt *stmt)
 	qry->provInfo = (Node *) stmt->provenanceClause;
 	SetSublinkRewritten(qry,false);
 
+	/* the normalized provenance output is produced on top of the plan of a complete statement */
+	if (IsProvNormalized(qry))
+	{
+		if (pstate->parentParseState != NULL)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("FORMAT NORMALIZED is only allowed in a top-level SELECT")));
+		if (qry->rowMarks != NIL)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("SELECT FOR UPDATE/SHARE is not allowed with FORMAT NORMALIZED")));
+	}
+
 	return qry;
 }
 
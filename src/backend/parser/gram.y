@@ -396,7 +396,7 @@ static Node *makeXmlExpr(XmlExprOp op, char *name, List *named_args, List *args)
 	EACH ELSE ENABLE_P ENCODING ENCRYPTED END_P ENUM_P ESCAPE EXCEPT EXCLUDING
 	EXCLUSIVE EXECUTE EXISTS EXPLAIN EXTERNAL EXTRACT
 
-	FALSE_P FAMILY FETCH FIRST_P FLOAT_P FOR FORCE FOREIGN FORWARD
+	FALSE_P FAMILY FETCH FIRST_P FLOAT_P FOR FORCE FOREIGN FORMAT FORWARD
 	FREEZE FROM FULL FUNCTION
 
 	GLOBAL GRANT GRANTED GRAPH GREATEST GROUP_P
@@ -416,10 +416,10 @@ static Node *makeXmlExpr(XmlExprOp op, char *name, List *named_args, List *args)
 	LIKE LIMIT LISTEN LOAD LOCAL LOCALTIME LOCALTIMESTAMP LOCATION
 	LOCK_P LOGIN_P
 
-	MAPPING MAPPROV MATCH MAXVALUE MINUTE_P MINVALUE MODE MONTH_P MOVE
+	MAPPING MAPPROV MATCH MATERIALIZED MAXVALUE MINUTE_P MINVALUE MODE MONTH_P MOVE
 
 	NAME_P NAMES NATIONAL NATURAL NCHAR NEW NEXT NO NOCREATEDB
-	NOCREATEROLE NOCREATEUSER NOINHERIT NOLOGIN_P NONE NOSUPERUSER
+	NOCREATEROLE NOCREATEUSER NOINHERIT NOLOGIN_P NONE NORMALIZED NOSUPERUSER
 	NOT NOTHING NOTIFY NOTNULL NOTTRANSITIVE NOWAIT NULL_P NULLIF NULLS_P NUMERIC
 
 	OBJECT_P OF OFF OFFSET OIDS OLD ON ONLY OPERATOR OPTION OR
@@ -443,7 +443,7 @@ static Node *makeXmlExpr(XmlExprOp op, char *name, List *named_args, List *args)
 
 	TABLE TABLESPACE TEMP TEMPLATE TEMPORARY TEXT_P THEN THIS TIME TIMESTAMP
 	TO TRAILING TRANSACTION TRANSITIVE TRANSPROV TRANSSQL TRANSXML TREAT TRIGGER TRIM TRUE_P
-	TRUNCATE TRUSTED TYPE_P
+	TRUNCATE TRUSTED TUPLEID TYPE_P
 
 	UNCOMMITTED UNENCRYPTED UNION UNIQUE UNKNOWN UNLISTEN UNTIL
 	UPDATE USER USING
@@ -465,6 +465,7 @@ static Node *makeXmlExpr(XmlExprOp op, char *name, List *named_args, List *args)
  * creates these tokens when required.
  */
 %token			NULLS_FIRST NULLS_LAST WITH_CASCADED WITH_LOCAL WITH_CHECK
+			FORMAT_NORMALIZED
 
 /* Special token types, not actually keywords - see the "lex" file */
 %token <str>	IDENT FCONST SCONST BCONST XCONST Op
@@ -5255,6 +5256,18 @@ ViewStmt: CREATE OptTemp VIEW qualified_name opt_column_list
 					n->replace = true;
 					$$ = (Node *) n;
 				}
+		| CREATE OptTemp MATERIALIZED PROVENANCE VIEW qualified_name opt_column_list
+				AS SelectStmt opt_check_option
+				{
+					ViewStmt *n = makeNode(ViewStmt);
+					n->view = $6;
+					n->view->istemp = $2;
+					n->aliases = $7;
+					n->query = $9;
+					n->replace = false;
+					n->materialized = true;
+					$$ = (Node *) n;
+				}
 		;
 
 /*
@@ -6369,6 +6382,22 @@ opt_provenance:
 					n->contribution = $5;
 					$$ = (Node *) n; 
 				}
+			| PROVENANCE FORMAT_NORMALIZED
+				{
+					ProvInfo *n = makeProvInfo();
+					n->shouldRewrite = true;
+					n->contribution = CONTR_INFLUENCE;
+					n->normalized = true;
+					$$ = (Node *) n;
+				}
+			| PROVENANCE ON CONTRIBUTION '(' contribution_type ')' FORMAT_NORMALIZED
+				{
+					ProvInfo *n = makeProvInfo();
+					n->shouldRewrite = true;
+					n->contribution = $5;
+					n->normalized = true;
+					$$ = (Node *) n;
+				}
 			| TRANSPROV
 				{
 					ProvInfo *n = makeProvInfo();
@@ -6433,6 +6462,7 @@ contribution_type:
 					} 
 				}
 			| INFLUENCE								{ $$ = CONTR_INFLUENCE; }
+			| TUPLEID								{ $$ = CONTR_TUPLEID; }
 
 opt_copy_contribution_mod:
 			PARTIAL									{ $$ = TRUE; }
@@ -9279,6 +9309,7 @@ unreserved_keyword:
 			| FETCH
 			| FIRST_P
 			| FORCE
+			| FORMAT
 			| FORWARD
 			| FUNCTION
 			| GLOBAL
@@ -9319,6 +9350,7 @@ unreserved_keyword:
 			| LOGIN_P
 			| MAPPING
 			| MATCH
+			| MATERIALIZED
 			| MAXVALUE
 			| MINUTE_P
 			| MINVALUE
@@ -9334,6 +9366,7 @@ unreserved_keyword:
 			| NOCREATEUSER
 			| NOINHERIT
 			| NOLOGIN_P
+			| NORMALIZED
 			| NOSUPERUSER
 			| NOTHING
 			| NOTIFY
@@ -9416,6 +9449,7 @@ unreserved_keyword:
 			| TRIGGER
 			| TRUNCATE
 			| TRUSTED
+			| TUPLEID
 			| TYPE_P
 			| UNCOMMITTED
 			| UNENCRYPTED
@@ -161,6 +161,7 @@ static const ScanKeyword ScanKeywords[] = {
 	{"for", FOR, RESERVED_KEYWORD},
 	{"force", FORCE, UNRESERVED_KEYWORD},
 	{"foreign", FOREIGN, RESERVED_KEYWORD},
+	{"format", FORMAT, UNRESERVED_KEYWORD},
 	{"forward", FORWARD, UNRESERVED_KEYWORD},
 	{"freeze", FREEZE, TYPE_FUNC_NAME_KEYWORD},
 	{"from", FROM, RESERVED_KEYWORD},
@@ -229,6 +230,7 @@ static const ScanKeyword ScanKeywords[] = {
 	{"mapping", MAPPING, UNRESERVED_KEYWORD},
 	{"mapprov", MAPPROV, RESERVED_KEYWORD},
 	{"match", MATCH, UNRESERVED_KEYWORD},
+	{"materialized", MATERIALIZED, UNRESERVED_KEYWORD},
 	{"maxvalue", MAXVALUE, UNRESERVED_KEYWORD},
 	{"minute", MINUTE_P, UNRESERVED_KEYWORD},
 	{"minvalue", MINVALUE, UNRESERVED_KEYWORD},
@@ -249,6 +251,7 @@ static const ScanKeyword ScanKeywords[] = {
 	{"noinherit", NOINHERIT, UNRESERVED_KEYWORD},
 	{"nologin", NOLOGIN_P, UNRESERVED_KEYWORD},
 	{"none", NONE, COL_NAME_KEYWORD},
+	{"normalized", NORMALIZED, UNRESERVED_KEYWORD},
 	{"nosuperuser", NOSUPERUSER, UNRESERVED_KEYWORD},
 	{"not", NOT, RESERVED_KEYWORD},
 	{"nothing", NOTHING, UNRESERVED_KEYWORD},
@@ -378,6 +381,7 @@ static const ScanKeyword ScanKeywords[] = {
 	{"true", TRUE_P, RESERVED_KEYWORD},
 	{"truncate", TRUNCATE, UNRESERVED_KEYWORD},
 	{"trusted", TRUSTED, UNRESERVED_KEYWORD},
+	{"tupleid", TUPLEID, UNRESERVED_KEYWORD},
 	{"type", TYPE_P, UNRESERVED_KEYWORD},
 	{"uncommitted", UNCOMMITTED, UNRESERVED_KEYWORD},
 	{"unencrypted", UNENCRYPTED, UNRESERVED_KEYWORD},
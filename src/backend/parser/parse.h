@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
+/* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,420 +31,447 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Tokens.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_BASE_YY_Y_TAB_H_INCLUDED
+# define YY_BASE_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int base_yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     ABORT_P = 258,
-     ABSOLUTE_P = 259,
-     ACCESS = 260,
-     ACTION = 261,
-     ADD_P = 262,
-     ADMIN = 263,
-     AFTER = 264,
-     AGGREGATE = 265,
-     ALL = 266,
-     ALSO = 267,
-     ALTER = 268,
-     ALWAYS = 269,
-     ANALYSE = 270,
-     ANALYZE = 271,
-     AND = 272,
-     ANNOT = 273,
-     ANY = 274,
-     ARRAY = 275,
-     AS = 276,
-     ASC = 277,
-     ASSERTION = 278,
-     ASSIGNMENT = 279,
-     ASYMMETRIC = 280,
-     AT = 281,
-     AUTHORIZATION = 282,
-     BACKWARD = 283,
-     BASERELATION = 284,
-     BEFORE = 285,
-     BEGIN_P = 286,
-     BETWEEN = 287,
-     BIGINT = 288,
-     BINARY = 289,
-     BIT = 290,
-     BOOLEAN_P = 291,
-     BOTH = 292,
-     BY = 293,
-     CACHE = 294,
-     CALLED = 295,
-     CASCADE = 296,
-     CASCADED = 297,
-     CASE = 298,
-     CAST = 299,
-     CHAIN = 300,
-     CHAR_P = 301,
-     CHARACTER = 302,
-     CHARACTERISTICS = 303,
-     CHECK = 304,
-     CHECKPOINT = 305,
-     CLASS = 306,
-     CLOSE = 307,
-     CLUSTER = 308,
-     COALESCE = 309,
-     COLLATE = 310,
-     COLUMN = 311,
-     COMMENT = 312,
-     COMMIT = 313,
-     COMMITTED = 314,
-     COMPLETE = 315,
-     CONCURRENTLY = 316,
-     CONFIGURATION = 317,
-     CONNECTION = 318,
-     CONSTRAINT = 319,
-     CONSTRAINTS = 320,
-     CONTENT_P = 321,
-     CONTRIBUTION = 322,
-     CONVERSION_P = 323,
-     COPY = 324,
-     COST = 325,
-     CREATE = 326,
-     CREATEDB = 327,
-     CREATEROLE = 328,
-     CREATEUSER = 329,
-     CROSS = 330,
-     CSV = 331,
-     CURRENT_P = 332,
-     CURRENT_DATE = 333,
-     CURRENT_ROLE = 334,
-     CURRENT_TIME = 335,
-     CURRENT_TIMESTAMP = 336,
-     CURRENT_USER = 337,
-     CURSOR = 338,
-     CYCLE = 339,
-     DATABASE = 340,
-     DAY_P = 341,
-     DEALLOCATE = 342,
-     DEC = 343,
-     DECIMAL_P = 344,
-     DECLARE = 345,
-     DEFAULT = 346,
-     DEFAULTS = 347,
-     DEFERRABLE = 348,
-     DEFERRED = 349,
-     DEFINER = 350,
-     DELETE_P = 351,
-     DELIMITER = 352,
-     DELIMITERS = 353,
-     DESC = 354,
-     DICTIONARY = 355,
-     DISABLE_P = 356,
-     DISCARD = 357,
-     DISTINCT = 358,
-     DO = 359,
-     DOCUMENT_P = 360,
-     DOMAIN_P = 361,
-     DOUBLE_P = 362,
-     DROP = 363,
-     EACH = 364,
-     ELSE = 365,
-     ENABLE_P = 366,
-     ENCODING = 367,
-     ENCRYPTED = 368,
-     END_P = 369,
-     ENUM_P = 370,
-     ESCAPE = 371,
-     EXCEPT = 372,
-     EXCLUDING = 373,
-     EXCLUSIVE = 374,
-     EXECUTE = 375,
-     EXISTS = 376,
-     EXPLAIN = 377,
-     EXTERNAL = 378,
-     EXTRACT = 379,
-     FALSE_P = 380,
-     FAMILY = 381,
-     FETCH = 382,
-     FIRST_P = 383,
-     FLOAT_P = 384,
-     FOR = 385,
-     FORCE = 386,
-     FOREIGN = 387,
-     FORWARD = 388,
-     FREEZE = 389,
-     FROM = 390,
-     FULL = 391,
-     FUNCTION = 392,
-     GLOBAL = 393,
-     GRANT = 394,
-     GRANTED = 395,
-     GRAPH = 396,
-     GREATEST = 397,
-     GROUP_P = 398,
-     HANDLER = 399,
-     HAVING = 400,
-     HEADER_P = 401,
-     HOLD = 402,
-     HOUR_P = 403,
-     IF_P = 404,
-     ILIKE = 405,
-     IMMEDIATE = 406,
-     IMMUTABLE = 407,
-     IMPLICIT_P = 408,
-     IN_P = 409,
-     INCLUDING = 410,
-     INCREMENT = 411,
-     INDEX = 412,
-     INDEXES = 413,
-     INFLUENCE = 414,
-     INHERIT = 415,
-     INHERITS = 416,
-     INITIALLY = 417,
-     INNER_P = 418,
-     INOUT = 419,
-     INPUT_P = 420,
-     INSENSITIVE = 421,
-     INSERT = 422,
-     INSTEAD = 423,
-     INT_P = 424,
-     INTEGER = 425,
-     INTERSECT = 426,
-     INTERVAL = 427,
-     INTO = 428,
-     INVOKER = 429,
-     IS = 430,
-     ISNULL = 431,
-     ISOLATION = 432,
-     JOIN = 433,
-     KEY = 434,
-     LANCOMPILER = 435,
-     LANGUAGE = 436,
-     LARGE_P = 437,
-     LAST_P = 438,
-     LEADING = 439,
-     LEAST = 440,
-     LEFT = 441,
-     LEVEL = 442,
-     LIKE = 443,
-     LIMIT = 444,
-     LISTEN = 445,
-     LOAD = 446,
-     LOCAL = 447,
-     LOCALTIME = 448,
-     LOCALTIMESTAMP = 449,
-     LOCATION = 450,
-     LOCK_P = 451,
-     LOGIN_P = 452,
-     MAPPING = 453,
-     MAPPROV = 454,
-     MATCH = 455,
-     MAXVALUE = 456,
-     MINUTE_P = 457,
-     MINVALUE = 458,
-     MODE = 459,
-     MONTH_P = 460,
-     MOVE = 461,
-     NAME_P = 462,
-     NAMES = 463,
-     NATIONAL = 464,
-     NATURAL = 465,
-     NCHAR = 466,
-     NEW = 467,
-     NEXT = 468,
-     NO = 469,
-     NOCREATEDB = 470,
-     NOCREATEROLE = 471,
-     NOCREATEUSER = 472,
-     NOINHERIT = 473,
-     NOLOGIN_P = 474,
-     NONE = 475,
-     NOSUPERUSER = 476,
-     NOT = 477,
-     NOTHING = 478,
-     NOTIFY = 479,
-     NOTNULL = 480,
-     NOTTRANSITIVE = 481,
-     NOWAIT = 482,
-     NULL_P = 483,
-     NULLIF = 484,
-     NULLS_P = 485,
-     NUMERIC = 486,
-     OBJECT_P = 487,
-     OF = 488,
-     OFF = 489,
-     OFFSET = 490,
-     OIDS = 491,
-     OLD = 492,
-     ON = 493,
-     ONLY = 494,
-     OPERATOR = 495,
-     OPTION = 496,
-     OR = 497,
-     ORDER = 498,
-     OUT_P = 499,
-     OUTER_P = 500,
-     OVERLAPS = 501,
-     OVERLAY = 502,
-     OWNED = 503,
-     OWNER = 504,
-     PARSER = 505,
-     PARTIAL = 506,
-     PASSWORD = 507,
-     PLACING = 508,
-     PLANS = 509,
-     POSITION = 510,
-     PRECISION = 511,
-     PRESERVE = 512,
-     PREPARE = 513,
-     PREPARED = 514,
-     PRIMARY = 515,
-     PRIOR = 516,
-     PRIVILEGES = 517,
-     PROCEDURAL = 518,
-     PROCEDURE = 519,
-     PROVENANCE = 520,
-     QUOTE = 521,
-     READ = 522,
-     REAL = 523,
-     REASSIGN = 524,
-     RECHECK = 525,
-     REFERENCES = 526,
-     REINDEX = 527,
-     RELATIVE_P = 528,
-     RELEASE = 529,
-     RENAME = 530,
-     REPEATABLE = 531,
-     REPLACE = 532,
-     REPLICA = 533,
-     RESET = 534,
-     RESTART = 535,
-     RESTRICT = 536,
-     RETURNING = 537,
-     RETURNS = 538,
-     REVOKE = 539,
-     RIGHT = 540,
-     ROLE = 541,
-     ROLLBACK = 542,
-     ROW = 543,
-     ROWS = 544,
-     RULE = 545,
-     SAVEPOINT = 546,
-     SCHEMA = 547,
-     SCROLL = 548,
-     SEARCH = 549,
-     SECOND_P = 550,
-     SECURITY = 551,
-     SELECT = 552,
-     SEQUENCE = 553,
-     SERIALIZABLE = 554,
-     SESSION = 555,
-     SESSION_USER = 556,
-     SET = 557,
-     SETOF = 558,
-     SHARE = 559,
-     SHOW = 560,
-     SIMILAR = 561,
-     SIMPLE = 562,
-     SMALLINT = 563,
-     SOME = 564,
-     SQLTEXT = 565,
-     SQLTEXTDB2 = 566,
-     STABLE = 567,
-     STANDALONE_P = 568,
-     START = 569,
-     STATEMENT = 570,
-     STATISTICS = 571,
-     STDIN = 572,
-     STDOUT = 573,
-     STORAGE = 574,
-     STRICT_P = 575,
-     STRIP_P = 576,
-     SUBSTRING = 577,
-     SUPERUSER_P = 578,
-     SYMMETRIC = 579,
-     SYSID = 580,
-     SYSTEM_P = 581,
-     TABLE = 582,
-     TABLESPACE = 583,
-     TEMP = 584,
-     TEMPLATE = 585,
-     TEMPORARY = 586,
-     TEXT_P = 587,
-     THEN = 588,
-     THIS = 589,
-     TIME = 590,
-     TIMESTAMP = 591,
-     TO = 592,
-     TRAILING = 593,
-     TRANSACTION = 594,
-     TRANSITIVE = 595,
-     TRANSPROV = 596,
-     TRANSSQL = 597,
-     TRANSXML = 598,
-     TREAT = 599,
-     TRIGGER = 600,
-     TRIM = 601,
-     TRUE_P = 602,
-     TRUNCATE = 603,
-     TRUSTED = 604,
-     TYPE_P = 605,
-     UNCOMMITTED = 606,
-     UNENCRYPTED = 607,
-     UNION = 608,
-     UNIQUE = 609,
-     UNKNOWN = 610,
-     UNLISTEN = 611,
-     UNTIL = 612,
-     UPDATE = 613,
-     USER = 614,
-     USING = 615,
-     VACUUM = 616,
-     VALID = 617,
-     VALIDATOR = 618,
-     VALUE_P = 619,
-     VALUES = 620,
-     VARCHAR = 621,
-     VARYING = 622,
-     VERBOSE = 623,
-     VERSION_P = 624,
-     VIEW = 625,
-     VOLATILE = 626,
-     WHEN = 627,
-     WHERE = 628,
-     WHITESPACE_P = 629,
-     WITH = 630,
-     WITHOUT = 631,
-     WORK = 632,
-     WRITE = 633,
-     XML_P = 634,
-     XMLATTRIBUTES = 635,
-     XMLCONCAT = 636,
-     XMLELEMENT = 637,
-     XMLFOREST = 638,
-     XMLPARSE = 639,
-     XMLPI = 640,
-     XMLROOT = 641,
-     XMLSERIALIZE = 642,
-     XSLT = 643,
-     YEAR_P = 644,
-     YES_P = 645,
-     ZONE = 646,
-     NULLS_FIRST = 647,
-     NULLS_LAST = 648,
-     WITH_CASCADED = 649,
-     WITH_LOCAL = 650,
-     WITH_CHECK = 651,
-     IDENT = 652,
-     FCONST = 653,
-     SCONST = 654,
-     BCONST = 655,
-     XCONST = 656,
-     Op = 657,
-     ICONST = 658,
-     PARAM = 659,
-     POSTFIXOP = 660,
-     UMINUS = 661,
-     TYPECAST = 662
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ABORT_P = 258,                 /* ABORT_P  */
+    ABSOLUTE_P = 259,              /* ABSOLUTE_P  */
+    ACCESS = 260,                  /* ACCESS  */
+    ACTION = 261,                  /* ACTION  */
+    ADD_P = 262,                   /* ADD_P  */
+    ADMIN = 263,                   /* ADMIN  */
+    AFTER = 264,                   /* AFTER  */
+    AGGREGATE = 265,               /* AGGREGATE  */
+    ALL = 266,                     /* ALL  */
+    ALSO = 267,                    /* ALSO  */
+    ALTER = 268,                   /* ALTER  */
+    ALWAYS = 269,                  /* ALWAYS  */
+    ANALYSE = 270,                 /* ANALYSE  */
+    ANALYZE = 271,                 /* ANALYZE  */
+    AND = 272,                     /* AND  */
+    ANNOT = 273,                   /* ANNOT  */
+    ANY = 274,                     /* ANY  */
+    ARRAY = 275,                   /* ARRAY  */
+    AS = 276,                      /* AS  */
+    ASC = 277,                     /* ASC  */
+    ASSERTION = 278,               /* ASSERTION  */
+    ASSIGNMENT = 279,              /* ASSIGNMENT  */
+    ASYMMETRIC = 280,              /* ASYMMETRIC  */
+    AT = 281,                      /* AT  */
+    AUTHORIZATION = 282,           /* AUTHORIZATION  */
+    BACKWARD = 283,                /* BACKWARD  */
+    BASERELATION = 284,            /* BASERELATION  */
+    BEFORE = 285,                  /* BEFORE  */
+    BEGIN_P = 286,                 /* BEGIN_P  */
+    BETWEEN = 287,                 /* BETWEEN  */
+    BIGINT = 288,                  /* BIGINT  */
+    BINARY = 289,                  /* BINARY  */
+    BIT = 290,                     /* BIT  */
+    BOOLEAN_P = 291,               /* BOOLEAN_P  */
+    BOTH = 292,                    /* BOTH  */
+    BY = 293,                      /* BY  */
+    CACHE = 294,                   /* CACHE  */
+    CALLED = 295,                  /* CALLED  */
+    CASCADE = 296,                 /* CASCADE  */
+    CASCADED = 297,                /* CASCADED  */
+    CASE = 298,                    /* CASE  */
+    CAST = 299,                    /* CAST  */
+    CHAIN = 300,                   /* CHAIN  */
+    CHAR_P = 301,                  /* CHAR_P  */
+    CHARACTER = 302,               /* CHARACTER  */
+    CHARACTERISTICS = 303,         /* CHARACTERISTICS  */
+    CHECK = 304,                   /* CHECK  */
+    CHECKPOINT = 305,              /* CHECKPOINT  */
+    CLASS = 306,                   /* CLASS  */
+    CLOSE = 307,                   /* CLOSE  */
+    CLUSTER = 308,                 /* CLUSTER  */
+    COALESCE = 309,                /* COALESCE  */
+    COLLATE = 310,                 /* COLLATE  */
+    COLUMN = 311,                  /* COLUMN  */
+    COMMENT = 312,                 /* COMMENT  */
+    COMMIT = 313,                  /* COMMIT  */
+    COMMITTED = 314,               /* COMMITTED  */
+    COMPLETE = 315,                /* COMPLETE  */
+    CONCURRENTLY = 316,            /* CONCURRENTLY  */
+    CONFIGURATION = 317,           /* CONFIGURATION  */
+    CONNECTION = 318,              /* CONNECTION  */
+    CONSTRAINT = 319,              /* CONSTRAINT  */
+    CONSTRAINTS = 320,             /* CONSTRAINTS  */
+    CONTENT_P = 321,               /* CONTENT_P  */
+    CONTRIBUTION = 322,            /* CONTRIBUTION  */
+    CONVERSION_P = 323,            /* CONVERSION_P  */
+    COPY = 324,                    /* COPY  */
+    COST = 325,                    /* COST  */
+    CREATE = 326,                  /* CREATE  */
+    CREATEDB = 327,                /* CREATEDB  */
+    CREATEROLE = 328,              /* CREATEROLE  */
+    CREATEUSER = 329,              /* CREATEUSER  */
+    CROSS = 330,                   /* CROSS  */
+    CSV = 331,                     /* CSV  */
+    CURRENT_P = 332,               /* CURRENT_P  */
+    CURRENT_DATE = 333,            /* CURRENT_DATE  */
+    CURRENT_ROLE = 334,            /* CURRENT_ROLE  */
+    CURRENT_TIME = 335,            /* CURRENT_TIME  */
+    CURRENT_TIMESTAMP = 336,       /* CURRENT_TIMESTAMP  */
+    CURRENT_USER = 337,            /* CURRENT_USER  */
+    CURSOR = 338,                  /* CURSOR  */
+    CYCLE = 339,                   /* CYCLE  */
+    DATABASE = 340,                /* DATABASE  */
+    DAY_P = 341,                   /* DAY_P  */
+    DEALLOCATE = 342,              /* DEALLOCATE  */
+    DEC = 343,                     /* DEC  */
+    DECIMAL_P = 344,               /* DECIMAL_P  */
+    DECLARE = 345,                 /* DECLARE  */
+    DEFAULT = 346,                 /* DEFAULT  */
+    DEFAULTS = 347,                /* DEFAULTS  */
+    DEFERRABLE = 348,              /* DEFERRABLE  */
+    DEFERRED = 349,                /* DEFERRED  */
+    DEFINER = 350,                 /* DEFINER  */
+    DELETE_P = 351,                /* DELETE_P  */
+    DELIMITER = 352,               /* DELIMITER  */
+    DELIMITERS = 353,              /* DELIMITERS  */
+    DESC = 354,                    /* DESC  */
+    DICTIONARY = 355,              /* DICTIONARY  */
+    DISABLE_P = 356,               /* DISABLE_P  */
+    DISCARD = 357,                 /* DISCARD  */
+    DISTINCT = 358,                /* DISTINCT  */
+    DO = 359,                      /* DO  */
+    DOCUMENT_P = 360,              /* DOCUMENT_P  */
+    DOMAIN_P = 361,                /* DOMAIN_P  */
+    DOUBLE_P = 362,                /* DOUBLE_P  */
+    DROP = 363,                    /* DROP  */
+    EACH = 364,                    /* EACH  */
+    ELSE = 365,                    /* ELSE  */
+    ENABLE_P = 366,                /* ENABLE_P  */
+    ENCODING = 367,                /* ENCODING  */
+    ENCRYPTED = 368,               /* ENCRYPTED  */
+    END_P = 369,                   /* END_P  */
+    ENUM_P = 370,                  /* ENUM_P  */
+    ESCAPE = 371,                  /* ESCAPE  */
+    EXCEPT = 372,                  /* EXCEPT  */
+    EXCLUDING = 373,               /* EXCLUDING  */
+    EXCLUSIVE = 374,               /* EXCLUSIVE  */
+    EXECUTE = 375,                 /* EXECUTE  */
+    EXISTS = 376,                  /* EXISTS  */
+    EXPLAIN = 377,                 /* EXPLAIN  */
+    EXTERNAL = 378,                /* EXTERNAL  */
+    EXTRACT = 379,                 /* EXTRACT  */
+    FALSE_P = 380,                 /* FALSE_P  */
+    FAMILY = 381,                  /* FAMILY  */
+    FETCH = 382,                   /* FETCH  */
+    FIRST_P = 383,                 /* FIRST_P  */
+    FLOAT_P = 384,                 /* FLOAT_P  */
+    FOR = 385,                     /* FOR  */
+    FORCE = 386,                   /* FORCE  */
+    FOREIGN = 387,                 /* FOREIGN  */
+    FORMAT = 388,                  /* FORMAT  */
+    FORWARD = 389,                 /* FORWARD  */
+    FREEZE = 390,                  /* FREEZE  */
+    FROM = 391,                    /* FROM  */
+    FULL = 392,                    /* FULL  */
+    FUNCTION = 393,                /* FUNCTION  */
+    GLOBAL = 394,                  /* GLOBAL  */
+    GRANT = 395,                   /* GRANT  */
+    GRANTED = 396,                 /* GRANTED  */
+    GRAPH = 397,                   /* GRAPH  */
+    GREATEST = 398,                /* GREATEST  */
+    GROUP_P = 399,                 /* GROUP_P  */
+    HANDLER = 400,                 /* HANDLER  */
+    HAVING = 401,                  /* HAVING  */
+    HEADER_P = 402,                /* HEADER_P  */
+    HOLD = 403,                    /* HOLD  */
+    HOUR_P = 404,                  /* HOUR_P  */
+    IF_P = 405,                    /* IF_P  */
+    ILIKE = 406,                   /* ILIKE  */
+    IMMEDIATE = 407,               /* IMMEDIATE  */
+    IMMUTABLE = 408,               /* IMMUTABLE  */
+    IMPLICIT_P = 409,              /* IMPLICIT_P  */
+    IN_P = 410,                    /* IN_P  */
+    INCLUDING = 411,               /* INCLUDING  */
+    INCREMENT = 412,               /* INCREMENT  */
+    INDEX = 413,                   /* INDEX  */
+    INDEXES = 414,                 /* INDEXES  */
+    INFLUENCE = 415,               /* INFLUENCE  */
+    INHERIT = 416,                 /* INHERIT  */
+    INHERITS = 417,                /* INHERITS  */
+    INITIALLY = 418,               /* INITIALLY  */
+    INNER_P = 419,                 /* INNER_P  */
+    INOUT = 420,                   /* INOUT  */
+    INPUT_P = 421,                 /* INPUT_P  */
+    INSENSITIVE = 422,             /* INSENSITIVE  */
+    INSERT = 423,                  /* INSERT  */
+    INSTEAD = 424,                 /* INSTEAD  */
+    INT_P = 425,                   /* INT_P  */
+    INTEGER = 426,                 /* INTEGER  */
+    INTERSECT = 427,               /* INTERSECT  */
+    INTERVAL = 428,                /* INTERVAL  */
+    INTO = 429,                    /* INTO  */
+    INVOKER = 430,                 /* INVOKER  */
+    IS = 431,                      /* IS  */
+    ISNULL = 432,                  /* ISNULL  */
+    ISOLATION = 433,               /* ISOLATION  */
+    JOIN = 434,                    /* JOIN  */
+    KEY = 435,                     /* KEY  */
+    LANCOMPILER = 436,             /* LANCOMPILER  */
+    LANGUAGE = 437,                /* LANGUAGE  */
+    LARGE_P = 438,                 /* LARGE_P  */
+    LAST_P = 439,                  /* LAST_P  */
+    LEADING = 440,                 /* LEADING  */
+    LEAST = 441,                   /* LEAST  */
+    LEFT = 442,                    /* LEFT  */
+    LEVEL = 443,                   /* LEVEL  */
+    LIKE = 444,                    /* LIKE  */
+    LIMIT = 445,                   /* LIMIT  */
+    LISTEN = 446,                  /* LISTEN  */
+    LOAD = 447,                    /* LOAD  */
+    LOCAL = 448,                   /* LOCAL  */
+    LOCALTIME = 449,               /* LOCALTIME  */
+    LOCALTIMESTAMP = 450,          /* LOCALTIMESTAMP  */
+    LOCATION = 451,                /* LOCATION  */
+    LOCK_P = 452,                  /* LOCK_P  */
+    LOGIN_P = 453,                 /* LOGIN_P  */
+    MAPPING = 454,                 /* MAPPING  */
+    MAPPROV = 455,                 /* MAPPROV  */
+    MATCH = 456,                   /* MATCH  */
+    MATERIALIZED = 457,            /* MATERIALIZED  */
+    MAXVALUE = 458,                /* MAXVALUE  */
+    MINUTE_P = 459,                /* MINUTE_P  */
+    MINVALUE = 460,                /* MINVALUE  */
+    MODE = 461,                    /* MODE  */
+    MONTH_P = 462,                 /* MONTH_P  */
+    MOVE = 463,                    /* MOVE  */
+    NAME_P = 464,                  /* NAME_P  */
+    NAMES = 465,                   /* NAMES  */
+    NATIONAL = 466,                /* NATIONAL  */
+    NATURAL = 467,                 /* NATURAL  */
+    NCHAR = 468,                   /* NCHAR  */
+    NEW = 469,                     /* NEW  */
+    NEXT = 470,                    /* NEXT  */
+    NO = 471,                      /* NO  */
+    NOCREATEDB = 472,              /* NOCREATEDB  */
+    NOCREATEROLE = 473,            /* NOCREATEROLE  */
+    NOCREATEUSER = 474,            /* NOCREATEUSER  */
+    NOINHERIT = 475,               /* NOINHERIT  */
+    NOLOGIN_P = 476,               /* NOLOGIN_P  */
+    NONE = 477,                    /* NONE  */
+    NORMALIZED = 478,              /* NORMALIZED  */
+    NOSUPERUSER = 479,             /* NOSUPERUSER  */
+    NOT = 480,                     /* NOT  */
+    NOTHING = 481,                 /* NOTHING  */
+    NOTIFY = 482,                  /* NOTIFY  */
+    NOTNULL = 483,                 /* NOTNULL  */
+    NOTTRANSITIVE = 484,           /* NOTTRANSITIVE  */
+    NOWAIT = 485,                  /* NOWAIT  */
+    NULL_P = 486,                  /* NULL_P  */
+    NULLIF = 487,                  /* NULLIF  */
+    NULLS_P = 488,                 /* NULLS_P  */
+    NUMERIC = 489,                 /* NUMERIC  */
+    OBJECT_P = 490,                /* OBJECT_P  */
+    OF = 491,                      /* OF  */
+    OFF = 492,                     /* OFF  */
+    OFFSET = 493,                  /* OFFSET  */
+    OIDS = 494,                    /* OIDS  */
+    OLD = 495,                     /* OLD  */
+    ON = 496,                      /* ON  */
+    ONLY = 497,                    /* ONLY  */
+    OPERATOR = 498,                /* OPERATOR  */
+    OPTION = 499,                  /* OPTION  */
+    OR = 500,                      /* OR  */
+    ORDER = 501,                   /* ORDER  */
+    OUT_P = 502,                   /* OUT_P  */
+    OUTER_P = 503,                 /* OUTER_P  */
+    OVERLAPS = 504,                /* OVERLAPS  */
+    OVERLAY = 505,                 /* OVERLAY  */
+    OWNED = 506,                   /* OWNED  */
+    OWNER = 507,                   /* OWNER  */
+    PARSER = 508,                  /* PARSER  */
+    PARTIAL = 509,                 /* PARTIAL  */
+    PASSWORD = 510,                /* PASSWORD  */
+    PLACING = 511,                 /* PLACING  */
+    PLANS = 512,                   /* PLANS  */
+    POSITION = 513,                /* POSITION  */
+    PRECISION = 514,               /* PRECISION  */
+    PRESERVE = 515,                /* PRESERVE  */
+    PREPARE = 516,                 /* PREPARE  */
+    PREPARED = 517,                /* PREPARED  */
+    PRIMARY = 518,                 /* PRIMARY  */
+    PRIOR = 519,                   /* PRIOR  */
+    PRIVILEGES = 520,              /* PRIVILEGES  */
+    PROCEDURAL = 521,              /* PROCEDURAL  */
+    PROCEDURE = 522,               /* PROCEDURE  */
+    PROVENANCE = 523,              /* PROVENANCE  */
+    QUOTE = 524,                   /* QUOTE  */
+    READ = 525,                    /* READ  */
+    REAL = 526,                    /* REAL  */
+    REASSIGN = 527,                /* REASSIGN  */
+    RECHECK = 528,                 /* RECHECK  */
+    REFERENCES = 529,              /* REFERENCES  */
+    REINDEX = 530,                 /* REINDEX  */
+    RELATIVE_P = 531,              /* RELATIVE_P  */
+    RELEASE = 532,                 /* RELEASE  */
+    RENAME = 533,                  /* RENAME  */
+    REPEATABLE = 534,              /* REPEATABLE  */
+    REPLACE = 535,                 /* REPLACE  */
+    REPLICA = 536,                 /* REPLICA  */
+    RESET = 537,                   /* RESET  */
+    RESTART = 538,                 /* RESTART  */
+    RESTRICT = 539,                /* RESTRICT  */
+    RETURNING = 540,               /* RETURNING  */
+    RETURNS = 541,                 /* RETURNS  */
+    REVOKE = 542,                  /* REVOKE  */
+    RIGHT = 543,                   /* RIGHT  */
+    ROLE = 544,                    /* ROLE  */
+    ROLLBACK = 545,                /* ROLLBACK  */
+    ROW = 546,                     /* ROW  */
+    ROWS = 547,                    /* ROWS  */
+    RULE = 548,                    /* RULE  */
+    SAVEPOINT = 549,               /* SAVEPOINT  */
+    SCHEMA = 550,                  /* SCHEMA  */
+    SCROLL = 551,                  /* SCROLL  */
+    SEARCH = 552,                  /* SEARCH  */
+    SECOND_P = 553,                /* SECOND_P  */
+    SECURITY = 554,                /* SECURITY  */
+    SELECT = 555,                  /* SELECT  */
+    SEQUENCE = 556,                /* SEQUENCE  */
+    SERIALIZABLE = 557,            /* SERIALIZABLE  */
+    SESSION = 558,                 /* SESSION  */
+    SESSION_USER = 559,            /* SESSION_USER  */
+    SET = 560,                     /* SET  */
+    SETOF = 561,                   /* SETOF  */
+    SHARE = 562,                   /* SHARE  */
+    SHOW = 563,                    /* SHOW  */
+    SIMILAR = 564,                 /* SIMILAR  */
+    SIMPLE = 565,                  /* SIMPLE  */
+    SMALLINT = 566,                /* SMALLINT  */
+    SOME = 567,                    /* SOME  */
+    SQLTEXT = 568,                 /* SQLTEXT  */
+    SQLTEXTDB2 = 569,              /* SQLTEXTDB2  */
+    STABLE = 570,                  /* STABLE  */
+    STANDALONE_P = 571,            /* STANDALONE_P  */
+    START = 572,                   /* START  */
+    STATEMENT = 573,               /* STATEMENT  */
+    STATISTICS = 574,              /* STATISTICS  */
+    STDIN = 575,                   /* STDIN  */
+    STDOUT = 576,                  /* STDOUT  */
+    STORAGE = 577,                 /* STORAGE  */
+    STRICT_P = 578,                /* STRICT_P  */
+    STRIP_P = 579,                 /* STRIP_P  */
+    SUBSTRING = 580,               /* SUBSTRING  */
+    SUPERUSER_P = 581,             /* SUPERUSER_P  */
+    SYMMETRIC = 582,               /* SYMMETRIC  */
+    SYSID = 583,                   /* SYSID  */
+    SYSTEM_P = 584,                /* SYSTEM_P  */
+    TABLE = 585,                   /* TABLE  */
+    TABLESPACE = 586,              /* TABLESPACE  */
+    TEMP = 587,                    /* TEMP  */
+    TEMPLATE = 588,                /* TEMPLATE  */
+    TEMPORARY = 589,               /* TEMPORARY  */
+    TEXT_P = 590,                  /* TEXT_P  */
+    THEN = 591,                    /* THEN  */
+    THIS = 592,                    /* THIS  */
+    TIME = 593,                    /* TIME  */
+    TIMESTAMP = 594,               /* TIMESTAMP  */
+    TO = 595,                      /* TO  */
+    TRAILING = 596,                /* TRAILING  */
+    TRANSACTION = 597,             /* TRANSACTION  */
+    TRANSITIVE = 598,              /* TRANSITIVE  */
+    TRANSPROV = 599,               /* TRANSPROV  */
+    TRANSSQL = 600,                /* TRANSSQL  */
+    TRANSXML = 601,                /* TRANSXML  */
+    TREAT = 602,                   /* TREAT  */
+    TRIGGER = 603,                 /* TRIGGER  */
+    TRIM = 604,                    /* TRIM  */
+    TRUE_P = 605,                  /* TRUE_P  */
+    TRUNCATE = 606,                /* TRUNCATE  */
+    TRUSTED = 607,                 /* TRUSTED  */
+    TUPLEID = 608,                 /* TUPLEID  */
+    TYPE_P = 609,                  /* TYPE_P  */
+    UNCOMMITTED = 610,             /* UNCOMMITTED  */
+    UNENCRYPTED = 611,             /* UNENCRYPTED  */
+    UNION = 612,                   /* UNION  */
+    UNIQUE = 613,                  /* UNIQUE  */
+    UNKNOWN = 614,                 /* UNKNOWN  */
+    UNLISTEN = 615,                /* UNLISTEN  */
+    UNTIL = 616,                   /* UNTIL  */
+    UPDATE = 617,                  /* UPDATE  */
+    USER = 618,                    /* USER  */
+    USING = 619,                   /* USING  */
+    VACUUM = 620,                  /* VACUUM  */
+    VALID = 621,                   /* VALID  */
+    VALIDATOR = 622,               /* VALIDATOR  */
+    VALUE_P = 623,                 /* VALUE_P  */
+    VALUES = 624,                  /* VALUES  */
+    VARCHAR = 625,                 /* VARCHAR  */
+    VARYING = 626,                 /* VARYING  */
+    VERBOSE = 627,                 /* VERBOSE  */
+    VERSION_P = 628,               /* VERSION_P  */
+    VIEW = 629,                    /* VIEW  */
+    VOLATILE = 630,                /* VOLATILE  */
+    WHEN = 631,                    /* WHEN  */
+    WHERE = 632,                   /* WHERE  */
+    WHITESPACE_P = 633,            /* WHITESPACE_P  */
+    WITH = 634,                    /* WITH  */
+    WITHOUT = 635,                 /* WITHOUT  */
+    WORK = 636,                    /* WORK  */
+    WRITE = 637,                   /* WRITE  */
+    XML_P = 638,                   /* XML_P  */
+    XMLATTRIBUTES = 639,           /* XMLATTRIBUTES  */
+    XMLCONCAT = 640,               /* XMLCONCAT  */
+    XMLELEMENT = 641,              /* XMLELEMENT  */
+    XMLFOREST = 642,               /* XMLFOREST  */
+    XMLPARSE = 643,                /* XMLPARSE  */
+    XMLPI = 644,                   /* XMLPI  */
+    XMLROOT = 645,                 /* XMLROOT  */
+    XMLSERIALIZE = 646,            /* XMLSERIALIZE  */
+    XSLT = 647,                    /* XSLT  */
+    YEAR_P = 648,                  /* YEAR_P  */
+    YES_P = 649,                   /* YES_P  */
+    ZONE = 650,                    /* ZONE  */
+    NULLS_FIRST = 651,             /* NULLS_FIRST  */
+    NULLS_LAST = 652,              /* NULLS_LAST  */
+    WITH_CASCADED = 653,           /* WITH_CASCADED  */
+    WITH_LOCAL = 654,              /* WITH_LOCAL  */
+    WITH_CHECK = 655,              /* WITH_CHECK  */
+    FORMAT_NORMALIZED = 656,       /* FORMAT_NORMALIZED  */
+    IDENT = 657,                   /* IDENT  */
+    FCONST = 658,                  /* FCONST  */
+    SCONST = 659,                  /* SCONST  */
+    BCONST = 660,                  /* BCONST  */
+    XCONST = 661,                  /* XCONST  */
+    Op = 662,                      /* Op  */
+    ICONST = 663,                  /* ICONST  */
+    PARAM = 664,                   /* PARAM  */
+    POSTFIXOP = 665,               /* POSTFIXOP  */
+    UMINUS = 666,                  /* UMINUS  */
+    TYPECAST = 667                 /* TYPECAST  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define ABORT_P 258
 #define ABSOLUTE_P 259
 #define ACCESS 260
@@ -577,289 +602,293 @@
 #define FOR 385
 #define FORCE 386
 #define FOREIGN 387
-#define FORWARD 388
-#define FREEZE 389
-#define FROM 390
-#define FULL 391
-#define FUNCTION 392
-#define GLOBAL 393
-#define GRANT 394
-#define GRANTED 395
-#define GRAPH 396
-#define GREATEST 397
-#define GROUP_P 398
-#define HANDLER 399
-#define HAVING 400
-#define HEADER_P 401
-#define HOLD 402
-#define HOUR_P 403
-#define IF_P 404
-#define ILIKE 405
-#define IMMEDIATE 406
-#define IMMUTABLE 407
-#define IMPLICIT_P 408
-#define IN_P 409
-#define INCLUDING 410
-#define INCREMENT 411
-#define INDEX 412
-#define INDEXES 413
-#define INFLUENCE 414
-#define INHERIT 415
-#define INHERITS 416
-#define INITIALLY 417
-#define INNER_P 418
-#define INOUT 419
-#define INPUT_P 420
-#define INSENSITIVE 421
-#define INSERT 422
-#define INSTEAD 423
-#define INT_P 424
-#define INTEGER 425
-#define INTERSECT 426
-#define INTERVAL 427
-#define INTO 428
-#define INVOKER 429
-#define IS 430
-#define ISNULL 431
-#define ISOLATION 432
-#define JOIN 433
-#define KEY 434
-#define LANCOMPILER 435
-#define LANGUAGE 436
-#define LARGE_P 437
-#define LAST_P 438
-#define LEADING 439
-#define LEAST 440
-#define LEFT 441
-#define LEVEL 442
-#define LIKE 443
-#define LIMIT 444
-#define LISTEN 445
-#define LOAD 446
-#define LOCAL 447
-#define LOCALTIME 448
-#define LOCALTIMESTAMP 449
-#define LOCATION 450
-#define LOCK_P 451
-#define LOGIN_P 452
-#define MAPPING 453
-#define MAPPROV 454
-#define MATCH 455
-#define MAXVALUE 456
-#define MINUTE_P 457
-#define MINVALUE 458
-#define MODE 459
-#define MONTH_P 460
-#define MOVE 461
-#define NAME_P 462
-#define NAMES 463
-#define NATIONAL 464
-#define NATURAL 465
-#define NCHAR 466
-#define NEW 467
-#define NEXT 468
-#define NO 469
-#define NOCREATEDB 470
-#define NOCREATEROLE 471
-#define NOCREATEUSER 472
-#define NOINHERIT 473
-#define NOLOGIN_P 474
-#define NONE 475
-#define NOSUPERUSER 476
-#define NOT 477
-#define NOTHING 478
-#define NOTIFY 479
-#define NOTNULL 480
-#define NOTTRANSITIVE 481
-#define NOWAIT 482
-#define NULL_P 483
-#define NULLIF 484
-#define NULLS_P 485
-#define NUMERIC 486
-#define OBJECT_P 487
-#define OF 488
-#define OFF 489
-#define OFFSET 490
-#define OIDS 491
-#define OLD 492
-#define ON 493
-#define ONLY 494
-#define OPERATOR 495
-#define OPTION 496
-#define OR 497
-#define ORDER 498
-#define OUT_P 499
-#define OUTER_P 500
-#define OVERLAPS 501
-#define OVERLAY 502
-#define OWNED 503
-#define OWNER 504
-#define PARSER 505
-#define PARTIAL 506
-#define PASSWORD 507
-#define PLACING 508
-#define PLANS 509
-#define POSITION 510
-#define PRECISION 511
-#define PRESERVE 512
-#define PREPARE 513
-#define PREPARED 514
-#define PRIMARY 515
-#define PRIOR 516
-#define PRIVILEGES 517
-#define PROCEDURAL 518
-#define PROCEDURE 519
-#define PROVENANCE 520
-#define QUOTE 521
-#define READ 522
-#define REAL 523
-#define REASSIGN 524
-#define RECHECK 525
-#define REFERENCES 526
-#define REINDEX 527
-#define RELATIVE_P 528
-#define RELEASE 529
-#define RENAME 530
-#define REPEATABLE 531
-#define REPLACE 532
-#define REPLICA 533
-#define RESET 534
-#define RESTART 535
-#define RESTRICT 536
-#define RETURNING 537
-#define RETURNS 538
-#define REVOKE 539
-#define RIGHT 540
-#define ROLE 541
-#define ROLLBACK 542
-#define ROW 543
-#define ROWS 544
-#define RULE 545
-#define SAVEPOINT 546
-#define SCHEMA 547
-#define SCROLL 548
-#define SEARCH 549
-#define SECOND_P 550
-#define SECURITY 551
-#define SELECT 552
-#define SEQUENCE 553
-#define SERIALIZABLE 554
-#define SESSION 555
-#define SESSION_USER 556
-#define SET 557
-#define SETOF 558
-#define SHARE 559
-#define SHOW 560
-#define SIMILAR 561
-#define SIMPLE 562
-#define SMALLINT 563
-#define SOME 564
-#define SQLTEXT 565
-#define SQLTEXTDB2 566
-#define STABLE 567
-#define STANDALONE_P 568
-#define START 569
-#define STATEMENT 570
-#define STATISTICS 571
-#define STDIN 572
-#define STDOUT 573
-#define STORAGE 574
-#define STRICT_P 575
-#define STRIP_P 576
-#define SUBSTRING 577
-#define SUPERUSER_P 578
-#define SYMMETRIC 579
-#define SYSID 580
-#define SYSTEM_P 581
-#define TABLE 582
-#define TABLESPACE 583
-#define TEMP 584
-#define TEMPLATE 585
-#define TEMPORARY 586
-#define TEXT_P 587
-#define THEN 588
-#define THIS 589
-#define TIME 590
-#define TIMESTAMP 591
-#define TO 592
-#define TRAILING 593
-#define TRANSACTION 594
-#define TRANSITIVE 595
-#define TRANSPROV 596
-#define TRANSSQL 597
-#define TRANSXML 598
-#define TREAT 599
-#define TRIGGER 600
-#define TRIM 601
-#define TRUE_P 602
-#define TRUNCATE 603
-#define TRUSTED 604
-#define TYPE_P 605
-#define UNCOMMITTED 606
-#define UNENCRYPTED 607
-#define UNION 608
-#define UNIQUE 609
-#define UNKNOWN 610
-#define UNLISTEN 611
-#define UNTIL 612
-#define UPDATE 613
-#define USER 614
-#define USING 615
-#define VACUUM 616
-#define VALID 617
-#define VALIDATOR 618
-#define VALUE_P 619
-#define VALUES 620
-#define VARCHAR 621
-#define VARYING 622
-#define VERBOSE 623
-#define VERSION_P 624
-#define VIEW 625
-#define VOLATILE 626
-#define WHEN 627
-#define WHERE 628
-#define WHITESPACE_P 629
-#define WITH 630
-#define WITHOUT 631
-#define WORK 632
-#define WRITE 633
-#define XML_P 634
-#define XMLATTRIBUTES 635
-#define XMLCONCAT 636
-#define XMLELEMENT 637
-#define XMLFOREST 638
-#define XMLPARSE 639
-#define XMLPI 640
-#define XMLROOT 641
-#define XMLSERIALIZE 642
-#define XSLT 643
-#define YEAR_P 644
-#define YES_P 645
-#define ZONE 646
-#define NULLS_FIRST 647
-#define NULLS_LAST 648
-#define WITH_CASCADED 649
-#define WITH_LOCAL 650
-#define WITH_CHECK 651
-#define IDENT 652
-#define FCONST 653
-#define SCONST 654
-#define BCONST 655
-#define XCONST 656
-#define Op 657
-#define ICONST 658
-#define PARAM 659
-#define POSTFIXOP 660
-#define UMINUS 661
-#define TYPECAST 662
-
-
-
+#define FORMAT 388
+#define FORWARD 389
+#define FREEZE 390
+#define FROM 391
+#define FULL 392
+#define FUNCTION 393
+#define GLOBAL 394
+#define GRANT 395
+#define GRANTED 396
+#define GRAPH 397
+#define GREATEST 398
+#define GROUP_P 399
+#define HANDLER 400
+#define HAVING 401
+#define HEADER_P 402
+#define HOLD 403
+#define HOUR_P 404
+#define IF_P 405
+#define ILIKE 406
+#define IMMEDIATE 407
+#define IMMUTABLE 408
+#define IMPLICIT_P 409
+#define IN_P 410
+#define INCLUDING 411
+#define INCREMENT 412
+#define INDEX 413
+#define INDEXES 414
+#define INFLUENCE 415
+#define INHERIT 416
+#define INHERITS 417
+#define INITIALLY 418
+#define INNER_P 419
+#define INOUT 420
+#define INPUT_P 421
+#define INSENSITIVE 422
+#define INSERT 423
+#define INSTEAD 424
+#define INT_P 425
+#define INTEGER 426
+#define INTERSECT 427
+#define INTERVAL 428
+#define INTO 429
+#define INVOKER 430
+#define IS 431
+#define ISNULL 432
+#define ISOLATION 433
+#define JOIN 434
+#define KEY 435
+#define LANCOMPILER 436
+#define LANGUAGE 437
+#define LARGE_P 438
+#define LAST_P 439
+#define LEADING 440
+#define LEAST 441
+#define LEFT 442
+#define LEVEL 443
+#define LIKE 444
+#define LIMIT 445
+#define LISTEN 446
+#define LOAD 447
+#define LOCAL 448
+#define LOCALTIME 449
+#define LOCALTIMESTAMP 450
+#define LOCATION 451
+#define LOCK_P 452
+#define LOGIN_P 453
+#define MAPPING 454
+#define MAPPROV 455
+#define MATCH 456
+#define MATERIALIZED 457
+#define MAXVALUE 458
+#define MINUTE_P 459
+#define MINVALUE 460
+#define MODE 461
+#define MONTH_P 462
+#define MOVE 463
+#define NAME_P 464
+#define NAMES 465
+#define NATIONAL 466
+#define NATURAL 467
+#define NCHAR 468
+#define NEW 469
+#define NEXT 470
+#define NO 471
+#define NOCREATEDB 472
+#define NOCREATEROLE 473
+#define NOCREATEUSER 474
+#define NOINHERIT 475
+#define NOLOGIN_P 476
+#define NONE 477
+#define NORMALIZED 478
+#define NOSUPERUSER 479
+#define NOT 480
+#define NOTHING 481
+#define NOTIFY 482
+#define NOTNULL 483
+#define NOTTRANSITIVE 484
+#define NOWAIT 485
+#define NULL_P 486
+#define NULLIF 487
+#define NULLS_P 488
+#define NUMERIC 489
+#define OBJECT_P 490
+#define OF 491
+#define OFF 492
+#define OFFSET 493
+#define OIDS 494
+#define OLD 495
+#define ON 496
+#define ONLY 497
+#define OPERATOR 498
+#define OPTION 499
+#define OR 500
+#define ORDER 501
+#define OUT_P 502
+#define OUTER_P 503
+#define OVERLAPS 504
+#define OVERLAY 505
+#define OWNED 506
+#define OWNER 507
+#define PARSER 508
+#define PARTIAL 509
+#define PASSWORD 510
+#define PLACING 511
+#define PLANS 512
+#define POSITION 513
+#define PRECISION 514
+#define PRESERVE 515
+#define PREPARE 516
+#define PREPARED 517
+#define PRIMARY 518
+#define PRIOR 519
+#define PRIVILEGES 520
+#define PROCEDURAL 521
+#define PROCEDURE 522
+#define PROVENANCE 523
+#define QUOTE 524
+#define READ 525
+#define REAL 526
+#define REASSIGN 527
+#define RECHECK 528
+#define REFERENCES 529
+#define REINDEX 530
+#define RELATIVE_P 531
+#define RELEASE 532
+#define RENAME 533
+#define REPEATABLE 534
+#define REPLACE 535
+#define REPLICA 536
+#define RESET 537
+#define RESTART 538
+#define RESTRICT 539
+#define RETURNING 540
+#define RETURNS 541
+#define REVOKE 542
+#define RIGHT 543
+#define ROLE 544
+#define ROLLBACK 545
+#define ROW 546
+#define ROWS 547
+#define RULE 548
+#define SAVEPOINT 549
+#define SCHEMA 550
+#define SCROLL 551
+#define SEARCH 552
+#define SECOND_P 553
+#define SECURITY 554
+#define SELECT 555
+#define SEQUENCE 556
+#define SERIALIZABLE 557
+#define SESSION 558
+#define SESSION_USER 559
+#define SET 560
+#define SETOF 561
+#define SHARE 562
+#define SHOW 563
+#define SIMILAR 564
+#define SIMPLE 565
+#define SMALLINT 566
+#define SOME 567
+#define SQLTEXT 568
+#define SQLTEXTDB2 569
+#define STABLE 570
+#define STANDALONE_P 571
+#define START 572
+#define STATEMENT 573
+#define STATISTICS 574
+#define STDIN 575
+#define STDOUT 576
+#define STORAGE 577
+#define STRICT_P 578
+#define STRIP_P 579
+#define SUBSTRING 580
+#define SUPERUSER_P 581
+#define SYMMETRIC 582
+#define SYSID 583
+#define SYSTEM_P 584
+#define TABLE 585
+#define TABLESPACE 586
+#define TEMP 587
+#define TEMPLATE 588
+#define TEMPORARY 589
+#define TEXT_P 590
+#define THEN 591
+#define THIS 592
+#define TIME 593
+#define TIMESTAMP 594
+#define TO 595
+#define TRAILING 596
+#define TRANSACTION 597
+#define TRANSITIVE 598
+#define TRANSPROV 599
+#define TRANSSQL 600
+#define TRANSXML 601
+#define TREAT 602
+#define TRIGGER 603
+#define TRIM 604
+#define TRUE_P 605
+#define TRUNCATE 606
+#define TRUSTED 607
+#define TUPLEID 608
+#define TYPE_P 609
+#define UNCOMMITTED 610
+#define UNENCRYPTED 611
+#define UNION 612
+#define UNIQUE 613
+#define UNKNOWN 614
+#define UNLISTEN 615
+#define UNTIL 616
+#define UPDATE 617
+#define USER 618
+#define USING 619
+#define VACUUM 620
+#define VALID 621
+#define VALIDATOR 622
+#define VALUE_P 623
+#define VALUES 624
+#define VARCHAR 625
+#define VARYING 626
+#define VERBOSE 627
+#define VERSION_P 628
+#define VIEW 629
+#define VOLATILE 630
+#define WHEN 631
+#define WHERE 632
+#define WHITESPACE_P 633
+#define WITH 634
+#define WITHOUT 635
+#define WORK 636
+#define WRITE 637
+#define XML_P 638
+#define XMLATTRIBUTES 639
+#define XMLCONCAT 640
+#define XMLELEMENT 641
+#define XMLFOREST 642
+#define XMLPARSE 643
+#define XMLPI 644
+#define XMLROOT 645
+#define XMLSERIALIZE 646
+#define XSLT 647
+#define YEAR_P 648
+#define YES_P 649
+#define ZONE 650
+#define NULLS_FIRST 651
+#define NULLS_LAST 652
+#define WITH_CASCADED 653
+#define WITH_LOCAL 654
+#define WITH_CHECK 655
+#define FORMAT_NORMALIZED 656
+#define IDENT 657
+#define FCONST 658
+#define SCONST 659
+#define BCONST 660
+#define XCONST 661
+#define Op 662
+#define ICONST 663
+#define PARAM 664
+#define POSTFIXOP 665
+#define UMINUS 666
+#define TYPECAST 667
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 118 "gram.y"
+union YYSTYPE
 {
+#line 118 "gram.y"
+
 	int					ival;
 	char				chr;
 	char				*str;
@@ -890,28 +919,34 @@ typedef union YYSTYPE
 
 	InsertStmt			*istmt;
 	VariableSetStmt		*vsetstmt;
-}
-/* Line 1489 of yacc.c.  */
-#line 896 "y.tab.h"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 924 "y.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE base_yylval;
-
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
+
+extern YYSTYPE base_yylval;
 extern YYLTYPE base_yylloc;
+
+int base_yyparse (void);
+
+
+#endif /* !YY_BASE_YY_Y_TAB_H_INCLUDED  */
@@ -1292,7 +1292,9 @@ expandProvenanceRTE (RangeTblEntry *rte, List **colnames, List **colvars, Index
 		curCols = NIL;
 		curVars = NIL;
 
-		if (curRTE->rtekind == RTE_RELATION)
+		if (ContributionType(rte->subquery) == CONTR_TUPLEID)
+			expandProvBaseRelation(curRTE, 1, true, &curCols, &curVars);
+		else if (curRTE->rtekind == RTE_RELATION)
 			expandRelation(curRTE->relid, curRTE->eref, 1, 0, false, &curCols, &curVars);
 		else
 			expandRTEWithParam (curRTE, rtindex, 0, false, false, &curCols, &curVars);
@@ -1399,6 +1401,7 @@ expandRTEWithParam (RangeTblEntry *rte, int rtindex, int sublevels_up,
 						case CONTR_COPY_PARTIAL_TRANSITIVE:
 						case CONTR_COPY_PARTIAL_NONTRANSITIVE:
 						case CONTR_INFLUENCE:
+						case CONTR_TUPLEID:
 							expandProvenanceRTE(rte, colnames, colvars, rtindex);
 						break;
 						case CONTR_TRANS_SET:
@@ -1620,6 +1623,7 @@ addProvenanceTEs (RangeTblEntry *rte) {
 		case CONTR_COPY_PARTIAL_TRANSITIVE:
 		case CONTR_COPY_PARTIAL_NONTRANSITIVE:
 		case CONTR_INFLUENCE:
+		case CONTR_TUPLEID:
 			expandProvenanceRTE(rte, &names, &provVars, 1);
 		break;
 		case CONTR_TRANS_SET:
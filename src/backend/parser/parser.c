@@ -33,6 +33,26 @@ static int	lookahead_token;	/* one-token lookahead */
 static YYSTYPE lookahead_yylval;	/* yylval for lookahead token */
 static YYLTYPE lookahead_yylloc;	/* yylloc for lookahead token */
 
+/*
+ * Position of the filter in a "SELECT [ANNOT (...)] PROVENANCE [ON
+ * CONTRIBUTION (...)]" clause, FORMAT NORMALIZED is only combined into one
+ * token directly after such a clause
+ */
+typedef enum
+{
+	PROV_CLAUSE_NONE,			/* not in a SELECT PROVENANCE clause */
+	PROV_CLAUSE_SELECT,			/* after SELECT [ANNOT (...)] */
+	PROV_CLAUSE_ANNOT,			/* within ANNOT (...) */
+	PROV_CLAUSE_PROVENANCE,		/* after PROVENANCE [ON CONTRIBUTION (...)] */
+	PROV_CLAUSE_ON,				/* after PROVENANCE ON */
+	PROV_CLAUSE_CONTRIBUTION,	/* after PROVENANCE ON CONTRIBUTION */
+	PROV_CLAUSE_TYPE			/* within ON CONTRIBUTION (...) */
+} ProvClauseState;
+
+static ProvClauseState prov_clause;
+
+static ProvClauseState next_prov_clause_state(ProvClauseState state, int token);
+
 
 /*
  * raw_parser
@@ -47,6 +67,7 @@ raw_parser(const char *str)
 
 	parsetree = NIL;			/* in case grammar forgets to set it */
 	have_lookahead = false;
+	prov_clause = PROV_CLAUSE_NONE;
 
 	scanner_init(str);
 	parser_init();
@@ -165,9 +186,82 @@ filtered_base_yylex(void)
 			}
 			break;
 
+		case FORMAT:
+
+			/*
+			 * FORMAT NORMALIZED must be reduced to one token, because FORMAT
+			 * may also start the target list of a SELECT PROVENANCE.  FORMAT
+			 * is an ordinary identifier anywhere else.
+			 */
+			if (prov_clause != PROV_CLAUSE_PROVENANCE)
+				break;
+
+			cur_yylval = base_yylval;
+			cur_yylloc = base_yylloc;
+			next_token = base_yylex();
+			switch (next_token)
+			{
+				case NORMALIZED:
+					cur_token = FORMAT_NORMALIZED;
+					break;
+				default:
+					/* save the lookahead token for next time */
+					lookahead_token = next_token;
+					lookahead_yylval = base_yylval;
+					lookahead_yylloc = base_yylloc;
+					have_lookahead = true;
+					/* and back up the output info to cur_token */
+					base_yylval = cur_yylval;
+					base_yylloc = cur_yylloc;
+					break;
+			}
+			break;
+
 		default:
 			break;
 	}
 
+	prov_clause = next_prov_clause_state(prov_clause, cur_token);
+
 	return cur_token;
 }
+
+/*
+ * Compute the position in a SELECT PROVENANCE clause after token
+ */
+static ProvClauseState
+next_prov_clause_state(ProvClauseState state, int token)
+{
+	if (token == SELECT)
+		return PROV_CLAUSE_SELECT;
+
+	switch (state)
+	{
+		case PROV_CLAUSE_SELECT:
+			if (token == ANNOT)
+				return PROV_CLAUSE_ANNOT;
+			if (token == PROVENANCE)
+				return PROV_CLAUSE_PROVENANCE;
+			break;
+		case PROV_CLAUSE_ANNOT:
+			return (token == ')') ? PROV_CLAUSE_SELECT : PROV_CLAUSE_ANNOT;
+		case PROV_CLAUSE_PROVENANCE:
+			if (token == ON)
+				return PROV_CLAUSE_ON;
+			break;
+		case PROV_CLAUSE_ON:
+			if (token == CONTRIBUTION)
+				return PROV_CLAUSE_CONTRIBUTION;
+			break;
+		case PROV_CLAUSE_CONTRIBUTION:
+			if (token == '(')
+				return PROV_CLAUSE_TYPE;
+			break;
+		case PROV_CLAUSE_TYPE:
+			return (token == ')') ? PROV_CLAUSE_PROVENANCE : PROV_CLAUSE_TYPE;
+		default:
+			break;
+	}
+
+	return PROV_CLAUSE_NONE;
+}
@@ -104,6 +104,13 @@ bool		pgstat_track_counts = false;
  */
 PgStat_MsgBgWriter BgWriterStats;
 
+/*
+ * Provenance rewrite statistics counters of this backend, updated by
+ * provrewrite/main/prov_stats.c and sent with the table statistics.
+ * We assume this inits to zeroes.
+ */
+PgStat_MsgProvenance ProvenanceStats;
+
 /* ----------
  * Local data
  * ----------
@@ -222,6 +229,7 @@ static void pgstat_recv_autovac(PgStat_MsgAutovacStart *msg, int len);
 static void pgstat_recv_vacuum(PgStat_MsgVacuum *msg, int len);
 static void pgstat_recv_analyze(PgStat_MsgAnalyze *msg, int len);
 static void pgstat_recv_bgwriter(PgStat_MsgBgWriter *msg, int len);
+static void pgstat_recv_provenance(PgStat_MsgProvenance *msg, int len);
 
 
 /* ------------------------------------------------------------
@@ -613,6 +621,7 @@ pgstat_report_tabstat(bool force)
 {
 	/* we assume this inits to all zeroes: */
 	static const PgStat_TableCounts all_zeroes;
+	static const PgStat_MsgProvenance prov_all_zeroes;
 	static TimestampTz last_report = 0;
 
 	TimestampTz now;
@@ -622,8 +631,10 @@ pgstat_report_tabstat(bool force)
 	int			i;
 
 	/* Don't expend a clock check if nothing to do */
-	if (pgStatTabList == NULL ||
-		pgStatTabList->tsa_used == 0)
+	if ((pgStatTabList == NULL ||
+		 pgStatTabList->tsa_used == 0) &&
+		memcmp(&ProvenanceStats, &prov_all_zeroes,
+			   sizeof(PgStat_MsgProvenance)) == 0)
 		return;
 
 	/*
@@ -636,6 +647,9 @@ pgstat_report_tabstat(bool force)
 		return;
 	last_report = now;
 
+	/* send the provenance rewrite statistics of this backend */
+	pgstat_send_provenance();
+
 	/*
 	 * Scan through the TabStatusArray struct(s) to find tables that actually
 	 * have counts, and build messages to send.  We have to separate shared
@@ -2116,6 +2130,31 @@ pgstat_send_bgwriter(void)
 	MemSet(&BgWriterStats, 0, sizeof(BgWriterStats));
 }
 
+/* ----------
+ * pgstat_send_provenance() -
+ *
+ *		Send provenance rewrite statistics to the collector
+ * ----------
+ */
+void
+pgstat_send_provenance(void)
+{
+	/* We assume this initializes to zeroes */
+	static const PgStat_MsgProvenance all_zeroes;
+
+	if (memcmp(&ProvenanceStats, &all_zeroes, sizeof(PgStat_MsgProvenance)) == 0)
+		return;
+
+	/* counts are discarded if they are not collected */
+	if (pgstat_track_counts)
+	{
+		pgstat_setheader(&ProvenanceStats.m_hdr, PGSTAT_MTYPE_PROVENANCE);
+		pgstat_send(&ProvenanceStats, sizeof(ProvenanceStats));
+	}
+
+	MemSet(&ProvenanceStats, 0, sizeof(ProvenanceStats));
+}
+
 
 /* ----------
  * PgstatCollectorMain() -
@@ -2368,6 +2407,10 @@ PgstatCollectorMain(int argc, char *argv[])
 					pgstat_recv_bgwriter((PgStat_MsgBgWriter *) &msg, len);
 					break;
 
+				case PGSTAT_MTYPE_PROVENANCE:
+					pgstat_recv_provenance((PgStat_MsgProvenance *) &msg, len);
+					break;
+
 				default:
 					break;
 			}
@@ -3170,3 +3213,23 @@ pgstat_recv_bgwriter(PgStat_MsgBgWriter *msg, int len)
 	globalStats.buf_written_backend += msg->m_buf_written_backend;
 	globalStats.buf_alloc += msg->m_buf_alloc;
 }
+
+/* ----------
+ * pgstat_recv_provenance() -
+ *
+ *	Process a PROVENANCE message.
+ * ----------
+ */
+static void
+pgstat_recv_provenance(PgStat_MsgProvenance *msg, int len)
+{
+	int			i;
+
+	for (i = 0; i < PGSTAT_NUM_PROV_PHASES; i++)
+	{
+		globalStats.prov_calls[i] += msg->m_calls[i];
+		globalStats.prov_time[i] += msg->m_time[i];
+	}
+	globalStats.prov_nodes += msg->m_nodes;
+	globalStats.prov_bytes += msg->m_bytes;
+}
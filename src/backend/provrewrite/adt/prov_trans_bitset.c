@@ -24,14 +24,22 @@
  *		stores the string representation we want to generate and mapping between indexes
  *		into this string and parts of the query. Thus, the representation function just
  *		has to traverse this structure and copy parts to the output and add the <NOT>-
- *		annotations if necessary.
+ *		annotations if necessary. The TransRepQueryInfo structures are hashed by
+ *		their query id. Typically most result tuples of a query share only a few
+ *		distinct bitsets, therefore each TransRepQueryInfo caches the
+ *		representations it has generated so far hashed by the bitset.
  *
  *-------------------------------------------------------------------------
  */
 
 #include "postgres.h"
 
+#include "access/hash.h"
+#include "catalog/pg_type.h"
 #include "fmgr.h"
+#include "nodes/execnodes.h"
+#include "utils/array.h"
+#include "utils/datum.h"
 #include "utils/varbit.h"
 #include "utils/memutils.h"
 
@@ -47,38 +55,47 @@
 
 
 
-/* macro to return one of the bitor_with_null function arguments */
-#define BITARG_RETURN(arg, result) \
-	do { \
-		result = (VarBit *) palloc(VARSIZE(arg)); \
-		SET_VARSIZE(result, VARSIZE(arg)); \
-		VARBITLEN(result) = VARBITLEN(arg); \
-		p1 = VARBITS(arg); \
-		r = VARBITS(result); \
-		for (; p1 < VARBITEND(arg); p1++) \
-			*r++ = *p1; \
-		mask = BITMASK << VARBITPAD(result); \
-		if (mask) \
-		{ \
-			r--; \
-			*r &= mask; \
-		} \
-		PG_RETURN_VARBIT_P(result); \
-	} while (0)
+/* entry of the hash table that maps query ids to TransRepQueryInfos */
+typedef struct TransRepIndexEntry
+{
+	Index queryId;				/* hash key */
+	TransRepQueryInfo *info;
+} TransRepIndexEntry;
+
+/*
+ * Entry of the cache of generated representations. Entries are hashed on the
+ * hash value of the bitset, collisions are detected by comparing the bitsets.
+ */
+typedef struct TransRepCacheEntry
+{
+	uint32 hash;				/* hash value of set (hash key) */
+	VarBit *set;
+	text *rep;
+} TransRepCacheEntry;
+
+/* maximal number of cached representations per query */
+#define MAX_CACHED_REPS 1024
 
 /* global data and consts */
-static const char *NOT_STRING = "<NOT>";
-static const char *CLOSE_NOT_STRING = "</NOT>";
+static const char NOT_STRING[] = "<NOT>";
+static const char CLOSE_NOT_STRING[] = "</NOT>";
+
+#define NOT_STRING_LEN (sizeof(NOT_STRING) - 1)
+#define CLOSE_NOT_STRING_LEN (sizeof(CLOSE_NOT_STRING) - 1)
 
 MemoryContext funcPrivateContext = NULL;
 TransRepQueryIndex *transProvQueryIndex = NULL;
 int queryId = 0;
 
 /* Functions declarations */
-static char *generateTransProvRep (VarBit *bitset, Index queryId);
+static text *getRepresentation (VarBit *bitset, Index queryId, bool mapRep);
+static TransRepQueryInfo *getQueryRepInfo (Index queryId);
+static char *generateTransProvRep (VarBit *bitset, TransRepQueryInfo *queryInfo);
+static void bitsetOrWords (bits8 *result, bits8 *left, bits8 *right, int nbytes);
 static bool bitsetContains (VarBit *left, VarBit *right);
 static bool bitsetEqual (VarBit *left, VarBit* right);
-static char *generateMapRep (VarBit *bitset, Index queryId);
+static char *generateMapRep (VarBit *bitset, TransRepQueryInfo *queryInfo);
+static TransRepQueryInfo *createQueryRepInfo (char *cursorName);
 static void listRemoveQueryInfoCell (List **list, ListCell *cell, ListCell *before);
 static void freeQueryRepInfo (TransRepQueryInfo *info);
 
@@ -87,6 +104,11 @@ static void freeQueryRepInfo (TransRepQueryInfo *info);
  * the other one is returned unmodified. This behavior is needed by transformation
  * provenance rewrites for e.g. LEFT JOIN to omit adding additional joins.
  *
+ * This function is also the transition function of the bitoragg aggregate. If
+ * called by nodeAgg the first argument is the transition value which we are
+ * allowed to modify (see int8inc). In this case the second argument is OR'ed
+ * into the transition value in-place, so no memory is allocated per input row.
+ *
  * 		Arguments: varbit, varbit
  */
 
@@ -96,14 +118,6 @@ bitor_with_null(PG_FUNCTION_ARGS)
 	VarBit	   *arg1;
 	VarBit	   *arg2;
 	VarBit	   *result;
-	int			len,
-				bitlen1,
-				bitlen2,
-				i;
-	bits8	   *p1,
-			   *p2,
-			   *r;
-	bits8		mask;
 
 	/* check if one or both arguments are NULL */
 	if (PG_ARGISNULL(0))
@@ -111,43 +125,31 @@ bitor_with_null(PG_FUNCTION_ARGS)
 		if (PG_ARGISNULL(1))
 			PG_RETURN_NULL();
 
-		arg2 = PG_GETARG_VARBIT_P(1);
-		BITARG_RETURN(arg2, result);
+		PG_RETURN_VARBIT_P(PG_GETARG_VARBIT_P(1));
 	}
 	else if (PG_ARGISNULL(1))
-	{
-		arg1 = PG_GETARG_VARBIT_P(0);
-		BITARG_RETURN(arg1, result);
-	}
+		PG_RETURN_VARBIT_P(PG_GETARG_VARBIT_P(0));
 
-	/* both args are not OR them */
+	/* both args are not NULL, OR them */
 	arg1 = PG_GETARG_VARBIT_P(0);
 	arg2 = PG_GETARG_VARBIT_P(1);
-	bitlen1 = VARBITLEN(arg1);
-	bitlen2 = VARBITLEN(arg2);
-	if (bitlen1 != bitlen2)
+	if (VARBITLEN(arg1) != VARBITLEN(arg2))
 		ereport(ERROR,
 				(errcode(ERRCODE_STRING_DATA_LENGTH_MISMATCH),
 				 errmsg("cannot OR bit strings of different sizes")));
-	len = VARSIZE(arg1);
-	result = (VarBit *) palloc(len);
-	SET_VARSIZE(result, len);
-	VARBITLEN(result) = bitlen1;
 
-	p1 = VARBITS(arg1);
-	p2 = VARBITS(arg2);
-	r = VARBITS(result);
-	for (i = 0; i < VARBITBYTES(arg1); i++)
-		*r++ = *p1++ | *p2++;
-
-	/* Pad the result */
-	mask = BITMASK << VARBITPAD(result);
-	if (mask)
+	if (fcinfo->context && IsA(fcinfo->context, AggState))
+		result = arg1;
+	else
 	{
-		r--;
-		*r &= mask;
+		result = (VarBit *) palloc(VARSIZE(arg1));
+		SET_VARSIZE(result, VARSIZE(arg1));
+		VARBITLEN(result) = VARBITLEN(arg1);
 	}
 
+	/* the padding bits of both inputs are zero, so we do not have to mask the result */
+	bitsetOrWords(VARBITS(result), VARBITS(arg1), VARBITS(arg2), VARBITBYTES(arg1));
+
 	PG_RETURN_VARBIT_P(result);
 }
 
@@ -164,28 +166,13 @@ Datum
 reconstructTransToSQL (PG_FUNCTION_ARGS)
 {
 	VarBit *transSet;
-	char *resultC;
-	text *result;
-	int len;
 
 	if (PG_ARGISNULL(0))
 		transSet = NULL;
 	else
 		transSet = PG_GETARG_VARBIT_P(0);
 
-	/* generate the string representation */
-	resultC = generateTransProvRep(transSet, PG_GETARG_INT32(1));
-
-	if (!resultC)
-		PG_RETURN_NULL();
-
-	len = strlen(resultC);
-	result = (text *) palloc(len + VARHDRSZ);
-	SET_VARSIZE(result, len + VARHDRSZ);
-
-	memcpy(VARDATA(result), resultC, len);
-
-	PG_RETURN_TEXT_P(result);
+	PG_RETURN_TEXT_P(getRepresentation(transSet, PG_GETARG_INT32(1), false));
 }
 
 /*
@@ -202,28 +189,13 @@ Datum
 reconstructMap (PG_FUNCTION_ARGS)
 {
 	VarBit *transSet;
-	char *resultC;
-	text *result;
-	int len;
 
 	if (PG_ARGISNULL(0))
 		transSet = NULL;
 	else
 		transSet = PG_GETARG_VARBIT_P(0);
 
-	/* generate the string representation */
-	resultC = generateMapRep(transSet, PG_GETARG_INT32(1));
-
-	if (!resultC)
-		PG_RETURN_NULL();
-
-	len = strlen(resultC);
-	result = (text *) palloc(len + VARHDRSZ);
-	SET_VARSIZE(result, len + VARHDRSZ);
-
-	memcpy(VARDATA(result), resultC, len);
-
-	PG_RETURN_TEXT_P(result);
+	PG_RETURN_TEXT_P(getRepresentation(transSet, PG_GETARG_INT32(1), true));
 }
 
 /*
@@ -296,45 +268,208 @@ bitset_nonzero_repeat(PG_FUNCTION_ARGS)
 }
 
 /*
- * Given a bitset representing the mapping provenance, generate a string representation.
- * The global structure transProvQuerIndex is accessed that stores string representations
- * for the complete mapping provenance (list of all mappings corresponding to the query)
- * and pointers to each part corresponding to bit in the bitset. Thus, this method only
- * traverses the bitset one bit at a time to determine if a certain part should be
- * copied from the global structure to the result or not.
+ * Returns a copy of the bitset given as the first argument with each bit from
+ * the int4 array given as the second argument set to 1, if the corresponding
+ * element of the bool array given as the third argument is true. Bits are
+ * numbered starting from 1. This function is used to compute the copy map of
+ * copy contribution semantics in one step instead of OR'ing a conditional
+ * singleton bitset for each inclusion condition.
+ *
+ * 		Arguments: varbit, int4[], bool[]
  */
 
-static char *
-generateMapRep (VarBit *bitset, Index queryId)
+Datum
+bitset_set_bits_if(PG_FUNCTION_ARGS)
 {
-	TransRepQueryInfo *queryInfo;
-	char *result;
-	char *partPointer;
-	int resultLength = 0;
-	int partLength;
-	int numRanges;
-	ListCell *lc;
+	VarBit *arg1;
+	ArrayType *bitArray;
+	ArrayType *condArray;
+	VarBit *result;
+	int32 *bits;
+	char *conds;
+	bits8 *condNulls;
+	int numBits;
+	int bit;
 	int i;
 
-	/* get the TransRepQueryInfo for the current query */
-	foreach(lc, transProvQueryIndex->queryInfos)
+	arg1 = PG_GETARG_VARBIT_P(0);
+	bitArray = PG_GETARG_ARRAYTYPE_P(1);
+	condArray = PG_GETARG_ARRAYTYPE_P(2);
+
+	numBits = ArrayGetNItems(ARR_NDIM(bitArray), ARR_DIMS(bitArray));
+	if (ARR_HASNULL(bitArray) || ARR_ELEMTYPE(bitArray) != INT4OID
+			|| ARR_ELEMTYPE(condArray) != BOOLOID
+			|| ArrayGetNItems(ARR_NDIM(condArray), ARR_DIMS(condArray)) != numBits)
+		ereport(ERROR,
+				(errcode(ERRCODE_ARRAY_SUBSCRIPT_ERROR),
+				 errmsg("bitset_set_bits_if expects a non NULL int4 array and "
+						 "a bool array of the same size")));
+
+	result = (VarBit *) palloc(VARSIZE(arg1));
+	memcpy(result, arg1, VARSIZE(arg1));
+
+	bits = (int32 *) ARR_DATA_PTR(bitArray);
+	conds = ARR_DATA_PTR(condArray);
+	condNulls = ARR_NULLBITMAP(condArray);
+
+	for (i = 0; i < numBits; i++)
 	{
-		queryInfo = (TransRepQueryInfo *) lfirst(lc);
-		if (queryInfo->queryId  == queryId)
-			break;
+		/* NULL conditions are handled as false and are not stored in the data
+		 * part of the array */
+		if (condNulls && !(condNulls[i / BITS_PER_BYTE] & (1 << (i % BITS_PER_BYTE))))
+			continue;
+
+		if (*((bool *) conds))
+		{
+			bit = bits[i] - 1;
+			if (bit < 0 || bit >= VARBITLEN(result))
+				ereport(ERROR,
+						(errcode(ERRCODE_ARRAY_SUBSCRIPT_ERROR),
+						 errmsg("bit %d is out of range for a bitset of "
+								 "length %d", bits[i], VARBITLEN(result))));
+
+			VARBITS(result)[bit / BITS_PER_BYTE] |= HIGHBIT >> (bit % BITS_PER_BYTE);
+		}
+
+		conds++;
 	}
 
+	PG_RETURN_VARBIT_P(result);
+}
+
+/*
+ * Returns the transformation provenance (mapRep is false) or mapping
+ * provenance (mapRep is true) representation for a bitset of the query
+ * identified by queryId. Representations are generated only once per distinct
+ * bitset and cached in the TransRepQueryInfo of the query.
+ */
+
+static text *
+getRepresentation (VarBit *bitset, Index queryId, bool mapRep)
+{
+	TransRepQueryInfo *queryInfo;
+	TransRepCacheEntry *entry;
+	HASHCTL ctl;
+	MemoryContext oldCtx;
+	uint32 hash;
+	bool found;
+	char *resultC;
+	text *result;
+	int len;
+
+	queryInfo = getQueryRepInfo(queryId);
+
 	if (!bitset)
 		ereport(ERROR,
 				(errcode(ERRCODE_INTERNAL_ERROR),
 				errmsg("a NULL value was passed to the transformation"
 						"provenance representation generation!")));
 
-	if(!(queryInfo->queryId == queryId))
+	/* create the cache on first use */
+	if (!queryInfo->repCache)
+	{
+		queryInfo->repCacheContext = AllocSetContextCreate(funcPrivateContext,
+					"TransProv representation cache",
+					ALLOCSET_SMALL_MINSIZE,
+					ALLOCSET_SMALL_INITSIZE,
+					ALLOCSET_DEFAULT_MAXSIZE);
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(uint32);
+		ctl.entrysize = sizeof(TransRepCacheEntry);
+		ctl.hash = tag_hash;
+		ctl.hcxt = queryInfo->repCacheContext;
+
+		queryInfo->repCache = hash_create("TransProv representation cache",
+				64, &ctl, HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+	}
+
+	/* is the representation for this bitset cached? */
+	hash = DatumGetUInt32(hash_any((unsigned char *) VARBITS(bitset),
+			VARBITBYTES(bitset)));
+	entry = (TransRepCacheEntry *) hash_search(queryInfo->repCache, &hash,
+			HASH_FIND, NULL);
+
+	if (entry && VARBITLEN(entry->set) == VARBITLEN(bitset)
+			&& bitsetEqual(entry->set, bitset))
+		return (text *) DatumGetPointer(datumCopy(PointerGetDatum(entry->rep),
+				false, -1));
+
+	/* generate the string representation */
+	if (mapRep)
+		resultC = generateMapRep(bitset, queryInfo);
+	else
+		resultC = generateTransProvRep(bitset, queryInfo);
+
+	len = strlen(resultC);
+	result = (text *) palloc(len + VARHDRSZ);
+	SET_VARSIZE(result, len + VARHDRSZ);
+	memcpy(VARDATA(result), resultC, len);
+	pfree(resultC);
+
+	/* cache it, a colliding entry is replaced */
+	if (entry || hash_get_num_entries(queryInfo->repCache) < MAX_CACHED_REPS)
+	{
+		entry = (TransRepCacheEntry *) hash_search(queryInfo->repCache, &hash,
+				HASH_ENTER, &found);
+		if (found)
+		{
+			pfree(entry->set);
+			pfree(entry->rep);
+		}
+
+		oldCtx = MemoryContextSwitchTo(queryInfo->repCacheContext);
+		entry->set = DatumGetVarBitP(datumCopy(VarBitPGetDatum(bitset),
+				false, -1));
+		entry->rep = (text *) DatumGetPointer(datumCopy(PointerGetDatum(result),
+				false, -1));
+		MemoryContextSwitchTo(oldCtx);
+	}
+
+	return result;
+}
+
+/*
+ * Returns the TransRepQueryInfo for the query identified by queryId.
+ */
+
+static TransRepQueryInfo *
+getQueryRepInfo (Index queryId)
+{
+	TransRepIndexEntry *entry;
+
+	entry = NULL;
+	if (transProvQueryIndex)
+		entry = (TransRepIndexEntry *) hash_search(
+				transProvQueryIndex->infoHash, &queryId, HASH_FIND, NULL);
+
+	if (!entry)
 		ereport(ERROR,
 					(errcode(ERRCODE_INTERNAL_ERROR),
-					errmsg("did not find TransRepQueryInfo needed for map"
-							"ping provenance generation!")));
+					errmsg("did not find TransRepQueryInfo needed for "
+							"transformation provenance generation!")));
+
+	return entry->info;
+}
+
+/*
+ * Given a bitset representing the mapping provenance, generate a string representation.
+ * The global structure transProvQuerIndex is accessed that stores string representations
+ * for the complete mapping provenance (list of all mappings corresponding to the query)
+ * and pointers to each part corresponding to bit in the bitset. Thus, this method only
+ * traverses the bitset one bit at a time to determine if a certain part should be
+ * copied from the global structure to the result or not.
+ */
+
+static char *
+generateMapRep (VarBit *bitset, TransRepQueryInfo *queryInfo)
+{
+	char *result;
+	char *partPointer;
+	int resultLength = 0;
+	int partLength;
+	int numRanges;
+	int i;
 
 	numRanges = queryInfo->numRanges;
 
@@ -376,10 +511,8 @@ generateMapRep (VarBit *bitset, Index queryId)
  */
 
 static char *
-generateTransProvRep (VarBit *bitset, Index queryId)
+generateTransProvRep (VarBit *bitset, TransRepQueryInfo *queryInfo)
 {
-	TransRepQueryInfo *queryInfo;
-	ListCell *lc;
 	char *result;
 	char *partPointer;
 	int resultLength;
@@ -387,27 +520,8 @@ generateTransProvRep (VarBit *bitset, Index queryId)
 	int numRanges;
 	int i, curRange, before;
 
-	foreach(lc, transProvQueryIndex->queryInfos)
-	{
-		queryInfo = (TransRepQueryInfo *) lfirst(lc);
-		if (queryInfo->queryId  == queryId)
-			break;
-	}
-
-	if (!bitset)
-		ereport(ERROR,
-					(errcode(ERRCODE_INTERNAL_ERROR),
-					errmsg("a NULL value was passed to the transformation"
-							"provenance representation generation!")));
-
-	if(!(queryInfo->queryId == queryId))
-		ereport(ERROR,
-					(errcode(ERRCODE_INTERNAL_ERROR),
-					errmsg("did not find TransRepQueryInfo needed for "
-							"transformation provenance generation!")));
-
 	numRanges =  queryInfo->numRanges;
-	resultLength = strlen(queryInfo->string);
+	resultLength = queryInfo->stringLength;
 
 	/* compute length */
 	for(i = curRange = 0; i < numRanges; curRange = ++i)
@@ -421,7 +535,7 @@ generateTransProvRep (VarBit *bitset, Index queryId)
 		 * transformation provenance. */
 		if (!bitsetContains(bitset, queryInfo->sets[i]))
 		{
-			resultLength += strlen(NOT_STRING) + strlen(CLOSE_NOT_STRING);
+			resultLength += NOT_STRING_LEN + CLOSE_NOT_STRING_LEN;
 			while(i < numRanges - 1
 					&& queryInfo->ends[i + 1] <= queryInfo->ends[curRange])
 				i++;
@@ -441,7 +555,7 @@ generateTransProvRep (VarBit *bitset, Index queryId)
 			if (i != numRanges - 1)
 				partLength = queryInfo->begins[i + 1] - queryInfo->begins[i];
 			else
-				partLength = strlen(queryInfo->string) - queryInfo->begins[i];
+				partLength = queryInfo->stringLength - queryInfo->begins[i];
 
 			memcpy(partPointer, queryInfo->stringPointers[i], partLength);
 			partPointer += partLength;
@@ -454,15 +568,15 @@ generateTransProvRep (VarBit *bitset, Index queryId)
 		 */
 		else
 		{
-			memcpy(partPointer, NOT_STRING, strlen(NOT_STRING));
-			partPointer += strlen(NOT_STRING);
+			memcpy(partPointer, NOT_STRING, NOT_STRING_LEN);
+			partPointer += NOT_STRING_LEN;
 
 			partLength = queryInfo->ends[i] - queryInfo->begins[i];
 			memcpy(partPointer, queryInfo->stringPointers[i], partLength);
 			partPointer += partLength;
 
-			memcpy(partPointer, CLOSE_NOT_STRING, strlen(CLOSE_NOT_STRING));
-			partPointer += strlen(CLOSE_NOT_STRING);
+			memcpy(partPointer, CLOSE_NOT_STRING, CLOSE_NOT_STRING_LEN);
+			partPointer += CLOSE_NOT_STRING_LEN;
 
 			before = i;
 
@@ -487,7 +601,7 @@ generateTransProvRep (VarBit *bitset, Index queryId)
 	 * string. */
 	if (partPointer - result < resultLength)
 	{
-		partLength = strlen(queryInfo->string) - queryInfo->ends[before];
+		partLength = queryInfo->stringLength - queryInfo->ends[before];
 		memcpy(partPointer, queryInfo->string + queryInfo->ends[before],
 				partLength);
 		partPointer += partLength;
@@ -522,11 +636,22 @@ dropTransProvQueryIndex (void)
 	/* create trans prov query index */
 	if (transProvQueryIndex == NULL)
 	{
+		HASHCTL ctl;
+
 		queryId = 0;
 		transProvQueryIndex = (TransRepQueryIndex *)
 				MemoryContextAlloc(funcPrivateContext,
 						sizeof(TransRepQueryIndex));
 		transProvQueryIndex->queryInfos = NIL;
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(Index);
+		ctl.entrysize = sizeof(TransRepIndexEntry);
+		ctl.hash = tag_hash;
+		ctl.hcxt = funcPrivateContext;
+
+		transProvQueryIndex->infoHash = hash_create("TransProv query index",
+				16, &ctl, HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
 	}
 
 	/* drop query infos if they are not needed anymore */
@@ -631,6 +756,12 @@ freeQueryRepInfo (TransRepQueryInfo *info)
 	int i;
 	VarBit *set;
 
+	hash_search(transProvQueryIndex->infoHash, &info->queryId, HASH_REMOVE,
+			NULL);
+
+	if (info->repCacheContext)
+		MemoryContextDelete(info->repCacheContext);
+
 	pfree(info->begins);
 	pfree(info->ends);
 
@@ -671,29 +802,11 @@ int
 generateTransProvQueryIndex (Query *query, char *cursorName)
 {
 	TransRepQueryInfo *newInfo;
-	MemoryContext oldCtx;
-
-	newInfo = (TransRepQueryInfo *) MemoryContextAlloc(funcPrivateContext,
-			sizeof(TransRepQueryInfo));
-	newInfo->queryId = queryId++;
-	if (cursorName)
-	{
-		newInfo->cusorName =
-				MemoryContextStrdup(funcPrivateContext, cursorName);
-		newInfo->hold = true;
-	}
-	else
-	{
-		newInfo->cusorName = NULL;
-		newInfo->hold = false;
-	}
 
-	oldCtx = MemoryContextSwitchTo(funcPrivateContext);
-	transProvQueryIndex->queryInfos =
-			lappend(transProvQueryIndex->queryInfos, newInfo);
-	MemoryContextSwitchTo(oldCtx);
+	newInfo = createQueryRepInfo(cursorName);
 
 	parseBackTransToSQL (query, newInfo, funcPrivateContext);
+	newInfo->stringLength = strlen(newInfo->string);
 
 	return newInfo->queryId;
 }
@@ -710,35 +823,12 @@ int
 generateTransXmlQueryIndex (Query *query, char *cursorName)//TODO merge with SQL method if no big changes
 {
 	TransRepQueryInfo *newInfo;
-	MemoryContext oldCtx;
 
-	newInfo = (TransRepQueryInfo *) MemoryContextAlloc(funcPrivateContext,
-			sizeof(TransRepQueryInfo));
-	newInfo->queryId = queryId++;
-
-	/* Is the query used inside a cursor? */
-	if (cursorName)
-	{
-		newInfo->cusorName = MemoryContextStrdup(funcPrivateContext,
-				cursorName);
-		newInfo->hold = true;
-	}
-	else
-	{
-		newInfo->cusorName = NULL;
-		newInfo->hold = false;
-	}
-
-	/* generate the data structure inside the private memory context of this
-	 * module (It cannot be droped after execution of a query, if we are
-	 * fetching from a cursor). */
-	oldCtx = MemoryContextSwitchTo(funcPrivateContext);
-	transProvQueryIndex->queryInfos =
-			lappend(transProvQueryIndex->queryInfos, newInfo);
-	MemoryContextSwitchTo(oldCtx);
+	newInfo = createQueryRepInfo(cursorName);
 
 	//if (Provinfo(query)->contribution == CONTR_TRANS_XML_SIMPLE)
 		parseBackTransToXML (query, newInfo, true, funcPrivateContext);
+	newInfo->stringLength = strlen(newInfo->string);
 
 	return newInfo->queryId;
 }
@@ -755,10 +845,35 @@ int
 generateMapQueryIndex (Query *query, char *cursorName)
 {
 	TransRepQueryInfo *newInfo;
+
+	newInfo = createQueryRepInfo(cursorName);
+
+	/* generate the string representation of the mapping provenance,
+	 * with pointers into that string used by the representation
+	 * generation function.
+	 */
+	generateMapString(query, newInfo, funcPrivateContext);
+	newInfo->stringLength = 0;
+
+	return newInfo->queryId;
+}
+
+/*
+ * Creates a new TransRepQueryInfo and adds it to the query index. The
+ * structure is generated inside the private memory context of this module (It
+ * cannot be droped after execution of a query, if we are fetching from a
+ * cursor).
+ */
+
+static TransRepQueryInfo *
+createQueryRepInfo (char *cursorName)
+{
+	TransRepQueryInfo *newInfo;
+	TransRepIndexEntry *entry;
 	MemoryContext oldCtx;
+	bool found;
 
-	/* generate a new TransRepQueryInfo */
-	newInfo = (TransRepQueryInfo *) MemoryContextAlloc(funcPrivateContext,
+	newInfo = (TransRepQueryInfo *) MemoryContextAllocZero(funcPrivateContext,
 			sizeof(TransRepQueryInfo));
 	newInfo->queryId = queryId++;
 
@@ -775,22 +890,17 @@ generateMapQueryIndex (Query *query, char *cursorName)
 		newInfo->hold = false;
 	}
 
-	/* generate the data structure inside the private memory
-	 * context of this module (It cannot be droped after execution
-	 * of a query, if we are fetching from a cursos).
-	 */
 	oldCtx = MemoryContextSwitchTo(funcPrivateContext);
 	transProvQueryIndex->queryInfos =
 			lappend(transProvQueryIndex->queryInfos, newInfo);
 	MemoryContextSwitchTo(oldCtx);
 
-	/* generate the string representation of the mapping provenance,
-	 * with pointers into that string used by the representation
-	 * generation function.
-	 */
-	generateMapString(query, newInfo, funcPrivateContext);
+	entry = (TransRepIndexEntry *) hash_search(transProvQueryIndex->infoHash,
+			&newInfo->queryId, HASH_ENTER, &found);
+	Assert(!found);
+	entry->info = newInfo;
 
-	return newInfo->queryId;
+	return newInfo;
 }
 
 /*
@@ -804,8 +914,9 @@ bitsetContains (VarBit *left, VarBit *right)
 	int bitlen2;
 	bits8 *p1;
 	bits8 *p2;
-	bits8 temp;
-	int i;
+	uint64 word1;
+	uint64 word2;
+	int nbytes;
 
 	bitlen1 = VARBITLEN(left);
 	bitlen2 = VARBITLEN(right);
@@ -818,16 +929,29 @@ bitsetContains (VarBit *left, VarBit *right)
 	p1 = VARBITS(left);
 	p2 = VARBITS(right);
 
-	/* AND each byte of both bitsets. If the result equals the second bitset
+	/* AND each word of both bitsets. If the result equals the second bitset
 	 * then the first set contains the second. E.g.
 	 *		left =  		1100011,1000000
 	 *		right = 		0000011,1000000
 	 *		left & right = 	0000011,1000000
 	 */
-	for(i = 0; i < VARBITBYTES(left); i++, p1++, p2++)
+	for(nbytes = VARBITBYTES(left); nbytes >= sizeof(uint64);
+			nbytes -= sizeof(uint64), p1 += sizeof(uint64), p2 += sizeof(uint64))
+	{
+		memcpy(&word1, p1, sizeof(uint64));
+		memcpy(&word2, p2, sizeof(uint64));
+		if ((word1 & word2) != word2)
+			return FALSE;
+	}
+
+	/* the remaining bytes are tested as one partial word */
+	if (nbytes > 0)
 	{
-		temp = *p1 & *p2;
-		if (temp != *p2)
+		word1 = 0;
+		word2 = 0;
+		memcpy(&word1, p1, nbytes);
+		memcpy(&word2, p2, nbytes);
+		if ((word1 & word2) != word2)
 			return FALSE;
 	}
 
@@ -844,9 +968,6 @@ bitsetEqual (VarBit *left, VarBit* right)
 {
 	int bitlen1;
 	int bitlen2;
-	bits8 *p1;
-	bits8 *p2;
-	int i;
 
 	bitlen1 = VARBITLEN(left);
 	bitlen2 = VARBITLEN(right);
@@ -856,16 +977,46 @@ bitsetEqual (VarBit *left, VarBit* right)
 				 errmsg("cannot test bit strings of "
 						 "different sizes for equality")));
 
-	p1 = VARBITS(left);
-	p2 = VARBITS(right);
+	return memcmp(VARBITS(left), VARBITS(right), VARBITBYTES(left)) == 0;
+}
+
+/*
+ * OR nbytes bytes of the bit data left and right and store the result in
+ * result (which may be the same as left). The bit data is processed one 64 bit
+ * word at a time and the bytes that do not fill a whole word are processed as
+ * one partial word, thus bitsets of up to 64 elements are OR'ed in a single
+ * step. Varbit data is not guaranteed to be aligned for 64 bit access, so the
+ * words are copied with memcpy which compilers translate into plain loads and
+ * stores.
+ */
 
-	for(i = 0; i < VARBITBYTES(left); i++, p1++, p2++)
+static void
+bitsetOrWords (bits8 *result, bits8 *left, bits8 *right, int nbytes)
+{
+	uint64 word1;
+	uint64 word2;
+
+	for(; nbytes >= sizeof(uint64); nbytes -= sizeof(uint64))
 	{
-		if (*p1 != *p2)
-			return FALSE;
+		memcpy(&word1, left, sizeof(uint64));
+		memcpy(&word2, right, sizeof(uint64));
+		word1 |= word2;
+		memcpy(result, &word1, sizeof(uint64));
+
+		result += sizeof(uint64);
+		left += sizeof(uint64);
+		right += sizeof(uint64);
 	}
 
-	return TRUE;
+	if (nbytes > 0)
+	{
+		word1 = 0;
+		word2 = 0;
+		memcpy(&word1, left, nbytes);
+		memcpy(&word2, right, nbytes);
+		word1 |= word2;
+		memcpy(result, &word1, nbytes);
+	}
 }
 
 /*
@@ -878,33 +1029,30 @@ Datum
 generateVarbitSetElem (int n, int value)
 {
 	VarBit *result;
-	bits8 *cur;
-	int realLength;
 
 	Assert(value <= n);
 
-	value--;
-	realLength = VARBITTOTALLEN(n);
-	result = (VarBit *) palloc0(realLength);
-	SET_VARSIZE(result, realLength);
-	VARBITLEN(result) = n;
+	/* values are counted from 1, 0 is treated like 1 */
+	value = Max(value - 1, 0);
+	result = generateEmptyBitset(n);
 
-	cur = VARBITS(result);
+	VARBITS(result)[value / BITS_PER_BYTE] = HIGHBIT >> (value % BITS_PER_BYTE);
 
-	/* we do not know size of bit8 definitely so just use this HIGHBIT stuff */
-	*cur = HIGHBIT;
-	for(;value > 0; value--)
-	{
-		*cur >>= 1;
+	return VarBitPGetDatum(result);
+}
 
-		if (*cur == 0)
-		{
-			cur++;
-			*cur = HIGHBIT;
-		}
-	}
+/*
+ * Adds value to the bitset (sets the corresponding bit) in place. Values are
+ * counted like in generateVarbitSetElem.
+ */
 
-	return VarBitPGetDatum(result);
+void
+bitsetAddElem (VarBit *bitset, int value)
+{
+	Assert(value <= VARBITLEN(bitset));
+
+	value = Max(value - 1, 0);
+	VARBITS(bitset)[value / BITS_PER_BYTE] |= HIGHBIT >> (value % BITS_PER_BYTE);
 }
 
 /*
@@ -916,7 +1064,6 @@ VarBit *
 generateEmptyBitset (int n)
 {
 	VarBit *result;
-	bits8 *cur;
 	int realLength;
 
 	realLength = VARBITTOTALLEN(n);
@@ -924,10 +1071,6 @@ generateEmptyBitset (int n)
 	SET_VARSIZE(result, realLength);
 	VARBITLEN(result) = n;
 
-	cur = VARBITS(result);
-	for(n = VARBITBYTES(result); n > 0; n--, *(cur++) = (bits8) 0)
-		;
-
 	return result;
 }
 
@@ -942,23 +1085,13 @@ varBitOr (Datum left, Datum right)
 {
 	VarBit *leftBit;
 	VarBit *rightBit;
-	bits8 *curLeft;
-	bits8 *curRight;
-	int i;
 
 	/* use as Varbit */
 	leftBit = DatumGetVarBitP(left);
 	rightBit = DatumGetVarBitP(right);
-	curLeft = VARBITS(leftBit);
-	curRight = VARBITS(rightBit);
 
-	/* OR-each byte of varbit data */
-	for(i = 0; i < VARBITBYTES(leftBit); i++)
-	{
-		*curLeft = *curLeft | *curRight;
-		curLeft++;
-		curRight++;
-	}
+	bitsetOrWords(VARBITS(leftBit), VARBITS(leftBit), VARBITS(rightBit),
+			VARBITBYTES(leftBit));
 
 	return left;
 }
@@ -0,0 +1,305 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_tupleid.c
+ *	  PERM C - functions to fetch base relation tuples identified by TUPLEID provenance.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: /postgres/src/backend/provrewrite/adt/prov_tupleid.c,v 1.542 31.08.2009 16:23:59 bglav Exp $
+ *
+ * NOTES
+ *		For TUPLEID contribution semantics the provenance of a result tuple is
+ *		not represented by copies of all attribute values of the contributing
+ *		base relation tuples, but by the oid or ctid of each contributing tuple.
+ *		The functions in this module fetch the actual tuples for a batch of
+ *		these identifiers. The first argument is a (typically NULL) row of the
+ *		base relation, that determines from which relation the tuples are
+ *		fetched and the result type of the function, e.g.,
+ *
+ *			SELECT * FROM prov_fetch_tuples(NULL::r, ARRAY['(0,1)','(0,3)']::tid[]);
+ *
+ *		Each tuple is returned at most once, no matter how often its identifier
+ *		is contained in the batch. Identifiers of tuples that do not exist or
+ *		are not visible to the current snapshot are ignored.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <stdlib.h>
+
+#include "access/heapam.h"
+#include "catalog/pg_class.h"
+#include "catalog/pg_type.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "storage/bufmgr.h"
+#include "utils/acl.h"
+#include "utils/array.h"
+#include "utils/lsyscache.h"
+#include "utils/tuplestore.h"
+
+#include "provrewrite/prov_tupleid.h"
+
+/* prototypes */
+static Relation openArgumentRelation (FunctionCallInfo fcinfo);
+static Tuplestorestate *beginResult (FunctionCallInfo fcinfo);
+static void endResult (FunctionCallInfo fcinfo, Tuplestorestate *store, Relation rel);
+static int compareTids (const void *left, const void *right);
+static int compareOids (const void *left, const void *right);
+
+/*
+ * Returns the tuples of a relation identified by an array of ctids. The ctids
+ * are sorted before fetching the tuples to access the relation in physical
+ * order.
+ */
+
+Datum
+prov_fetch_tuples_by_tid (PG_FUNCTION_ARGS)
+{
+	Tuplestorestate *store;
+	Relation rel;
+	Datum *elems;
+	bool *elemNulls;
+	int numElems;
+	ItemPointerData *tids;
+	int numTids;
+	BlockNumber numBlocks;
+	HeapTupleData tuple;
+	Buffer buffer;
+	MemoryContext oldcontext;
+	int i;
+
+	store = beginResult(fcinfo);
+	rel = openArgumentRelation(fcinfo);
+
+	if (PG_ARGISNULL(1))
+	{
+		endResult(fcinfo, store, rel);
+		return (Datum) 0;
+	}
+
+	/* get the non null ctids from the array and sort them */
+	deconstruct_array(PG_GETARG_ARRAYTYPE_P(1), TIDOID, sizeof(ItemPointerData),
+			false, 's', &elems, &elemNulls, &numElems);
+
+	tids = (ItemPointerData *) palloc(Max(numElems, 1) * sizeof(ItemPointerData));
+	numTids = 0;
+
+	for (i = 0; i < numElems; i++)
+		if (!elemNulls[i])
+			tids[numTids++] = *((ItemPointer) DatumGetPointer(elems[i]));
+
+	qsort(tids, numTids, sizeof(ItemPointerData), compareTids);
+
+	/* fetch each tuple once, ctids beyond the end of the relation are ignored */
+	numBlocks = RelationGetNumberOfBlocks(rel);
+
+	for (i = 0; i < numTids; i++)
+	{
+		if (i > 0 && ItemPointerEquals(&tids[i], &tids[i - 1]))
+			continue;
+		if (ItemPointerGetBlockNumber(&tids[i]) >= numBlocks)
+			continue;
+
+		tuple.t_self = tids[i];
+		if (heap_fetch(rel, ActiveSnapshot, &tuple, &buffer, false, NULL))
+		{
+			oldcontext = MemoryContextSwitchTo(
+					((ReturnSetInfo *) fcinfo->resultinfo)->econtext->ecxt_per_query_memory);
+			tuplestore_puttuple(store, &tuple);
+			MemoryContextSwitchTo(oldcontext);
+
+			ReleaseBuffer(buffer);
+		}
+	}
+
+	endResult(fcinfo, store, rel);
+
+	return (Datum) 0;
+}
+
+/*
+ * Returns the tuples of a relation identified by an array of oids. The
+ * relation is scanned once for the whole batch of oids.
+ */
+
+Datum
+prov_fetch_tuples_by_oid (PG_FUNCTION_ARGS)
+{
+	Tuplestorestate *store;
+	Relation rel;
+	Datum *elems;
+	bool *elemNulls;
+	int numElems;
+	Oid *oids;
+	Oid tupleOid;
+	int numOids;
+	HeapScanDesc scan;
+	HeapTuple tuple;
+	MemoryContext oldcontext;
+	int i;
+
+	store = beginResult(fcinfo);
+	rel = openArgumentRelation(fcinfo);
+
+	if (!rel->rd_rel->relhasoids)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("relation \"%s\" does not have OIDs",
+						RelationGetRelationName(rel))));
+
+	if (PG_ARGISNULL(1))
+	{
+		endResult(fcinfo, store, rel);
+		return (Datum) 0;
+	}
+
+	/* get the non null oids from the array and sort them */
+	deconstruct_array(PG_GETARG_ARRAYTYPE_P(1), OIDOID, sizeof(Oid), true, 'i',
+			&elems, &elemNulls, &numElems);
+
+	oids = (Oid *) palloc(Max(numElems, 1) * sizeof(Oid));
+	numOids = 0;
+
+	for (i = 0; i < numElems; i++)
+		if (!elemNulls[i])
+			oids[numOids++] = DatumGetObjectId(elems[i]);
+
+	qsort(oids, numOids, sizeof(Oid), compareOids);
+
+	/* scan the relation and return each tuple whose oid is in the batch */
+	if (numOids > 0)
+	{
+		scan = heap_beginscan(rel, ActiveSnapshot, 0, NULL);
+
+		while ((tuple = heap_getnext(scan, ForwardScanDirection)) != NULL)
+		{
+			tupleOid = HeapTupleGetOid(tuple);
+
+			if (bsearch(&tupleOid, oids, numOids, sizeof(Oid), compareOids) == NULL)
+				continue;
+
+			oldcontext = MemoryContextSwitchTo(
+					((ReturnSetInfo *) fcinfo->resultinfo)->econtext->ecxt_per_query_memory);
+			tuplestore_puttuple(store, tuple);
+			MemoryContextSwitchTo(oldcontext);
+		}
+
+		heap_endscan(scan);
+	}
+
+	endResult(fcinfo, store, rel);
+
+	return (Datum) 0;
+}
+
+/*
+ * Opens the relation whose row type is the type of the first argument of the
+ * function after checking that the user is allowed to read it.
+ */
+
+static Relation
+openArgumentRelation (FunctionCallInfo fcinfo)
+{
+	Oid argType;
+	Oid relid = InvalidOid;
+	AclResult aclresult;
+	Relation rel;
+
+	argType = get_fn_expr_argtype(fcinfo->flinfo, 0);
+	if (OidIsValid(argType))
+		relid = get_typ_typrelid(argType);
+
+	if (!OidIsValid(relid))
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("first argument of prov_fetch_tuples must be a row of a table")));
+
+	aclresult = pg_class_aclcheck(relid, GetUserId(), ACL_SELECT);
+	if (aclresult != ACLCHECK_OK)
+		aclcheck_error(aclresult, ACL_KIND_CLASS, get_rel_name(relid));
+
+	rel = heap_open(relid, AccessShareLock);
+
+	if (rel->rd_rel->relkind != RELKIND_RELATION)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("\"%s\" is not a table",
+						RelationGetRelationName(rel))));
+
+	return rel;
+}
+
+/*
+ * Checks that the caller accepts a tuplestore as the result and creates it.
+ */
+
+static Tuplestorestate *
+beginResult (FunctionCallInfo fcinfo)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	Tuplestorestate *store;
+	MemoryContext oldcontext;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not " \
+						"allowed in this context")));
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	store = tuplestore_begin_heap(true, false, work_mem);
+	MemoryContextSwitchTo(oldcontext);
+
+	return store;
+}
+
+/*
+ * Hands the tuplestore to the caller and closes the relation. The lock is kept
+ * until the end of the transaction.
+ */
+
+static void
+endResult (FunctionCallInfo fcinfo, Tuplestorestate *store, Relation rel)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	MemoryContext oldcontext;
+
+	tuplestore_donestoring(store);
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	rsinfo->setDesc = CreateTupleDescCopy(RelationGetDescr(rel));
+	MemoryContextSwitchTo(oldcontext);
+
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = store;
+
+	heap_close(rel, NoLock);
+}
+
+static int
+compareTids (const void *left, const void *right)
+{
+	return ItemPointerCompare((ItemPointer) left, (ItemPointer) right);
+}
+
+static int
+compareOids (const void *left, const void *right)
+{
+	Oid l = *((const Oid *) left);
+	Oid r = *((const Oid *) right);
+
+	if (l < r)
+		return -1;
+	if (l > r)
+		return 1;
+	return 0;
+}
@@ -19,7 +19,9 @@
 
 #include "postgres.h"
 
+#include "catalog/pg_type.h"
 #include "parser/parse_expr.h"
+#include "utils/array.h"
 
 #include "provrewrite/prov_util.h"
 #include "provrewrite/provlog.h"
@@ -41,8 +43,9 @@ static Node *createCompleteFinalInclConds (CopyMapRelEntry *rel,
 static Node *generateVarBitConstruction (Query *query, CopyMapRelEntry *rel,
 		int numAttrs);
 static Node *generateBitInclusionCond (Query *query, CopyMapRelEntry *rel,
-		CopyMapEntry *attr, InclusionCond *cond, InclusionCond *outCond,
-		int bitLength, int bitNum);
+		CopyMapEntry *attr, InclusionCond *cond, InclusionCond *outCond);
+static void addStaticBit (VarBit *bitset, int bitLength, int bitNum);
+static Node *makeSetBitsExpr (VarBit *staticSet, List *bits, List *conds);
 static Node *getInputBitset (Query *query, CopyMapRelEntry *rel,
 		CopyMapEntry *attr, int outAttr);
 
@@ -108,7 +111,7 @@ addTopCopyInclExpr (Query *query, int origAttrNum)
 		 * of provenance */
 		else
 		{
-			int i;
+			ListCell *provLc;
 
 			if (IS_PARTIALC(ContributionType(query)))
 				condition = createPartialFinalInclConds(relEntry, origAttrNum);
@@ -116,11 +119,11 @@ addTopCopyInclExpr (Query *query, int origAttrNum)
 				condition = createCompleteFinalInclConds(relEntry,
 						origAttrNum);
 
-			foreachi(innerLc, i, relEntry->attrEntries)
+			forboth(innerLc, relEntry->attrEntries, provLc, relEntry->provAttrs)
 			{
 				attrEntry = (CopyMapEntry *) lfirst(innerLc);
 
-				provAttr = (TargetEntry *) list_nth(relEntry->provAttrs, i);
+				provAttr = (TargetEntry *) lfirst(provLc);
 				provAttr->expr = (Expr *) makeCaseForProvAttr(condition,
 						provAttr->expr);
 				provAttr->resno = ++tlPos;
@@ -235,7 +238,11 @@ generateCopyMapAttributs (Query *query, int numQAttrs)
 }
 
 /*
- *
+ * Generates the expression that computes the copy map bitset for a copy map
+ * rel entry. Bits that are set independent of the instance data are folded
+ * into a constant bitset at rewrite time. For the remaining bits the inclusion
+ * conditions are collected and passed to bitset_set_bits_if that sets the bits
+ * whose conditions are fulfilled in one pass.
  */
 
 static Node *
@@ -246,13 +253,17 @@ generateVarBitConstruction (Query *query, CopyMapRelEntry *rel, int numAttrs)
 	InclusionCond *cond;
 	ListCell *aLc, *outLc, *condLc, *inCondLc;
 	int inAtt, outAtt;
-	List *exprs = NIL;
-	Node *result = NULL;
-	Node *condition = NULL;
+	VarBit *staticSet;
+	List *bits = NIL;
+	List *conds = NIL;
+	Node *condition;
+	bool hasCondition;
 	int bitLength = numAttrs * list_length(rel->attrEntries);
 	int bitSingleton;
 
-	// for each inclusion condition create a conditional bitset computation
+	staticSet = generateEmptyBitset(bitLength);
+
+	// for each inclusion condition either set a static bit or add a condition
 	foreachi(aLc, inAtt, rel->attrEntries)
 	{
 		entry = (CopyMapEntry *) lfirst(aLc);
@@ -260,7 +271,6 @@ generateVarBitConstruction (Query *query, CopyMapRelEntry *rel, int numAttrs)
 		// if attr entry is static true, generate fixed bitset
 		if (entry->isStaticTrue)
 		{
-			Datum bitset = generateVarbitSetElem(bitLength, 0);
 			bool fixedSet = true;
 
 			// check if all attribute inclusions are static
@@ -270,19 +280,18 @@ generateVarBitConstruction (Query *query, CopyMapRelEntry *rel, int numAttrs)
 				fixedSet &= attr->isStatic;
 			}
 
-			// if so generate a fixed bitset
+			// if so add the bits to the fixed bitset
 			if (fixedSet)
 			{
+				addStaticBit(staticSet, bitLength, 0);
+
 				foreach(outLc, entry->outAttrIncls)
 				{
 					attr = (AttrInclusions *) lfirst(outLc);
 					outAtt = attr->attr->varattno;
 					bitSingleton = (inAtt * numAttrs) + outAtt;
-					bitset = varBitOr(generateVarbitSetElem
-							(bitLength, bitSingleton), bitset);
+					addStaticBit(staticSet, bitLength, bitSingleton);
 				}
-				condition = (Node *) MAKE_VARBIT_CONST(bitset);
-				exprs = lappend(exprs, condition);
 				continue;
 			}
 		}
@@ -298,12 +307,8 @@ generateVarBitConstruction (Query *query, CopyMapRelEntry *rel, int numAttrs)
 
 			// out attribute is included statically
 			if (attr->isStatic)
-			{
-				condition = (Node *) MAKE_VARBIT_CONST(generateVarbitSetElem(
-						bitLength, bitSingleton));
-				exprs = lappend(exprs, condition);
-			}
-			// non-static create conditional for each InclusionCond
+				addStaticBit(staticSet, bitLength, bitSingleton);
+			// non-static create condition for each InclusionCond
 			else
 			{
 				foreach(condLc, attr->inclConds)
@@ -315,54 +320,54 @@ generateVarBitConstruction (Query *query, CopyMapRelEntry *rel, int numAttrs)
 					Assert(IsA(cond->existsAttr, AttrInclusions));
 
 					inAttrIncl = (AttrInclusions *) cond->existsAttr;
+					condition = NULL;
+					hasCondition = false;
 
 					foreach(inCondLc, inAttrIncl->inclConds)
 					{
 						innerCond = (InclusionCond *) lfirst(inCondLc);
 						condition = generateBitInclusionCond (query, rel, entry,
-							innerCond, cond, bitLength, bitSingleton);
+							innerCond, cond);
+						hasCondition = true;
 					}
 
-					exprs = lappend(exprs, condition);
+					if (!hasCondition)
+						continue;
+
+					if (condition)
+					{
+						bits = lappend_int(bits, bitSingleton);
+						conds = lappend(conds, condition);
+					}
+					else
+						addStaticBit(staticSet, bitLength, bitSingleton);
 				}
 			}
 		}
 	}
 
-	if (list_length(exprs) == 0)
-		return (Node *) MAKE_EMPTY_BITSET_CONST(bitLength);
-
-	// bit_or the individual computations
-	result = (Node *) linitial(exprs);
+	if (conds == NIL)
+		return (Node *) MAKE_VARBIT_CONST(VarBitPGetDatum(staticSet));
 
-	for(aLc = exprs->head->next; aLc != NULL; aLc = aLc->next)
-		result = (Node *) MAKE_SETOR_FUNC(list_make2(result, lfirst(aLc)));
-
-	return result;
+	return makeSetBitsExpr(staticSet, bits, conds);
 }
 
 /*
- *
+ * Returns the condition under which the bit for an inclusion condition is set
+ * in the copy map. If the bit is always set NULL is returned.
  */
 
 static Node *
 generateBitInclusionCond (Query *query, CopyMapRelEntry *rel,
-		CopyMapEntry *attr, InclusionCond *cond, InclusionCond *outCond,
-		int bitLength, int bitNum)
+		CopyMapEntry *attr, InclusionCond *cond, InclusionCond *outCond)
 {
 	Node *condition = NULL;
-	Datum bitSet;
 	Node *inputBitset;
 	Var *inProvAttr = NULL;
-	Node *cons;
-	CaseExpr *caseExpr;
-	CaseWhen *ifPart;
 	ListCell *lc;
 	CopyMapRelEntry *relChild;
 	int inputAttr;
 
-	bitSet = generateVarbitSetElem(bitLength, bitNum);
-	cons = (Node *) MAKE_VARBIT_CONST(bitSet);
 	inputAttr = ((Var *) cond->existsAttr)->varattno;
 
 	/* get child copy-provenance attribute and bitset-singleton for the exists
@@ -378,7 +383,7 @@ generateBitInclusionCond (Query *query, CopyMapRelEntry *rel,
 				inputBitset));
 	}
 	else if (cond->inclType == INCL_EXISTS && outCond->inclType == INCL_EXISTS)
-		return cons;
+		return NULL;
 
 	/* inner condition is an equal condition add the equality constraint to
 	 * "condition" */
@@ -415,16 +420,54 @@ generateBitInclusionCond (Query *query, CopyMapRelEntry *rel,
 			condition = copyObject(outCond->cond);
 	}
 
-	ifPart = (CaseWhen *) makeNode(CaseWhen);
-	ifPart->result = (Expr *) cons;
-	ifPart->expr = (Expr *) condition;
+	return condition;
+}
 
-	caseExpr = (CaseExpr *) makeNode(CaseExpr);
-	caseExpr->casetype = VARBITOID;
-	caseExpr->defresult = (Expr *) MAKE_EMPTY_BITSET_CONST(bitLength);
-	caseExpr->args = list_make1(ifPart);
+/*
+ * Sets bit bitNum in a bitset of length bitLength.
+ */
 
-	return (Node *) caseExpr;
+static void
+addStaticBit (VarBit *bitset, int bitLength, int bitNum)
+{
+	Assert(VARBITLEN(bitset) == bitLength);
+
+	bitsetAddElem(bitset, bitNum);
+}
+
+/*
+ * Creates a call to bitset_set_bits_if that sets the bits from list "bits" in
+ * the constant bitset staticSet, if the corresponding condition from list
+ * "conds" is true.
+ */
+
+static Node *
+makeSetBitsExpr (VarBit *staticSet, List *bits, List *conds)
+{
+	Datum *bitDatums;
+	ArrayType *bitArray;
+	ArrayExpr *condArray;
+	ListCell *lc;
+	int i;
+
+	bitDatums = (Datum *) palloc(list_length(bits) * sizeof(Datum));
+	foreachi(lc, i, bits)
+		bitDatums[i] = Int32GetDatum(lfirst_int(lc));
+
+	bitArray = construct_array(bitDatums, list_length(bits), INT4OID,
+			sizeof(int32), true, 'i');
+
+	condArray = makeNode(ArrayExpr);
+	condArray->array_typeid = BOOLARRAYOID;
+	condArray->element_typeid = BOOLOID;
+	condArray->elements = conds;
+	condArray->multidims = false;
+
+	return (Node *) MAKE_SETBITSIF_FUNC(
+			MAKE_VARBIT_CONST(VarBitPGetDatum(staticSet)),
+			makeConst(INT4ARRAYOID, -1, -1, PointerGetDatum(bitArray), false,
+					false),
+			condArray);
 }
 
 /*
@@ -34,6 +34,7 @@
 #include "optimizer/clauses.h"
 #include "parser/parse_relation.h"
 #include "parser/parsetree.h"
+#include "utils/hsearch.h"
 
 #include "provrewrite/prov_util.h"
 #include "provrewrite/provlog.h"
@@ -51,6 +52,19 @@ typedef enum StaticType {
 	NOT_STATIC
 } StaticType;
 
+/* projection attributes that copy the values of a child attribute */
+typedef struct ChildVarKey {
+	Index varno;
+	AttrNumber varattno;
+} ChildVarKey;
+
+typedef struct ChildVarUses {
+	ChildVarKey key;
+	List *vars;			/* result Vars of TEs that are a bare child Var */
+	List *caseVars;		/* result Vars of CaseExprs returning the child Var */
+	List *caseConds;	/* the WHEN conditions of these CaseExprs */
+} ChildVarUses;
+
 typedef struct EquiGraphNode {
 	Var *nodeVar;
 	List *sEdges;
@@ -93,6 +107,7 @@ static void generateAggCopyMap (Query *query, Index rtindex);
 static void handleProjectionCopyMap (Query *query, Index rtindex);
 static void mapChildVarsToTargetEntries (Query *query, Index rtindex,
 		List *tes);
+static ChildVarUses *getChildVarUses (HTAB *childVarUses, Var *childVar);
 static CaseInfo *getCaseInfoIfSimple (Node *expr, Query *query);
 static AttrInclusions *getInclForVar (CopyMapEntry *entry, Var *var);
 static void handleJoins (Query *query);
@@ -356,14 +371,16 @@ handleProjectionCopyMap (Query *query, Index rtindex)
 static void
 mapChildVarsToTargetEntries (Query *query, Index rtindex, List *tes)
 {
-	List *simpleVars;
-	List *tePos;
+	HTAB *childVarUses;
+	HASHCTL ctl;
+	ChildVarKey key;
+	ChildVarUses *uses;
 	List *oldIncls;
-	List *cases;
-	ListCell *lc, *innerLc, *attLc, *teLc, *caseLc, *varLc;
+	CaseInfo *caseInfo;
+	ListCell *lc, *innerLc, *attLc, *condLc, *varLc;
 	Var *var;
 	Var *inVar;
-	Var *teVar;
+	Var *childVar;
 	TargetEntry *te;
 	CopyMap *map;
 	CopyMapRelEntry *relEntry;
@@ -371,31 +388,53 @@ mapChildVarsToTargetEntries (Query *query, Index rtindex, List *tes)
 	AttrInclusions *incl;
 	AttrInclusions *newIncl;
 	InclusionCond *newCond;
-	CaseInfo *caseInfo;
-	Node *caseCond;
-	Var *caseVar;
-	int pos;
+	bool found;
 
 	map = GET_COPY_MAP(query);
-	tePos = NIL;
-	cases = NIL;
-	simpleVars = NIL;
 
-	/* get all simple vars in the target list */
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(ChildVarKey);
+	ctl.entrysize = sizeof(ChildVarUses);
+	ctl.hash = tag_hash;
+	ctl.hcxt = CurrentMemoryContext;
+
+	childVarUses = hash_create("Copy map child var uses",
+			Max(list_length(tes), 16), &ctl,
+			HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+	/*
+	 * Index the simple vars and the vars returned by bare CaseExprs in the
+	 * target list by the child attribute they copy, so each AttrInclusions
+	 * below finds the projection attributes that use it without scanning the
+	 * whole target list.
+	 */
 	foreach(lc, tes)
 	{
 		te = (TargetEntry *) lfirst(lc);
 
-		if (!te->resjunk)
+		if (te->resjunk)
+			continue;
+
+		childVar = getVarFromTeIfSimple((Node *) te->expr);
+		if (childVar)
+		{
+			childVar = resolveToRteVar(childVar, query);
+			uses = getChildVarUses(childVarUses, childVar);
+			uses->vars = lappend(uses->vars, makeVar(rtindex, te->resno,
+					childVar->vartype, childVar->vartypmod, 0));
+		}
+
+		caseInfo = getCaseInfoIfSimple((Node *) te->expr, query);
+		if (caseInfo)
 		{
-			var = getVarFromTeIfSimple((Node *) te->expr);
-			if (var)
-				var = resolveToRteVar(var, query);
-			caseInfo = getCaseInfoIfSimple((Node *) te->expr, query);
-
-			simpleVars = lappend(simpleVars, var);
-			cases = lappend(cases, caseInfo);
-			tePos = lappend_int(tePos, te->resno);
+			forboth(condLc, caseInfo->conditions, varLc, caseInfo->vars)
+			{
+				childVar = (Var *) lfirst(varLc);
+				uses = getChildVarUses(childVarUses, childVar);
+				uses->caseVars = lappend(uses->caseVars, makeVar(rtindex,
+						te->resno, childVar->vartype, childVar->vartypmod, 0));
+				uses->caseConds = lappend(uses->caseConds, lfirst(condLc));
+			}
 		}
 	}
 
@@ -416,68 +455,82 @@ mapChildVarsToTargetEntries (Query *query, Index rtindex, List *tes)
 				incl = (AttrInclusions *) lfirst(attLc);
 				inVar = (Var *) incl->attr;
 
+				MemSet(&key, 0, sizeof(ChildVarKey));
+				key.varno = inVar->varno;
+				key.varattno = inVar->varattno;
+
+				uses = (ChildVarUses *) hash_search(childVarUses, &key,
+						HASH_FIND, &found);
+				if (!found)
+					continue;
+
 				/* is inVar used somewhere in the projection list. If so, add a
 				 * new AttrInclusion for the projection attr that uses inVar and
 				 * add the current AttrInclusions as the outVarIncls of the new
 				 * AttrInclusion */
-				foreachi(teLc, pos, simpleVars) {
-					teVar = (Var *) lfirst(teLc);
-
-					if (teVar && teVar->varno == inVar->varno
-							&& teVar->varattno == inVar->varattno)
-					{
-						var = makeVar(rtindex, list_nth_int(tePos,pos),
-								teVar->vartype, teVar->vartypmod, 0);
-						newIncl = getInclForVar(attr,var);
+				foreach(varLc, uses->vars)
+				{
+					var = (Var *) copyObject(lfirst(varLc));
+					newIncl = getInclForVar(attr,var);
 
-						if (newIncl == NULL)
-							MAKE_PROJ_INCL(newIncl);
+					if (newIncl == NULL)
+						MAKE_PROJ_INCL(newIncl);
 
-						MAKE_EXISTS_INCL(newCond, (Node *) incl);
-						newIncl->inclConds = lappend(newIncl->inclConds,
-								newCond);
-					}
+					MAKE_EXISTS_INCL(newCond, (Node *) incl);
+					newIncl->inclConds = lappend(newIncl->inclConds,
+							newCond);
 				}
 
 				/* For each WHEN X THEN inVar in a bare CaseExpr in the
 				 * projection list add a conditional inclusion for the current
 				 * AttrInclusions to the new AttrInclusions for the result
 				 * attribute. */
-				foreachi(teLc, pos, cases)
+				forboth(varLc, uses->caseVars, condLc, uses->caseConds)
 				{
-					caseInfo = (CaseInfo *) lfirst(teLc);
+					var = (Var *) copyObject(lfirst(varLc));
+					newIncl = getInclForVar(attr,var);
 
-					if(caseInfo)
-					{
-						forboth(caseLc, caseInfo->conditions, varLc,
-								caseInfo->vars)
-						{
-							caseCond = (Node *) lfirst(caseLc);
-							caseVar = (Var *) lfirst(varLc);
-
-							if (caseVar->varno == inVar->varno
-									&& caseVar->varattno == inVar->varattno)
-							{
-								var = makeVar(rtindex,
-										list_nth_int(tePos, pos),
-										caseVar->vartype,
-										caseVar->vartypmod, 0);
-								newIncl = getInclForVar(attr,var);
-
-								if (newIncl == NULL)
-									MAKE_PROJ_INCL(newIncl);
-
-								MAKE_COND_INCL(newCond, (Node *) incl,
-										caseCond);
-								newIncl->inclConds =
-										lappend(newIncl->inclConds, newCond);
-							}
-						}
-					}
+					if (newIncl == NULL)
+						MAKE_PROJ_INCL(newIncl);
+
+					MAKE_COND_INCL(newCond, (Node *) incl,
+							(Node *) lfirst(condLc));
+					newIncl->inclConds =
+							lappend(newIncl->inclConds, newCond);
 				}
 			}
 		}
 	}
+
+	hash_destroy(childVarUses);
+}
+
+/*
+ * Returns the entry of the child var uses hash table for a child Var. The
+ * entry is created if it does not exist yet.
+ */
+
+static ChildVarUses *
+getChildVarUses (HTAB *childVarUses, Var *childVar)
+{
+	ChildVarKey key;
+	ChildVarUses *uses;
+	bool found;
+
+	MemSet(&key, 0, sizeof(ChildVarKey));
+	key.varno = childVar->varno;
+	key.varattno = childVar->varattno;
+
+	uses = (ChildVarUses *) hash_search(childVarUses, &key, HASH_ENTER,
+			&found);
+	if (!found)
+	{
+		uses->vars = NIL;
+		uses->caseVars = NIL;
+		uses->caseConds = NIL;
+	}
+
+	return uses;
 }
 
 /*
@@ -843,6 +896,7 @@ addCondForEquiGraph (List *equiGraph, List *rels)
 	int numNodes = list_length(equiGraph);
 	bool *hasStatic = (bool *) palloc0(numNodes * numNodes * sizeof(bool));
 	bool *haveSeen = (bool *) palloc0(numNodes * sizeof(bool));
+	EquiGraphNode **nodes = (EquiGraphNode **) palloc(numNodes * sizeof(EquiGraphNode *));
 	int i, j;
 	EquiGraphNode *cur;
 	CopyMapRelEntry *rel;
@@ -861,6 +915,7 @@ addCondForEquiGraph (List *equiGraph, List *rels)
 	{
 		cur = (EquiGraphNode *) lfirst(lc);
 		cur->pos = i;
+		nodes[i] = cur;
 	}
 
 	// store in hasStatic which nodes are connected through static paths.
@@ -898,8 +953,7 @@ addCondForEquiGraph (List *equiGraph, List *rels)
 					 * inclusion with an EXISTS */
 					if (HAS_STATIC_POS(nodePos,j) && j != nodePos)
 					{
-						Var *toVar = (Var *) copyObject(((EquiGraphNode *)
-								list_nth(equiGraph, j))->nodeVar);
+						Var *toVar = (Var *) copyObject(nodes[j]->nodeVar);
 						newAttrIncl = makeAttrInclusions();
 						newAttrIncl->attr = toVar;
 						MAKE_EXISTS_INCL(inclCond, copyObject(attrIncl->attr));
@@ -913,13 +967,10 @@ addCondForEquiGraph (List *equiGraph, List *rels)
 					{
 						MemSetAligned(haveSeen, 0, numNodes * sizeof(bool));
 						newAttrIncl = makeAttrInclusions();
-						newAttrIncl->attr = (Var *) copyObject(((EquiGraphNode *)
-								list_nth(equiGraph, j))->nodeVar);
-						addEqualityForNonStaticPaths(
-								(EquiGraphNode *) list_nth(equiGraph, nodePos),
-								(EquiGraphNode *) list_nth(equiGraph, j),
-								(EquiGraphNode *) list_nth(equiGraph, nodePos),
-								haveSeen, newAttrIncl, NIL, true);
+						newAttrIncl->attr = (Var *) copyObject(nodes[j]->nodeVar);
+						addEqualityForNonStaticPaths(nodes[nodePos], nodes[j],
+								nodes[nodePos], haveSeen, newAttrIncl, NIL,
+								true);
 						if (newAttrIncl->inclConds != NIL)
 							newAttrIncls = lappend(newAttrIncls, newAttrIncl);
 					}
@@ -1124,6 +1175,7 @@ generateBaseRelCopyMap (RangeTblEntry *rte, Index rtindex)
 	Var *var;
 	CopyMapEntry *attrEntry;
 	AttrInclusions *attrIncl;
+	ProvAttrAccess *access;
 
 	vars = NIL;
 	names = NIL;
@@ -1135,6 +1187,7 @@ generateBaseRelCopyMap (RangeTblEntry *rte, Index rtindex)
 	relMap->refNum = getRelationRefNum (rte->relid, true);
 	relMap->rtindex = rtindex;
 	relMap->isStatic = true;
+	access = addProvAttrAccess(createProvAttrRelPrefix(rte));
 
 	/* get Attributes */
 	expandRTE(rte, rtindex, 0, false, &names, &vars);
@@ -1150,6 +1203,7 @@ generateBaseRelCopyMap (RangeTblEntry *rte, Index rtindex)
 		attrEntry = makeCopyMapEntry();
 		attrEntry->baseRelAttr = var;
 		attrEntry->provAttrName = createProvAttrName(rte, strVal((Value *) lfirst(nameLc)));
+		addProvAttrAccessAttr(access, attrEntry->provAttrName);
 		attrEntry->isStaticTrue = true;
 		attrEntry->isStaticFalse = false;
 		attrEntry->outAttrIncls = list_make1(attrIncl);
@@ -249,6 +249,7 @@ addProvAttrsForRelEntry (Query *query, CopyMapRelEntry *rel,
 	Index curResno = list_length(query->targetList);
 	TargetEntry *newTe, *te;
 	Expr *expr;
+	List *provVars = NIL;
 
 	foreach(lc, child->provAttrs)
 	{
@@ -261,11 +262,12 @@ addProvAttrsForRelEntry (Query *query, CopyMapRelEntry *rel,
 					exprTypmod ((Node *) te->expr),
 					0);
 		newTe = makeTargetEntry(expr, ++curResno, te->resname, false);
-
-		/* adapt varno und varattno if referenced rte is used in a join-RTE */
-		getRTindexForProvTE (query, (Var *) expr);
+		provVars = lappend(provVars, expr);
 
 		query->targetList = lappend(query->targetList, newTe);
 		rel->provAttrs = lappend(rel->provAttrs, newTe);
 	}
+
+	/* adapt varno und varattno if referenced rte is used in a join-RTE */
+	getRTindexForProvTEs (query, provVars);
 }
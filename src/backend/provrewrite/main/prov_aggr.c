@@ -16,6 +16,18 @@
  *	to join on them we have to add them there. This doesn't change the result schema because group by attributes
  *	that did not belong to the original target list are projected out by the new top query node.
  *
+ *	If prov_use_aggr_single_pass is activated, aggregations without sublinks, LIMIT and DISTINCT are
+ *	rewritten by only rewriting their range table entries and adding the provenance attributes to the
+ *	target list of the aggregation itself. The query is marked (see IsAggSinglePass) and the planner
+ *	generates an Agg node that emits each input tuple of a group together with the aggregation results
+ *	for the group. This avoids computing the aggregation twice and the join between the aggregation and
+ *	its rewritten input.
+ *
+ *	Group by attributes that can never be NULL are joined with equality instead of IS NOT DISTINCT FROM.
+ *	For a top-k aggregation (LIMIT or OFFSET with GROUP BY) the join is an inner join, because each group
+ *	has at least one input tuple. Both let the planner drive the join from the few remaining groups and
+ *	probe the rewritten input with the group by values instead of computing its full provenance first.
+ *
  *-------------------------------------------------------------------------
  */
 
@@ -24,12 +36,15 @@
 #include "nodes/makefuncs.h"			// needed to create new nodes
 #include "nodes/print.h"				// pretty print node (trees)
 #include "optimizer/clauses.h"			// tools for expression clauses
+#include "parser/parsetree.h"			// rt_fetch
 #include "parser/parse_expr.h"			// expression transformation used for expression type calculation
 #include "parser/parse_oper.h"			// defintion of Operator type and convience routines for operator lookup
+#include "utils/guc.h"
 #include "utils/syscache.h"				// used to release heap tuple references
 #include "provrewrite/provlog.h"
 #include "provrewrite/provstack.h"
 #include "provrewrite/prov_util.h"
+#include "provrewrite/prov_nodes.h"
 #include "provrewrite/prov_aggr.h"
 #include "provrewrite/prov_spj.h"
 #include "provrewrite/provrewrite.h"
@@ -40,6 +55,9 @@
 #include "provrewrite/prov_sublink_util_search.h"
 
 /* Function declarations */
+static bool checkAggSinglePass (Query *query);
+static void moveResjunkToEnd (Query *query);
+static Query *rewriteAggregateSinglePass (Query *query);
 static bool isAggrExprWalker (Node *node, bool* context);
 static TargetEntry *getTEforSortgroupref (Query *query, Index sortGroupRef);
 static List *sortTargetListOnGroupBy (List *targetList);
@@ -74,6 +92,10 @@ rewriteAggregateQuery (Query *query)
 			return rewriteSPJQuery(query);
 	}
 
+	/* use the single pass rewrite if possible */
+	if (checkAggSinglePass(query))
+		return rewriteAggregateSinglePass(query);
+
 	/* get group by attributes */
 	groupByTLEs = getGroupByTLEs (query);
 
@@ -118,6 +140,19 @@ rewriteAggregateQuery (Query *query)
 	rte->jointype = JOIN_LEFT;
 	newTopQuery->rtable = lappend(newTopQuery->rtable, rte);
 
+	/*
+	 * Each group of a top-k aggregation has input tuples, so an inner join
+	 * returns the same result. Unlike the left join it can be reordered with
+	 * the joins of the rewritten input.
+	 */
+	if (query->groupClause != NIL
+			&& (query->limitCount != NULL || query->limitOffset != NULL))
+	{
+		rte->jointype = JOIN_INNER;
+		((JoinExpr *) linitial(newTopQuery->jointree->fromlist))->jointype =
+				JOIN_INNER;
+	}
+
 	SetProvRewrite(newRewriteQuery,false);
 	SetProvRewrite(query,false);
 	adaptRTEsForJoins(list_make1(linitial(newTopQuery->jointree->fromlist)), newTopQuery, "joinAggAndRewrite");
@@ -142,6 +177,134 @@ rewriteAggregateQuery (Query *query)
 	return newTopQuery;
 }
 
+/*
+ * Checks if the provenance of an aggregation can be computed in a single pass
+ * by the Agg node. This is the case if the option is activated, the query
+ * has no sublinks, LIMIT and DISTINCT and the rewrite of its range table
+ * entries does not change the multiset of input tuples of the aggregation.
+ */
+
+static bool
+checkAggSinglePass (Query *query)
+{
+	if (!prov_use_aggr_single_pass)
+		return false;
+
+	if (query->hasSubLinks || IsSublinkRewritten(query))
+		return false;
+
+	if (query->limitCount != NULL
+			|| query->limitOffset != NULL
+			|| query->distinctClause != NIL)
+		return false;
+
+	return rewritePreservesInput(query);
+}
+
+/*
+ * Checks that the rewritten range table entries of a query produce exactly
+ * one tuple for each tuple of the original range table entries. This holds for
+ * base relations and for SPJ subqueries that only access such range table
+ * entries. Aggregation, set operations, DISTINCT, LIMIT and sublinks
+ * in a subquery may duplicate tuples in the rewritten subquery.
+ */
+
+bool
+rewritePreservesInput (Query *query)
+{
+	ListCell *lc;
+	RangeTblEntry *rte;
+	Query *sub;
+
+	foreach(lc, query->rtable)
+	{
+		rte = (RangeTblEntry *) lfirst(lc);
+
+		if (rte->rtekind == RTE_JOIN || rte->rtekind == RTE_RELATION
+				|| rte->isProvBase || rte->provAttrs != NIL)
+			continue;
+
+		if (rte->rtekind != RTE_SUBQUERY)
+			return false;
+
+		sub = rte->subquery;
+
+		if (sub->hasAggs || sub->setOperations != NULL
+				|| sub->distinctClause != NIL || sub->hasSubLinks
+				|| sub->limitCount != NULL || sub->limitOffset != NULL)
+			return false;
+
+		if (!rewritePreservesInput(sub))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Rewrite an aggregation for single pass provenance computation. The range
+ * table entries of the aggregation are rewritten and their provenance
+ * attributes are added to the target list of the aggregation. These
+ * attributes are neither grouped nor aggregated, the planner and executor
+ * handle them by emitting each input tuple of a group (see nodeAgg.c).
+ */
+
+static Query *
+rewriteAggregateSinglePass (Query *query)
+{
+	List *subList;
+
+	subList = NIL;
+
+	addUsedMethod("AggSinglePass");
+	SetAggSinglePass(query, true);
+
+	query = rewriteSPJrestrict(query, &subList, list_length(query->rtable));
+	moveResjunkToEnd(query);
+
+	return query;
+}
+
+/*
+ * Moves resjunk target entries (e.g., group by attributes that are not in the
+ * result) behind the provenance attributes added by the rewrite, so the
+ * position of the provenance attributes matches the non-junk attributes seen
+ * by the parent query. The target entries are renumbered in place, so the
+ * provenance attribute lists on pStack stay valid.
+ */
+
+static void
+moveResjunkToEnd (Query *query)
+{
+	List *normal;
+	List *junk;
+	ListCell *lc;
+	TargetEntry *te;
+	AttrNumber curResno;
+
+	normal = NIL;
+	junk = NIL;
+
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk)
+			junk = lappend(junk, te);
+		else
+			normal = lappend(normal, te);
+	}
+
+	query->targetList = list_concat(normal, junk);
+
+	curResno = 1;
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+		te->resno = curResno++;
+	}
+}
+
 /*
  * Stripes of the aggregation from a query node. This is used to produce the input of
  * the aggregation that can be rewritten using SPJ-query rewrite. If returnMapping is
@@ -292,7 +455,9 @@ addSubqueryTargetListToTargetList (Query *query, Index rtindex)
 
 /*
  * Creates a join condition with equality comparisons for attributes from
- * joinAttrsLeft and joinAttrsRight.
+ * joinAttrsLeft and joinAttrsRight. Attributes that may be NULL are compared
+ * with IS NOT DISTINCT FROM. The join is marked as a provenance join to let
+ * the planner estimate its size from the number of groups.
  */
 
 //CHECK can be replaced by generic function from prov_util?
@@ -306,6 +471,7 @@ addJoinOnAttributes (Query *query, List *joinAttrsLeft, Query *rightSub)
 	ListCell *rightLc;
 	TargetEntry *curLeft;
 	TargetEntry *curRight;
+	Query *leftSub;
 	Node *equal;
 	List *equalConds;
 	Var *leftOp;
@@ -315,6 +481,7 @@ addJoinOnAttributes (Query *query, List *joinAttrsLeft, Query *rightSub)
 	RangeTblRef *rtRef;
 
 	equalConds = NIL;
+	leftSub = rt_fetch(1, query->rtable)->subquery;
 	joinAttrsRight = copyObject(rightSub->targetList);
 	joinAttrsLeft = copyObject(joinAttrsLeft);
 
@@ -351,8 +518,14 @@ addJoinOnAttributes (Query *query, List *joinAttrsLeft, Query *rightSub)
 				exprTypmod ((Node *) curRight->expr),
 				0);
 
-		/* create a not distinct condition (basically equality check but null = null) */
-		equal = createNotDistinctConditionForVars (leftOp, rightOp);
+		/*
+		 * create a not distinct condition (basically equality check but null = null)
+		 * unless the group by attribute is never NULL
+		 */
+		if (isNotNullExpr(leftSub, (Node *) curLeft->expr))
+			equal = createEqualityConditionForVars (leftOp, rightOp);
+		else
+			equal = createNotDistinctConditionForVars (leftOp, rightOp);
 
 		/* append current equality condition to equalConds List */
 		equalConds = lappend (equalConds, equal);
@@ -384,6 +557,7 @@ addJoinOnAttributes (Query *query, List *joinAttrsLeft, Query *rightSub)
 	joinExpr->jointype = JOIN_LEFT;
 	joinExpr->rtindex = 3;
 	joinExpr->quals = curRoot;
+	joinExpr->isProvJoin = true;
 
 	newFrom->fromlist = lappend (newFrom->fromlist, joinExpr);
 
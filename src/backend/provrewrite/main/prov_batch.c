@@ -0,0 +1,724 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_batch.c
+ *	  PERM C -  Execution of batches of provenance queries that share a common subexpression.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/main/prov_batch.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		provenance_batch(text[]) rewrites and executes a batch of queries and returns the result rows
+ *		of all queries as (query, result) pairs, where query is the position of the query in the batch
+ *		and result is the text representation of the row, e.g.,
+ *
+ *			SELECT * FROM provenance_batch(ARRAY['SELECT PROVENANCE a FROM r JOIN s ON (b = c) WHERE d < 5',
+ *												 'SELECT PROVENANCE b FROM r JOIN s ON (b = c) WHERE d > 7']);
+ *
+ *		Batches of provenance queries often differ only in their selection conditions and projections.
+ *		After the provenance rewrite such queries have the same range table and FROM clause. The queries
+ *		of the batch are grouped by range table and FROM clause. For each group of simple queries
+ *		(without aggregation, set operations or sublinks) the FROM clause restricted by the conjuncts of
+ *		the WHERE clause that are shared by all members of the group (the shared subexpression) is
+ *		computed once and stored in a temporary relation. Only the Vars used by the target lists and
+ *		the remaining conjuncts of the members are stored. Each member is then executed as a residual
+ *		query that applies its remaining conjuncts and target list to the temporary relation.
+ *
+ *		A shared subexpression is only used if the estimated cost of computing and storing it plus the
+ *		cost of scanning it once per member is lower than the estimated cost of the original queries.
+ *		Otherwise (e.g., if each query can use an index for its own selection conditions) the queries
+ *		of the group are executed as they are.
+ *
+ *		All queries of the batch are executed with the snapshot of the calling query. The result rows
+ *		are returned in the order of the queries in the batch. If the provenance rewrite is done by the
+ *		optimizer (prov_use_optimizer), the queries are not rewritten before planning and are always
+ *		executed one by one.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <math.h>
+
+#include "access/heapam.h"
+#include "access/xact.h"
+#include "catalog/dependency.h"
+#include "catalog/namespace.h"
+#include "catalog/pg_class.h"
+#include "catalog/pg_type.h"
+#include "executor/executor.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/cost.h"
+#include "optimizer/var.h"
+#include "parser/parse_relation.h"
+#include "tcop/tcopprot.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/fmgroids.h"
+#include "utils/guc.h"
+#include "utils/memutils.h"
+#include "utils/tuplestore.h"
+
+#include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_util.h"
+#include "provrewrite/prov_batch.h"
+
+/*
+ * A group of queries of the batch with the same range table and FROM clause. If sharedPlan is set,
+ * the shared subexpression of the group is stored in the temporary relation sharedRel.
+ */
+typedef struct BatchGroup
+{
+	List		   *members;		/* positions of the member queries in the batch (int) */
+	List		   *common;			/* conjuncts of the WHERE clause shared by all members */
+	List		   *vars;			/* Vars stored by the shared subexpression */
+	RangeVar	   *sharedRel;		/* temporary relation that stores the shared subexpression */
+	PlannedStmt	   *sharedPlan;		/* plan of the shared subexpression or NULL */
+} BatchGroup;
+
+/* DestReceiver that stores the result rows of the batch as (query, result) pairs */
+typedef struct BatchReceiver
+{
+	DestReceiver	pub;
+	Tuplestorestate *store;			/* result of provenance_batch */
+	TupleDesc		resultDesc;		/* type of the (query, result) pairs */
+	TupleDesc		rowDesc;		/* blessed result type of the current query */
+	FmgrInfo		recordOut;		/* record_out for the rows of the current query */
+	MemoryContext	storeContext;	/* context of the tuplestore */
+	MemoryContext	rowContext;		/* reset after each row */
+	int32			queryNo;		/* position of the current query in the batch */
+} BatchReceiver;
+
+/*
+ * Global variables.
+ */
+static int batchRelCounter = 0;
+
+/* Function declarations */
+static Query **parseBatch (ArrayType *array, int *numQueries);
+static bool isShareableQuery (Query *query);
+static List *groupBatch (Query **queries, int numQueries);
+static void findSharedSubexpression (BatchGroup *group, Query **queries);
+static List *getResidualQuals (Query *query, List *common);
+static int findSharedVar (List *vars, Var *var);
+static Query *makeSharedQuery (BatchGroup *group, Query *member);
+static bool isSharingCheaper (BatchGroup *group, PlannedStmt **plans);
+static Query *makeResidualQuery (Query *query, BatchGroup *group, RangeTblEntry *sharedRte);
+static Node *replaceSharedVarsMutator (Node *node, List *vars);
+static void runBatchPlan (PlannedStmt *plan, Snapshot snapshot, DestReceiver *dest);
+static BatchReceiver *createBatchReceiver (Tuplestorestate *store, TupleDesc resultDesc,
+		MemoryContext storeContext);
+static void batchReceiverStartup (DestReceiver *self, int operation, TupleDesc typeinfo);
+static void batchReceiverReceive (TupleTableSlot *slot, DestReceiver *self);
+static void batchReceiverShutdown (DestReceiver *self);
+static void batchReceiverDestroy (DestReceiver *self);
+
+/*
+ * Executes the batch of queries given as a text array and returns the result rows of all queries.
+ */
+
+Datum
+provenance_batch (PG_FUNCTION_ARGS)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	Tuplestorestate *store;
+	TupleDesc resultDesc;
+	BatchReceiver *receiver;
+	BatchGroup *group;
+	Query **queries;
+	PlannedStmt **plans;
+	List *groups;
+	Snapshot snapshot;
+	Snapshot saveActiveSnapshot;
+	RangeTblEntry *sharedRte;
+	Relation sharedRel;
+	ParseState *pstate;
+	ObjectAddress object;
+	MemoryContext batchContext;
+	MemoryContext oldcontext;
+	ListCell *lc;
+	ListCell *member;
+	int numQueries;
+	int i;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not " \
+						"allowed in this context")));
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+
+	if (get_call_result_type(fcinfo, NULL, &resultDesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+	resultDesc = CreateTupleDescCopy(resultDesc);
+	store = tuplestore_begin_heap(true, false, work_mem);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	batchContext = AllocSetContextCreate(CurrentMemoryContext,
+			"Provenance batch",
+			ALLOCSET_DEFAULT_MINSIZE,
+			ALLOCSET_DEFAULT_INITSIZE,
+			ALLOCSET_DEFAULT_MAXSIZE);
+	oldcontext = MemoryContextSwitchTo(batchContext);
+
+	/* rewrite and plan each query of the batch */
+	queries = parseBatch(PG_GETARG_ARRAYTYPE_P(0), &numQueries);
+	plans = (PlannedStmt **) palloc(Max(numQueries, 1) * sizeof(PlannedStmt *));
+
+	for (i = 0; i < numQueries; i++)
+		plans[i] = pg_plan_query((Query *) copyObject(queries[i]), 0, NULL);
+
+	/* find the shared subexpressions that are worth computing */
+	groups = groupBatch(queries, numQueries);
+
+	foreach(lc, groups)
+	{
+		group = (BatchGroup *) lfirst(lc);
+
+		if (list_length(group->members) < 2)
+			continue;
+
+		findSharedSubexpression(group, queries);
+		if (group->vars == NIL)
+			continue;
+
+		group->sharedPlan = pg_plan_query(makeSharedQuery(group,
+				queries[linitial_int(group->members)]), 0, NULL);
+
+		if (!isSharingCheaper(group, plans))
+			group->sharedPlan = NULL;
+	}
+
+	receiver = createBatchReceiver(store, resultDesc, rsinfo->econtext->ecxt_per_query_memory);
+
+	snapshot = CopySnapshot(ActiveSnapshot);
+	saveActiveSnapshot = ActiveSnapshot;
+
+	PG_TRY();
+	{
+		ActiveSnapshot = snapshot;
+
+		/* store the shared subexpressions and make them visible to the residual queries */
+		foreach(lc, groups)
+		{
+			group = (BatchGroup *) lfirst(lc);
+
+			if (group->sharedPlan != NULL)
+				runBatchPlan(group->sharedPlan, snapshot, None_Receiver);
+		}
+
+		CommandCounterIncrement();
+		snapshot->curcid = GetCurrentCommandId(false);
+
+		foreach(lc, groups)
+		{
+			group = (BatchGroup *) lfirst(lc);
+
+			if (group->sharedPlan == NULL)
+				continue;
+
+			sharedRel = heap_openrv(group->sharedRel, AccessShareLock);
+			pstate = make_parsestate(NULL);
+			sharedRte = addRangeTableEntryForRelation(pstate, sharedRel, NULL, false, false);
+
+			foreach(member, group->members)
+			{
+				i = lfirst_int(member);
+				plans[i] = pg_plan_query(makeResidualQuery(queries[i], group, sharedRte), 0, NULL);
+			}
+
+			heap_close(sharedRel, NoLock);
+		}
+
+		/* execute the queries in the order of the batch */
+		for (i = 0; i < numQueries; i++)
+		{
+			receiver->queryNo = i + 1;
+			runBatchPlan(plans[i], snapshot, (DestReceiver *) receiver);
+		}
+	}
+	PG_CATCH();
+	{
+		ActiveSnapshot = saveActiveSnapshot;
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	ActiveSnapshot = saveActiveSnapshot;
+
+	/* drop the temporary relations */
+	foreach(lc, groups)
+	{
+		group = (BatchGroup *) lfirst(lc);
+
+		if (group->sharedPlan == NULL)
+			continue;
+
+		object.classId = RelationRelationId;
+		object.objectId = RangeVarGetRelid(group->sharedRel, false);
+		object.objectSubId = 0;
+
+		performDeletion(&object, DROP_RESTRICT);
+	}
+
+	CommandCounterIncrement();
+
+	(*receiver->pub.rDestroy) ((DestReceiver *) receiver);
+
+	MemoryContextSwitchTo(oldcontext);
+	MemoryContextDelete(batchContext);
+
+	tuplestore_donestoring(store);
+
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = store;
+	rsinfo->setDesc = resultDesc;
+
+	return (Datum) 0;
+}
+
+/*
+ * Parse analyzes and rewrites the queries of the batch. Each element of the array has to be a single
+ * SELECT query.
+ */
+
+static Query **
+parseBatch (ArrayType *array, int *numQueries)
+{
+	Query **result;
+	Query *query;
+	List *rawList;
+	List *queryList;
+	Datum *elems;
+	bool *elemNulls;
+	char *sql;
+	int numElems;
+	int i;
+
+	deconstruct_array(array, TEXTOID, -1, false, 'i', &elems, &elemNulls, &numElems);
+
+	result = (Query **) palloc(Max(numElems, 1) * sizeof(Query *));
+
+	for (i = 0; i < numElems; i++)
+	{
+		if (elemNulls[i])
+			ereport(ERROR,
+					(errcode(ERRCODE_NULL_VALUE_NOT_ALLOWED),
+					 errmsg("query %d of the batch is NULL", i + 1)));
+
+		sql = DatumGetCString(DirectFunctionCall1(textout, elems[i]));
+
+		rawList = pg_parse_query(sql);
+		if (list_length(rawList) != 1)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("query %d of the batch must be a single statement", i + 1)));
+
+		queryList = pg_analyze_and_rewrite((Node *) linitial(rawList), sql, NULL, 0);
+		query = (list_length(queryList) == 1) ? (Query *) linitial(queryList) : NULL;
+
+		if (query == NULL || query->commandType != CMD_SELECT || query->utilityStmt != NULL
+				|| query->intoClause != NULL)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("query %d of the batch is not a SELECT query", i + 1)));
+
+		result[i] = query;
+	}
+
+	*numQueries = numElems;
+
+	return result;
+}
+
+/*
+ * Checks if a rewritten query is a simple query whose FROM clause and WHERE conjuncts can be shared with
+ * other queries.
+ */
+
+static bool
+isShareableQuery (Query *query)
+{
+	if (prov_use_optimizer)
+		return false;
+
+	return query->setOperations == NULL
+			&& !query->hasAggs
+			&& query->groupClause == NIL
+			&& query->havingQual == NULL
+			&& !query->hasSubLinks
+			&& query->rowMarks == NIL
+			&& query->jointree->fromlist != NIL;
+}
+
+/*
+ * Groups the queries of the batch by their range table and FROM clause. Queries that cannot share a
+ * subexpression form a group of their own.
+ */
+
+static List *
+groupBatch (Query **queries, int numQueries)
+{
+	List *groups = NIL;
+	BatchGroup *group;
+	Query *first;
+	ListCell *lc;
+	int i;
+
+	for (i = 0; i < numQueries; i++)
+	{
+		group = NULL;
+
+		if (isShareableQuery(queries[i]))
+		{
+			foreach(lc, groups)
+			{
+				first = queries[linitial_int(((BatchGroup *) lfirst(lc))->members)];
+
+				if (isShareableQuery(first)
+						&& equal(first->rtable, queries[i]->rtable)
+						&& equal(first->jointree->fromlist, queries[i]->jointree->fromlist))
+				{
+					group = (BatchGroup *) lfirst(lc);
+					break;
+				}
+			}
+		}
+
+		if (group == NULL)
+		{
+			group = (BatchGroup *) palloc0(sizeof(BatchGroup));
+			groups = lappend(groups, group);
+		}
+
+		group->members = lappend_int(group->members, i);
+	}
+
+	return groups;
+}
+
+/*
+ * Determines the WHERE conjuncts shared by all members of a group and the Vars the residual queries
+ * need from the shared subexpression. Volatile conjuncts are never shared.
+ */
+
+static void
+findSharedSubexpression (BatchGroup *group, Query **queries)
+{
+	Query *query;
+	Node *qual;
+	List *vars;
+	ListCell *lc;
+	ListCell *member;
+	bool shared;
+	char name[NAMEDATALEN];
+
+	query = queries[linitial_int(group->members)];
+
+	foreach(lc, make_ands_implicit((Expr *) query->jointree->quals))
+	{
+		qual = (Node *) lfirst(lc);
+
+		if (contain_volatile_functions(qual) || list_member(group->common, qual))
+			continue;
+
+		shared = true;
+		for_each_cell(member, lnext(list_head(group->members)))
+		{
+			query = queries[lfirst_int(member)];
+
+			if (!list_member(make_ands_implicit((Expr *) query->jointree->quals), qual))
+			{
+				shared = false;
+				break;
+			}
+		}
+
+		if (shared)
+			group->common = lappend(group->common, qual);
+	}
+
+	foreach(member, group->members)
+	{
+		query = queries[lfirst_int(member)];
+
+		vars = pull_var_clause((Node *) query->targetList, false);
+		vars = list_concat(vars, pull_var_clause(
+				(Node *) getResidualQuals(query, group->common), false));
+
+		foreach(lc, vars)
+			if (findSharedVar(group->vars, (Var *) lfirst(lc)) == 0)
+				group->vars = lappend(group->vars, lfirst(lc));
+	}
+
+	snprintf(name, NAMEDATALEN, "prov_batch_shared_%d", ++batchRelCounter);
+	group->sharedRel = makeRangeVar(NULL, pstrdup(name));
+	group->sharedRel->istemp = true;
+}
+
+/*
+ * Returns the WHERE conjuncts of a member query that are not part of the shared subexpression.
+ */
+
+static List *
+getResidualQuals (Query *query, List *common)
+{
+	return list_difference(make_ands_implicit((Expr *) query->jointree->quals), common);
+}
+
+/*
+ * Returns the attribute number of a Var in the shared subexpression or 0 if the Var is not stored.
+ */
+
+static int
+findSharedVar (List *vars, Var *var)
+{
+	ListCell *lc;
+	Var *sharedVar;
+	int attno = 0;
+
+	foreach(lc, vars)
+	{
+		sharedVar = (Var *) lfirst(lc);
+		attno++;
+
+		if (sharedVar->varno == var->varno && sharedVar->varattno == var->varattno
+				&& sharedVar->varlevelsup == var->varlevelsup)
+			return attno;
+	}
+
+	return 0;
+}
+
+/*
+ * Creates the query
+ *
+ *		SELECT v1 AS a1, ..., vn AS an INTO TEMP sharedRel FROM <from clause> WHERE <common conjuncts>
+ *
+ * that stores the shared subexpression of a group.
+ */
+
+static Query *
+makeSharedQuery (BatchGroup *group, Query *member)
+{
+	Query *result;
+	IntoClause *into;
+	TargetEntry *te;
+	ListCell *lc;
+	char name[NAMEDATALEN];
+	int attno = 0;
+
+	result = makeQuery();
+	result->rtable = (List *) copyObject(member->rtable);
+	result->jointree->fromlist = (List *) copyObject(member->jointree->fromlist);
+	if (group->common != NIL)
+		result->jointree->quals = (Node *) make_ands_explicit((List *) copyObject(group->common));
+
+	foreach(lc, group->vars)
+	{
+		snprintf(name, NAMEDATALEN, "a%d", ++attno);
+		te = makeTargetEntry((Expr *) copyObject(lfirst(lc)), attno, pstrdup(name), false);
+		result->targetList = lappend(result->targetList, te);
+	}
+
+	into = makeNode(IntoClause);
+	into->rel = group->sharedRel;
+	into->colNames = NIL;
+	into->options = NIL;
+	into->onCommit = ONCOMMIT_DROP;
+	into->tableSpaceName = NULL;
+	result->intoClause = into;
+
+	return result;
+}
+
+/*
+ * Compares the estimated cost of the original member queries of a group with the cost of computing
+ * and storing the shared subexpression once and scanning it for each member.
+ */
+
+static bool
+isSharingCheaper (BatchGroup *group, PlannedStmt **plans)
+{
+	Plan *sharedPlan = group->sharedPlan->planTree;
+	ListCell *member;
+	Cost originalCost = 0;
+	Cost sharedCost;
+	double tupleSize;
+	double pages;
+
+	foreach(member, group->members)
+		originalCost += plans[lfirst_int(member)]->planTree->total_cost;
+
+	tupleSize = MAXALIGN(sharedPlan->plan_width) + MAXALIGN(sizeof(HeapTupleHeaderData))
+			+ sizeof(ItemIdData);
+	pages = ceil(sharedPlan->plan_rows * tupleSize / BLCKSZ);
+
+	/* computing and writing the relation, then one sequential scan per member */
+	sharedCost = sharedPlan->total_cost + pages * seq_page_cost;
+	sharedCost += list_length(group->members)
+			* (pages * seq_page_cost + sharedPlan->plan_rows * cpu_tuple_cost);
+
+	return sharedCost < originalCost;
+}
+
+/*
+ * Creates the residual query of a member query of a group that applies the remaining conjuncts and
+ * the target list of the member to the stored shared subexpression.
+ */
+
+static Query *
+makeResidualQuery (Query *query, BatchGroup *group, RangeTblEntry *sharedRte)
+{
+	Query *result;
+	List *quals;
+	RangeTblRef *rtRef;
+
+	result = (Query *) copyObject(query);
+	quals = getResidualQuals(result, group->common);
+
+	MAKE_RTREF(rtRef, 1);
+	result->rtable = list_make1(copyObject(sharedRte));
+	result->jointree = makeFromExpr(list_make1(rtRef), (quals == NIL) ? NULL :
+			replaceSharedVarsMutator((Node *) make_ands_explicit(quals), group->vars));
+	result->targetList = (List *) replaceSharedVarsMutator((Node *) result->targetList,
+			group->vars);
+
+	return result;
+}
+
+/*
+ * Replaces each Var with the corresponding attribute of the stored shared subexpression.
+ */
+
+static Node *
+replaceSharedVarsMutator (Node *node, List *vars)
+{
+	Var *var;
+	int attno;
+
+	if (node == NULL)
+		return NULL;
+
+	if (IsA(node, Var))
+	{
+		var = (Var *) node;
+		attno = findSharedVar(vars, var);
+
+		if (attno == 0)
+			elog(ERROR, "variable %d.%d is not stored by the shared subexpression",
+					var->varno, var->varattno);
+
+		return (Node *) makeVar(1, attno, var->vartype, var->vartypmod, 0);
+	}
+
+	return expression_tree_mutator(node, replaceSharedVarsMutator, (void *) vars);
+}
+
+/*
+ * Executes a plan of the batch and sends its result to dest.
+ */
+
+static void
+runBatchPlan (PlannedStmt *plan, Snapshot snapshot, DestReceiver *dest)
+{
+	QueryDesc *queryDesc;
+
+	queryDesc = CreateQueryDesc(plan, snapshot, InvalidSnapshot, dest, NULL, false);
+
+	ExecutorStart(queryDesc, 0);
+	ExecutorRun(queryDesc, ForwardScanDirection, 0L);
+	ExecutorEnd(queryDesc);
+	FreeQueryDesc(queryDesc);
+}
+
+/*
+ * Creates the DestReceiver that converts the result rows of the queries into (query, result) pairs.
+ */
+
+static BatchReceiver *
+createBatchReceiver (Tuplestorestate *store, TupleDesc resultDesc, MemoryContext storeContext)
+{
+	BatchReceiver *self = (BatchReceiver *) palloc0(sizeof(BatchReceiver));
+
+	self->pub.receiveSlot = batchReceiverReceive;
+	self->pub.rStartup = batchReceiverStartup;
+	self->pub.rShutdown = batchReceiverShutdown;
+	self->pub.rDestroy = batchReceiverDestroy;
+	self->pub.mydest = DestNone;
+
+	self->store = store;
+	self->resultDesc = resultDesc;
+	self->storeContext = storeContext;
+	self->rowContext = AllocSetContextCreate(CurrentMemoryContext,
+			"Provenance batch row",
+			ALLOCSET_SMALL_MINSIZE,
+			ALLOCSET_SMALL_INITSIZE,
+			ALLOCSET_SMALL_MAXSIZE);
+
+	return self;
+}
+
+static void
+batchReceiverStartup (DestReceiver *self, int operation, TupleDesc typeinfo)
+{
+	BatchReceiver *receiver = (BatchReceiver *) self;
+
+	receiver->rowDesc = CreateTupleDescCopy(typeinfo);
+	BlessTupleDesc(receiver->rowDesc);
+	fmgr_info(F_RECORD_OUT, &receiver->recordOut);
+}
+
+static void
+batchReceiverReceive (TupleTableSlot *slot, DestReceiver *self)
+{
+	BatchReceiver *receiver = (BatchReceiver *) self;
+	HeapTuple row;
+	HeapTuple result;
+	Datum values[2];
+	bool nulls[2] = { false, false };
+	MemoryContext oldcontext;
+
+	oldcontext = MemoryContextSwitchTo(receiver->rowContext);
+
+	slot_getallattrs(slot);
+	row = heap_form_tuple(receiver->rowDesc, slot->tts_values, slot->tts_isnull);
+
+	values[0] = Int32GetDatum(receiver->queryNo);
+	values[1] = DirectFunctionCall1(textin, CStringGetDatum(
+			OutputFunctionCall(&receiver->recordOut, HeapTupleGetDatum(row))));
+	result = heap_form_tuple(receiver->resultDesc, values, nulls);
+
+	MemoryContextSwitchTo(receiver->storeContext);
+	tuplestore_puttuple(receiver->store, result);
+	MemoryContextSwitchTo(oldcontext);
+
+	MemoryContextReset(receiver->rowContext);
+}
+
+static void
+batchReceiverShutdown (DestReceiver *self)
+{
+	/* do nothing */
+}
+
+static void
+batchReceiverDestroy (DestReceiver *self)
+{
+	BatchReceiver *receiver = (BatchReceiver *) self;
+
+	MemoryContextDelete(receiver->rowContext);
+	pfree(receiver);
+}
@@ -0,0 +1,331 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_cache.c
+ *	  PERM C -  Backend local cache of rewritten and planned provenance queries.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/prov_cache.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		Rewriting a provenance query and planning the (often large) rewritten query is expensive, but
+ *		applications tend to issue the same provenance queries over and over again. If
+ *		prov_use_rewrite_cache is activated the TCop stores the plan of each simple provenance SELECT
+ *		in this cache and executes the cached plan the next time the same query is issued. The key of
+ *		an entry is a fingerprint build from the query text with insignificant whitespace removed, the
+ *		settings of the provenance rewriter options, the user and the search_path. The cached plans are
+ *		stored as CachedPlanSources so we get invalidation through the relcache callbacks of the plan
+ *		cache for free. An invalidated plan is rewritten and planned again on its next use. At most
+ *		prov_rewrite_cache_size queries are cached, the least recently used entry is dropped first.
+ *
+ *		A query that is not in this cache may have been rewritten by another backend, the rewritten query
+ *		is looked up in the shared memory cache before the query is rewritten (see prov_shared_cache.c).
+ *
+ *		Queries that use transformation provenance are not cached, because their rewrite registers
+ *		information in a backend global index that is needed during execution.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <ctype.h>
+
+#include "access/hash.h"
+#include "catalog/namespace.h"
+#include "lib/dllist.h"
+#include "miscadmin.h"
+#include "nodes/plannodes.h"
+#include "parser/gramparse.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+
+#include "provrewrite/prov_cache.h"
+
+/*
+ * An entry of the rewrite cache. Entries are hashed on the hash value of their key, collisions are
+ * detected by comparing the full key.
+ */
+typedef struct ProvCacheEntry
+{
+	uint32				hash;			/* hash value of the key (hash table key) */
+	char			   *key;			/* fingerprint of the query and the rewriter settings */
+	CachedPlanSource   *plansource;		/* the rewritten and planned query */
+	Dlelem				lruElem;		/* position in the LRU list */
+} ProvCacheEntry;
+
+#define INITIAL_CACHE_SIZE 64
+
+/*
+ * Global variables.
+ */
+static HTAB *provCache = NULL;
+static Dllist provCacheLRU;
+
+/* Function declarations */
+static void initProvCache (void);
+static void removeCacheEntry (ProvCacheEntry *entry);
+static void normalizeQueryString (StringInfo str, const char *queryString);
+static const char *copyQuoted (StringInfo str, const char *queryString, const char *c);
+
+/*
+ * Returns the cached plan source for query string queryString or NULL if the query has not been
+ * cached for the current rewriter settings.
+ */
+
+CachedPlanSource *
+provCacheLookup (const char *queryString)
+{
+	ProvCacheEntry *entry;
+	char *key;
+	uint32 hash;
+
+	if (provCache == NULL)
+		return NULL;
+
+	key = buildProvCacheKey(queryString);
+	hash = DatumGetUInt32(hash_any((unsigned char *) key, strlen(key)));
+
+	entry = (ProvCacheEntry *) hash_search(provCache, &hash, HASH_FIND, NULL);
+
+	if (entry == NULL || strcmp(entry->key, key) != 0)
+	{
+		pfree(key);
+		return NULL;
+	}
+
+	pfree(key);
+	DLMoveToFront(&entry->lruElem);
+
+	return entry->plansource;
+}
+
+/*
+ * Stores the plan of a provenance query in the cache. rawParseTree has to be an unmodified copy of
+ * the output of raw_parser, because the plan cache uses it to rewrite and plan the query again
+ * after an invalidation. Statement lists that are not a single SELECT are ignored.
+ */
+
+void
+provCacheStore (const char *queryString, Node *rawParseTree, const char *commandTag, List *stmtList)
+{
+	ProvCacheEntry *entry;
+	PlannedStmt *stmt;
+	CachedPlanSource *plansource;
+	char *key;
+	uint32 hash;
+	bool found;
+
+	if (list_length(stmtList) != 1 || !IsA(linitial(stmtList), PlannedStmt))
+		return;
+
+	stmt = (PlannedStmt *) linitial(stmtList);
+	if (stmt->commandType != CMD_SELECT || stmt->utilityStmt || stmt->intoClause)
+		return;
+
+	if (provCache == NULL)
+		initProvCache();
+
+	key = buildProvCacheKey(queryString);
+	hash = DatumGetUInt32(hash_any((unsigned char *) key, strlen(key)));
+
+	/* create the plan cache entry first, so an error does not leave a half filled entry behind */
+	plansource = CreateCachedPlan(rawParseTree, queryString, commandTag, NULL, 0, 0, stmtList,
+			true, false);
+
+	/* a colliding entry is replaced */
+	entry = (ProvCacheEntry *) hash_search(provCache, &hash, HASH_FIND, NULL);
+	if (entry != NULL)
+		removeCacheEntry(entry);
+
+	entry = (ProvCacheEntry *) hash_search(provCache, &hash, HASH_ENTER, &found);
+	Assert(!found);
+
+	entry->key = MemoryContextStrdup(CacheMemoryContext, key);
+	entry->plansource = plansource;
+	DLInitElem(&entry->lruElem, entry);
+	DLAddHead(&provCacheLRU, &entry->lruElem);
+
+	pfree(key);
+
+	/* evict least recently used entries */
+	while (hash_get_num_entries(provCache) > prov_rewrite_cache_size)
+		removeCacheEntry((ProvCacheEntry *) DLE_VAL(DLGetTail(&provCacheLRU)));
+}
+
+/*
+ * Creates the hash table and LRU list of the cache.
+ */
+
+static void
+initProvCache (void)
+{
+	HASHCTL ctl;
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(uint32);
+	ctl.entrysize = sizeof(ProvCacheEntry);
+	ctl.hash = oid_hash;
+
+	provCache = hash_create("Provenance rewrite cache", INITIAL_CACHE_SIZE, &ctl,
+			HASH_ELEM | HASH_FUNCTION);
+	DLInitList(&provCacheLRU);
+}
+
+/*
+ * Removes an entry from the cache and releases its plan.
+ */
+
+static void
+removeCacheEntry (ProvCacheEntry *entry)
+{
+	uint32 hash = entry->hash;
+
+	DLRemove(&entry->lruElem);
+	DropCachedPlan(entry->plansource);
+	pfree(entry->key);
+
+	hash_search(provCache, &hash, HASH_REMOVE, NULL);
+}
+
+/*
+ * Builds the cache key for a query string. Besides the normalized query text the key contains
+ * everything else that influences parse analysis, rewrite and planning of the query: the user,
+ * the search_path and the settings of the provenance rewriter and planner.
+ */
+
+char *
+buildProvCacheKey (const char *queryString)
+{
+	StringInfoData str;
+
+	initStringInfo(&str);
+
+	appendStringInfo(&str, "%u|%s|%d|%d%d%d%d%d%d%d%d%d%d%d%d%d%d|%g|",
+			GetUserId(),
+			namespace_search_path,
+			standard_conforming_strings,
+			prov_use_set_optimization,
+			prov_use_wl_union_semantics,
+			prov_use_tagged_union,
+			prov_use_sublink_optimization_left_join,
+			prov_use_sublink_move_to_target,
+			prov_use_sublink_transfrom_top_level_any_to_join,
+			prov_use_unnest_JA,
+			prov_use_optimizer,
+			prov_use_selection_pushdown,
+			prov_use_inequality_deduction,
+			prov_use_aggr_single_pass,
+			prov_use_anti_join,
+			prov_use_sublink_memoization,
+			prov_xml_whitespace,
+			prov_optimizer_plan_share);
+
+	normalizeQueryString(&str, queryString);
+
+	return str.data;
+}
+
+/*
+ * Appends queryString to str replacing each sequence of white space outside of literals, quoted
+ * identifiers and comments with a single blank. Leading and trailing white space and trailing
+ * semicolons are removed. Dollar quoted strings are not recognized, thus query strings that
+ * contain a '$' are appended unmodified.
+ */
+
+static void
+normalizeQueryString (StringInfo str, const char *queryString)
+{
+	const char *c = queryString;
+	int start = str->len;
+	bool pendingSpace = false;
+
+	if (strchr(queryString, '$') != NULL)
+	{
+		appendStringInfoString(str, queryString);
+		return;
+	}
+
+	while (*c)
+	{
+		if (isspace((unsigned char) *c))
+		{
+			pendingSpace = true;
+			c++;
+			continue;
+		}
+
+		if (pendingSpace && str->len > start)
+			appendStringInfoChar(str, ' ');
+		pendingSpace = false;
+
+		/* literal or quoted identifier */
+		if (*c == '\'' || *c == '"')
+			c = copyQuoted(str, queryString, c);
+		/* line comment, keep the newline that terminates it */
+		else if (c[0] == '-' && c[1] == '-')
+		{
+			while (*c && *c != '\n')
+				appendStringInfoChar(str, *c++);
+			if (*c)
+				appendStringInfoChar(str, *c++);
+		}
+		/* block comments may be nested, simply keep the remainder of the query */
+		else if (c[0] == '/' && c[1] == '*')
+		{
+			appendStringInfoString(str, c);
+			return;
+		}
+		else
+			appendStringInfoChar(str, *c++);
+	}
+
+	while (str->len > start
+			&& (str->data[str->len - 1] == ';' || str->data[str->len - 1] == ' '))
+		str->data[--str->len] = '\0';
+}
+
+/*
+ * Copies the literal or quoted identifier starting at c to str. Returns a pointer to the first
+ * character after the closing quote.
+ */
+
+static const char *
+copyQuoted (StringInfo str, const char *queryString, const char *c)
+{
+	char quote = *c;
+	bool backslashEscapes = false;
+
+	/* backslashes escape in E'' strings and in all strings if standard_conforming_strings is off */
+	if (quote == '\'')
+	{
+		backslashEscapes = !standard_conforming_strings;
+
+		if (c > queryString && (c[-1] == 'E' || c[-1] == 'e'))
+			backslashEscapes = backslashEscapes || c - 1 == queryString
+					|| !(isalnum((unsigned char) c[-2]) || c[-2] == '_'
+							|| IS_HIGHBIT_SET(c[-2]));
+	}
+
+	appendStringInfoChar(str, *c++);
+
+	while (*c)
+	{
+		if ((backslashEscapes && *c == '\\' && c[1] != '\0')
+				|| (*c == quote && c[1] == quote))
+		{
+			appendBinaryStringInfo(str, c, 2);
+			c += 2;
+			continue;
+		}
+
+		appendStringInfoChar(str, *c);
+		if (*c++ == quote)
+			break;
+	}
+
+	return c;
+}
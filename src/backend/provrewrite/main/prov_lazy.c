@@ -0,0 +1,984 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_lazy.c
+ *	  PERM C -  Lazy provenance cursors that compute the provenance of fetched rows only.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/main/prov_lazy.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		If prov_use_lazy_cursors is activated, a cursor declared for a provenance query runs the
+ *		original query without provenance computation. Each FETCH from the cursor fetches the next
+ *		batch of rows of the original query and computes the provenance of the batch with a single
+ *		execution of the provenance query restricted to the fetched rows. Thus, the cost of
+ *		provenance computation depends on the number of fetched rows instead of the size of the
+ *		query result.
+ *
+ *		Fetched rows are matched with the rows of the provenance query by their identity, not by
+ *		their values. The identity of a result row of an SPJ query is the ctid (and tableoid for
+ *		inheritance parents) of the base relation tuples it was built from, of an aggregation the
+ *		group-by expressions, and of a DISTINCT query or set operation without ALL the values of
+ *		the row. If the query does not output its row identity, it is added to the result of the
+ *		cursor and removed from the result of FETCH. Each identity attribute is restricted with
+ *		"ai = ANY($i)" where $i is the array of identities of the fetched rows:
+ *
+ *			SELECT * FROM (provenance query) WHERE a1 = ANY($1) AND ... AND an = ANY($n)
+ *
+ *		The restricted query may return rows of other combinations of these values; they are
+ *		discarded by comparing the identity of each returned row with the identities of the
+ *		fetched rows. Because NULL values are not equal to anything, "OR ai IS NULL" is added for
+ *		each identity attribute that is NULL for a fetched row. A restricted query is planned for
+ *		each combination of such attributes; the query without NULLs is planned when the cursor is
+ *		declared.
+ *
+ *		Only cursors for queries with influence, copy or TUPLEID contribution semantics whose row
+ *		identity can be determined and has equality operators and array types are computed lazily.
+ *		The state of a lazy cursor is released when its portal is dropped, including cursors that
+ *		are closed implicitly at the end of a transaction.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/hash.h"
+#include "access/heapam.h"
+#include "access/xact.h"
+#include "catalog/pg_type.h"
+#include "executor/executor.h"
+#include "executor/tstoreReceiver.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/plancat.h"
+#include "optimizer/tlist.h"
+#include "parser/parse_expr.h"
+#include "parser/parse_oper.h"
+#include "parser/parsetree.h"
+#include "tcop/pquery.h"
+#include "tcop/tcopprot.h"
+#include "utils/array.h"
+#include "utils/hsearch.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
+#include "utils/tuplestore.h"
+
+#include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_util.h"
+#include "provrewrite/provrewrite.h"
+#include "provrewrite/prov_lazy.h"
+
+/*
+ * A lazy provenance cursor. The hash key is the name of the cursor. Because the entry is created
+ * before the portal of the cursor, it is associated with the portal through the start time of the
+ * statement that declared the cursor.
+ */
+typedef struct LazyProvCursor
+{
+	char			name[NAMEDATALEN];	/* name of the cursor (hash table key) */
+	MemoryContext	context;			/* context that holds the queries and plans */
+	TimestampTz		creationTime;		/* start of the statement that declared the cursor */
+	Query		   *provQuery;			/* the rewritten provenance query */
+	TupleDesc		tupDesc;			/* result type of FETCH */
+	TupleDesc		probeDesc;			/* result type of the restricted provenance query */
+	TupleDesc		identDesc;			/* type of the row identity */
+	int				numOrigAttrs;		/* number of result attributes of the original query */
+	int				numAdded;			/* identity attributes added to the result of the query */
+	int				firstIdent;			/* position of the first identity attribute */
+	int				numIdent;			/* number of identity attributes */
+	Oid			   *eqOps;				/* equality operator of each identity attribute */
+	Oid			   *arrayTypes;			/* array type of each identity attribute */
+	List		   *plans;				/* restricted queries planned so far (LazyProvPlan) */
+} LazyProvCursor;
+
+/* a restricted provenance query planned for a combination of NULL values */
+typedef struct LazyProvPlan
+{
+	char		   *nulls;				/* 'n' for each identity attribute with NULLs */
+	PlannedStmt	   *plan;
+} LazyProvPlan;
+
+/* a distinct row identity of the current batch and its provenance */
+typedef struct LazyProvRow
+{
+	MinimalTuple	identity;
+	List		   *provenance;			/* rows of the restricted query (MinimalTuple) */
+} LazyProvRow;
+
+/* row identities of the current batch with the same hash value */
+typedef struct FetchedRowsEntry
+{
+	uint32			hash;
+	List		   *rows;				/* LazyProvRow */
+} FetchedRowsEntry;
+
+#define INITIAL_CURSOR_HASH_SIZE 16
+#define LAZY_IDENTITY_NAME "lazy_identity"
+
+/*
+ * Global variables.
+ */
+static HTAB *lazyCursors = NULL;
+
+/* Function declarations */
+static bool getRowIdentity (Query *query, List **identity, bool *byValue);
+static bool getJoinTreeIdentity (Query *query, Node *jtnode, List **identity);
+static int addIdentityTargetEntry (Query *query, Expr *expr);
+static void dropLazyProvCursor (LazyProvCursor *cursor);
+static void dropOrphanedLazyProvCursors (void);
+static LazyProvCursor *getLazyProvCursor (Portal portal);
+static PlannedStmt *getLazyProvPlan (LazyProvCursor *cursor, char *nulls);
+static Query *makeRestrictedQuery (LazyProvCursor *cursor, char *nulls);
+static MinimalTuple getRowIdentityTuple (LazyProvCursor *cursor, TupleTableSlot *slot);
+static LazyProvRow *lookupFetchedRow (HTAB *fetchedRows, MinimalTuple identity, bool create);
+
+/*
+ * Checks if the provenance of a cursor declaration query can be computed lazily.
+ */
+
+bool
+isLazyProvCursorQuery (Query *query)
+{
+	if (query->utilityStmt == NULL || !IsA(query->utilityStmt, DeclareCursorStmt)
+			|| !IsProvRewrite(query))
+		return false;
+
+	/* the rows of a normalized provenance cursor do not correspond to result tuples */
+	if (IsProvNormalized(query))
+		return false;
+
+	switch (ContributionType(query))
+	{
+		case CONTR_INFLUENCE:
+		case CONTR_COPY_COMPLETE_TRANSITIVE:
+		case CONTR_COPY_COMPLETE_NONTRANSITIVE:
+		case CONTR_COPY_PARTIAL_TRANSITIVE:
+		case CONTR_COPY_PARTIAL_NONTRANSITIVE:
+		case CONTR_TUPLEID:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Rewrites the provenance query for a cursor declaration and plans the restricted provenance query
+ * for rows without NULL values. Returns the query the cursor runs instead of the provenance query,
+ * that is the original query extended with the identity of its result rows, or NULL if the
+ * provenance of the cursor cannot be computed lazily. Afterwards FETCH returns the provenance of
+ * the fetched rows.
+ */
+
+Query *
+defineLazyProvCursor (Query *query, char *cursorName)
+{
+	LazyProvCursor *cursor;
+	Query *cursorQuery;
+	Query *provQuery;
+	Query *restricted;
+	TargetEntry *te;
+	Operator op;
+	MemoryContext context;
+	MemoryContext oldcontext;
+	List *identity;
+	List *fetchTargetList = NIL;
+	ListCell *lc;
+	char key[NAMEDATALEN];
+	char *nulls;
+	Oid *types;
+	int numOrigAttrs = 0;
+	int i;
+	bool byValue;
+	bool found;
+
+	dropOrphanedLazyProvCursors();
+
+	/* declaring the cursor fails if a cursor with the same name is open */
+	if (GetPortalByName(cursorName) != NULL)
+		return NULL;
+
+	foreach(lc, query->targetList)
+		if (!((TargetEntry *) lfirst(lc))->resjunk)
+			numOrigAttrs++;
+
+	/* extend the cursor query with the identity of its result rows */
+	cursorQuery = (Query *) copyObject(query);
+	if (!getRowIdentity(cursorQuery, &identity, &byValue))
+		return NULL;
+
+	foreach(lc, identity)
+		addIdentityTargetEntry(cursorQuery, (Expr *) lfirst(lc));
+
+	/* the identity attributes are compared with the identities of the fetched rows */
+	types = (Oid *) palloc(sizeof(Oid) * (numOrigAttrs + list_length(identity)));
+	i = 0;
+	foreach(lc, cursorQuery->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk || (!byValue && te->resno <= numOrigAttrs))
+			continue;
+
+		types[i] = exprType((Node *) te->expr);
+		if (!OidIsValid(get_array_type(types[i])))
+			return NULL;
+
+		op = equality_oper(types[i], true);
+		if (op == NULL)
+			return NULL;
+		ReleaseSysCache(op);
+		i++;
+	}
+
+	/* rewrite a copy of the query into the provenance query */
+	provQuery = (Query *) copyObject(cursorQuery);
+	provQuery->utilityStmt = NULL;
+	provQuery = provenanceRewriteQuery(provQuery);
+
+	context = AllocSetContextCreate(TopMemoryContext,
+			"Lazy provenance cursor",
+			ALLOCSET_SMALL_MINSIZE,
+			ALLOCSET_SMALL_INITSIZE,
+			ALLOCSET_DEFAULT_MAXSIZE);
+
+	if (lazyCursors == NULL)
+	{
+		HASHCTL ctl;
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = NAMEDATALEN;
+		ctl.entrysize = sizeof(LazyProvCursor);
+
+		lazyCursors = hash_create("Lazy provenance cursors", INITIAL_CURSOR_HASH_SIZE, &ctl,
+				HASH_ELEM);
+	}
+
+	MemSet(key, 0, NAMEDATALEN);
+	StrNCpy(key, cursorName, NAMEDATALEN);
+
+	cursor = (LazyProvCursor *) hash_search(lazyCursors, key, HASH_ENTER, &found);
+	Assert(!found);
+
+	cursor->context = context;
+	cursor->creationTime = GetCurrentStatementStartTimestamp();
+	cursor->numOrigAttrs = numOrigAttrs;
+	cursor->numAdded = list_length(identity);
+	cursor->firstIdent = byValue ? 1 : numOrigAttrs + 1;
+	cursor->numIdent = byValue ? numOrigAttrs : list_length(identity);
+	cursor->provQuery = NULL;
+	cursor->tupDesc = NULL;
+	cursor->plans = NIL;
+
+	oldcontext = MemoryContextSwitchTo(context);
+
+	cursor->provQuery = (Query *) copyObject(provQuery);
+	cursor->eqOps = (Oid *) palloc(sizeof(Oid) * cursor->numIdent);
+	cursor->arrayTypes = (Oid *) palloc(sizeof(Oid) * cursor->numIdent);
+	cursor->identDesc = CreateTemplateTupleDesc(cursor->numIdent, false);
+
+	for (i = 0; i < cursor->numIdent; i++)
+	{
+		op = equality_oper(types[i], false);
+		cursor->eqOps[i] = oprid(op);
+		ReleaseSysCache(op);
+
+		cursor->arrayTypes[i] = get_array_type(types[i]);
+		TupleDescInitEntry(cursor->identDesc, (AttrNumber) (i + 1), NULL, types[i], -1, 0);
+	}
+
+	/* FETCH returns the result of the restricted query without the added identity attributes */
+	restricted = makeRestrictedQuery(cursor, NULL);
+	cursor->probeDesc = ExecCleanTypeFromTL(restricted->targetList, false);
+
+	foreach(lc, restricted->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resno <= numOrigAttrs || te->resno > numOrigAttrs + cursor->numAdded)
+			fetchTargetList = lappend(fetchTargetList, te);
+	}
+	cursor->tupDesc = ExecCleanTypeFromTL(fetchTargetList, false);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	/* plan the restricted query for rows without NULL values */
+	nulls = (char *) palloc(cursor->numIdent + 1);
+	MemSet(nulls, ' ', cursor->numIdent);
+	nulls[cursor->numIdent] = '\0';
+
+	getLazyProvPlan(cursor, nulls);
+
+	return cursorQuery;
+}
+
+/*
+ * Releases the state of the lazy provenance cursor of portal. Called when the portal is dropped.
+ */
+
+void
+releaseLazyProvCursor (Portal portal)
+{
+	LazyProvCursor *cursor = getLazyProvCursor(portal);
+
+	if (cursor != NULL)
+		dropLazyProvCursor(cursor);
+}
+
+/*
+ * Returns the result type of FETCH for a lazy provenance cursor or NULL if portal is not a lazy
+ * provenance cursor.
+ */
+
+TupleDesc
+getLazyProvCursorTupleDesc (Portal portal)
+{
+	LazyProvCursor *cursor = getLazyProvCursor(portal);
+
+	return cursor ? cursor->tupDesc : NULL;
+}
+
+/*
+ * Executes FETCH for a lazy provenance cursor: fetches a batch of rows from the portal and sends
+ * the provenance of these rows to dest in the order of the fetched rows. The provenance is
+ * computed with the snapshot of the cursor. Returns the number of rows sent.
+ */
+
+long
+lazyProvCursorFetch (Portal portal, FetchStmt *stmt, DestReceiver *dest)
+{
+	LazyProvCursor *cursor = getLazyProvCursor(portal);
+	Tuplestorestate *fetched;
+	Tuplestorestate *result;
+	DestReceiver *fetchDest;
+	DestReceiver *resultDest;
+	TupleTableSlot *slot;
+	TupleTableSlot *identSlot;
+	TupleTableSlot *resultSlot;
+	TupleTableSlot *outSlot;
+	LazyProvRow *row;
+	ParamListInfo params;
+	QueryDesc *queryDesc;
+	HTAB *fetchedRows;
+	HASHCTL ctl;
+	Snapshot saveActiveSnapshot;
+	MemoryContext fetchContext;
+	MemoryContext oldcontext;
+	List *fetchOrder = NIL;
+	List *distinctRows = NIL;
+	ListCell *lc;
+	ListCell *provLc;
+	Datum *elems;
+	char *nulls;
+	long nprocessed = 0;
+	int16 typlen;
+	bool typbyval;
+	char typalign;
+	bool isNull;
+	int numElems;
+	int i;
+	int j;
+
+	Assert(cursor != NULL);
+
+	fetchContext = AllocSetContextCreate(CurrentMemoryContext,
+			"Lazy provenance fetch",
+			ALLOCSET_DEFAULT_MINSIZE,
+			ALLOCSET_DEFAULT_INITSIZE,
+			ALLOCSET_DEFAULT_MAXSIZE);
+	oldcontext = MemoryContextSwitchTo(fetchContext);
+
+	/* fetch the next batch of rows of the original query */
+	fetched = tuplestore_begin_heap(false, false, work_mem);
+	fetchDest = CreateTuplestoreDestReceiver(fetched, fetchContext);
+	PortalRunFetch(portal, stmt->direction, stmt->howMany, fetchDest);
+	(*fetchDest->rDestroy) (fetchDest);
+
+	/* collect the distinct row identities of the batch */
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(uint32);
+	ctl.entrysize = sizeof(FetchedRowsEntry);
+	ctl.hash = oid_hash;
+	ctl.hcxt = fetchContext;
+	fetchedRows = hash_create("Lazy provenance fetched rows", 256, &ctl,
+			HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+	slot = MakeSingleTupleTableSlot(portal->tupDesc);
+
+	while (tuplestore_gettupleslot(fetched, true, slot))
+	{
+		MinimalTuple identity = getRowIdentityTuple(cursor, slot);
+
+		row = lookupFetchedRow(fetchedRows, identity, false);
+		if (row == NULL)
+		{
+			row = lookupFetchedRow(fetchedRows, identity, true);
+			distinctRows = lappend(distinctRows, row);
+		}
+		else
+			pfree(identity);
+
+		fetchOrder = lappend(fetchOrder, row);
+	}
+
+	ExecDropSingleTupleTableSlot(slot);
+	tuplestore_end(fetched);
+
+	/* compute the provenance of all fetched rows with one execution of the restricted query */
+	result = tuplestore_begin_heap(false, false, work_mem);
+
+	if (distinctRows != NIL)
+	{
+		params = (ParamListInfo) palloc0(sizeof(ParamListInfoData)
+				+ (cursor->numIdent - 1) * sizeof(ParamExternData));
+		params->numParams = cursor->numIdent;
+		nulls = (char *) palloc(cursor->numIdent + 1);
+		elems = (Datum *) palloc(sizeof(Datum) * list_length(distinctRows));
+		identSlot = MakeSingleTupleTableSlot(cursor->identDesc);
+
+		for (i = 0; i < cursor->numIdent; i++)
+		{
+			Oid elemType = cursor->identDesc->attrs[i]->atttypid;
+
+			nulls[i] = ' ';
+			numElems = 0;
+
+			foreach(lc, distinctRows)
+			{
+				row = (LazyProvRow *) lfirst(lc);
+				ExecStoreMinimalTuple(row->identity, identSlot, false);
+				elems[numElems] = slot_getattr(identSlot, i + 1, &isNull);
+
+				if (isNull)
+					nulls[i] = 'n';
+				else
+					numElems++;
+			}
+
+			get_typlenbyvalalign(elemType, &typlen, &typbyval, &typalign);
+
+			params->params[i].value = PointerGetDatum(numElems > 0 ?
+					construct_array(elems, numElems, elemType, typlen, typbyval, typalign) :
+					construct_empty_array(elemType));
+			params->params[i].isnull = false;
+			params->params[i].pflags = 0;
+			params->params[i].ptype = cursor->arrayTypes[i];
+		}
+		nulls[cursor->numIdent] = '\0';
+
+		ExecDropSingleTupleTableSlot(identSlot);
+
+		saveActiveSnapshot = ActiveSnapshot;
+		if (PortalGetQueryDesc(portal) != NULL)
+			ActiveSnapshot = PortalGetQueryDesc(portal)->snapshot;
+		else
+			ActiveSnapshot = CopySnapshot(GetTransactionSnapshot());
+
+		resultDest = CreateTuplestoreDestReceiver(result, fetchContext);
+		queryDesc = CreateQueryDesc(getLazyProvPlan(cursor, nulls), ActiveSnapshot,
+				InvalidSnapshot, resultDest, params, false);
+
+		ExecutorStart(queryDesc, 0);
+		ExecutorRun(queryDesc, ForwardScanDirection, 0L);
+		ExecutorEnd(queryDesc);
+		FreeQueryDesc(queryDesc);
+		(*resultDest->rDestroy) (resultDest);
+
+		ActiveSnapshot = saveActiveSnapshot;
+	}
+
+	/* assign the provenance rows to the fetched rows with the same identity */
+	resultSlot = MakeSingleTupleTableSlot(cursor->probeDesc);
+
+	while (tuplestore_gettupleslot(result, true, resultSlot))
+	{
+		MinimalTuple identity = getRowIdentityTuple(cursor, resultSlot);
+
+		row = lookupFetchedRow(fetchedRows, identity, false);
+		if (row != NULL)
+			row->provenance = lappend(row->provenance, ExecCopySlotMinimalTuple(resultSlot));
+		pfree(identity);
+	}
+
+	tuplestore_end(result);
+
+	/* send the provenance of the fetched rows without the added identity attributes */
+	outSlot = MakeSingleTupleTableSlot(cursor->tupDesc);
+	(*dest->rStartup) (dest, CMD_SELECT, cursor->tupDesc);
+
+	foreach(lc, fetchOrder)
+	{
+		row = (LazyProvRow *) lfirst(lc);
+
+		foreach(provLc, row->provenance)
+		{
+			ExecStoreMinimalTuple((MinimalTuple) lfirst(provLc), resultSlot, false);
+			slot_getallattrs(resultSlot);
+			ExecClearTuple(outSlot);
+
+			for (i = 0, j = 0; i < cursor->probeDesc->natts; i++)
+			{
+				if (i >= cursor->numOrigAttrs && i < cursor->numOrigAttrs + cursor->numAdded)
+					continue;
+
+				outSlot->tts_values[j] = resultSlot->tts_values[i];
+				outSlot->tts_isnull[j] = resultSlot->tts_isnull[i];
+				j++;
+			}
+
+			ExecStoreVirtualTuple(outSlot);
+			(*dest->receiveSlot) (outSlot, dest);
+			nprocessed++;
+		}
+	}
+
+	(*dest->rShutdown) (dest);
+	ExecDropSingleTupleTableSlot(outSlot);
+	ExecDropSingleTupleTableSlot(resultSlot);
+
+	MemoryContextSwitchTo(oldcontext);
+	MemoryContextDelete(fetchContext);
+
+	return nprocessed;
+}
+
+/*
+ * Determines the expressions that identify a result row of query. If the values of a result row
+ * identify the row, byValue is set and identity is NIL. Returns false if the rows of the query
+ * cannot be identified. Identity attributes of subqueries are added to their target lists.
+ */
+
+static bool
+getRowIdentity (Query *query, List **identity, bool *byValue)
+{
+	TargetEntry *te;
+	ListCell *lc;
+
+	*identity = NIL;
+	*byValue = false;
+
+	/* the result of a set operation is identified by its values if duplicates are removed */
+	if (query->setOperations != NULL)
+	{
+		*byValue = !((SetOperationStmt *) query->setOperations)->all;
+		return *byValue;
+	}
+
+	if (query->distinctClause != NIL)
+	{
+		if (has_distinct_on_clause(query))
+			return false;
+
+		*byValue = true;
+		return true;
+	}
+
+	/* a group is identified by the values of its group-by expressions */
+	if (query->groupClause != NIL)
+	{
+		foreach(lc, query->groupClause)
+		{
+			te = get_sortgroupclause_tle((SortClause *) lfirst(lc), query->targetList);
+			*identity = lappend(*identity, copyObject(te->expr));
+		}
+
+		return true;
+	}
+
+	/* an aggregation without GROUP BY returns a single row */
+	if (query->hasAggs)
+	{
+		*byValue = true;
+		return true;
+	}
+
+	if (!getJoinTreeIdentity(query, (Node *) query->jointree, identity))
+		return false;
+
+	/* so does a query without FROM */
+	if (*identity == NIL)
+		*byValue = true;
+
+	return true;
+}
+
+/*
+ * Adds the expressions that identify the combination of tuples of the range table entries in
+ * jtnode to identity.
+ */
+
+static bool
+getJoinTreeIdentity (Query *query, Node *jtnode, List **identity)
+{
+	ListCell *lc;
+
+	if (IsA(jtnode, RangeTblRef))
+	{
+		int rtindex = ((RangeTblRef *) jtnode)->rtindex;
+		RangeTblEntry *rte = rt_fetch(rtindex, query->rtable);
+		List *subIdentity;
+		bool subByValue;
+		TargetEntry *te;
+		int resno;
+
+		switch (rte->rtekind)
+		{
+			case RTE_RELATION:
+				*identity = lappend(*identity, makeVar(rtindex, SelfItemPointerAttributeNumber,
+						TIDOID, -1, 0));
+
+				if (rte->inh && has_subclass(rte->relid))
+					*identity = lappend(*identity, makeVar(rtindex, TableOidAttributeNumber,
+							OIDOID, -1, 0));
+				return true;
+			case RTE_SUBQUERY:
+				/* the result of a provenance base subquery is not rewritten */
+				if (rte->isProvBase || rte->provAttrs != NIL)
+					return false;
+
+				if (!getRowIdentity(rte->subquery, &subIdentity, &subByValue))
+					return false;
+
+				if (subByValue)
+				{
+					foreach(lc, rte->subquery->targetList)
+					{
+						te = (TargetEntry *) lfirst(lc);
+
+						if (!te->resjunk)
+							*identity = lappend(*identity, makeVar(rtindex, te->resno,
+									exprType((Node *) te->expr), exprTypmod((Node *) te->expr), 0));
+					}
+
+					return true;
+				}
+
+				foreach(lc, subIdentity)
+				{
+					Expr *expr = (Expr *) lfirst(lc);
+
+					resno = addIdentityTargetEntry(rte->subquery, expr);
+					rte->eref->colnames = lappend(rte->eref->colnames,
+							makeString(pstrdup(LAZY_IDENTITY_NAME)));
+					*identity = lappend(*identity, makeVar(rtindex, resno,
+							exprType((Node *) expr), exprTypmod((Node *) expr), 0));
+				}
+
+				return true;
+			default:
+				return false;
+		}
+	}
+	else if (IsA(jtnode, FromExpr))
+	{
+		foreach(lc, ((FromExpr *) jtnode)->fromlist)
+			if (!getJoinTreeIdentity(query, (Node *) lfirst(lc), identity))
+				return false;
+
+		return true;
+	}
+	else if (IsA(jtnode, JoinExpr))
+	{
+		JoinExpr *join = (JoinExpr *) jtnode;
+
+		return getJoinTreeIdentity(query, join->larg, identity)
+				&& getJoinTreeIdentity(query, join->rarg, identity);
+	}
+
+	return false;
+}
+
+/*
+ * Adds expr as a result attribute to query after its last non-junk attribute. Returns the
+ * position of the new attribute.
+ */
+
+static int
+addIdentityTargetEntry (Query *query, Expr *expr)
+{
+	TargetEntry *te;
+	List *targetList = NIL;
+	ListCell *lc;
+	AttrNumber resno = 1;
+	int result = 0;
+
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk && result == 0)
+		{
+			result = resno++;
+			targetList = lappend(targetList, makeTargetEntry(expr, result,
+					pstrdup(LAZY_IDENTITY_NAME), false));
+		}
+
+		te->resno = resno++;
+		targetList = lappend(targetList, te);
+	}
+
+	if (result == 0)
+	{
+		result = resno;
+		targetList = lappend(targetList, makeTargetEntry(expr, result,
+				pstrdup(LAZY_IDENTITY_NAME), false));
+	}
+
+	query->targetList = targetList;
+
+	return result;
+}
+
+/*
+ * Removes a lazy provenance cursor and releases its queries and plans.
+ */
+
+static void
+dropLazyProvCursor (LazyProvCursor *cursor)
+{
+	char key[NAMEDATALEN];
+
+	MemoryContextDelete(cursor->context);
+	memcpy(key, cursor->name, NAMEDATALEN);
+	hash_search(lazyCursors, key, HASH_REMOVE, NULL);
+}
+
+/*
+ * Removes lazy provenance cursors whose portal has not been created, because declaring the cursor
+ * failed after the provenance rewrite.
+ */
+
+static void
+dropOrphanedLazyProvCursors (void)
+{
+	LazyProvCursor *cursor;
+	HASH_SEQ_STATUS status;
+	Portal portal;
+
+	if (lazyCursors == NULL)
+		return;
+
+	hash_seq_init(&status, lazyCursors);
+	while ((cursor = (LazyProvCursor *) hash_seq_search(&status)) != NULL)
+	{
+		portal = GetPortalByName(cursor->name);
+
+		if (portal == NULL || portal->creation_time != cursor->creationTime)
+			dropLazyProvCursor(cursor);
+	}
+}
+
+/*
+ * Returns the lazy provenance cursor of a portal or NULL if the portal is not a lazy provenance
+ * cursor.
+ */
+
+static LazyProvCursor *
+getLazyProvCursor (Portal portal)
+{
+	LazyProvCursor *cursor;
+	char key[NAMEDATALEN];
+
+	if (lazyCursors == NULL || portal->name == NULL)
+		return NULL;
+
+	MemSet(key, 0, NAMEDATALEN);
+	StrNCpy(key, portal->name, NAMEDATALEN);
+
+	cursor = (LazyProvCursor *) hash_search(lazyCursors, key, HASH_FIND, NULL);
+
+	/* a portal with the same name that was not created by the declaring statement */
+	if (cursor != NULL && cursor->creationTime != portal->creation_time)
+		return NULL;
+
+	return cursor;
+}
+
+/*
+ * Returns the plan of the restricted provenance query for the combination of identity attributes
+ * with NULL values nulls. The plan is created on first use.
+ */
+
+static PlannedStmt *
+getLazyProvPlan (LazyProvCursor *cursor, char *nulls)
+{
+	LazyProvPlan *lazyPlan;
+	PlannedStmt *plan;
+	MemoryContext oldcontext;
+	ListCell *lc;
+
+	foreach(lc, cursor->plans)
+	{
+		lazyPlan = (LazyProvPlan *) lfirst(lc);
+
+		if (strcmp(lazyPlan->nulls, nulls) == 0)
+			return lazyPlan->plan;
+	}
+
+	plan = pg_plan_query(makeRestrictedQuery(cursor, nulls), 0, NULL);
+
+	oldcontext = MemoryContextSwitchTo(cursor->context);
+
+	lazyPlan = (LazyProvPlan *) palloc(sizeof(LazyProvPlan));
+	lazyPlan->nulls = pstrdup(nulls);
+	lazyPlan->plan = (PlannedStmt *) copyObject(plan);
+	cursor->plans = lappend(cursor->plans, lazyPlan);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return lazyPlan->plan;
+}
+
+/*
+ * Creates the query
+ *
+ *		SELECT * FROM (provQuery) WHERE a1 = ANY($1) AND ... AND an = ANY($n)
+ *
+ * that restricts the provenance query of a cursor to the provenance of a batch of result tuples
+ * of the original query. ai is the i-th identity attribute and $i the array of its values in the
+ * batch. If nulls is not NULL, "ai = ANY($i) OR ai IS NULL" is used for each identity attribute
+ * marked in nulls.
+ */
+
+static Query *
+makeRestrictedQuery (LazyProvCursor *cursor, char *nulls)
+{
+	Query *provQuery = (Query *) copyObject(cursor->provQuery);
+	Query *result;
+	RangeTblRef *rtr;
+	TargetEntry *te;
+	ScalarArrayOpExpr *anyExpr;
+	NullTest *nullTest;
+	Param *param;
+	Var *var;
+	List *conds = NIL;
+	ListCell *lc;
+	int resno = 0;
+	int i;
+
+	result = makeQuery();
+	addSubqueryToRT(result, provQuery, "lazyProvenance");
+	correctSubQueryAlias(result);
+
+	rtr = makeNode(RangeTblRef);
+	rtr->rtindex = 1;
+	result->jointree->fromlist = list_make1(rtr);
+
+	foreach(lc, provQuery->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk)
+			continue;
+
+		var = makeVar(1, te->resno, exprType((Node *) te->expr), exprTypmod((Node *) te->expr), 0);
+		resno++;
+		result->targetList = lappend(result->targetList,
+				makeTargetEntry((Expr *) var, resno, pstrdup(te->resname), false));
+
+		i = resno - cursor->firstIdent;
+		if (i < 0 || i >= cursor->numIdent)
+			continue;
+
+		param = makeNode(Param);
+		param->paramkind = PARAM_EXTERN;
+		param->paramid = i + 1;
+		param->paramtype = cursor->arrayTypes[i];
+		param->paramtypmod = -1;
+
+		anyExpr = makeNode(ScalarArrayOpExpr);
+		anyExpr->opno = cursor->eqOps[i];
+		anyExpr->opfuncid = get_opcode(cursor->eqOps[i]);
+		anyExpr->useOr = true;
+		anyExpr->args = list_make2(copyObject(var), param);
+
+		if (nulls != NULL && nulls[i] == 'n')
+		{
+			nullTest = makeNode(NullTest);
+			nullTest->arg = (Expr *) copyObject(var);
+			nullTest->nulltesttype = IS_NULL;
+			conds = lappend(conds, makeBoolExpr(OR_EXPR, list_make2(anyExpr, nullTest)));
+		}
+		else
+			conds = lappend(conds, anyExpr);
+	}
+
+	result->jointree->quals = createAndFromList(conds);
+
+	return result;
+}
+
+/*
+ * Returns the identity of the row in slot, which is a row of the cursor query or of the restricted
+ * provenance query.
+ */
+
+static MinimalTuple
+getRowIdentityTuple (LazyProvCursor *cursor, TupleTableSlot *slot)
+{
+	Datum *values;
+	bool *isnull;
+	MinimalTuple result;
+	int i;
+
+	values = (Datum *) palloc(sizeof(Datum) * cursor->numIdent);
+	isnull = (bool *) palloc(sizeof(bool) * cursor->numIdent);
+
+	for (i = 0; i < cursor->numIdent; i++)
+		values[i] = slot_getattr(slot, cursor->firstIdent + i, &isnull[i]);
+
+	result = heap_form_minimal_tuple(cursor->identDesc, values, isnull);
+
+	pfree(values);
+	pfree(isnull);
+
+	return result;
+}
+
+/*
+ * Returns the fetched row of the current batch with the row identity identity or NULL if no such
+ * row has been fetched. If create is true, the identity is remembered as a new fetched row.
+ */
+
+static LazyProvRow *
+lookupFetchedRow (HTAB *fetchedRows, MinimalTuple identity, bool create)
+{
+	FetchedRowsEntry *entry;
+	LazyProvRow *row;
+	ListCell *lc;
+	uint32 hash;
+	bool found;
+
+	hash = DatumGetUInt32(hash_any((unsigned char *) identity, identity->t_len));
+
+	entry = (FetchedRowsEntry *) hash_search(fetchedRows, &hash,
+			create ? HASH_ENTER : HASH_FIND, &found);
+	if (entry == NULL)
+		return NULL;
+	if (!found)
+		entry->rows = NIL;
+
+	if (!create)
+	{
+		foreach(lc, entry->rows)
+		{
+			row = (LazyProvRow *) lfirst(lc);
+
+			if (row->identity->t_len == identity->t_len
+					&& memcmp(row->identity, identity, identity->t_len) == 0)
+				return row;
+		}
+
+		return NULL;
+	}
+
+	row = (LazyProvRow *) palloc(sizeof(LazyProvRow));
+	row->identity = identity;
+	row->provenance = NIL;
+	entry->rows = lappend(entry->rows, row);
+
+	return row;
+}
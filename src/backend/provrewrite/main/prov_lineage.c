@@ -0,0 +1,511 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_lineage.c
+ *	  PERM C - Lineage capture for INSERT ... SELECT PROVENANCE and SELECT PROVENANCE ... INTO.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/main/prov_lineage.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		Normally INSERT ... SELECT PROVENANCE stores the result of the original query and
+ *		SELECT PROVENANCE ... INTO stores the result of the provenance query. If prov_lineage_relation
+ *		names a relation with the columns (target_rel oid, target_tid tid, source_rel oid, source_tid tid),
+ *		both store the result of the original query and record for each stored row and each base tuple in
+ *		its provenance the tuple ids of the row and the base tuple in this relation. Thus, the provenance
+ *		of the stored rows can later be looked up instead of being recomputed.
+ *
+ *		The SELECT is rewritten with TUPLEID contribution semantics, but base relations are always
+ *		identified by their ctid (also if they have oids). For the INSERT the rewritten query is the
+ *		subquery that provides the inserted rows, a SELECT INTO is wrapped into a new top query that
+ *		selects the result attributes of the rewritten query. The query that stores the rows gets a junk
+ *		attribute prov_lineage_<i> for the i-th provenance attribute. The executor inserts the lineage
+ *		records (see executor/execProvLineage.c).
+ *
+ *		A result row has one row per witness in the rewritten query. For SPJ queries each result row has
+ *		exactly one witness. Otherwise we need that the result rows are distinct (aggregations whose group
+ *		by expressions are result attributes, SELECT DISTINCT and set operations without ALL). Then the
+ *		executor stores only the first row of each result row, which is recognized by the values of the
+ *		junk attributes prov_lineage_key_<i> that repeat the result attributes. Other queries are not
+ *		supported.
+ *
+ *		The tuple ids are only valid until the base tuples or stored rows are updated or the relations are
+ *		reorganized (e.g., by VACUUM FULL or CLUSTER).
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/heapam.h"
+#include "catalog/namespace.h"
+#include "catalog/pg_type.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/tlist.h"
+#include "parser/parse_clause.h"
+#include "parser/parse_expr.h"
+#include "parser/parse_relation.h"
+#include "parser/parsetree.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/guc.h"
+
+#include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_util.h"
+#include "provrewrite/prov_aggr.h"
+#include "provrewrite/provattrname.h"
+#include "provrewrite/provrewrite.h"
+#include "provrewrite/prov_lineage.h"
+
+/* true while the provenance of a query that captures lineage is rewritten */
+bool provLineageCapture = false;
+
+/* prototypes */
+static Index getLineageSourceIndex (Query *query);
+static void checkLineageQuery (Query *query);
+static bool needsLineageKeys (Query *query);
+static Query *getSelectStarSubquery (Query *query);
+static bool groupByInResult (Query *query);
+static bool resultIsDistinct (Query *query);
+static Oid getLineageSourceRelid (Query *query, Expr *expr);
+static Oid addLineageRelation (Query *query);
+static void addLineageTe (Query *query, Index rtindex, TargetEntry *te, char *prefix, int num);
+
+/*
+ * Returns true if query stores the result of a provenance query and its lineage should be captured.
+ */
+
+bool
+isLineageCaptureQuery (Query *query)
+{
+	if (prov_lineage_relation == NULL || prov_lineage_relation[0] == '\0')
+		return false;
+
+	if (query->commandType == CMD_INSERT)
+		return getLineageSourceIndex(query) != 0;
+
+	return query->commandType == CMD_SELECT && query->intoClause != NULL
+			&& query->utilityStmt == NULL && IsProvRewrite(query);
+}
+
+/*
+ * Returns the range table index of the provenance subquery that provides the rows of an
+ * INSERT ... SELECT PROVENANCE or 0 if the INSERT does not insert the result of a provenance query.
+ */
+
+static Index
+getLineageSourceIndex (Query *query)
+{
+	ListCell *lc;
+	RangeTblEntry *rte;
+	Index rtindex = 0;
+
+	foreach(lc, query->rtable)
+	{
+		rte = (RangeTblEntry *) lfirst(lc);
+		rtindex++;
+
+		if (rte->rtekind == RTE_SUBQUERY && IsProvRewrite(rte->subquery))
+			return rtindex;
+	}
+
+	return 0;
+}
+
+/*
+ * Rewrite a query that stores the result of a provenance query to capture the lineage of the stored rows.
+ */
+
+Query *
+rewriteLineageCaptureQuery (Query *query)
+{
+	Query *top;
+	Query *sub;
+	RangeTblEntry *rte;
+	RangeTblRef *rtRef;
+	ProvLineageInfo *lineage;
+	TargetEntry *te;
+	ListCell *lc;
+	Index subIndex;
+	Oid relid;
+	bool selectInto;
+	bool distinct;
+	int i;
+
+	selectInto = (query->commandType == CMD_SELECT);
+
+	/* a SELECT INTO stores the result attributes of a new top query */
+	if (selectInto)
+	{
+		sub = query;
+		top = makeQuery();
+		top->intoClause = sub->intoClause;
+		sub->intoClause = NULL;
+
+		addSubqueryToRT(top, sub, "lineage");
+		subIndex = 1;
+		MAKE_RTREF(rtRef, 1);
+		top->jointree->fromlist = list_make1(rtRef);
+	}
+	else
+	{
+		top = query;
+		subIndex = getLineageSourceIndex(query);
+		sub = rt_fetch(subIndex, top->rtable)->subquery;
+
+		if (top->provInfo == NULL)
+			top->provInfo = (Node *) makeProvInfo();
+	}
+
+	checkLineageQuery(sub);
+	distinct = needsLineageKeys(sub);
+
+	/* compute the provenance as ctids of the base relations */
+	ContributionType(sub) = CONTR_TUPLEID;
+
+	provLineageCapture = true;
+	PG_TRY();
+	{
+		sub = provenanceRewriteQuery(sub);
+	}
+	PG_CATCH();
+	{
+		provLineageCapture = false;
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+	provLineageCapture = false;
+
+	rte = rt_fetch(subIndex, top->rtable);
+	rte->subquery = sub;
+	correctRTEAlias(rte);
+
+	lineage = makeProvLineageInfo();
+	lineage->lineageRelid = addLineageRelation(top);
+
+	/* result attributes stored by the SELECT INTO */
+	if (selectInto)
+	{
+		foreach(lc, sub->targetList)
+		{
+			te = (TargetEntry *) lfirst(lc);
+
+			if (!te->resjunk && !isProvAttr(te))
+				addLineageTe(top, subIndex, te, NULL, 0);
+		}
+	}
+
+	/* the tuple ids of the base relations and the values of the result rows */
+	i = 0;
+	foreach(lc, sub->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk)
+			continue;
+
+		if (isProvAttr(te))
+		{
+			relid = getLineageSourceRelid(sub, te->expr);
+			if (!OidIsValid(relid))
+				ereport(ERROR,
+						(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+						 errmsg("could not determine the base relation of provenance attribute \"%s\"",
+								 te->resname),
+						 errdetail("Lineage capture needs the tuple ids of base relations.")));
+
+			lineage->sourceRelids = lappend_oid(lineage->sourceRelids, relid);
+			addLineageTe(top, subIndex, te, "prov_lineage", ++i);
+		}
+		else if (distinct)
+			addLineageTe(top, subIndex, te, "prov_lineage_key", ++lineage->numKeys);
+	}
+
+	((ProvInfo *) top->provInfo)->lineage = (Node *) lineage;
+
+	/* EXPLAIN shows the rewrite strategies of the top query */
+	((ProvInfo *) top->provInfo)->rewriteInfo = copyObject(((ProvInfo *) sub->provInfo)->rewriteInfo);
+
+	/* the rewrite depends on prov_lineage_relation */
+	provRewriteCacheable = false;
+
+	return top;
+}
+
+/*
+ * Lineage is computed from the tuple ids of the base relations. Only influence and TUPLEID contribution
+ * semantics compute the provenance as the base tuples of the witnesses.
+ */
+
+static void
+checkLineageQuery (Query *query)
+{
+	switch (ContributionType(query))
+	{
+		case CONTR_INFLUENCE:
+		case CONTR_TUPLEID:
+			break;
+		default:
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("lineage capture is only supported for influence and TUPLEID contribution semantics")));
+	}
+
+	if (IsProvNormalized(query))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("lineage capture is not supported for FORMAT NORMALIZED")));
+}
+
+/*
+ * Returns true if a result row of query may have more than one witness, false if each result row has
+ * exactly one witness. If a result row may have more than one witness, the result rows have to be
+ * distinct to identify the witnesses of a stored row.
+ */
+
+static bool
+needsLineageKeys (Query *query)
+{
+	SetOperationStmt *setOp;
+	Query *sub;
+
+	/* SELECT * FROM (q) AS sub has the result rows of q */
+	while ((sub = getSelectStarSubquery(query)) != NULL)
+		query = sub;
+
+	if (query->setOperations != NULL)
+	{
+		setOp = (SetOperationStmt *) query->setOperations;
+		if (!setOp->all)
+			return true;
+	}
+	else if (query->hasAggs || query->groupClause != NIL)
+	{
+		if (groupByInResult(query))
+			return true;
+	}
+	else if (query->distinctClause != NIL)
+	{
+		if (resultIsDistinct(query))
+			return true;
+	}
+	else if (!query->hasSubLinks && query->limitCount == NULL && query->limitOffset == NULL
+			&& rewritePreservesInput(query))
+		return false;
+
+	ereport(ERROR,
+			(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+			 errmsg("lineage capture is not supported for this provenance query"),
+			 errhint("Lineage can be captured for queries without sublinks that are SPJ queries, "
+					 "aggregations whose GROUP BY expressions are result attributes, "
+					 "SELECT DISTINCT queries or set operations without ALL.")));
+
+	return false;	/* keep compiler quiet */
+}
+
+/*
+ * Returns q for a query SELECT * FROM (q) AS sub, otherwise NULL.
+ */
+
+static Query *
+getSelectStarSubquery (Query *query)
+{
+	RangeTblRef *rtRef;
+	RangeTblEntry *rte;
+	TargetEntry *te;
+	Var *var;
+	ListCell *lc;
+	int numAttrs = 0;
+
+	if (query->hasAggs || query->groupClause != NIL || query->distinctClause != NIL
+			|| query->setOperations != NULL || query->hasSubLinks
+			|| query->limitCount != NULL || query->limitOffset != NULL
+			|| query->jointree->quals != NULL || list_length(query->jointree->fromlist) != 1
+			|| !IsA(linitial(query->jointree->fromlist), RangeTblRef))
+		return NULL;
+
+	rtRef = (RangeTblRef *) linitial(query->jointree->fromlist);
+	rte = rt_fetch(rtRef->rtindex, query->rtable);
+	if (rte->rtekind != RTE_SUBQUERY)
+		return NULL;
+
+	/* the result attributes are the result attributes of the subquery in their order */
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+		if (te->resjunk)
+			continue;
+
+		var = (Var *) te->expr;
+		if (!IsA(var, Var) || var->varno != rtRef->rtindex || var->varlevelsup != 0
+				|| var->varattno != ++numAttrs)
+			return NULL;
+	}
+
+	foreach(lc, rte->subquery->targetList)
+	{
+		if (!((TargetEntry *) lfirst(lc))->resjunk)
+			numAttrs--;
+	}
+
+	return (numAttrs == 0) ? rte->subquery : NULL;
+}
+
+/*
+ * Returns true if all group by expressions of an aggregation are result attributes. Then the result
+ * rows of different groups are distinct.
+ */
+
+static bool
+groupByInResult (Query *query)
+{
+	ListCell *lc;
+	TargetEntry *te;
+
+	foreach(lc, query->groupClause)
+	{
+		te = get_sortgroupclause_tle((SortClause *) lfirst(lc), query->targetList);
+
+		if (te->resjunk)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Returns true if all result attributes of a query are in its DISTINCT clause (no DISTINCT ON).
+ */
+
+static bool
+resultIsDistinct (Query *query)
+{
+	ListCell *lc;
+	TargetEntry *te;
+
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (!te->resjunk && !targetIsInSortList(te, InvalidOid, query->distinctClause))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Returns the base relation whose ctid is the value of a provenance attribute of a rewritten query.
+ */
+
+static Oid
+getLineageSourceRelid (Query *query, Expr *expr)
+{
+	RangeTblEntry *rte;
+	TargetEntry *te;
+	ListCell *lc;
+	Var *var;
+	Oid result = InvalidOid;
+
+	if (!IsA(expr, Var))
+		return InvalidOid;
+
+	var = (Var *) expr;
+
+	/* the value of a provenance attribute of a set operation comes from one of its inputs */
+	if (query->setOperations != NULL)
+	{
+		foreach(lc, query->rtable)
+		{
+			rte = (RangeTblEntry *) lfirst(lc);
+
+			if (rte->rtekind != RTE_SUBQUERY)
+				continue;
+
+			te = get_tle_by_resno(rte->subquery->targetList, var->varattno);
+			result = getLineageSourceRelid(rte->subquery, te->expr);
+			if (OidIsValid(result))
+				break;
+		}
+	}
+	else
+	{
+		rte = rt_fetch(var->varno, query->rtable);
+
+		switch (rte->rtekind)
+		{
+			case RTE_RELATION:
+				if (var->varattno == SelfItemPointerAttributeNumber)
+					result = rte->relid;
+				break;
+			case RTE_SUBQUERY:
+				te = get_tle_by_resno(rte->subquery->targetList, var->varattno);
+				result = getLineageSourceRelid(rte->subquery, te->expr);
+				break;
+			case RTE_JOIN:
+				result = getLineageSourceRelid(query,
+						(Expr *) list_nth(rte->joinaliasvars, var->varattno - 1));
+				break;
+			default:
+				break;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Add the relation named by prov_lineage_relation to the range table of query. The relation is not
+ * accessed by the query, but the executor checks that the user may insert into it.
+ */
+
+static Oid
+addLineageRelation (Query *query)
+{
+	RangeVar *rv;
+	Relation rel;
+	RangeTblEntry *rte;
+	ParseState *pstate;
+	Oid result;
+
+	rv = makeRangeVarFromNameList(stringToQualifiedNameList(prov_lineage_relation));
+	rel = heap_openrv(rv, RowExclusiveLock);
+	result = RelationGetRelid(rel);
+
+	pstate = make_parsestate(NULL);
+	rte = addRangeTableEntryForRelation(pstate, rel, NULL, false, false);
+	rte->requiredPerms = ACL_INSERT;
+	query->rtable = lappend(query->rtable, rte);
+
+	heap_close(rel, NoLock);
+
+	return result;
+}
+
+/*
+ * Append a target list entry for the attribute te of the subquery rtindex to the target list of query. If
+ * prefix is not NULL, the entry is the junk attribute <prefix>_<num>.
+ */
+
+static void
+addLineageTe (Query *query, Index rtindex, TargetEntry *te, char *prefix, int num)
+{
+	TargetEntry *newTe;
+	Var *var;
+	char *name;
+
+	var = makeVar(rtindex, te->resno, exprType((Node *) te->expr), exprTypmod((Node *) te->expr), 0);
+
+	if (prefix == NULL)
+		name = pstrdup(te->resname);
+	else
+	{
+		name = (char *) palloc(NAMEDATALEN);
+		snprintf(name, NAMEDATALEN, "%s_%d", prefix, num);
+	}
+
+	newTe = makeTargetEntry((Expr *) var, list_length(query->targetList) + 1, name, prefix != NULL);
+	query->targetList = lappend(query->targetList, newTe);
+}
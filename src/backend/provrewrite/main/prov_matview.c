@@ -0,0 +1,1070 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_matview.c
+ *	  PERM C - Materialized provenance views that are maintained by triggers on their base relations.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/main/prov_matview.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		CREATE MATERIALIZED PROVENANCE VIEW v AS SELECT ... creates a provenance view v_provdef that
+ *		stores the definition of the view and a table v that stores the result of v_provdef. The
+ *		SELECT is marked for provenance rewrite with influence contribution semantics if it does not
+ *		contain a PROVENANCE clause. The table is kept up to date by AFTER triggers that execute
+ *		prov_matview_maintain on each base relation accessed by the query. Dropping v drops v_provdef
+ *		and the triggers.
+ *
+ *		For SPJ queries with inner joins and for aggregations with a GROUP BY clause computed with
+ *		influence contribution semantics each provenance attribute of the view is a copy of an
+ *		attribute of a base relation tuple. Thus, if a tuple t of base relation R is inserted, updated
+ *		or deleted, only the result tuples whose R provenance is equal to t (the slice of t) change.
+ *		These views are maintained by row level triggers:
+ *			- SPJ: the slice of t is deleted from v and recomputed from v_provdef.
+ *			- aggregation: the groups of the result tuples in the slice of t (in v before and in
+ *			  v_provdef after the modification) are deleted from v and recomputed from v_provdef.
+ *		All other views (set operations, sublinks, outer joins, subqueries in FROM, other
+ *		contribution semantics, ...) are recomputed completely by a statement level trigger. TRUNCATE
+ *		does not fire triggers and is therefore not reflected in materialized provenance views.
+ *
+ *		The statements used for maintenance are prepared once per trigger and backend.
+ *
+ *		Maintenance is serialized by a ShareRowExclusiveLock on v that is held until the end of the
+ *		transaction. Otherwise two transactions that concurrently insert join partners into
+ *		different base relations would both recompute their slice without seeing the other
+ *		transaction's tuple and the join result would be lost. In READ COMMITTED mode the
+ *		recomputation after the lock is granted sees the committed tuples of the transaction that
+ *		held the lock. In SERIALIZABLE mode it does not, so v is only correct without concurrent
+ *		writers of its base relations.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <stdlib.h>
+
+#include "access/heapam.h"
+#include "access/xact.h"
+#include "catalog/dependency.h"
+#include "catalog/namespace.h"
+#include "catalog/pg_class.h"
+#include "catalog/pg_trigger.h"
+#include "commands/trigger.h"
+#include "commands/view.h"
+#include "executor/spi.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/tlist.h"
+#include "parser/analyze.h"
+#include "parser/gramparse.h"
+#include "parser/parse_oper.h"
+#include "parser/parsetree.h"
+#include "utils/builtins.h"
+#include "utils/hsearch.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+#include "utils/syscache.h"
+
+#include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_matview.h"
+
+/* maintenance modes */
+#define MATVIEW_MODE_SPJ 's'
+#define MATVIEW_MODE_AGG 'a'
+#define MATVIEW_MODE_FULL 'f'
+
+#define MATVIEW_DEF_SUFFIX "_provdef"
+#define MATVIEW_TRIGGER_PREFIX "prov_matview_"
+
+/* statements used to maintain a materialized provenance view */
+typedef enum MatViewStmtKind
+{
+	MATVIEW_DELETE_SLICE,
+	MATVIEW_INSERT_SLICE,
+	MATVIEW_GROUPS_OF_SLICE,
+	MATVIEW_DELETE_GROUP,
+	MATVIEW_INSERT_GROUP,
+	MATVIEW_DELETE_ALL,
+	MATVIEW_INSERT_ALL
+} MatViewStmtKind;
+
+/* key and entry of the hash table of prepared maintenance statements */
+typedef struct MatViewPlanKey
+{
+	Oid				tgoid;			/* trigger the statement belongs to */
+	MatViewStmtKind	kind;
+} MatViewPlanKey;
+
+typedef struct MatViewPlanEntry
+{
+	MatViewPlanKey	key;
+	SPIPlanPtr		plan;
+} MatViewPlanEntry;
+
+/*
+ * Maintenance information of a trigger. It is stored in the trigger arguments:
+ *		0: oid of the table that stores the view
+ *		1: oid of the view that defines the view
+ *		2: maintenance mode
+ *		3: comma separated list of the view attribute numbers of the group by attributes
+ *		4..: one argument per occurrence of the base relation in the query. A comma separated list
+ *			of viewattr:baseattr pairs that map the provenance attributes of this occurrence to the
+ *			base relation attributes they are copied from.
+ */
+typedef struct MatViewTrigInfo
+{
+	Oid			tgoid;
+	Oid			matOid;
+	Oid			defOid;
+	char		mode;
+	List	   *groupAttrs;		/* view attribute numbers of the group by attributes */
+	List	   *viewAttrs;		/* per occurrence the view attribute numbers of its prov attrs */
+	List	   *baseAttrs;		/* per occurrence the base relation attribute numbers */
+	List	   *sliceAttrs;		/* base relation attributes used as parameters of slice statements */
+} MatViewTrigInfo;
+
+/* an occurrence of a base relation in the definition of a view */
+typedef struct MatViewOccurrence
+{
+	RangeTblEntry  *rte;
+	Oid				relid;
+	StringInfoData	attrs;			/* viewattr:baseattr pairs */
+} MatViewOccurrence;
+
+/* context for collecting the base relations of a view */
+typedef struct BaseRelContext
+{
+	List	   *baseRels;
+	List	   *views;
+} BaseRelContext;
+
+/*
+ * Global variables.
+ */
+static HTAB *matViewPlans = NULL;
+
+/* Function declarations */
+static char getMaintenanceMode (Query *query, List **groupAttrs);
+static bool collectBaseRelsWalker (Node *node, BaseRelContext *context);
+static List *getOccurrences (Query *defQuery, int numOrigAttrs, List *baseRels);
+static bool traceProvAttr (Query *query, Expr *expr, Oid *relid, AttrNumber *attno,
+		RangeTblEntry **baseRte);
+static bool hasEqualityOperators (Oid relid, List *attrs);
+static void createMaintenanceTrigger (Oid baseRelid, Oid matOid, Oid defOid, char mode,
+		List *groupAttrs, List *occurrences);
+static void parseTrigInfo (Trigger *trigger, MatViewTrigInfo *info);
+static void parseAttrList (char *arg, List **first, List **second);
+static void maintainSlice (MatViewTrigInfo *info, Relation rel, HeapTuple tuple);
+static void executeMaintenanceStmt (MatViewTrigInfo *info, MatViewStmtKind kind, Relation rel,
+		Datum *values, char *nulls);
+static SPIPlanPtr getMaintenancePlan (MatViewTrigInfo *info, MatViewStmtKind kind, Relation rel);
+static char *buildMaintenanceQuery (MatViewTrigInfo *info, MatViewStmtKind kind, Relation rel,
+		Oid **argtypes, int *nargs);
+static void appendSliceCond (StringInfo str, MatViewTrigInfo *info, TupleDesc desc);
+static void appendGroupCond (StringInfo str, MatViewTrigInfo *info, TupleDesc desc);
+static void appendGroupAttrs (StringInfo str, MatViewTrigInfo *info, TupleDesc desc);
+static char *getQualifiedRelName (Relation rel);
+
+/*
+ * Executes a CREATE MATERIALIZED PROVENANCE VIEW statement.
+ */
+
+void
+DefineMaterializedProvView (ViewStmt *stmt, const char *queryString)
+{
+	SelectStmt *select;
+	ProvInfo *provInfo;
+	Query *query;
+	Query *defQuery;
+	ViewStmt *defStmt;
+	Relation defRel;
+	BaseRelContext context;
+	List *groupAttrs = NIL;
+	List *occurrences = NIL;
+	ListCell *lc;
+	ListCell *occLc;
+	Oid defOid;
+	Oid matOid;
+	Oid namespaceId;
+	ObjectAddress defAddress;
+	ObjectAddress matAddress;
+	StringInfoData sql;
+	char mode;
+	int numOrigAttrs = 0;
+
+	if (strlen(stmt->view->relname) + strlen(MATVIEW_DEF_SUFFIX) >= NAMEDATALEN)
+		ereport(ERROR,
+				(errcode(ERRCODE_NAME_TOO_LONG),
+				 errmsg("name of materialized provenance view \"%s\" is too long",
+						stmt->view->relname)));
+
+	/* mark the query for provenance rewrite if the user did not */
+	stmt = (ViewStmt *) copyObject(stmt);
+	select = (SelectStmt *) stmt->query;
+
+	if (IsA(select, SelectStmt) && select->provenanceClause != NULL)
+	{
+		provInfo = (ProvInfo *) select->provenanceClause;
+		if (!provInfo->shouldRewrite)
+		{
+			provInfo->shouldRewrite = true;
+			provInfo->contribution = CONTR_INFLUENCE;
+		}
+	}
+
+	query = parse_analyze((Node *) copyObject(stmt->query), queryString, NULL, 0);
+
+	if (!IsProvRewrite(query))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("query of a materialized provenance view must be a provenance query"),
+				 errhint("Use SELECT PROVENANCE.")));
+
+	foreach(lc, query->targetList)
+		if (!((TargetEntry *) lfirst(lc))->resjunk)
+			numOrigAttrs++;
+
+	mode = getMaintenanceMode(query, &groupAttrs);
+
+	/* create the view that stores the definition */
+	defStmt = (ViewStmt *) copyObject(stmt);
+	defStmt->materialized = false;
+	defStmt->view->relname = palloc(NAMEDATALEN);
+	snprintf(defStmt->view->relname, NAMEDATALEN, "%s%s", stmt->view->relname,
+			MATVIEW_DEF_SUFFIX);
+
+	DefineView(defStmt, queryString);
+	CommandCounterIncrement();
+
+	defOid = RangeVarGetRelid(defStmt->view, false);
+	namespaceId = get_rel_namespace(defOid);
+
+	/* create the table and fill it with the result of the view */
+	initStringInfo(&sql);
+	appendStringInfo(&sql, "CREATE %sTABLE %s AS SELECT * FROM %s",
+			isTempNamespace(namespaceId) ? "TEMP " : "",
+			isTempNamespace(namespaceId) ? quote_identifier(stmt->view->relname)
+					: quote_qualified_identifier(get_namespace_name(namespaceId),
+							stmt->view->relname),
+			quote_qualified_identifier(get_namespace_name(namespaceId), get_rel_name(defOid)));
+
+	if (SPI_connect() != SPI_OK_CONNECT)
+		elog(ERROR, "SPI_connect failed");
+	if (SPI_execute(sql.data, false, 0) < 0)
+		elog(ERROR, "SPI_execute failed: %s", sql.data);
+	SPI_finish();
+
+	CommandCounterIncrement();
+
+	matOid = get_relname_relid(stmt->view->relname, namespaceId);
+	if (!OidIsValid(matOid))
+		elog(ERROR, "could not find table of materialized provenance view \"%s\"",
+				stmt->view->relname);
+
+	/* the definition is dropped together with the table */
+	defAddress.classId = RelationRelationId;
+	defAddress.objectId = defOid;
+	defAddress.objectSubId = 0;
+	matAddress.classId = RelationRelationId;
+	matAddress.objectId = matOid;
+	matAddress.objectSubId = 0;
+
+	recordDependencyOn(&defAddress, &matAddress, DEPENDENCY_AUTO);
+
+	/*
+	 * Get the base relations and the provenance attributes of each occurrence of a base relation
+	 * from the rewritten definition.
+	 */
+	defRel = relation_open(defOid, AccessShareLock);
+	defQuery = (Query *) copyObject(linitial(defRel->rd_rules->rules[0]->actions));
+	relation_close(defRel, AccessShareLock);
+
+	context.baseRels = NIL;
+	context.views = list_make1_oid(defOid);
+	collectBaseRelsWalker((Node *) defQuery, &context);
+
+	if (mode != MATVIEW_MODE_FULL)
+	{
+		occurrences = getOccurrences(defQuery, numOrigAttrs, context.baseRels);
+
+		if (occurrences == NIL || !hasEqualityOperators(matOid, groupAttrs))
+			mode = MATVIEW_MODE_FULL;
+	}
+
+	/* create the maintenance triggers */
+	occLc = list_head(occurrences);
+	foreach(lc, context.baseRels)
+	{
+		createMaintenanceTrigger(lfirst_oid(lc), matOid, defOid, mode, groupAttrs,
+				(mode == MATVIEW_MODE_FULL) ? NIL : (List *) lfirst(occLc));
+
+		if (mode != MATVIEW_MODE_FULL)
+			occLc = lnext(occLc);
+	}
+}
+
+/*
+ * Returns how a view is maintained. Only SPJ queries with inner joins and aggregations with a
+ * GROUP BY clause computed with influence contribution semantics are maintained incrementally.
+ * For aggregations the positions of the group by attributes in the result are returned in
+ * groupAttrs. Parse analysis does not expand views, so a query that accesses a view may contain
+ * any operator. Such queries are recomputed completely.
+ */
+
+static char
+getMaintenanceMode (Query *query, List **groupAttrs)
+{
+	ListCell *lc;
+	ListCell *tlc;
+	RangeTblEntry *rte;
+	TargetEntry *te;
+	int pos;
+
+	if (ContributionType(query) != CONTR_INFLUENCE
+			|| query->setOperations != NULL
+			|| query->hasSubLinks
+			|| query->distinctClause != NIL
+			|| query->limitOffset != NULL
+			|| query->limitCount != NULL)
+		return MATVIEW_MODE_FULL;
+
+	foreach(lc, query->rtable)
+	{
+		rte = (RangeTblEntry *) lfirst(lc);
+
+		if ((rte->rtekind != RTE_RELATION && rte->rtekind != RTE_JOIN)
+				|| (rte->rtekind == RTE_JOIN && rte->jointype != JOIN_INNER)
+				|| (rte->rtekind == RTE_RELATION && get_rel_relkind(rte->relid) != RELKIND_RELATION)
+				|| rte->isProvBase || rte->provAttrs != NIL)
+			return MATVIEW_MODE_FULL;
+	}
+
+	if (query->groupClause == NIL)
+		return query->hasAggs ? MATVIEW_MODE_FULL : MATVIEW_MODE_SPJ;
+
+	/* find the positions of the group by attributes in the result */
+	foreach(lc, query->groupClause)
+	{
+		te = get_sortgroupclause_tle((SortClause *) lfirst(lc), query->targetList);
+
+		if (te->resjunk)
+		{
+			*groupAttrs = NIL;
+			return MATVIEW_MODE_FULL;
+		}
+
+		pos = 0;
+		foreach(tlc, query->targetList)
+		{
+			if (!((TargetEntry *) lfirst(tlc))->resjunk)
+				pos++;
+			if (lfirst(tlc) == te)
+				break;
+		}
+
+		*groupAttrs = lappend_int(*groupAttrs, pos);
+	}
+
+	return MATVIEW_MODE_AGG;
+}
+
+/*
+ * Collects the oids of all tables accessed by a query. Views are replaced by the tables they
+ * access.
+ */
+
+static bool
+collectBaseRelsWalker (Node *node, BaseRelContext *context)
+{
+	ListCell *lc;
+	RangeTblEntry *rte;
+	Relation rel;
+	Query *viewQuery;
+
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Query))
+	{
+		foreach(lc, ((Query *) node)->rtable)
+		{
+			rte = (RangeTblEntry *) lfirst(lc);
+
+			if (rte->rtekind != RTE_RELATION)
+				continue;
+
+			switch (get_rel_relkind(rte->relid))
+			{
+				case RELKIND_RELATION:
+					context->baseRels = list_append_unique_oid(context->baseRels, rte->relid);
+					break;
+				case RELKIND_VIEW:
+					if (list_member_oid(context->views, rte->relid))
+						break;
+					context->views = lappend_oid(context->views, rte->relid);
+
+					rel = relation_open(rte->relid, AccessShareLock);
+					viewQuery = (Query *) linitial(rel->rd_rules->rules[0]->actions);
+					collectBaseRelsWalker((Node *) viewQuery, context);
+					relation_close(rel, AccessShareLock);
+					break;
+				default:
+					ereport(ERROR,
+							(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+							 errmsg("materialized provenance views can only access tables and views"),
+							 errdetail("\"%s\" is neither a table nor a view.",
+									 get_rel_name(rte->relid))));
+			}
+		}
+
+		return query_tree_walker((Query *) node, collectBaseRelsWalker, (void *) context, 0);
+	}
+
+	return expression_tree_walker(node, collectBaseRelsWalker, (void *) context);
+}
+
+/*
+ * Traces each provenance attribute of the rewritten definition of a view to the base relation
+ * attribute it is copied from. Returns for each base relation in baseRels a list with the
+ * viewattr:baseattr strings of its occurrences, or NIL if a provenance attribute cannot be traced
+ * or a base relation does not contribute provenance attributes.
+ */
+
+static List *
+getOccurrences (Query *defQuery, int numOrigAttrs, List *baseRels)
+{
+	List *occurrences = NIL;
+	List *result = NIL;
+	List *relOccurrences;
+	List *baseAttrs;
+	MatViewOccurrence *occ;
+	TargetEntry *te;
+	RangeTblEntry *baseRte;
+	ListCell *lc;
+	ListCell *occLc;
+	Oid relid;
+	AttrNumber attno;
+	int viewAttr = 0;
+
+	foreach(lc, defQuery->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk || ++viewAttr <= numOrigAttrs)
+			continue;
+
+		if (!traceProvAttr(defQuery, te->expr, &relid, &attno, &baseRte)
+				|| !list_member_oid(baseRels, relid))
+			return NIL;
+
+		occ = NULL;
+		foreach(occLc, occurrences)
+		{
+			if (((MatViewOccurrence *) lfirst(occLc))->rte == baseRte)
+			{
+				occ = (MatViewOccurrence *) lfirst(occLc);
+				break;
+			}
+		}
+
+		if (occ == NULL)
+		{
+			occ = (MatViewOccurrence *) palloc(sizeof(MatViewOccurrence));
+			occ->rte = baseRte;
+			occ->relid = relid;
+			initStringInfo(&occ->attrs);
+			occurrences = lappend(occurrences, occ);
+		}
+
+		appendStringInfo(&occ->attrs, "%s%d:%d", (occ->attrs.len > 0) ? "," : "", viewAttr,
+				attno);
+	}
+
+	foreach(lc, baseRels)
+	{
+		relOccurrences = NIL;
+		baseAttrs = NIL;
+
+		foreach(occLc, occurrences)
+		{
+			occ = (MatViewOccurrence *) lfirst(occLc);
+
+			if (occ->relid == lfirst_oid(lc))
+			{
+				relOccurrences = lappend(relOccurrences, occ->attrs.data);
+				parseAttrList(occ->attrs.data, NULL, &baseAttrs);
+			}
+		}
+
+		if (relOccurrences == NIL || !hasEqualityOperators(lfirst_oid(lc), baseAttrs))
+			return NIL;
+
+		result = lappend(result, relOccurrences);
+	}
+
+	return result;
+}
+
+/*
+ * Follows a target list expression through joins and subqueries down to the base relation
+ * attribute it is a copy of. Returns false if the expression is not a simple copy of a base
+ * relation attribute.
+ */
+
+static bool
+traceProvAttr (Query *query, Expr *expr, Oid *relid, AttrNumber *attno, RangeTblEntry **baseRte)
+{
+	RangeTblEntry *rte;
+	TargetEntry *te;
+	Var *var;
+
+	while (true)
+	{
+		if (expr == NULL || !IsA(expr, Var))
+			return false;
+
+		var = (Var *) expr;
+		if (var->varlevelsup != 0 || var->varattno <= 0)
+			return false;
+
+		rte = rt_fetch(var->varno, query->rtable);
+
+		switch (rte->rtekind)
+		{
+			case RTE_RELATION:
+				*relid = rte->relid;
+				*attno = var->varattno;
+				*baseRte = rte;
+				return true;
+			case RTE_JOIN:
+				expr = (Expr *) list_nth(rte->joinaliasvars, var->varattno - 1);
+				break;
+			case RTE_SUBQUERY:
+				if (rte->subquery->setOperations != NULL)
+					return false;
+
+				te = get_tle_by_resno(rte->subquery->targetList, var->varattno);
+				if (te == NULL)
+					return false;
+
+				query = rte->subquery;
+				expr = te->expr;
+				break;
+			default:
+				return false;
+		}
+	}
+}
+
+/*
+ * Checks that the types of the attributes attrs of relation relid have an equality operator.
+ */
+
+static bool
+hasEqualityOperators (Oid relid, List *attrs)
+{
+	ListCell *lc;
+	Operator op;
+
+	foreach(lc, attrs)
+	{
+		op = equality_oper(get_atttype(relid, (AttrNumber) lfirst_int(lc)), true);
+		if (op == NULL)
+			return false;
+		ReleaseSysCache(op);
+	}
+
+	return true;
+}
+
+/*
+ * Creates the trigger that maintains a materialized provenance view on one of its base relations.
+ */
+
+static void
+createMaintenanceTrigger (Oid baseRelid, Oid matOid, Oid defOid, char mode, List *groupAttrs,
+		List *occurrences)
+{
+	CreateTrigStmt *trig;
+	ObjectAddress trigAddress;
+	ObjectAddress defAddress;
+	StringInfoData str;
+	ListCell *lc;
+
+	trig = makeNode(CreateTrigStmt);
+	trig->trigname = palloc(NAMEDATALEN);
+	snprintf(trig->trigname, NAMEDATALEN, MATVIEW_TRIGGER_PREFIX "%u", matOid);
+	trig->relation = makeRangeVar(get_namespace_name(get_rel_namespace(baseRelid)),
+			get_rel_name(baseRelid));
+	trig->funcname = SystemFuncName("prov_matview_maintain");
+	trig->before = false;
+	trig->row = (mode != MATVIEW_MODE_FULL);
+	strcpy(trig->actions, "iud");
+
+	initStringInfo(&str);
+	appendStringInfo(&str, "%u", matOid);
+	trig->args = lappend(trig->args, makeString(pstrdup(str.data)));
+
+	resetStringInfo(&str);
+	appendStringInfo(&str, "%u", defOid);
+	trig->args = lappend(trig->args, makeString(pstrdup(str.data)));
+
+	resetStringInfo(&str);
+	appendStringInfoChar(&str, mode);
+	trig->args = lappend(trig->args, makeString(pstrdup(str.data)));
+
+	resetStringInfo(&str);
+	foreach(lc, groupAttrs)
+		appendStringInfo(&str, "%s%d", (str.len > 0) ? "," : "", lfirst_int(lc));
+	trig->args = lappend(trig->args, makeString(pstrdup(str.data)));
+
+	foreach(lc, occurrences)
+		trig->args = lappend(trig->args, makeString((char *) lfirst(lc)));
+
+	trigAddress.classId = TriggerRelationId;
+	trigAddress.objectId = CreateTrigger(trig, InvalidOid);
+	trigAddress.objectSubId = 0;
+	defAddress.classId = RelationRelationId;
+	defAddress.objectId = defOid;
+	defAddress.objectSubId = 0;
+
+	recordDependencyOn(&trigAddress, &defAddress, DEPENDENCY_AUTO);
+}
+
+/*
+ * Trigger function that maintains a materialized provenance view after a modification of one of
+ * its base relations. The maintenance statements are executed as the owner of the view.
+ */
+
+Datum
+prov_matview_maintain (PG_FUNCTION_ARGS)
+{
+	TriggerData *trigdata = (TriggerData *) fcinfo->context;
+	MatViewTrigInfo info;
+	Relation matRel;
+	Oid matOwner;
+	Oid saveUserId;
+	bool saveSecDefContext;
+
+	if (!CALLED_AS_TRIGGER(fcinfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED),
+				 errmsg("prov_matview_maintain was not called by trigger manager")));
+	if (!TRIGGER_FIRED_AFTER(trigdata->tg_event))
+		ereport(ERROR,
+				(errcode(ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED),
+				 errmsg("prov_matview_maintain must be fired AFTER")));
+
+	parseTrigInfo(trigdata->tg_trigger, &info);
+
+	/* serialize maintenance of the view, see the notes at the top of the file */
+	matRel = heap_open(info.matOid, ShareRowExclusiveLock);
+	matOwner = RelationGetForm(matRel)->relowner;
+	heap_close(matRel, NoLock);
+
+	if (SPI_connect() != SPI_OK_CONNECT)
+		elog(ERROR, "SPI_connect failed");
+
+	GetUserIdAndContext(&saveUserId, &saveSecDefContext);
+	SetUserIdAndContext(matOwner, true);
+
+	if (info.mode == MATVIEW_MODE_FULL)
+	{
+		executeMaintenanceStmt(&info, MATVIEW_DELETE_ALL, trigdata->tg_relation, NULL, NULL);
+		executeMaintenanceStmt(&info, MATVIEW_INSERT_ALL, trigdata->tg_relation, NULL, NULL);
+	}
+	else
+	{
+		maintainSlice(&info, trigdata->tg_relation, trigdata->tg_trigtuple);
+
+		if (TRIGGER_FIRED_BY_UPDATE(trigdata->tg_event))
+			maintainSlice(&info, trigdata->tg_relation, trigdata->tg_newtuple);
+	}
+
+	SetUserIdAndContext(saveUserId, saveSecDefContext);
+
+	if (SPI_finish() != SPI_OK_FINISH)
+		elog(ERROR, "SPI_finish failed");
+
+	return PointerGetDatum(NULL);
+}
+
+/*
+ * Reads the maintenance information from the arguments of a trigger.
+ */
+
+static void
+parseTrigInfo (Trigger *trigger, MatViewTrigInfo *info)
+{
+	List *viewAttrs;
+	List *baseAttrs;
+	ListCell *lc;
+	int i;
+
+	if (trigger->tgnargs < 4)
+		ereport(ERROR,
+				(errcode(ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED),
+				 errmsg("prov_matview_maintain called with wrong number of arguments")));
+
+	info->tgoid = trigger->tgoid;
+	info->matOid = (Oid) strtoul(trigger->tgargs[0], NULL, 10);
+	info->defOid = (Oid) strtoul(trigger->tgargs[1], NULL, 10);
+	info->mode = trigger->tgargs[2][0];
+	info->groupAttrs = NIL;
+	info->viewAttrs = NIL;
+	info->baseAttrs = NIL;
+	info->sliceAttrs = NIL;
+
+	parseAttrList(trigger->tgargs[3], &info->groupAttrs, NULL);
+
+	for (i = 4; i < trigger->tgnargs; i++)
+	{
+		viewAttrs = NIL;
+		baseAttrs = NIL;
+		parseAttrList(trigger->tgargs[i], &viewAttrs, &baseAttrs);
+
+		info->viewAttrs = lappend(info->viewAttrs, viewAttrs);
+		info->baseAttrs = lappend(info->baseAttrs, baseAttrs);
+
+		foreach(lc, baseAttrs)
+			info->sliceAttrs = list_append_unique_int(info->sliceAttrs, lfirst_int(lc));
+	}
+}
+
+/*
+ * Parses a comma separated list of attribute numbers or of pairs of attribute numbers separated
+ * by ':'. The first numbers of the pairs are appended to first (if not NULL), the second numbers
+ * to second (if not NULL).
+ */
+
+static void
+parseAttrList (char *arg, List **first, List **second)
+{
+	char *c = arg;
+	char *end;
+	long attno;
+	bool isSecond = false;
+
+	while (*c)
+	{
+		attno = strtol(c, &end, 10);
+		if (end == c)
+			ereport(ERROR,
+					(errcode(ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED),
+					 errmsg("invalid argument \"%s\" for prov_matview_maintain", arg)));
+
+		if (!isSecond && first)
+			*first = lappend_int(*first, (int) attno);
+		if (isSecond && second)
+			*second = lappend_int(*second, (int) attno);
+
+		isSecond = (*end == ':');
+		c = (*end == '\0') ? end : end + 1;
+	}
+}
+
+/*
+ * Recomputes the part of a view that depends on a tuple of one of its base relations.
+ */
+
+static void
+maintainSlice (MatViewTrigInfo *info, Relation rel, HeapTuple tuple)
+{
+	SPITupleTable *groups;
+	int numGroups;
+	int numGroupAttrs = list_length(info->groupAttrs);
+	Datum *values;
+	char *nulls;
+	ListCell *lc;
+	bool isNull;
+	int i;
+	int j;
+
+	values = (Datum *) palloc(Max(list_length(info->sliceAttrs), numGroupAttrs) * sizeof(Datum));
+	nulls = (char *) palloc(Max(list_length(info->sliceAttrs), numGroupAttrs) + 1);
+
+	i = 0;
+	foreach(lc, info->sliceAttrs)
+	{
+		values[i] = heap_getattr(tuple, lfirst_int(lc), RelationGetDescr(rel), &isNull);
+		nulls[i++] = isNull ? 'n' : ' ';
+	}
+
+	if (info->mode == MATVIEW_MODE_SPJ)
+	{
+		executeMaintenanceStmt(info, MATVIEW_DELETE_SLICE, rel, values, nulls);
+		executeMaintenanceStmt(info, MATVIEW_INSERT_SLICE, rel, values, nulls);
+		return;
+	}
+
+	/* recompute each group with result tuples in the slice before or after the modification */
+	executeMaintenanceStmt(info, MATVIEW_GROUPS_OF_SLICE, rel, values, nulls);
+	groups = SPI_tuptable;
+	numGroups = SPI_processed;
+
+	for (i = 0; i < numGroups; i++)
+	{
+		for (j = 0; j < numGroupAttrs; j++)
+		{
+			values[j] = SPI_getbinval(groups->vals[i], groups->tupdesc, j + 1, &isNull);
+			nulls[j] = isNull ? 'n' : ' ';
+		}
+
+		executeMaintenanceStmt(info, MATVIEW_DELETE_GROUP, rel, values, nulls);
+		executeMaintenanceStmt(info, MATVIEW_INSERT_GROUP, rel, values, nulls);
+	}
+
+	SPI_freetuptable(groups);
+}
+
+/*
+ * Executes a maintenance statement.
+ */
+
+static void
+executeMaintenanceStmt (MatViewTrigInfo *info, MatViewStmtKind kind, Relation rel, Datum *values,
+		char *nulls)
+{
+	SPIPlanPtr plan;
+	int result;
+
+	plan = getMaintenancePlan(info, kind, rel);
+
+	result = SPI_execute_plan(plan, values, nulls, false, 0);
+	if (result < 0)
+		elog(ERROR, "SPI_execute_plan returned %d", result);
+}
+
+/*
+ * Returns the prepared maintenance statement of type kind for a trigger. The statement is
+ * prepared on first use.
+ */
+
+static SPIPlanPtr
+getMaintenancePlan (MatViewTrigInfo *info, MatViewStmtKind kind, Relation rel)
+{
+	MatViewPlanKey key;
+	MatViewPlanEntry *entry;
+	HASHCTL ctl;
+	SPIPlanPtr plan;
+	Oid *argtypes;
+	char *query;
+	int nargs;
+	bool found;
+
+	if (matViewPlans == NULL)
+	{
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(MatViewPlanKey);
+		ctl.entrysize = sizeof(MatViewPlanEntry);
+		ctl.hash = tag_hash;
+
+		matViewPlans = hash_create("Materialized provenance view plans", 64, &ctl,
+				HASH_ELEM | HASH_FUNCTION);
+	}
+
+	MemSet(&key, 0, sizeof(key));
+	key.tgoid = info->tgoid;
+	key.kind = kind;
+
+	entry = (MatViewPlanEntry *) hash_search(matViewPlans, &key, HASH_FIND, NULL);
+	if (entry != NULL)
+		return entry->plan;
+
+	query = buildMaintenanceQuery(info, kind, rel, &argtypes, &nargs);
+
+	plan = SPI_prepare(query, nargs, argtypes);
+	if (plan == NULL)
+		elog(ERROR, "SPI_prepare returned %d for %s", SPI_result, query);
+	plan = SPI_saveplan(plan);
+
+	entry = (MatViewPlanEntry *) hash_search(matViewPlans, &key, HASH_ENTER, &found);
+	entry->plan = plan;
+
+	return plan;
+}
+
+/*
+ * Builds the query string and the parameter types of a maintenance statement. Slice statements
+ * have a parameter for each base relation attribute in sliceAttrs, group statements a parameter
+ * for each group by attribute.
+ */
+
+static char *
+buildMaintenanceQuery (MatViewTrigInfo *info, MatViewStmtKind kind, Relation rel, Oid **argtypes,
+		int *nargs)
+{
+	StringInfoData str;
+	Relation matRel;
+	Relation defRel;
+	TupleDesc matDesc;
+	TupleDesc defDesc;
+	char *matName;
+	char *defName;
+	ListCell *lc;
+	int i;
+
+	matRel = relation_open(info->matOid, AccessShareLock);
+	defRel = relation_open(info->defOid, AccessShareLock);
+	matDesc = RelationGetDescr(matRel);
+	defDesc = RelationGetDescr(defRel);
+	matName = getQualifiedRelName(matRel);
+	defName = getQualifiedRelName(defRel);
+
+	initStringInfo(&str);
+
+	switch (kind)
+	{
+		case MATVIEW_DELETE_SLICE:
+			appendStringInfo(&str, "DELETE FROM %s WHERE ", matName);
+			appendSliceCond(&str, info, matDesc);
+			break;
+		case MATVIEW_INSERT_SLICE:
+			appendStringInfo(&str, "INSERT INTO %s SELECT * FROM %s WHERE ", matName, defName);
+			appendSliceCond(&str, info, defDesc);
+			break;
+		case MATVIEW_GROUPS_OF_SLICE:
+			appendStringInfoString(&str, "SELECT ");
+			appendGroupAttrs(&str, info, matDesc);
+			appendStringInfo(&str, " FROM %s WHERE ", matName);
+			appendSliceCond(&str, info, matDesc);
+			appendStringInfoString(&str, " UNION SELECT ");
+			appendGroupAttrs(&str, info, defDesc);
+			appendStringInfo(&str, " FROM %s WHERE ", defName);
+			appendSliceCond(&str, info, defDesc);
+			break;
+		case MATVIEW_DELETE_GROUP:
+			appendStringInfo(&str, "DELETE FROM %s WHERE ", matName);
+			appendGroupCond(&str, info, matDesc);
+			break;
+		case MATVIEW_INSERT_GROUP:
+			appendStringInfo(&str, "INSERT INTO %s SELECT * FROM %s WHERE ", matName, defName);
+			appendGroupCond(&str, info, defDesc);
+			break;
+		case MATVIEW_DELETE_ALL:
+			appendStringInfo(&str, "DELETE FROM %s", matName);
+			break;
+		case MATVIEW_INSERT_ALL:
+			appendStringInfo(&str, "INSERT INTO %s SELECT * FROM %s", matName, defName);
+			break;
+	}
+
+	/* determine the parameter types */
+	switch (kind)
+	{
+		case MATVIEW_DELETE_SLICE:
+		case MATVIEW_INSERT_SLICE:
+		case MATVIEW_GROUPS_OF_SLICE:
+			*nargs = list_length(info->sliceAttrs);
+			*argtypes = (Oid *) palloc((*nargs + 1) * sizeof(Oid));
+			i = 0;
+			foreach(lc, info->sliceAttrs)
+				(*argtypes)[i++] = RelationGetDescr(rel)->attrs[lfirst_int(lc) - 1]->atttypid;
+			break;
+		case MATVIEW_DELETE_GROUP:
+		case MATVIEW_INSERT_GROUP:
+			*nargs = list_length(info->groupAttrs);
+			*argtypes = (Oid *) palloc((*nargs + 1) * sizeof(Oid));
+			i = 0;
+			foreach(lc, info->groupAttrs)
+				(*argtypes)[i++] = matDesc->attrs[lfirst_int(lc) - 1]->atttypid;
+			break;
+		default:
+			*nargs = 0;
+			*argtypes = NULL;
+			break;
+	}
+
+	relation_close(defRel, AccessShareLock);
+	relation_close(matRel, AccessShareLock);
+
+	return str.data;
+}
+
+/*
+ * Appends the condition that selects the tuples of the view in the slice of a base relation tuple,
+ * i.e., the tuples with the provenance attributes of at least one occurrence of the base relation
+ * equal to the parameters.
+ */
+
+static void
+appendSliceCond (StringInfo str, MatViewTrigInfo *info, TupleDesc desc)
+{
+	ListCell *occViewLc;
+	ListCell *occBaseLc;
+	ListCell *viewLc;
+	ListCell *baseLc;
+	ListCell *lc;
+	int param;
+
+	forboth(occViewLc, info->viewAttrs, occBaseLc, info->baseAttrs)
+	{
+		appendStringInfoString(str, (occViewLc == list_head(info->viewAttrs)) ? "(" : " OR (");
+
+		forboth(viewLc, (List *) lfirst(occViewLc), baseLc, (List *) lfirst(occBaseLc))
+		{
+			/* the parameter number of a base relation attribute is its position in sliceAttrs */
+			param = 1;
+			foreach(lc, info->sliceAttrs)
+			{
+				if (lfirst_int(lc) == lfirst_int(baseLc))
+					break;
+				param++;
+			}
+
+			appendStringInfo(str, "%s%s IS NOT DISTINCT FROM $%d",
+					(viewLc == list_head((List *) lfirst(occViewLc))) ? "" : " AND ",
+					quote_identifier(NameStr(desc->attrs[lfirst_int(viewLc) - 1]->attname)),
+					param);
+		}
+
+		appendStringInfoChar(str, ')');
+	}
+}
+
+/*
+ * Appends the condition that selects the tuples of the view of the group given as parameters.
+ */
+
+static void
+appendGroupCond (StringInfo str, MatViewTrigInfo *info, TupleDesc desc)
+{
+	ListCell *lc;
+	int param = 1;
+
+	foreach(lc, info->groupAttrs)
+	{
+		appendStringInfo(str, "%s%s IS NOT DISTINCT FROM $%d", (param > 1) ? " AND " : "",
+				quote_identifier(NameStr(desc->attrs[lfirst_int(lc) - 1]->attname)), param);
+		param++;
+	}
+}
+
+/*
+ * Appends the comma separated group by attributes of the view.
+ */
+
+static void
+appendGroupAttrs (StringInfo str, MatViewTrigInfo *info, TupleDesc desc)
+{
+	ListCell *lc;
+
+	foreach(lc, info->groupAttrs)
+		appendStringInfo(str, "%s%s", (lc == list_head(info->groupAttrs)) ? "" : ", ",
+				quote_identifier(NameStr(desc->attrs[lfirst_int(lc) - 1]->attname)));
+}
+
+/*
+ * Returns the schema qualified and quoted name of a relation.
+ */
+
+static char *
+getQualifiedRelName (Relation rel)
+{
+	return quote_qualified_identifier(get_namespace_name(RelationGetNamespace(rel)),
+			RelationGetRelationName(rel));
+}
@@ -283,6 +283,7 @@ static TransProvInfo *_copyTransProvInfo(TransProvInfo *from);
 static TransSubInfo *_copyTransSubInfo(TransSubInfo *from);
 static XsltFuncExpr *_copyXsltFuncExpr(XsltFuncExpr *from);
 static ThisExpr *_copyThisExpr(ThisExpr *from);
+static ProvLineageInfo *_copyProvLineageInfo(ProvLineageInfo *from);
 
 static int *_copyVarLengthIntArray(int *array, int numMembers);
 
@@ -313,6 +314,7 @@ static TransProvInfo *_readTransProvInfo(void);
 static TransSubInfo *_readTransSubInfo(void);
 static XsltFuncExpr *_readXsltFuncExpr(void);
 static ThisExpr *_readThisExpr(void);
+static ProvLineageInfo *_readProvLineageInfo(void);
 
 /* out functions */
 static void _outSublinkInfo(StringInfo str, SublinkInfo *node);
@@ -336,6 +338,7 @@ static void _outTransProvInfo(StringInfo str, TransProvInfo *node);
 static void _outTransSubInfo(StringInfo str, TransSubInfo *node);
 static void _outXsltFuncExpr(StringInfo str, XsltFuncExpr *node);
 static void _outThisExpr(StringInfo str, ThisExpr *node);
+static void _outProvLineageInfo(StringInfo str, ProvLineageInfo *node);
 
 static void _outVarLenghtIntArray (StringInfo str, int *array, int numMembers);
 static void _outToken(StringInfo str, char *s);
@@ -364,6 +367,7 @@ static bool _equalTransProvInfo (TransProvInfo *a, TransProvInfo *b);
 static bool _equalTransSubInfo (TransSubInfo *a, TransSubInfo *b);
 static bool _equalXsltFuncExpr (XsltFuncExpr *a, XsltFuncExpr *b);
 static bool _equalThisExpr (ThisExpr *a, ThisExpr *b);
+static bool _equalProvLineageInfo (ProvLineageInfo *a, ProvLineageInfo *b);
 
 /*
  * Make functions
@@ -414,6 +418,9 @@ makeProvInfo (void)
 	result->annotations = NIL;
 	result->provSublinkRewritten = false;
 	result->shouldRewrite = false;
+	result->aggSinglePass = false;
+	result->normalized = false;
+	result->lineage = NULL;
 
 	return result;
 }
@@ -720,6 +727,20 @@ makeTransSubInfo (int id, SubOperationType opType)
 	return result;
 }
 
+ProvLineageInfo *
+makeProvLineageInfo (void)
+{
+	ProvLineageInfo *result;
+
+	result = makeNode(ProvLineageInfo);
+
+	result->lineageRelid = InvalidOid;
+	result->sourceRelids = NIL;
+	result->numKeys = 0;
+
+	return result;
+}
+
 
 Query *
 flatCopyWithoutProvInfo (Query *from)
@@ -824,6 +845,9 @@ provNodesEquals(void *a, void *b)
 	case T_ThisExpr:
 		retval = _equalThisExpr(a,b);
 		break;
+	case T_ProvLineageInfo:
+		retval = _equalProvLineageInfo(a,b);
+		break;
 	default:
 		elog(ERROR, "unrecognized node type: %d",
 			 (int) nodeTag(a));
@@ -884,7 +908,10 @@ _equalProvInfo(ProvInfo *a, ProvInfo *b)
 {
 	COMPARE_SCALAR_FIELD(provSublinkRewritten);
 	COMPARE_SCALAR_FIELD(shouldRewrite);
+	COMPARE_SCALAR_FIELD(aggSinglePass);
+	COMPARE_SCALAR_FIELD(normalized);
 	COMPARE_NODE_FIELD(rewriteInfo);
+	COMPARE_NODE_FIELD(lineage);
 
 	return true;
 }
@@ -1124,6 +1151,16 @@ _equalThisExpr (ThisExpr *a, ThisExpr *b)
 	return true;
 }
 
+static bool
+_equalProvLineageInfo (ProvLineageInfo *a, ProvLineageInfo *b)
+{
+	COMPARE_SCALAR_FIELD(lineageRelid);
+	COMPARE_NODE_FIELD(sourceRelids);
+	COMPARE_SCALAR_FIELD(numKeys);
+
+	return true;
+}
+
 /*
  * OUT functions
  */
@@ -1196,6 +1233,9 @@ outProvNode(StringInfo str, void *obj)
 	case T_ThisExpr:
 		_outThisExpr(str, obj);
 		break;
+	case T_ProvLineageInfo:
+		_outProvLineageInfo(str, obj);
+		break;
 	default:
 
 		/*
@@ -1257,10 +1297,13 @@ _outProvInfo(StringInfo str, ProvInfo *node)
 
 	WRITE_BOOL_FIELD(provSublinkRewritten);
 	WRITE_BOOL_FIELD(shouldRewrite);
+	WRITE_BOOL_FIELD(aggSinglePass);
+	WRITE_BOOL_FIELD(normalized);
 	WRITE_ENUM_FIELD(contribution, ContributionType);
 	WRITE_NODE_FIELD(copyInfo);
 	WRITE_NODE_FIELD(rewriteInfo);
 	WRITE_NODE_FIELD(annotations);
+	WRITE_NODE_FIELD(lineage);
 
 }
 
@@ -1473,6 +1516,16 @@ _outThisExpr (StringInfo str, ThisExpr *node)
 	WRITE_STRING_FIELD(thisType);
 }
 
+static void
+_outProvLineageInfo (StringInfo str, ProvLineageInfo *node)
+{
+	WRITE_NODE_TYPE("PROVLINEAGEINFO");
+
+	WRITE_OID_FIELD(lineageRelid);
+	WRITE_NODE_FIELD(sourceRelids);
+	WRITE_INT_FIELD(numKeys);
+}
+
 static void
 _outVarLenghtIntArray (StringInfo str, int *array, int numMembers)
 {
@@ -1581,6 +1634,8 @@ parseProvNodeString(char *token, int length)
 		retval = _readXsltFuncExpr();
 	else if (MATCH("THISEXPR", 8))
 		retval = _readThisExpr();
+	else if (MATCH("PROVLINEAGEINFO", 15))
+		retval = _readProvLineageInfo();
 	else
 	{
 		elog(ERROR, "badly formatted node string \"%.32s\"...", token);
@@ -1643,10 +1698,13 @@ _readProvInfo(void)
 
 	READ_BOOL_FIELD(provSublinkRewritten);
 	READ_BOOL_FIELD(shouldRewrite);
+	READ_BOOL_FIELD(aggSinglePass);
+	READ_BOOL_FIELD(normalized);
 	READ_ENUM_FIELD(contribution, ContributionType);
 	READ_NODE_FIELD(copyInfo);
 	READ_NODE_FIELD(rewriteInfo);
 	READ_NODE_FIELD(annotations);
+	READ_NODE_FIELD(lineage);
 
 	READ_DONE();
 }
@@ -1853,6 +1911,18 @@ _readThisExpr(void)
 	READ_DONE();
 }
 
+static ProvLineageInfo *
+_readProvLineageInfo(void)
+{
+	READ_LOCALS(ProvLineageInfo);
+
+	READ_OID_FIELD(lineageRelid);
+	READ_NODE_FIELD(sourceRelids);
+	READ_INT_FIELD(numKeys);
+
+	READ_DONE();
+}
+
 /*
  * COPY functions
  */
@@ -1926,6 +1996,9 @@ void *copyProvNode (void *from)
 		case T_ThisExpr:
 			retval = _copyThisExpr(from);
 			break;
+		case T_ProvLineageInfo:
+			retval = _copyProvLineageInfo(from);
+			break;
 		default:
 			elog(ERROR, "unrecognized node type: %d", (int) nodeTag(from));
 			retval = from;		/* keep compiler quiet */
@@ -1994,10 +2067,13 @@ _copyProvInfo(ProvInfo *from)
 
 	COPY_SCALAR_FIELD(provSublinkRewritten);
 	COPY_SCALAR_FIELD(shouldRewrite);
+	COPY_SCALAR_FIELD(aggSinglePass);
+	COPY_SCALAR_FIELD(normalized);
 	COPY_SCALAR_FIELD(contribution);
 	COPY_NODE_FIELD(copyInfo);
 	COPY_NODE_FIELD(rewriteInfo);
 	COPY_NODE_FIELD(annotations);
+	COPY_NODE_FIELD(lineage);
 
 	return newnode;
 }
@@ -2296,6 +2372,18 @@ _copyThisExpr(ThisExpr *from)
 	return newnode;
 }
 
+static ProvLineageInfo *
+_copyProvLineageInfo(ProvLineageInfo *from)
+{
+	ProvLineageInfo *newnode = makeNode(ProvLineageInfo);
+
+	COPY_SCALAR_FIELD(lineageRelid);
+	COPY_NODE_FIELD(sourceRelids);
+	COPY_SCALAR_FIELD(numKeys);
+
+	return newnode;
+}
+
 static int *
 _copyVarLengthIntArray (int *array, int numMembers)
 {
@@ -0,0 +1,262 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_normalize.c
+ *	  PERM C -  Normalized output of provenance queries (SELECT PROVENANCE ... FORMAT NORMALIZED).
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/main/prov_normalize.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		A provenance query returns one row per witness of a result tuple, which repeats the result
+ *		tuple and the base tuples of the witness. The normalized output returns each distinct result
+ *		tuple and each distinct base tuple only once with an id and one row per witness that
+ *		references these ids:
+ *
+ *			prov_row | prov_id | result attrs | prov_r | prov_r_a ... | prov_s | prov_s_b ...
+ *			'r'      | result  | values       |        |              |        |
+ *			'b'      | base    |              | base   | values       |        |
+ *			'w'      | result  |              | base   |              | base   |
+ *
+ *		The rewritten provenance query is wrapped into a new top query that has this layout. The
+ *		result and provenance attributes are taken from the rewritten query, the kind (prov_row) and
+ *		the id attributes are NULL placeholders. The planner adds a ProvNormalize node on top of the
+ *		plan of this query that removes the duplicates with hash tables and fills in the placeholders
+ *		(see executor/nodeProvNormalize.c). The rewriter records the provenance attributes it creates
+ *		for each base relation access (see addProvAttrAccess), so the attributes of an access are
+ *		found without parsing their names.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "catalog/pg_type.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/cost.h"
+#include "parser/parse_expr.h"
+#include "parser/parse_oper.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+#include "utils/syscache.h"
+
+#include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_util.h"
+#include "provrewrite/provattrname.h"
+#include "provrewrite/prov_normalize.h"
+
+/* prototypes */
+static void addPlaceholderTe (Query *query, char *name, Oid type);
+static void addSubqueryTe (Query *query, TargetEntry *te);
+static Oid getHashableEqualityOp (TargetEntry *te);
+
+/*
+ * Wrap a rewritten provenance query into a top query with the layout of the normalized output.
+ */
+
+Query *
+addNormalizedTopQuery (Query *query)
+{
+	Query *newTop;
+	RangeTblRef *rtRef;
+	TargetEntry *te;
+	ListCell *lc;
+	ProvAttrAccess *access;
+	ProvAttrAccess *curAccess = NULL;
+
+	newTop = makeQuery();
+	SetProvNormalized(newTop, true);
+	SetProvNormalized(query, false);
+
+	/* the into clause and cursor declaration belong to the new top query */
+	newTop->intoClause = query->intoClause;
+	newTop->utilityStmt = query->utilityStmt;
+	query->intoClause = NULL;
+	query->utilityStmt = NULL;
+
+	addSubqueryToRT(newTop, query, "normalized");
+	correctRTEAlias((RangeTblEntry *) linitial(newTop->rtable));
+
+	MAKE_RTREF(rtRef, 1);
+	newTop->jointree->fromlist = list_make1(rtRef);
+
+	/* kind and id of an output row */
+	addPlaceholderTe(newTop, "prov_row", TEXTOID);
+	addPlaceholderTe(newTop, "prov_id", INT8OID);
+
+	/* result attributes */
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (!te->resjunk && !isProvAttr(te))
+			addSubqueryTe(newTop, te);
+	}
+
+	/* provenance attributes, the attributes of each base relation access are preceded by its id */
+	foreach(lc, query->targetList)
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		if (te->resjunk || !isProvAttr(te))
+			continue;
+
+		access = getProvAttrAccess(te->resname);
+		if (access == NULL)
+			elog(ERROR, "provenance attribute %s does not belong to a base relation access",
+					te->resname);
+
+		if (access != curAccess)
+		{
+			addPlaceholderTe(newTop, access->accessName, INT8OID);
+			curAccess = access;
+		}
+
+		addSubqueryTe(newTop, te);
+	}
+
+	return newTop;
+}
+
+/*
+ * Append a NULL constant target list entry to the target list of query.
+ */
+
+static void
+addPlaceholderTe (Query *query, char *name, Oid type)
+{
+	TargetEntry *te;
+
+	te = makeTargetEntry((Expr *) makeNullConst(type, -1),
+			list_length(query->targetList) + 1, pstrdup(name), false);
+	query->targetList = lappend(query->targetList, te);
+}
+
+/*
+ * Append a reference to the target list entry te of the subquery to the target list of query.
+ */
+
+static void
+addSubqueryTe (Query *query, TargetEntry *te)
+{
+	TargetEntry *newTe;
+	Var *var;
+
+	var = makeVar(1, te->resno, exprType((Node *) te->expr), exprTypmod((Node *) te->expr), 0);
+	newTe = makeTargetEntry((Expr *) var, list_length(query->targetList) + 1, pstrdup(te->resname), false);
+	query->targetList = lappend(query->targetList, newTe);
+}
+
+/*
+ * Create the ProvNormalize plan node for a query created by addNormalizedTopQuery. This has to be done before
+ * the query is planned, because the placeholders are recognized as the constants in the target list and the
+ * planner replaces the Vars of pulled up subqueries by their expressions.
+ */
+
+ProvNormalize *
+makeProvNormalize (Query *query)
+{
+	ProvNormalize *node;
+	TargetEntry *te;
+	ListCell *lc;
+	int numTes;
+	int col;
+
+	node = makeNode(ProvNormalize);
+	node->numResultCols = 0;
+	node->numGroups = 0;
+	node->numCols = 0;
+
+	numTes = list_length(query->targetList);
+	node->groupNumCols = (int *) palloc(numTes * sizeof(int));
+	node->colIdx = (AttrNumber *) palloc(numTes * sizeof(AttrNumber));
+	node->eqOperators = (Oid *) palloc(numTes * sizeof(Oid));
+
+	/* skip the kind and id of the output row */
+	for_each_cell(lc, lnext(lnext(list_head(query->targetList))))
+	{
+		te = (TargetEntry *) lfirst(lc);
+
+		/* id placeholder of a base relation access */
+		if (IsA(te->expr, Const))
+		{
+			node->groupNumCols[node->numGroups++] = 0;
+			continue;
+		}
+
+		col = node->numCols++;
+		node->colIdx[col] = te->resno;
+		node->eqOperators[col] = getHashableEqualityOp(te);
+
+		if (node->numGroups == 0)
+			node->numResultCols++;
+		else
+			node->groupNumCols[node->numGroups - 1]++;
+	}
+
+	return node;
+}
+
+/*
+ * Returns the equality operator used to compare the values of a result or provenance attribute. The
+ * ProvNormalize node needs an operator that supports hashing.
+ */
+
+static Oid
+getHashableEqualityOp (TargetEntry *te)
+{
+	Oid type;
+	Oid result = InvalidOid;
+	Operator op;
+
+	type = exprType((Node *) te->expr);
+	op = equality_oper(type, true);
+
+	if (op != NULL)
+	{
+		result = oprid(op);
+		ReleaseSysCache(op);
+	}
+
+	if (!OidIsValid(result) || !op_hashjoinable(result))
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_FUNCTION),
+				 errmsg("could not identify a hashable equality operator for type %s",
+						format_type_be(type)),
+				 errdetail("FORMAT NORMALIZED compares the values of attribute \"%s\".",
+						te->resname)));
+
+	return result;
+}
+
+/*
+ * Put the ProvNormalize node created by makeProvNormalize on top of the plan of its query.
+ */
+
+Plan *
+addProvNormalizePlan (ProvNormalize *node, Plan *subplan)
+{
+	Plan *plan = &node->plan;
+
+	/* the node outputs the tuples in the layout of its input (set_dummy_tlist_references) */
+	plan->targetlist = subplan->targetlist;
+	plan->qual = NIL;
+	plan->lefttree = subplan;
+	plan->righttree = NULL;
+
+	/*
+	 * Each input tuple is hashed once per base relation access and for the result attributes. The number of
+	 * output rows is between the number of witnesses and this number times the number of hash tables, we use
+	 * the number of witnesses.
+	 */
+	plan->startup_cost = subplan->startup_cost;
+	plan->total_cost = subplan->total_cost
+			+ (cpu_operator_cost * node->numCols + cpu_tuple_cost * (node->numGroups + 1))
+			* subplan->plan_rows;
+	plan->plan_rows = subplan->plan_rows;
+	plan->plan_width = subplan->plan_width;
+
+	return plan;
+}
@@ -11,20 +11,37 @@
  *	  $PostgreSQL: pgsql/src/backend/provrewrite/prov_plan_all.c,v 1.322 2008/01/09 08:46:44 bglavic $
  *
  * NOTES
- *		Current implementation generates simply activates and deactivates each rewrite strategy, calls the
- *		the perm module to apply each on/off combination and each generated plan is passed to the optimizer.
- *		The estimated cost of computed by the optimizer for each plan is used to rank these plans. The cheapest
- *		plan is then choosen for execution (so actually we have to store only the current cheapest plan).
+ *		Each of the rewrite strategies controlled by the options in setOptions can be activated or
+ *		deactivated. The search only considers options that can influence the rewrite of the query (e.g.,
+ *		the sublink strategies are ignored for queries without sublinks) and starts with the options the
+ *		user has set. Rewrites that produce a Query tree that has already been planned are skipped. The
+ *		estimated cost of each plan is used to rank the plans and the cheapest plan is choosen for
+ *		execution (so actually we have to store only the current cheapest plan). The search stops early,
+ *		once the time spend on rewriting and planning exceeds prov_optimizer_plan_share of the estimated
+ *		cost of the cheapest plan found so far.
+ *
+ *		Each candidate is rewritten and planned in its own memory context. The context of a candidate that
+ *		is not cheaper than the cheapest one is reset as a whole, the context of the cheapest candidate is
+ *		kept until the search is finished. Only the final plan (and query) are copied to the caller's
+ *		memory context. The rewriter modifies the query tree in place, so each candidate still starts with
+ *		a copy of the query. The planner copy of the rewritten query is only made if the caller needs the
+ *		unplanned query.
  *
  *-------------------------------------------------------------------------
  */
 
 #include <stdlib.h>
 #include "postgres.h"
+#include "access/hash.h"
+#include "executor/instrument.h"
+#include "nodes/nodeFuncs.h"
 #include "nodes/plannodes.h"
 #include "nodes/parsenodes.h"
+#include "optimizer/clauses.h"
+#include "optimizer/cost.h"
 #include "optimizer/planner.h"
 #include "utils/guc.h"
+#include "utils/memutils.h"
 #include "provrewrite/provrewrite.h"
 #include "provrewrite/prov_plan_all.h"
 #include "provrewrite/provattrname.h"
@@ -32,37 +49,56 @@
 #include "provrewrite/provlog.h"
 #include "provrewrite/prov_util.h"
 #include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_stats.h"
 
 /* Macros */
 #define NUM_OPTIONS 32
-#define STOP_PLANING_THRESHHOLD -1
+#define OPTION_SET 0x01
+#define OPTIONS_SUBLINK 0x1E
+
+/*
+ * Number of operator evaluations the executor performs in one millisecond. Used to
+ * convert the time spend on planning into estimated cost units (one millisecond costs
+ * OPERATORS_PER_MSEC * cpu_operator_cost). Calibrated with a sequential scan that
+ * evaluates ten comparisons per tuple, which takes about 50ns per comparison.
+ */
+#define OPERATORS_PER_MSEC 20000.0
+
+/* a rewritten query tree that has already been planned */
+typedef struct PlannedRewrite
+{
+	uint32 hash;
+	char *tree;
+} PlannedRewrite;
 
 /* Function declarations */
 static void generateCheapestQueryAndPlan (Query *query, int cursorOptions,
 										ParamListInfo boundParams, Query **cheapestQuery,
 										PlannedStmt **cheapestPlan);
+static void searchCheapestQueryAndPlan (Query *query, int cursorOptions,
+										ParamListInfo boundParams, Query **cheapestQuery,
+										PlannedStmt **cheapestPlan);
+static int getApplicableOptions (Query *query);
+static bool getApplicableOptionsWalker (Node *node, int *context);
+static bool isPlannedRewrite (Query *rewrittenQuery, List **planned, MemoryContext plannedContext);
+static void resetRewriterState (void);
+static int getOptions (void);
 static void setOptions(int flags);
-static bool checkIfRewriteNeeded (Query *query);
 
 /*
  * Generate rewritten queries for applicable rewrite methods, plan them to estimate
  * their costs and return the plan for the one that's supposed to be the cheapest.
  */
-/*TODO we could add a basic lower bound for the costs where it does not make
- * sense to try other rewrites because planning them would cost more time than
- * just executing the current plan (Have to measure plan times then to know when
- * to apply this pruning)
- */
+
 PlannedStmt *
 generateCheapestProvenancePlan (Query *query, int cursorOptions, ParamListInfo boundParams)
 {
 	PlannedStmt *cheapestPlan;
-	Query *cheapestQuery;
 
 	cheapestPlan = NULL;
-	cheapestQuery = NULL;
 
-	generateCheapestQueryAndPlan (query, cursorOptions, boundParams, &cheapestQuery, &cheapestPlan);
+	/* only the plan is needed */
+	generateCheapestQueryAndPlan (query, cursorOptions, boundParams, NULL, &cheapestPlan);
 
 	return cheapestPlan;
 }
@@ -86,75 +122,301 @@ generateCheapestPlanQuery (Query *query, int cursorOptions, ParamListInfo boundP
 }
 
 /*
- *
+ * Search for the cheapest rewrite of query. The options set by the user are
+ * restored afterwards, even if the search fails. cheapestQuery may be NULL if
+ * the caller only needs the plan.
  */
+
 static void
 generateCheapestQueryAndPlan (Query *query, int cursorOptions, ParamListInfo boundParams, Query **cheapestQuery, PlannedStmt **cheapestPlan)
 {
+	int userOptions;
+	instr_time searchStart;
+
+	/* queries without provenance parts are planned once */
+	if (!queryHasRewriteChildren(query))
+	{
+		if (cheapestQuery)
+			*cheapestQuery = query;
+		*cheapestPlan = standard_planner(query, cursorOptions, boundParams);
+		return;
+	}
+
+	userOptions = getOptions();
+	provStatsResetStatement();
+	ProvStatsBegin(searchStart);
+
+	PG_TRY();
+	{
+		searchCheapestQueryAndPlan(query, cursorOptions, boundParams,
+				cheapestQuery, cheapestPlan);
+	}
+	PG_CATCH();
+	{
+		setOptions(userOptions);
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	setOptions(userOptions);
+	provStatsEnd(PROV_PHASE_PLAN_ALL, &searchStart);
+}
+
+/*
+ * Try the combinations of the options that can change the rewrite of query.
+ * The combination the user has set is tried first. Combinations that produce
+ * an already planned Query tree are not planned again.
+ */
+
+static void
+searchCheapestQueryAndPlan (Query *query, int cursorOptions, ParamListInfo boundParams, Query **cheapestQuery, PlannedStmt **cheapestPlan)
+{
+	MemoryContext outerContext = CurrentMemoryContext;
+	MemoryContext candidateContext;
+	MemoryContext cheapestContext;
+	MemoryContext swapContext;
 	Query *rewrittenQuery;
 	PlannedStmt *curPlan;
+	List *rewriteInfo;
+	List *cheapestRewriteInfo = NIL;
+	List *planned = NIL;
 	Cost minCost = -1.0;
+	instr_time startTime;
+	instr_time curTime;
+	instr_time candidateStart;
+	double planCost;
+	bool needQuery;
+	int applicable;
+	int first;
+	int flags;
 	int i;
 
-	/* check if query contains provenance queries */
-	if (checkIfRewriteNeeded(query))
-		*cheapestPlan = standard_planner(query, cursorOptions, boundParams);
+	INSTR_TIME_SET_CURRENT(startTime);
 
-	/* try all applicable rewrite methods */
+	applicable = getApplicableOptions(query);
+	first = getOptions() & applicable;
+	needQuery = (cheapestQuery != NULL);
 	*cheapestPlan = NULL;
 
+	candidateContext = AllocSetContextCreate(outerContext,
+											 "Provenance rewrite candidate",
+											 ALLOCSET_DEFAULT_MINSIZE,
+											 ALLOCSET_DEFAULT_INITSIZE,
+											 ALLOCSET_DEFAULT_MAXSIZE);
+	cheapestContext = AllocSetContextCreate(outerContext,
+											"Cheapest provenance rewrite candidate",
+											ALLOCSET_DEFAULT_MINSIZE,
+											ALLOCSET_DEFAULT_INITSIZE,
+											ALLOCSET_DEFAULT_MAXSIZE);
+
 	LOGNOTICE("-------------- optimize statement");
-	for(i = 0; i < NUM_OPTIONS; i++)
+	for(i = -1; i < NUM_OPTIONS; i++)
 	{
-		logNotice("--next plan");
+		/* user options first, afterwards all other applicable combinations */
+		if (i == -1)
+			flags = first;
+		else if ((i & ~applicable) != 0 || i == first)
+			continue;
+		else
+			flags = i;
+
+		LOGNOTICE("--next plan");
+		ProvStatsBegin(candidateStart);
+
 		/* rewrite Query */
-		setOptions(i);
+		MemoryContextSwitchTo(candidateContext);
+		setOptions(flags);
 		rewrittenQuery = copyObject(query);
 		rewrittenQuery = provenanceRewriteQuery(rewrittenQuery);
 
-		/* plan current rewrite. If the resulting plan has lower estimated cost than the
-		 * cheaptest Plan we have seen until now, the current plan is the new cheapest plan.
+		/* skip rewrites we have planned before */
+		if (isPlannedRewrite(rewrittenQuery, &planned, outerContext))
+		{
+			LOGNOTICE("------- same as previous rewrite");
+			MemoryContextSwitchTo(outerContext);
+			MemoryContextReset(candidateContext);
+			provStatsEnd(PROV_PHASE_PLAN_ALL_CANDIDATE, &candidateStart);
+			continue;
+		}
+
+		/* plan current rewrite. The planner scribbles on its input, so the rewritten query is only
+		 * copied if we have to return it.
+		 */
+		rewriteInfo = (List *) copyObject(rewriteMethodStack);
+		if (needQuery)
+			curPlan = standard_planner(copyObject(rewrittenQuery), cursorOptions, boundParams);
+		else
+			curPlan = standard_planner(rewrittenQuery, cursorOptions, boundParams);
+
+		MemoryContextSwitchTo(outerContext);
+
+		/* If the resulting plan has lower estimated cost than the cheaptest Plan we have seen until now,
+		 * the current plan is the new cheapest plan and its memory context is kept.
 		 */
-		curPlan = standard_planner(copyObject(rewrittenQuery), cursorOptions, boundParams);
 		if (!(*cheapestPlan) || curPlan->planTree->total_cost < minCost)
 		{
 			LOGNOTICE("------- is cheapest");
-			if (*cheapestPlan)
-				pfree(*cheapestPlan);
+			swapContext = cheapestContext;
+			cheapestContext = candidateContext;
+			candidateContext = swapContext;
 
 			*cheapestPlan = curPlan;
 			minCost = (*cheapestPlan)->planTree->total_cost;
-			((ProvInfo *) query->provInfo)->rewriteInfo = copyObject(rewriteMethodStack);
-			*cheapestQuery = rewrittenQuery;
-			((ProvInfo *) (*cheapestQuery)->provInfo)->rewriteInfo = copyObject(rewriteMethodStack);
+			cheapestRewriteInfo = rewriteInfo;
+			if (needQuery)
+				*cheapestQuery = rewrittenQuery;
 		}
-		else
+
+		MemoryContextReset(candidateContext);
+
+		provStatsEnd(PROV_PHASE_PLAN_ALL_CANDIDATE, &candidateStart);
+
+		/* stop if planning has used up its share of the cheapest plan's cost */
+		if (prov_optimizer_plan_share > 0)
 		{
-			pfree(curPlan);
-			pfree(rewrittenQuery);
+			INSTR_TIME_SET_CURRENT(curTime);
+			planCost = (INSTR_TIME_GET_DOUBLE(curTime)
+					- INSTR_TIME_GET_DOUBLE(startTime)) * 1000.0
+					* OPERATORS_PER_MSEC * cpu_operator_cost;
+
+			if (planCost >= minCost * prov_optimizer_plan_share)
+				break;
 		}
+	}
 
-		if (minCost < STOP_PLANING_THRESHHOLD)
-			break;
+	/* copy the cheapest plan and query to the caller's memory context */
+	*cheapestPlan = (PlannedStmt *) copyObject(*cheapestPlan);
+	((ProvInfo *) query->provInfo)->rewriteInfo = copyObject(cheapestRewriteInfo);
+	if (needQuery)
+	{
+		*cheapestQuery = (Query *) copyObject(*cheapestQuery);
+		((ProvInfo *) (*cheapestQuery)->provInfo)->rewriteInfo = copyObject(cheapestRewriteInfo);
 	}
+
+	resetRewriterState();
+	MemoryContextDelete(candidateContext);
+	MemoryContextDelete(cheapestContext);
 }
 
 /*
- * Checks if the query contains parts that are marked for provenance rewrite.
+ * Returns the options that can change the rewrite of a query. The set operation
+ * option is only applicable if the query tree contains set operations, the
+ * sublink options only if it contains sublinks.
  */
 
+static int
+getApplicableOptions (Query *query)
+{
+	int result = 0;
+
+	getApplicableOptionsWalker((Node *) query, &result);
+
+	return result;
+}
+
 static bool
-checkIfRewriteNeeded (Query *query)
+getApplicableOptionsWalker (Node *node, int *context)
 {
-	/* ignore Utility statements */
-	if (query->commandType != CMD_UTILITY)
+	if (node == NULL)
 		return false;
 
-	if (!queryHasRewriteChildren(query))
-		return false;
+	if (IsA(node, Query))
+	{
+		Query *query = (Query *) node;
+
+		if (query->setOperations != NULL)
+			*context |= OPTION_SET;
+		if (query->hasSubLinks)
+			*context |= OPTIONS_SUBLINK;
+
+		return query_tree_walker(query, getApplicableOptionsWalker,
+				(void *) context, 0);
+	}
+
+	return expression_tree_walker(node, getApplicableOptionsWalker,
+			(void *) context);
+}
+
+/*
+ * Checks if a rewritten query is equal to a rewrite that has already been
+ * planned. If not, the rewrite is added to the list of planned rewrites. The
+ * strategy names stored by the rewriter are not considered.
+ */
+
+static bool
+isPlannedRewrite (Query *rewrittenQuery, List **planned, MemoryContext plannedContext)
+{
+	PlannedRewrite *cur;
+	ListCell *lc;
+	Node *rewriteInfo;
+	MemoryContext oldcontext;
+	char *tree;
+	uint32 hash;
+
+	rewriteInfo = Provinfo(rewrittenQuery)->rewriteInfo;
+	Provinfo(rewrittenQuery)->rewriteInfo = NULL;
+	tree = nodeToString(rewrittenQuery);
+	Provinfo(rewrittenQuery)->rewriteInfo = rewriteInfo;
+
+	hash = DatumGetUInt32(hash_any((unsigned char *) tree, strlen(tree)));
+
+	foreach(lc, *planned)
+	{
+		cur = (PlannedRewrite *) lfirst(lc);
+
+		if (cur->hash == hash && strcmp(cur->tree, tree) == 0)
+			return true;
+	}
+
+	/* the planned rewrites have to survive the reset of the candidate's memory context */
+	oldcontext = MemoryContextSwitchTo(plannedContext);
+
+	cur = (PlannedRewrite *) palloc(sizeof(PlannedRewrite));
+	cur->hash = hash;
+	cur->tree = pstrdup(tree);
+	*planned = lappend(*planned, cur);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return false;
+}
+
+/*
+ * The rewriter keeps its stacks in global variables. Reset them after the memory of the candidates
+ * has been freed, so they do not point to freed memory.
+ */
+
+static void
+resetRewriterState (void)
+{
+	pStack = NIL;
+	baseRelStack = NIL;
+	rewriteMethodStack = NIL;
+	resetRelReferences();
+}
+
+/*
+ * Returns the current values of the provenance optimization options as flags
+ * (see setOptions).
+ */
+
+static int
+getOptions (void)
+{
+	int flags = 0;
+
+	if (prov_use_set_optimization)
+		flags |= 0x01;
+	if (prov_use_sublink_optimization_left_join)
+		flags |= 0x02;
+	if (prov_use_sublink_move_to_target)
+		flags |= 0x04;
+	if (prov_use_sublink_transfrom_top_level_any_to_join)
+		flags |= 0x08;
+	if (prov_use_unnest_JA)
+		flags |= 0x10;
 
-	/* check if query contains provenance queries */
-	return true;
+	return flags;
 }
 
 /*
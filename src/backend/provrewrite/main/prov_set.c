@@ -23,6 +23,7 @@
 
 #include "postgres.h"
 #include "catalog/pg_operator.h"		// pg_operator system table for operator lookup
+#include "catalog/pg_type.h"
 #include "nodes/makefuncs.h"			// needed to create new nodes
 #include "nodes/print.h"				// pretty print node (trees)
 #include "optimizer/clauses.h"
@@ -45,12 +46,21 @@
 #include "provrewrite/prov_set.h"
 
 
+/*
+ * Global variables.
+ */
+// if true unions may represent their provenance by a branch tag (see rewriteUnionWithWLCS)
+bool provUseTaggedUnion = false;
+
 /* Function declarations */
 static void addSetSubqueryRTEs (Query *top, Query *orig);
 static void createNullSetDiffProvAttrs(Query *newTop, Query *query,
 		List **pList);
 static void rewriteUnionWithWLCS (Query *query);
 static void addDummyProvAttrs (RangeTblEntry *rte, List *subProv, int pos);
+static bool unionProvAttrsCompatible (List *subProvs);
+static TargetEntry *addUnionTagAttr (RangeTblEntry *rte, List *subProv,
+		int pos);
 static void adaptSetProvenanceAttrs (Query *query);
 static void adaptSetStmtCols (SetOperationStmt *stmt, List *colTypes,
 		List *colTypmods);
@@ -239,11 +249,14 @@ createNullSetDiffProvAttrs(Query *newTop, Query *query, List **pList)
 			}
 			else
 			{
+				ProvAttrAccess *access;
+
 				/* increment rel ref counter */
 				getQueryRefNum(provRte, true);
+				access = addProvAttrAccess(createProvAttrRelPrefix(provRte));
 
 				/* get RTE attributes */
-				expandRTEWithParam(provRte, 1, 0, false, false, &attrNames, &vars);
+				expandProvBaseRelation(provRte, 1, provUseTupleIds, &attrNames, &vars);
 
 				/* generate provenance attributes */
 				forboth(attrLc, attrNames, varLc, vars)
@@ -259,6 +272,7 @@ createNullSetDiffProvAttrs(Query *newTop, Query *query, List **pList)
 							provName, false);
 					newTop->targetList = lappend(newTop->targetList, newTe);
 					*pList = lappend(*pList, newTe);
+					addProvAttrAccessAttr(access, provName);
 				}
 			}
 		}
@@ -330,19 +344,55 @@ rewriteUnionWithWLCS (Query *query)
 		subProvs = lappend(subProvs, linitial(pStack));
 	}
 
-	// add projections on NULL to each subquery to generate
-	// the same schema for each subquery.
-	foreachi(lc, i, query->rtable)
+	/*
+	 * If the provenance attributes of all subqueries have the same types,
+	 * each subquery outputs a tag that identifies the subquery followed by
+	 * its own provenance attributes. The provenance attributes of the first
+	 * subquery then represent the provenance of all subqueries. This is not
+	 * possible if a sublink that is rewritten using the base relations it
+	 * accesses (see prov_sublink_keepcor.c) contains the union or if the
+	 * provenance attributes have been fixed by parse analysis (see
+	 * traverseQueryTree).
+	 */
+	if (provUseTaggedUnion && !baseRelStackActive
+			&& unionProvAttrsCompatible(subProvs))
 	{
-		rte = (RangeTblEntry *) lfirst(lc);
-		addDummyProvAttrs(rte, subProvs, i);
+		List *tagTes = NIL;
+		List *firstProv;
+
+		foreachi(lc, i, query->rtable)
+		{
+			rte = (RangeTblEntry *) lfirst(lc);
+			tagTes = lappend(tagTes, addUnionTagAttr(rte, subProvs, i));
+		}
+
+		correctSubQueryAlias(query);
+
+		// replace the provenance attrs of the subqueries on the stack with
+		// the tag and the provenance attrs of the first subquery
+		firstProv = (List *) linitial(popListAndReverse(&pStack,
+				list_length(query->rtable)));
+		push(&pStack, lcons(linitial(tagTes), firstProv));
+
+		pList = addProvenanceAttrsForRange(query, 1, 2, pList);
+		push(&pStack, pList);
 	}
+	else
+	{
+		// add projections on NULL to each subquery to generate
+		// the same schema for each subquery.
+		foreachi(lc, i, query->rtable)
+		{
+			rte = (RangeTblEntry *) lfirst(lc);
+			addDummyProvAttrs(rte, subProvs, i);
+		}
 
-	correctSubQueryAlias(query);
+		correctSubQueryAlias(query);
 
-	// push provenance list on stack and add provenance attrs to query
-	pList = addProvenanceAttrsForRange(query, 1, list_length(query->rtable) + 1, pList);
-	push(&pStack, pList);
+		// push provenance list on stack and add provenance attrs to query
+		pList = addProvenanceAttrsForRange(query, 1, list_length(query->rtable) + 1, pList);
+		push(&pStack, pList);
+	}
 
 	// adapt set operation query provenance attributes
 	adaptSetProvenanceAttrs(query);
@@ -416,6 +466,92 @@ addDummyProvAttrs (RangeTblEntry *rte, List *subProv, int pos)
 }
 
 
+/*
+ * Checks if the provenance attributes of all subqueries of a union have the
+ * same number and the same types and typmods.
+ */
+
+static bool
+unionProvAttrsCompatible (List *subProvs)
+{
+	List *firstProv;
+	List *curProv;
+	ListCell *lc;
+	ListCell *firstLc;
+	ListCell *curLc;
+	TargetEntry *firstTe;
+	TargetEntry *curTe;
+
+	firstProv = (List *) linitial(subProvs);
+
+	for(lc = lnext(list_head(subProvs)); lc != NULL; lc = lnext(lc))
+	{
+		curProv = (List *) lfirst(lc);
+
+		if (list_length(curProv) != list_length(firstProv))
+			return false;
+
+		forboth(firstLc, firstProv, curLc, curProv)
+		{
+			firstTe = (TargetEntry *) lfirst(firstLc);
+			curTe = (TargetEntry *) lfirst(curLc);
+
+			if (exprType((Node *) firstTe->expr) != exprType((Node *) curTe->expr)
+					|| exprTypmod((Node *) firstTe->expr)
+					!= exprTypmod((Node *) curTe->expr))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Adds a constant that identifies the subquery of a union in front of the
+ * provenance attributes of the subquery. Returns the target entry of the
+ * constant.
+ */
+
+static TargetEntry *
+addUnionTagAttr (RangeTblEntry *rte, List *subProv, int pos)
+{
+	Query *query;
+	List *ownProv;
+	List *curProvList;
+	ListCell *lc;
+	TargetEntry *te;
+	TargetEntry *tagTe;
+	int numSelfProvAttrs;
+	int curResno;
+
+	query = rte->subquery;
+
+	// remove the provenance attributes from target list
+	curProvList = (List *) list_nth(subProv, pos);
+	numSelfProvAttrs = list_length(curProvList);
+	ownProv = list_copy_tail(query->targetList,
+							list_length(query->targetList) - numSelfProvAttrs);
+	removeAfterPos(query->targetList, list_length(query->targetList) - numSelfProvAttrs);
+	curResno = list_length(query->targetList) + 1;
+
+	// add the tag and the provenance attributes again
+	tagTe = makeTargetEntry((Expr *) makeConst(INT4OID, -1, sizeof(int32),
+			Int32GetDatum(pos + 1), false, true), curResno++,
+			pstrdup("prov_union_branch"), false);
+	query->targetList = lappend(query->targetList, tagTe);
+
+	foreach(lc, ownProv)
+	{
+		te = (TargetEntry *) lfirst(lc);
+		te->resno = curResno++;
+		query->targetList = lappend(query->targetList, te);
+	}
+
+	list_free(ownProv);
+
+	return tagTe;
+}
+
 /*
  *
  */
@@ -675,6 +811,9 @@ createSetJoinCondition (Query *query, JoinExpr *join, Index leftIndex, Index rig
 	rightAttrs = list_truncate (rightAttrs, origTlength);
 
 	join->quals = createEqualityCondition(leftAttrs, rightAttrs, leftIndex, rightIndex, AND_EXPR, neq);
+
+	/* let the planner know that each input tuple joins with its result tuple */
+	join->isProvJoin = !neq;
 }
 
 /*
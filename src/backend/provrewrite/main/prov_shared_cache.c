@@ -0,0 +1,494 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_shared_cache.c
+ *	  PERM C -  Shared memory cache of rewritten provenance queries.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/prov_shared_cache.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		The backend local rewrite cache (see prov_cache.c) is empty in each new backend. Applications
+ *		that use a connection pool therefore pay for the rewrite of their provenance queries once per
+ *		connection. This cache stores the rewritten query trees (as node strings) in a fixed size area of
+ *		shared memory (prov_shared_cache_size kB), so a backend that misses its local cache can skip
+ *		parse analysis and the provenance rewrite if another backend has rewritten the query before.
+ *		The query is still planned by the backend itself and then stored in its local cache.
+ *
+ *		The key of an entry is the key of the local cache plus the database. Each entry stores the OIDs
+ *		of the relations used by the query. Every backend registers a relcache callback that removes the
+ *		entries using an invalidated relation, so the backend that changes a relation removes the entries
+ *		when it commits. A backend that uses an entry locks its relations before the query tree is read,
+ *		if this processes an invalidation of one of the relations the entry is not used.
+ *
+ *		The same query text can refer to different relations in a backend that has a temporary
+ *		namespace (temporary tables are found before other tables, and are private to the backend).
+ *		Such backends neither use nor fill the cache.
+ *
+ *		The area is divided into NUM_PROV_CACHE_PARTITIONS partitions, each protected by its own LWLock.
+ *		The partition of an entry is determined by the hash value of its key. The entries of a partition
+ *		are stored consecutively and are searched sequentially. If a new entry does not fit into its
+ *		partition the least recently used entries of the partition are evicted.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/hash.h"
+#include "catalog/namespace.h"
+#include "miscadmin.h"
+#include "nodes/plannodes.h"
+#include "storage/lmgr.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/guc.h"
+#include "utils/inval.h"
+
+#include "provrewrite/prov_cache.h"
+#include "provrewrite/prov_shared_cache.h"
+
+/*
+ * An entry of the shared cache. The entry is followed by the OIDs of the relations used by the query, the key
+ * and the node string of the rewritten query list (both null terminated).
+ */
+typedef struct ProvSharedCacheEntry
+{
+	uint32		hash;			/* hash value of the key */
+	uint32		lastUsed;		/* value of the partition clock at the last use */
+	Size		size;			/* MAXALIGNed size of the entry including the data */
+	int			keyLen;			/* length of the key */
+	int			treeLen;		/* length of the node string */
+	int			numRelids;		/* number of relation OIDs */
+	Oid			relids[1];		/* VARIABLE LENGTH ARRAY */
+} ProvSharedCacheEntry;
+
+typedef struct ProvSharedCachePartition
+{
+	Size		used;			/* bytes of data used by entries */
+	int			numEntries;
+	uint32		clock;			/* incremented for each use of an entry */
+	char		data[1];		/* VARIABLE LENGTH ARRAY */
+} ProvSharedCachePartition;
+
+#define EntryRelidsSize(numRelids) (offsetof(ProvSharedCacheEntry, relids) + (numRelids) * sizeof(Oid))
+#define EntryKey(entry) (((char *) (entry)) + EntryRelidsSize((entry)->numRelids))
+#define EntryTree(entry) (EntryKey(entry) + (entry)->keyLen + 1)
+#define NextEntry(entry) ((ProvSharedCacheEntry *) (((char *) (entry)) + (entry)->size))
+
+#define PartitionLock(part) ((LWLockId) (FirstProvCacheLock + (part)))
+
+/*
+ * Global variables.
+ */
+static char *provSharedCache = NULL;
+static Size partitionSize = 0;			/* distance between two partitions */
+static Size dataSize = 0;				/* size of the data area of a partition */
+
+/* relations of the entry that is read by provSharedCacheLookup and whether one of them has been invalidated */
+static Oid *pendingRelids = NULL;
+static int numPendingRelids = 0;
+static bool pendingInvalidated = false;
+
+/* Function declarations */
+static char *buildSharedCacheKey (const char *queryString);
+static Size partitionDataSize (void);
+static ProvSharedCachePartition *getPartition (int part);
+static ProvSharedCacheEntry *findEntry (ProvSharedCachePartition *partition, uint32 hash, const char *key);
+static void removeEntry (ProvSharedCachePartition *partition, ProvSharedCacheEntry *entry);
+static bool entryUsesRelation (ProvSharedCacheEntry *entry, Oid relid);
+static void provSharedCacheCallback (Datum arg, Oid relid);
+
+/*
+ * Returns the amount of shared memory used by the cache.
+ */
+
+Size
+ProvSharedCacheShmemSize (void)
+{
+	if (prov_shared_cache_size <= 0)
+		return 0;
+
+	return mul_size(NUM_PROV_CACHE_PARTITIONS,
+			MAXALIGN(add_size(offsetof(ProvSharedCachePartition, data), partitionDataSize())));
+}
+
+/*
+ * Allocates and initializes the shared memory of the cache.
+ */
+
+void
+ProvSharedCacheShmemInit (void)
+{
+	bool found;
+	int i;
+
+	if (prov_shared_cache_size <= 0)
+		return;
+
+	dataSize = partitionDataSize();
+	partitionSize = MAXALIGN(offsetof(ProvSharedCachePartition, data) + dataSize);
+	provSharedCache = ShmemInitStruct("Provenance Rewrite Cache", ProvSharedCacheShmemSize(), &found);
+
+	if (!IsUnderPostmaster)
+	{
+		Assert(!found);
+
+		for (i = 0; i < NUM_PROV_CACHE_PARTITIONS; i++)
+		{
+			ProvSharedCachePartition *partition = getPartition(i);
+
+			partition->used = 0;
+			partition->numEntries = 0;
+			partition->clock = 0;
+		}
+	}
+	else
+		Assert(found);
+}
+
+/*
+ * Initialize the cache for a backend (called by InitPostgres). Every backend has to remove the entries that use
+ * a relation when it processes an invalidation for this relation, because the backend that changes the
+ * relation may never use the cache itself.
+ */
+
+void
+InitProvSharedCache (void)
+{
+	if (prov_shared_cache_size > 0)
+		CacheRegisterRelcacheCallback(provSharedCacheCallback, (Datum) 0);
+}
+
+/*
+ * Returns the rewritten query list for query string queryString or NIL if it is not cached for the current
+ * settings. The relations of the query are locked.
+ */
+
+List *
+provSharedCacheLookup (const char *queryString)
+{
+	ProvSharedCachePartition *partition;
+	ProvSharedCacheEntry *entry;
+	LWLockId lock;
+	char *key;
+	char *tree = NULL;
+	Oid *relids = NULL;
+	int numRelids = 0;
+	uint32 hash;
+	bool valid;
+	int i;
+
+	if (provSharedCache == NULL || OidIsValid(GetTempNamespace()))
+		return NIL;
+
+	key = buildSharedCacheKey(queryString);
+	hash = DatumGetUInt32(hash_any((unsigned char *) key, strlen(key)));
+	partition = getPartition(hash % NUM_PROV_CACHE_PARTITIONS);
+	lock = PartitionLock(hash % NUM_PROV_CACHE_PARTITIONS);
+
+	/* copy the entry, we must not hold the partition lock while we lock the relations */
+	LWLockAcquire(lock, LW_SHARED);
+
+	entry = findEntry(partition, hash, key);
+	if (entry != NULL)
+	{
+		/*
+		 * The LRU information is updated under a shared lock. Concurrent readers may lose an increment of the
+		 * clock, which only affects the order in which entries are evicted.
+		 */
+		entry->lastUsed = ++partition->clock;
+
+		numRelids = entry->numRelids;
+		relids = (Oid *) palloc(Max(numRelids, 1) * sizeof(Oid));
+		memcpy(relids, entry->relids, numRelids * sizeof(Oid));
+		tree = pstrdup(EntryTree(entry));
+	}
+
+	LWLockRelease(lock);
+	pfree(key);
+
+	if (tree == NULL)
+		return NIL;
+
+	/*
+	 * Lock the relations of the query like parse analysis would have done. This processes pending
+	 * invalidations, if one of the relations has been changed since the entry has been created the query tree
+	 * is outdated (the callback has already removed the entry).
+	 */
+	pendingRelids = relids;
+	numPendingRelids = numRelids;
+	pendingInvalidated = false;
+
+	PG_TRY();
+	{
+		for (i = 0; i < numRelids; i++)
+			LockRelationOid(relids[i], AccessShareLock);
+	}
+	PG_CATCH();
+	{
+		pendingRelids = NULL;
+		numPendingRelids = 0;
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	valid = !pendingInvalidated;
+	pendingRelids = NULL;
+	numPendingRelids = 0;
+	pfree(relids);
+
+	if (!valid)
+	{
+		pfree(tree);
+		return NIL;
+	}
+
+	return (List *) stringToNode(tree);
+}
+
+/*
+ * Stores the node string tree of the rewritten query list of a provenance query in the cache. The string has
+ * to be created before the query is planned, because the planner modifies the query tree. stmtList is the
+ * planned query list, its relation OIDs are stored with the entry.
+ */
+
+void
+provSharedCacheStore (const char *queryString, char *tree, List *stmtList)
+{
+	ProvSharedCachePartition *partition;
+	ProvSharedCacheEntry *entry;
+	ProvSharedCacheEntry *lru;
+	ProvSharedCacheEntry *cur;
+	LWLockId lock;
+	List *relids = NIL;
+	ListCell *lc;
+	char *key;
+	uint32 hash;
+	int keyLen;
+	int treeLen;
+	Size size;
+	int i;
+
+	if (provSharedCache == NULL || OidIsValid(GetTempNamespace()))
+		return;
+
+	foreach(lc, stmtList)
+	{
+		PlannedStmt *stmt = (PlannedStmt *) lfirst(lc);
+
+		if (!IsA(stmt, PlannedStmt))
+			return;
+
+		relids = list_concat_unique_oid(relids, stmt->relationOids);
+	}
+
+	key = buildSharedCacheKey(queryString);
+	hash = DatumGetUInt32(hash_any((unsigned char *) key, strlen(key)));
+	keyLen = strlen(key);
+	treeLen = strlen(tree);
+
+	size = MAXALIGN(EntryRelidsSize(list_length(relids)) + keyLen + treeLen + 2);
+	if (size > dataSize)
+	{
+		pfree(key);
+		list_free(relids);
+		return;
+	}
+
+	partition = getPartition(hash % NUM_PROV_CACHE_PARTITIONS);
+	lock = PartitionLock(hash % NUM_PROV_CACHE_PARTITIONS);
+
+	LWLockAcquire(lock, LW_EXCLUSIVE);
+
+	/* another backend may have stored the query in the meantime */
+	entry = findEntry(partition, hash, key);
+	if (entry != NULL)
+		removeEntry(partition, entry);
+
+	/* evict the least recently used entries until the new entry fits */
+	while (partition->used + size > dataSize)
+	{
+		lru = cur = (ProvSharedCacheEntry *) partition->data;
+
+		for (i = 0; i < partition->numEntries; i++, cur = NextEntry(cur))
+		{
+			if ((int32) (cur->lastUsed - lru->lastUsed) < 0)
+				lru = cur;
+		}
+
+		removeEntry(partition, lru);
+	}
+
+	entry = (ProvSharedCacheEntry *) (partition->data + partition->used);
+	entry->hash = hash;
+	entry->lastUsed = ++partition->clock;
+	entry->size = size;
+	entry->keyLen = keyLen;
+	entry->treeLen = treeLen;
+	entry->numRelids = 0;
+
+	foreach(lc, relids)
+		entry->relids[entry->numRelids++] = lfirst_oid(lc);
+
+	memcpy(EntryKey(entry), key, keyLen + 1);
+	memcpy(EntryTree(entry), tree, treeLen + 1);
+
+	partition->used += size;
+	partition->numEntries++;
+
+	LWLockRelease(lock);
+
+	pfree(key);
+	list_free(relids);
+}
+
+/*
+ * The key of the local cache does not contain the database.
+ */
+
+static char *
+buildSharedCacheKey (const char *queryString)
+{
+	StringInfoData str;
+	char *localKey;
+
+	localKey = buildProvCacheKey(queryString);
+
+	initStringInfo(&str);
+	appendStringInfo(&str, "%u|%s", MyDatabaseId, localKey);
+	pfree(localKey);
+
+	return str.data;
+}
+
+/*
+ * Returns the size of the data area of a partition.
+ */
+
+static Size
+partitionDataSize (void)
+{
+	return MAXALIGN(mul_size(prov_shared_cache_size, 1024) / NUM_PROV_CACHE_PARTITIONS);
+}
+
+static ProvSharedCachePartition *
+getPartition (int part)
+{
+	return (ProvSharedCachePartition *) (provSharedCache + part * partitionSize);
+}
+
+/*
+ * Returns the entry for key or NULL if the partition has no such entry. The caller has to hold the lock of the
+ * partition.
+ */
+
+static ProvSharedCacheEntry *
+findEntry (ProvSharedCachePartition *partition, uint32 hash, const char *key)
+{
+	ProvSharedCacheEntry *entry = (ProvSharedCacheEntry *) partition->data;
+	int keyLen = strlen(key);
+	int i;
+
+	for (i = 0; i < partition->numEntries; i++, entry = NextEntry(entry))
+	{
+		if (entry->hash == hash && entry->keyLen == keyLen && memcmp(EntryKey(entry), key, keyLen) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/*
+ * Removes an entry from a partition by moving the entries behind it. The caller has to hold the lock of the
+ * partition in exclusive mode.
+ */
+
+static void
+removeEntry (ProvSharedCachePartition *partition, ProvSharedCacheEntry *entry)
+{
+	char *start = (char *) entry;
+	char *end = start + entry->size;
+	Size size = entry->size;
+
+	memmove(start, end, (partition->data + partition->used) - end);
+	partition->used -= size;
+	partition->numEntries--;
+}
+
+static bool
+entryUsesRelation (ProvSharedCacheEntry *entry, Oid relid)
+{
+	int i;
+
+	if (!OidIsValid(relid))
+		return true;
+
+	for (i = 0; i < entry->numRelids; i++)
+	{
+		if (entry->relids[i] == relid)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Relcache invalidation callback. Removes the entries that use relation relid or all entries if relid is
+ * InvalidOid. Most backends process an invalidation after the changing backend has already removed the
+ * entries, so the partitions are searched under a shared lock first.
+ */
+
+static void
+provSharedCacheCallback (Datum arg, Oid relid)
+{
+	ProvSharedCachePartition *partition;
+	ProvSharedCacheEntry *entry;
+	bool found;
+	int part;
+	int i;
+
+	if (pendingRelids != NULL)
+	{
+		if (!OidIsValid(relid))
+			pendingInvalidated = true;
+
+		for (i = 0; i < numPendingRelids; i++)
+		{
+			if (pendingRelids[i] == relid)
+				pendingInvalidated = true;
+		}
+	}
+
+	for (part = 0; part < NUM_PROV_CACHE_PARTITIONS; part++)
+	{
+		partition = getPartition(part);
+		found = false;
+
+		LWLockAcquire(PartitionLock(part), LW_SHARED);
+
+		entry = (ProvSharedCacheEntry *) partition->data;
+		for (i = 0; i < partition->numEntries && !found; i++, entry = NextEntry(entry))
+			found = entryUsesRelation(entry, relid);
+
+		LWLockRelease(PartitionLock(part));
+
+		if (!found)
+			continue;
+
+		LWLockAcquire(PartitionLock(part), LW_EXCLUSIVE);
+
+		entry = (ProvSharedCacheEntry *) partition->data;
+		while ((char *) entry < partition->data + partition->used)
+		{
+			if (entryUsesRelation(entry, relid))
+				removeEntry(partition, entry);
+			else
+				entry = NextEntry(entry);
+		}
+
+		LWLockRelease(PartitionLock(part));
+	}
+}
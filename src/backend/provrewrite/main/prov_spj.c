@@ -29,6 +29,12 @@
 #include "provrewrite/provattrname.h"
 #include "provrewrite/prov_sublink.h"
 
+/*
+ * Global variables.
+ */
+// if true base relations are represented by a tuple identifier (TUPLEID contribution semantics)
+bool provUseTupleIds = false;
+
 /* Function declarations */
 static void rewriteBaseRelation (int rtindex, RangeTblEntry *rte, Query *query);
 static void computeJoinPAttrs(List **pAttrs, Node *joinChild, Query *query, List *subList);
@@ -178,6 +184,8 @@ rewriteRTEs (Query *query, List **subList, Index maxRtindex)
  * the projection. E.g.:
  * 			- SELECT PROVENANCE * FROM r is not rewritten into SELECT * FROM (SELECT r.a, r.a AS prov_r_a FROM r), but
  * 			into SELECT r.a, r.a AS prov_r_a FROM r).
+ * For TUPLEID provenance the only provenance attribute of a base relation is its oid or ctid, e.g.,
+ * SELECT PROVENANCE ON CONTRIBUTION (TUPLEID) * FROM r is rewritten into SELECT r.a, r.ctid AS prov_r_ctid FROM r.
  */
 
 static void
@@ -192,17 +200,19 @@ rewriteBaseRelation (int rtindex, RangeTblEntry *rte, Query *query)
 	Expr *expr;
 	char *namestr;
 	AttrNumber curResno;
+	ProvAttrAccess *access;
 
 	pList = NIL;
 
-	/* create Var nodes for all attributes of the relation */
-	expandRTEWithParam(rte, rtindex, 0, false, false, &names, &vars);
+	/* create Var nodes for all attributes of the relation (or its tuple identifier) */
+	expandProvBaseRelation(rte, rtindex, provUseTupleIds, &names, &vars);
 
 	/* get number of TE s */
 	curResno = 0;
 
 	/* increment reference counter for relation used in provnenace attribute names */
 	getQueryRefNum (rte, true);
+	access = addProvAttrAccess(createProvAttrRelPrefix(rte));
 
 	/* create a list with a new target entry for each attribute of the base relation */
 	forboth (var, vars, name, names)
@@ -218,6 +228,7 @@ rewriteBaseRelation (int rtindex, RangeTblEntry *rte, Query *query)
 		te->resorigcol = ((Var *) expr)->varoattno;
 
 		pList = lappend(pList, te);
+		addProvAttrAccessAttr(access, te->resname);
 	}
 
 	/* push the provenance attrs on pStack */
@@ -248,6 +259,7 @@ void rewriteRTEwithProvenance (int rtindex, RangeTblEntry *rte)
 	List *pList;
 	TargetEntry *te;
 	Var * attrVar;
+	ProvAttrAccess *access;
 
 	pList = NIL;
 
@@ -285,6 +297,8 @@ void rewriteRTEwithProvenance (int rtindex, RangeTblEntry *rte)
 				"PROVENANCE construct in FROM clause is only allowed"
 				"for base relations and subqueries");
 
+	access = addProvAttrAccess(createProvAttrRelPrefix(rte));
+
 
 
 	/* walk through provAttrs and find correspoding var */
@@ -304,6 +318,7 @@ void rewriteRTEwithProvenance (int rtindex, RangeTblEntry *rte)
 				te = makeTargetEntry((Expr *) attrVar, attrVar->varattno,
 						createExternalProvAttrName(attr->val.str), false);
 				pList = lappend(pList, te);
+				addProvAttrAccessAttr(access, te->resname);
 			}
 		}
 		if (!found)
@@ -383,9 +398,6 @@ computeJoinPAttrs(List **pAttrs, Node *joinChild, Query *query, List *subList)
 			te = (TargetEntry *) lfirst(lc);
 			var = (Var *) te->expr;
 
-			/* adapt var */
-			var->varattno = te->resno;
-
 			/*
 			 * make new Var and TE for this join. TE is just used to transfer the
 			 * attribute name.
@@ -425,6 +437,7 @@ computeJoinPAttrs(List **pAttrs, Node *joinChild, Query *query, List *subList)
 			/* copy te so we can savely change it */
 			te = copyObject(te);
 			var = (Var *) te->expr;
+			var->varattno = getProvAttrAttno(query, rteRef, te);
 			var->varno = rteRef;
 
 			*pAttrs = lappend(*pAttrs, te);
@@ -534,6 +547,8 @@ checkForNTupleDupConstructs (Query *query)
  * Rewrites an LIMIT clause for an SPJ-query that might have more than one contributing
  * tuple from a base relation for a result tuple. To preserve the limit we have to join
  * the original query with the rewritten query on the original result attributes.
+ * Result attributes that are never NULL are joined with equality, which allows the
+ * planner to probe the rewritten query with the k result tuples of the original query.
  */
 
 Query *
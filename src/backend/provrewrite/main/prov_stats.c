@@ -0,0 +1,163 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_stats.c
+ *	  PERM C -  Counters and timers for the phases of the provenance rewrite.
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ *
+ * IDENTIFICATION
+ *	  $PostgreSQL: pgsql/src/backend/provrewrite/prov_stats.c,v 1.542 2008/01/26 19:55:08 bglav Exp $
+ *
+ * NOTES
+ *		Each phase of the rewrite is timed with ProvStatsBegin/provStatsEnd. The measurements are added to the
+ *		statistics of the current statement (shown by EXPLAIN ANALYZE) and to the pending statistics message
+ *		that is sent to the stats collector with the table statistics (shown by the pg_stat_provenance view).
+ *		Both only cost a clock read per phase, so they are always active.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "optimizer/clauses.h"
+#include "utils/memutils.h"
+
+#include "provrewrite/prov_stats.h"
+
+/* node and byte counts of a query tree */
+typedef struct ProvNodeCount
+{
+	int64 nodes;
+	int64 bytes;
+} ProvNodeCount;
+
+/* statistics of the current statement */
+ProvStatementStats provStatementStats;
+
+/* names of the phases used by EXPLAIN and pg_stat_provenance */
+static const char *phaseNames[PROV_NUM_PHASES] = {
+	"rewrite",
+	"this_exprs",
+	"copy_maps",
+	"sublink_unnest",
+	"selection_pushdown",
+	"transprov_index",
+	"plan_all",
+	"plan_all_candidate"
+};
+
+/* prototypes */
+static bool countNodesWalker (Node *node, ProvNodeCount *context);
+
+/*
+ * Reset the statistics of the current statement. Called before a statement is rewritten.
+ */
+
+void
+provStatsResetStatement (void)
+{
+	MemSet(&provStatementStats, 0, sizeof(ProvStatementStats));
+}
+
+/*
+ * End timing a phase that was started at start.
+ */
+
+void
+provStatsEnd (ProvStatsPhase phase, instr_time *start)
+{
+	instr_time now;
+	double elapsed;
+
+	INSTR_TIME_SET_CURRENT(now);
+	elapsed = (INSTR_TIME_GET_DOUBLE(now) - INSTR_TIME_GET_DOUBLE(*start)) * 1000.0;
+
+	provStatementStats.calls[phase]++;
+	provStatementStats.time[phase] += elapsed;
+
+	ProvenanceStats.m_calls[phase]++;
+	ProvenanceStats.m_time[phase] += (PgStat_Counter) (elapsed * 1000.0);
+}
+
+/*
+ * Count the nodes of a rewritten query tree and the memory used for them.
+ */
+
+void
+provStatsCountQuery (Query *query)
+{
+	ProvNodeCount count;
+
+	count.nodes = 0;
+	count.bytes = 0;
+
+	countNodesWalker((Node *) query, &count);
+
+	provStatementStats.nodes += count.nodes;
+	provStatementStats.bytes += count.bytes;
+
+	ProvenanceStats.m_nodes += count.nodes;
+	ProvenanceStats.m_bytes += count.bytes;
+}
+
+static bool
+countNodesWalker (Node *node, ProvNodeCount *context)
+{
+	ListCell *lc;
+
+	if (node == NULL)
+		return false;
+
+	context->nodes++;
+	context->bytes += GetMemoryChunkSpace(node);
+
+	if (IsA(node, List) || IsA(node, IntList) || IsA(node, OidList))
+	{
+		foreach(lc, (List *) node)
+			context->bytes += GetMemoryChunkSpace(lc);
+
+		if (!IsA(node, List))
+			return false;
+	}
+
+	/* query_tree_walker also walks the subqueries in the range table */
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node, countNodesWalker, (void *) context, 0);
+
+	return expression_tree_walker(node, countNodesWalker, (void *) context);
+}
+
+/*
+ * Returns the name of a phase.
+ */
+
+const char *
+provStatsPhaseName (int phase)
+{
+	Assert(phase >= 0 && phase < PROV_NUM_PHASES);
+
+	return phaseNames[phase];
+}
+
+/*
+ * Append the statistics of the current statement to an EXPLAIN output.
+ */
+
+void
+provStatsExplain (StringInfo str)
+{
+	int i;
+
+	appendStringInfo(str, "Provenance rewrite: %.3f ms, " INT64_FORMAT " nodes, " INT64_FORMAT " bytes\n",
+			provStatementStats.time[PROV_PHASE_REWRITE], provStatementStats.nodes, provStatementStats.bytes);
+
+	for (i = 0; i < PROV_NUM_PHASES; i++)
+	{
+		if (i == PROV_PHASE_REWRITE || provStatementStats.calls[i] == 0)
+			continue;
+
+		appendStringInfo(str, "  %s: calls=" INT64_FORMAT " time=%.3f ms\n", phaseNames[i],
+				provStatementStats.calls[i], provStatementStats.time[i]);
+	}
+}
@@ -58,6 +58,10 @@
 #include "provrewrite/prov_copy_inclattr.h"
 #include "provrewrite/prov_trans_main.h"
 #include "provrewrite/prov_trans_bitset.h"
+#include "provrewrite/prov_lazy.h"
+#include "provrewrite/prov_stats.h"
+#include "provrewrite/prov_normalize.h"
+#include "provrewrite/prov_lineage.h"
 
 /*
  * Global variables.
@@ -65,6 +69,9 @@
 // a list of reference counts for base relation. It is used to generate provenance attribute names.
 static List *relRefCount;
 
+// true if the last query rewritten by provenanceRewriteQuery was a provenance query whose plan can be reused
+bool provRewriteCacheable = false;
+
 /* Function declarations */
 static Query *traverseQueryTree (RangeTblEntry *rteQuery, Query *query, char *cursorName);
 
@@ -77,6 +84,8 @@ provenanceRewriteQueryList (List *queries)
 {
 	ListCell *l;
 
+	provStatsResetStatement();
+
 	foreach (l, queries)
 	{
 		Node *command = (Node *) lfirst(l);
@@ -99,12 +108,35 @@ Query *
 provenanceRewriteQuery (Query *query)
 {
 	char *cursorName = NULL;
+	instr_time rewriteStart;
+	instr_time phaseStart;
+	bool normalized;
+
+	/*
+	 * If the provenance of a cursor is computed lazily, the cursor itself runs the original query
+	 * extended with the identity of its result rows.
+	 */
+	if (prov_use_lazy_cursors && isLazyProvCursorQuery(query))
+	{
+		Query *cursorQuery;
+
+		cursorQuery = defineLazyProvCursor(query,
+				((DeclareCursorStmt *) query->utilityStmt)->portalname);
+		if (cursorQuery != NULL)
+		{
+			query = cursorQuery;
+			SetProvRewrite(query, false);
+		}
+	}
 
 	/* initialize pStack and baseRelStack*/
 	pStack = NIL;
 	baseRelStack = NIL;
 	relRefCount = NIL;
 	rewriteMethodStack = NIL;
+	provRewriteCacheable = false;
+	provUseTupleIds = false;
+	provUseTaggedUnion = false;
 
 	/* if this is a close cursor stmt, release the trans prov function holds (if any) */
 	if (query->utilityStmt && IsA(query->utilityStmt,ClosePortalStmt))
@@ -112,12 +144,21 @@ provenanceRewriteQuery (Query *query)
 
 	dropTransProvQueryIndex();
 
+	/* INSERT ... SELECT PROVENANCE and SELECT PROVENANCE ... INTO may capture lineage */
+	if (isLineageCaptureQuery(query))
+		return rewriteLineageCaptureQuery(query);
+
 	/* only SELECT commands can be rewritten */
 	if (query->commandType != CMD_SELECT)
 		return query;//TODO
 
+	/* the rewrite creates a new top query node, remember if the output should be normalized */
+	normalized = IsProvNormalized(query);
+
 	/* handle this expressions here */
+	ProvStatsBegin(phaseStart);
 	query = handleThisExprs(query);
+	provStatsEnd(PROV_PHASE_THIS_EXPRS, &phaseStart);
 
 	LOGNODE(query, "complete query tree");
 
@@ -125,6 +166,8 @@ provenanceRewriteQuery (Query *query)
 	if (!hasProvenanceSubquery(query))
 		return query;
 
+	ProvStatsBegin(rewriteStart);
+
 	/* try to pushdown selections be aware of provenance attrs */
 	//query = pushdownSelections(query);
 
@@ -133,17 +176,27 @@ provenanceRewriteQuery (Query *query)
 		cursorName = ((DeclareCursorStmt *) query->utilityStmt)->portalname;
 
 	/* traverse query tree and search for nodes marked for provenance rewrite */
+	provRewriteCacheable = true;
 	query = traverseQueryTree (NULL, query, cursorName);
 
 	/* try to pushdown selections */
+	ProvStatsBegin(phaseStart);
 	query = pushdownSelections(query);
+	provStatsEnd(PROV_PHASE_PUSHDOWN, &phaseStart);
 
 	LOGNODE(query, "complete rewritten query tree");
 	LOGDEBUG(parseBackSafe(copyObject(query))->data);
 
+	/* produce normalized output for FORMAT NORMALIZED */
+	if (normalized)
+		query = addNormalizedTopQuery(query);
+
 	/* store the rewrite strategies that were used in the query tree */
 	((ProvInfo *) query->provInfo)->rewriteInfo = copyObject(rewriteMethodStack);
 
+	provStatsEnd(PROV_PHASE_REWRITE, &rewriteStart);
+	provStatsCountQuery(query);
+
 	return query;
 }
 
@@ -184,21 +237,37 @@ traverseQueryTree (RangeTblEntry *rteQuery, Query *query, char *cursorName)
 			query->utilityStmt = NULL;
 		}
 
+		/*
+		 * The provenance attributes of a query that is used in the FROM
+		 * clause of another query have been fixed during parse analysis
+		 * (see expandProvenanceRTE). Only the provenance of a top level
+		 * query may use the tagged representation of unions.
+		 */
+		provUseTaggedUnion = prov_use_tagged_union && rteQuery == NULL;
+
 		/* rewrite query node according to the requested provenance type */
 		switch(ContributionType(query))
 		{
 			case CONTR_INFLUENCE:
 				query = rewriteQueryNode (query);
 			break;
+			case CONTR_TUPLEID:
+				provUseTupleIds = true;
+				query = rewriteQueryNode (query);
+				provUseTupleIds = false;
+			break;
 			case CONTR_COPY_PARTIAL_TRANSITIVE:
 			case CONTR_COPY_PARTIAL_NONTRANSITIVE:
 			case CONTR_COPY_COMPLETE_TRANSITIVE:
 			case CONTR_COPY_COMPLETE_NONTRANSITIVE:
 			{
 				int numQAttrs;
+				instr_time phaseStart;
 
 				numQAttrs = list_length(query->targetList);
+				ProvStatsBegin(phaseStart);
 				generateCopyMaps(query);
+				provStatsEnd(PROV_PHASE_COPY_MAPS, &phaseStart);
 				query = rewriteQueryNodeCopy (query);
 				addTopCopyInclExpr(query, numQAttrs);
 			}
@@ -208,6 +277,8 @@ traverseQueryTree (RangeTblEntry *rteQuery, Query *query, char *cursorName)
 			case CONTR_TRANS_XML:
 			case CONTR_TRANS_XML_SIMPLE:
 			case CONTR_MAP:
+				/* the rewritten query depends on the trans prov query index */
+				provRewriteCacheable = false;
 				query = rewriteQueryTransProv (query, cursorName);
 			break;
 			default:
@@ -217,6 +288,8 @@ traverseQueryTree (RangeTblEntry *rteQuery, Query *query, char *cursorName)
 			break;
 		}
 
+		provUseTaggedUnion = false;
+
 		/* reset into and utiltiy and set rewritten query in RTE if present */
 		if (rteQuery != NULL)
 			rteQuery->subquery = query;
@@ -3154,6 +3154,8 @@ get_from_clause_item(Node *jtnode, Query *query, deparse_context *context)
 
 		if (!PRETTY_PAREN(context) || j->alias != NULL)
 			appendStringInfoChar(buf, '(');
+		if (j->jointype == JOIN_ANTI)
+			appendStringInfoChar(buf, '(');
 
 		get_from_clause_item(j->larg, query, context);
 
@@ -3217,6 +3219,12 @@ get_from_clause_item(Node *jtnode, Query *query, deparse_context *context)
 										 -PRETTYINDENT_JOIN,
 										 PRETTYINDENT_JOIN, 2);
 					break;
+				case JOIN_ANTI:
+					/* no syntax for anti joins, emulated below */
+					appendContextKeyword(context, " LEFT JOIN ",
+										 -PRETTYINDENT_JOIN,
+										 PRETTYINDENT_JOIN, 2);
+					break;
 				default:
 					elog(ERROR, "unrecognized join type: %d",
 						 (int) j->jointype);
@@ -3247,6 +3255,31 @@ get_from_clause_item(Node *jtnode, Query *query, deparse_context *context)
 				}
 				appendStringInfoChar(buf, ')');
 			}
+			else if (j->jointype == JOIN_ANTI)
+			{
+				/*
+				 * An anti join returns the left input tuples without a join
+				 * partner, padded with nulls for the right input. Produce the
+				 * padding with a left join that never matches and filter the
+				 * result by joining it with a single row on a NOT EXISTS
+				 * condition that re-evaluates the right input. The right
+				 * input is deparsed again under the same alias, so the join
+				 * quals refer to the copy inside NOT EXISTS.
+				 */
+				appendStringInfoString(buf, " ON (1 = 0))");
+				appendContextKeyword(context, " JOIN ",
+									 -PRETTYINDENT_JOIN,
+									 PRETTYINDENT_JOIN, 2);
+				appendStringInfo(buf, "(SELECT 1 FROM SYSIBM.SYSDUMMY1) anti_join_%d", j->rtindex);
+				appendStringInfoString(buf, " ON (NOT EXISTS (SELECT 1 FROM ");
+				get_from_clause_item(j->rarg, query, context);
+				if (j->quals)
+				{
+					appendStringInfoString(buf, " WHERE ");
+					get_rule_expr(j->quals, context, false);
+				}
+				appendStringInfoString(buf, "))");
+			}
 			else if (j->quals)
 			{
 				appendStringInfo(buf, " ON ");
@@ -74,7 +74,6 @@ generateQualPointers (QueryPushdownInfo *info)
 {
 	ListCell *lc;
 	QueryPushdownInfo *child;
-	Node *fromItem;
 
 	info->qualPointers = generateDuplicatesList(NULL, list_length(info->query->rtable) + 1);
 
@@ -84,11 +83,7 @@ generateQualPointers (QueryPushdownInfo *info)
 
 	/* create pointers for each from item */
 	foreach(lc, info->query->jointree->fromlist)
-	{
-		fromItem = (Node *) lfirst(lc);
-
-		generateQualPointerForNode (&fromItem, info);
-	}
+		generateQualPointerForNode ((Node **) &(lfirst(lc)), info);
 
 	/* create Quals pointers for children */
 	foreach(lc, info->children)
@@ -165,6 +160,10 @@ finalizeAggScope (Query *query, SelScope *scope)
 
 	qualPointer = &(query->havingQual);
 
+	/* the having qual can never be fulfilled */
+	if (scope->contradiction)
+		addExprToQual (query, makeBoolConst(false, false), qualPointer);
+
 	/* add all selection conditions to having qual */
 	foreach(lc, scope->selInfos)
 	{
@@ -190,6 +189,13 @@ finalizeSelScope (Query *query, SelScope *scope)
 	Node **qualPointer;
 	SelScope *child;
 
+	/* the selection conditions of the scope can never be fulfilled */
+	if (scope->contradiction)
+	{
+		qualPointer = (Node **) list_nth(scope->pushdown->qualPointers, scope->topIndex);
+		addExprToQual (query, makeBoolConst(false, false), qualPointer);
+	}
+
 	/* process selection infos */
 	foreach(lc, scope->selInfos)
 	{
@@ -427,6 +433,7 @@ static void
 addExprToQual (Query *query, Node *newQual, Node **qualPointer)
 {
 	BoolExpr *and;
+	MemoryContext old;
 
 	/* qual was NULL before */
 	if (*qualPointer == NULL)
@@ -437,7 +444,12 @@ addExprToQual (Query *query, Node *newQual, Node **qualPointer)
 	else if (IsA(*qualPointer, BoolExpr) && ((BoolExpr *) *qualPointer)->boolop == AND_EXPR)
 	{
 		and = (BoolExpr *) *qualPointer;
-		and->args = lappend(and->args, copyObjectNorm(newQual));
+		newQual = copyObjectNorm(newQual);
+
+		/* the new list cell has to survive the pushdown memory context too */
+		old = MemoryContextSwitchTo(CurrentMemoryContext->parent);
+		and->args = lappend(and->args, newQual);
+		MemoryContextSwitchTo(old);
 	}
 	/* top level node is something else */
 	else
@@ -16,8 +16,14 @@
  */
 
 #include "postgres.h"
+#include "catalog/pg_operator.h"
+#include "fmgr.h"
+#include "nodes/bitmapset.h"
 #include "nodes/makefuncs.h"
 #include "optimizer/clauses.h"
+#include "parser/parse_expr.h"
+#include "parser/parse_oper.h"
+#include "utils/syscache.h"
 
 #include "provrewrite/prov_nodes.h"
 #include "provrewrite/prov_restr_ineq.h"
@@ -25,36 +31,329 @@
 #include "provrewrite/prov_util.h"
 #include "provrewrite/provstack.h"
 
+/* node to position mapping used for the bit matrix of the transitive closure */
+typedef struct IneqNodeIndex
+{
+	InequalityGraphNode *node;
+	int pos;
+} IneqNodeIndex;
+
 /* marcos */
 #define IsAConstNode(node) \
 	(list_length(((InequalityGraphNode *) node)->consts))
 
 /* prototypes */
-static InequalityGraphNode *getNodeForExpr (InequalityGraph *graph, Node *expr, PushdownInfo *info);
+static InequalityGraphNode *getNodeForExpr (InequalityGraph *graph, Node *expr);
 static bool graphNodeContainsEL (Node *node, EquivalenceList *context);
-static bool computeReachableNodes (InequalityGraph *graph, InequalityGraphNode *currentNode,
-	 InequalityGraphNode *start, bool smaeq, List *path, List **cycles);
+static int compareIneqNodeIndex (const void *left, const void *right);
+static int getIneqNodePos (IneqNodeIndex *index, int numNodes, InequalityGraphNode *node);
 static void mergeCycles (InequalityGraph *graph, List *mergeLists);
 static InequalityGraphNode *mergeCycle (InequalityGraph *graph, List *path);
 static void removeParalellEdges (InequalityGraph *graph);
 static void removeRedundentEdgesToNodes (InequalityGraphNode *node);
 static void removeEdgesToConsts (InequalityGraphNode *node, ComparisonType edgeType, InequalityGraphNode **maxMinNode, List **remove);
-static void mergeGraphNodeEquivalenceLists (InequalityGraph *graph, PushdownInfo *info);
+static void mergeGraphNodeEquivalenceLists (InequalityGraph *graph, SelScope *scope);
 static bool checkNodeConsts (InequalityGraphNode *node);
 static bool examineSelfEdges (InequalityGraph *graph);
-static SelectionInfo *generateInequality (InequalityGraphNode *from, InequalityGraphNode *to, ComparisonType type);
+static SelectionInfo *generateInequality (SelScope *scope, InequalityGraphNode *from, InequalityGraphNode *to, ComparisonType type);
 static void removeEdgesFromList (InequalityGraphNode *node, List *edges, bool bigger);
-static bool computeConstantsForGraph (InequalityGraph *graph, PushdownInfo *info);
+static bool computeConstantsForGraph (InequalityGraph *graph, SelScope *scope);
 static bool checkInequality (InequalityGraphNode *left, InequalityGraphNode *right, ComparisonType type);
+static void addConstantEdges (InequalityGraph *graph);
+static Const *getNodeConst (InequalityGraphNode *node);
+static bool compareConsts (Const *left, Const *right, int *result);
+static void addBoundSelections (SelScope *scope, InequalityGraphNode *node, bool upper);
+static Const *getTightestBound (List *strictEdges, List *edges, bool upper, bool *strict);
 
 //TODO provide flat free for graph
 
 /*
- * Compute the inequality graph for a pushdown info and a list of inequalities
+ * Derive new inequalities for a selection scope from the transitive closure of its inequality graph:
+ * 		E1 < E2 && E2 < E1 ->	false
+ * 		E1 < E2 && E2 < c  -> E1 < c
+ * 		E1 < c1 && E1 > c2 with c1 < c2  -> false
+ * A contradiction is recorded in the scope. Otherwise the tightest constant upper and lower bound of each
+ * expression is added to the scope as a derived selection condition, so it can be pushed down to the relation
+ * the expression belongs to.
+ */
+
+void
+deduceScopeInequalities (SelScope *scope)
+{
+	InequalityGraph *graph;
+	InequalityGraphNode *node;
+	ListCell *lc;
+
+	/* build inequality-EC graph and add the order of its constants */
+	graph = computeInequalityGraph(scope);
+	addConstantEdges(graph);
+
+	/* compute transitive closure */
+	graph = computeTransitiveClosure(graph);
+
+	if (graph == NULL)
+	{
+		scope->contradiction = true;
+		return;
+	}
+
+	/* add the tightest constant bounds of each node without a constant */
+	foreach(lc, graph->nodes)
+	{
+		node = (InequalityGraphNode *) lfirst(lc);
+
+		if (getNodeConst(node) != NULL)
+			continue;
+
+		addBoundSelections(scope, node, true);
+		addBoundSelections(scope, node, false);
+	}
+}
+
+/*
+ * Add an edge between each pair of constant nodes of the same type according to the order of their values. Constants
+ * with the same value get "<="-edges in both directions and are merged by the transitive closure.
+ */
+
+static void
+addConstantEdges (InequalityGraph *graph)
+{
+	ListCell *lc;
+	ListCell *innerLc;
+	InequalityGraphNode *left;
+	InequalityGraphNode *right;
+	Const *leftConst;
+	Const *rightConst;
+	int cmp;
+
+	foreach(lc, graph->nodes)
+	{
+		left = (InequalityGraphNode *) lfirst(lc);
+		leftConst = getNodeConst(left);
+
+		if (leftConst == NULL)
+			continue;
+
+		foreachsince(innerLc, lc->next)
+		{
+			right = (InequalityGraphNode *) lfirst(innerLc);
+			rightConst = getNodeConst(right);
+
+			if (rightConst == NULL || !compareConsts(leftConst, rightConst, &cmp))
+				continue;
+
+			if (cmp <= 0)
+			{
+				if (cmp < 0)
+				{
+					left->lessThen = lappend(left->lessThen, right);
+					right->greaterEqThen = lappend(right->greaterEqThen, left);
+				}
+				else
+				{
+					left->lessEqThen = lappend(left->lessEqThen, right);
+					right->greaterThen = lappend(right->greaterThen, left);
+				}
+			}
+			if (cmp >= 0)
+			{
+				if (cmp > 0)
+				{
+					right->lessThen = lappend(right->lessThen, left);
+					left->greaterEqThen = lappend(left->greaterEqThen, right);
+				}
+				else
+				{
+					right->lessEqThen = lappend(right->lessEqThen, left);
+					left->greaterThen = lappend(left->greaterThen, right);
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Returns the constant of the equivalence lists of an inequality graph node or NULL if the node has no constant.
+ */
+
+static Const *
+getNodeConst (InequalityGraphNode *node)
+{
+	ListCell *lc;
+	EquivalenceList *equi;
+
+	foreach(lc, node->equis)
+	{
+		equi = (EquivalenceList *) lfirst(lc);
+
+		if (equi->constant != NULL)
+			return equi->constant;
+	}
+
+	return NULL;
+}
+
+/*
+ * Compares two non-null constants of the same type using the ordering operator of the type. Returns false if the
+ * constants cannot be compared.
+ */
+
+static bool
+compareConsts (Const *left, Const *right, int *result)
+{
+	Operator operTuple;
+	Oid opfuncid;
+
+	if (left->consttype != right->consttype || left->constisnull || right->constisnull)
+		return false;
+
+	operTuple = ordering_oper(left->consttype, true);
+
+	if (operTuple == NULL)
+		return false;
+
+	opfuncid = ((Form_pg_operator) GETSTRUCT(operTuple))->oprcode;
+	ReleaseSysCache(operTuple);
+
+	if (DatumGetBool(OidFunctionCall2(opfuncid, left->constvalue, right->constvalue)))
+		*result = -1;
+	else if (DatumGetBool(OidFunctionCall2(opfuncid, right->constvalue, left->constvalue)))
+		*result = 1;
+	else
+		*result = 0;
+
+	return true;
+}
+
+/*
+ * Adds a derived selection condition for the tightest upper (or lower) constant bound of a node for each Var of the
+ * node, unless the scope already contains this condition.
+ */
+
+static void
+addBoundSelections (SelScope *scope, InequalityGraphNode *node, bool upper)
+{
+	ListCell *lc;
+	ListCell *innerLc;
+	ListCell *lc2;
+	EquivalenceList *equi;
+	SelectionInfo *sel;
+	Const *bound;
+	Node *expr;
+	Node *cond;
+	Node *commuted;
+	bool strict;
+	bool found;
+
+	/* A in X->greaterEqThen <-> X in A->lessThen and A in X->greaterThen <-> X in A->lessEqThen */
+	if (upper)
+		bound = getTightestBound(node->lessThen, node->lessEqThen, true, &strict);
+	else
+		bound = getTightestBound(node->greaterEqThen, node->greaterThen, false, &strict);
+
+	if (bound == NULL)
+		return;
+
+	foreach(lc, node->equis)
+	{
+		equi = (EquivalenceList *) lfirst(lc);
+
+		foreach(innerLc, equi->exprs)
+		{
+			expr = (Node *) lfirst(innerLc);
+
+			if (!IsA(expr, Var) || exprType(expr) != bound->consttype)
+				continue;
+
+			/* the condition and its commuted form, e.g. "a < 5" and "5 > a" */
+			if (upper)
+			{
+				cond = strict ? createSmallerCondition(copyObject(expr), copyObject(bound))
+						: createSmallerEqCondition(copyObject(expr), copyObject(bound));
+				commuted = strict ? createBiggerCondition(copyObject(bound), copyObject(expr))
+						: createBiggerEqCondition(copyObject(bound), copyObject(expr));
+			}
+			else
+			{
+				cond = strict ? createBiggerCondition(copyObject(expr), copyObject(bound))
+						: createBiggerEqCondition(copyObject(expr), copyObject(bound));
+				commuted = strict ? createSmallerCondition(copyObject(bound), copyObject(expr))
+						: createSmallerEqCondition(copyObject(bound), copyObject(expr));
+			}
+
+			/* do not add a condition that is already part of the scope */
+			found = false;
+			foreach(lc2, scope->selInfos)
+			{
+				sel = (SelectionInfo *) lfirst(lc2);
+
+				if (equal(sel->expr, cond) || equal(sel->expr, commuted))
+				{
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+				scope->selInfos = lappend(scope->selInfos, createSelectionInfo(cond, scope->topIndex, true));
+		}
+	}
+}
+
+/*
+ * Returns the smallest (or biggest) constant of the nodes reached over strict and non-strict edges. If the same value
+ * is reached over a strict and a non-strict edge the strict one is used.
+ */
+
+static Const *
+getTightestBound (List *strictEdges, List *edges, bool upper, bool *strict)
+{
+	ListCell *lc;
+	Const *result;
+	Const *cons;
+	int cmp;
+
+	result = NULL;
+	*strict = false;
+
+	foreach(lc, strictEdges)
+	{
+		cons = getNodeConst((InequalityGraphNode *) lfirst(lc));
+
+		if (cons == NULL || cons->constisnull)
+			continue;
+
+		if (result == NULL)
+			result = cons;
+		else if (compareConsts(cons, result, &cmp) && (upper ? cmp < 0 : cmp > 0))
+			result = cons;
+	}
+
+	*strict = (result != NULL);
+
+	foreach(lc, edges)
+	{
+		cons = getNodeConst((InequalityGraphNode *) lfirst(lc));
+
+		if (cons == NULL || cons->constisnull)
+			continue;
+
+		if (result == NULL || (compareConsts(cons, result, &cmp) && (upper ? cmp < 0 : cmp > 0)))
+		{
+			result = cons;
+			*strict = false;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Compute the inequality graph for the equivalence lists and inequalities of a selection scope
  */
 
 InequalityGraph *
-computeInequalityGraph (PushdownInfo *info)
+computeInequalityGraph (SelScope *scope)
 {
 	List *ineqs;
 	InequalityGraph *graph;
@@ -67,12 +366,12 @@ computeInequalityGraph (PushdownInfo *info)
 	InequalityGraphNode *toNode;
 	SelectionInfo *sel;
 
-	ineqs = getSimpleInequalities (info);
+	ineqs = getSimpleInequalities (scope);
 
 	graph = makeInequalityGraph ();
 
-	/* generate a node in the graph for each equivalence list from info */
-	foreach(lc,info->equiLists)
+	/* generate a node in the graph for each equivalence list from scope */
+	foreach(lc,scope->equiLists)
 	{
 		equi = (EquivalenceList *) lfirst(lc);
 
@@ -85,29 +384,29 @@ computeInequalityGraph (PushdownInfo *info)
 	foreach(lc, ineqs)
 	{
 		sel = (SelectionInfo *) lfirst(lc);
-		from = getLeftSelOp (sel);
-		to = getRightSelOp (sel);
-		fromNode = getNodeForExpr (graph, from, info);
-		toNode = getNodeForExpr (graph, to, info);
+		from = get_leftop((Expr *) sel->expr);
+		to = get_rightop((Expr *) sel->expr);
+		fromNode = getNodeForExpr (graph, from);
+		toNode = getNodeForExpr (graph, to);
 
 		/* the type of inequality determines the type of edge we have to add */
 		switch(getTypeForIneq (sel))
 		{
 			case COMP_SMALLER:
-				fromNode->lessThen = list_append_unique(fromNode->lessThen, toNode);
-				toNode->greaterEqThen = list_append_unique(toNode->greaterEqThen, fromNode);
+				fromNode->lessThen = list_append_unique_ptr(fromNode->lessThen, toNode);
+				toNode->greaterEqThen = list_append_unique_ptr(toNode->greaterEqThen, fromNode);
 			break;
 			case COMP_SMALLEREQ:
-				fromNode->lessEqThen = list_append_unique(fromNode->lessEqThen, toNode);
-				toNode->greaterThen = list_append_unique(toNode->greaterThen, fromNode);
+				fromNode->lessEqThen = list_append_unique_ptr(fromNode->lessEqThen, toNode);
+				toNode->greaterThen = list_append_unique_ptr(toNode->greaterThen, fromNode);
 			break;
 			case COMP_BIGGEREQ:
-				toNode->lessThen = list_append_unique(toNode->lessThen, fromNode);
-				fromNode->greaterEqThen = list_append_unique(fromNode->greaterEqThen, toNode);
+				toNode->lessEqThen = list_append_unique_ptr(toNode->lessEqThen, fromNode);
+				fromNode->greaterThen = list_append_unique_ptr(fromNode->greaterThen, toNode);
 			break;
 			case COMP_BIGGER:
-				toNode->lessEqThen = list_append_unique(toNode->lessEqThen, fromNode);
-				fromNode->greaterThen = list_append_unique(fromNode->greaterThen, toNode);
+				toNode->lessThen = list_append_unique_ptr(toNode->lessThen, fromNode);
+				fromNode->greaterEqThen = list_append_unique_ptr(fromNode->greaterEqThen, toNode);
 			break;
 			default:
 				//TODO error
@@ -119,20 +418,40 @@ computeInequalityGraph (PushdownInfo *info)
 }
 
 /*
- * Searches for the node that represent the equivalence list of an expression.
+ * Searches for the node that represent the equivalence list of an expression. Expressions that are not part of
+ * any equivalence list of the scope get a new node with a single element equivalence list.
  */
 
 static InequalityGraphNode *
-getNodeForExpr (InequalityGraph *graph, Node *expr, PushdownInfo *info)
+getNodeForExpr (InequalityGraph *graph, Node *expr)
 {
 	EquivalenceList *equi;
+	InequalityGraphNode *node;
+	ListCell *lc;
+	ListCell *innerLc;
 
-	equi = getEqualityListForExpr (info, expr);
+	foreach(lc, graph->equiLists)
+	{
+		equi = (EquivalenceList *) lfirst(lc);
 
-	if (equi == NULL)
-		return NULL;
+		foreach(innerLc, equi->exprs)
+		{
+			if (equal(expr, lfirst(innerLc)))
+				return (InequalityGraphNode *) getFirstNodeForPred(graph->nodes, graphNodeContainsEL, (void *) equi);
+		}
+	}
+
+	equi = makeEquivalenceList ();
+	equi->exprs = list_make1(expr);
+
+	if (IsA(expr, Const))
+		equi->constant = (Const *) expr;
 
-	return (InequalityGraphNode *) getFirstNodeForPred(graph->nodes, graphNodeContainsEL, (void *) equi);
+	node = makeInequalityGraphNode ((Node *) equi);
+	graph->nodes = lappend(graph->nodes, node);
+	graph->equiLists = lappend(graph->equiLists, equi);
+
+	return node;
 }
 
 /*
@@ -164,6 +483,11 @@ graphNodeContainsEL (Node *node, EquivalenceList *context)
  *		1) Add a new edge between E1 and E2 if there is a path from E1 to E2. The label of the edge is determined by:
  *			1) all edges on the path are labeled as <= --> label is <=
  *			2) else --> label is <
+ *
+ *	The closure is computed on a dense bit matrix (one Bitmapset row per node and label) with Warshall's algorithm,
+ *	so each relaxation step ORs whole rows word by word instead of walking every path of the graph. Nodes that
+ *	reach each other over "<="-paths form a cycle and are merged afterwards. A "<"-path from a node to itself is
+ *	a contradiction and NULL is returned.
  */
 
 InequalityGraph *
@@ -171,99 +495,185 @@ computeTransitiveClosure (InequalityGraph *graph)
 {
 	ListCell *lc;
 	InequalityGraphNode *node;
+	InequalityGraphNode **nodes;
+	IneqNodeIndex *index;
+	Bitmapset **le;
+	Bitmapset **lt;
+	Bitmapset *done;
 	List *cycles;
+	List *cycle;
+	int numNodes;
+	int i;
+	int j;
+	int k;
 
-
+	numNodes = list_length(graph->nodes);
 	cycles = NIL;
 
-	/* for each node in the graph find all reachable nodes */
+	if (numNodes == 0)
+		return graph;
+
+	/* number the nodes and build a sorted index to map nodes to their position */
+	nodes = (InequalityGraphNode **) palloc(numNodes * sizeof(InequalityGraphNode *));
+	index = (IneqNodeIndex *) palloc(numNodes * sizeof(IneqNodeIndex));
+
+	i = 0;
 	foreach(lc, graph->nodes)
 	{
-		node = (InequalityGraphNode *) lfirst(lc);
-
-		if (computeReachableNodes(graph, node, node, true, NIL, &cycles))
-			return NULL;
+		nodes[i] = (InequalityGraphNode *) lfirst(lc);
+		index[i].node = nodes[i];
+		index[i].pos = i;
+		i++;
 	}
 
-	/* if has mergeable cycles then merge the nodes of each cycle */
-	mergeCycles(graph, cycles);
+	qsort(index, numNodes, sizeof(IneqNodeIndex), compareIneqNodeIndex);
 
-	return graph;
-}
+	/*
+	 * Initialize the matrix with the edges of the graph. Each node is reachable from itself over an empty "<="-path.
+	 */
+	le = (Bitmapset **) palloc(numNodes * sizeof(Bitmapset *));
+	lt = (Bitmapset **) palloc(numNodes * sizeof(Bitmapset *));
 
-/*
- * Recursively computes the nodes reachable from one node.
- */
+	for(i = 0; i < numNodes; i++)
+	{
+		node = nodes[i];
 
-static bool
-computeReachableNodes (InequalityGraph *graph, InequalityGraphNode *currentNode,
-		InequalityGraphNode *start, bool smaeq, List *path, List **cycles)
-{
-	InequalityGraphNode *node;
-	ListCell *lc;
-	List *newPath;
-	bool alreadyThere;
+		le[i] = bms_make_singleton(i);
+		lt[i] = NULL;
 
-	alreadyThere = false;
+		foreach(lc, node->lessEqThen)
+			le[i] = bms_add_member(le[i], getIneqNodePos(index, numNodes, lfirst(lc)));
+
+		foreach(lc, node->lessThen)
+			lt[i] = bms_add_member(lt[i], getIneqNodePos(index, numNodes, lfirst(lc)));
+	}
 
 	/*
-	 * Check for a cycle. If we have a cycle check if it represents an contradiction or results in merge of the
-	 * equivalence classes of the cycle.
+	 * Warshall: after step k, row i contains every node reachable from i over paths whose inner nodes are
+	 * among the first k nodes. A path is a "<"-path if one of its two halves is a "<"-path.
 	 */
-	if (list_length(path) != 0 && start == currentNode)
+	for(k = 0; k < numNodes; k++)
 	{
-		if (smaeq)
-			*cycles = list_append_unique (*cycles, path);
-		else
-			return true;
+		for(i = 0; i < numNodes; i++)
+		{
+			if (bms_is_member(k, le[i]))
+			{
+				le[i] = bms_add_members(le[i], le[k]);
+				lt[i] = bms_add_members(lt[i], lt[k]);
+			}
+			if (bms_is_member(k, lt[i]))
+			{
+				lt[i] = bms_add_members(lt[i], le[k]);
+				lt[i] = bms_add_members(lt[i], lt[k]);
+			}
+		}
+	}
+
+	/* a "<"-cycle is a contradiction */
+	for(i = 0; i < numNodes; i++)
+	{
+		if (bms_is_member(i, lt[i]))
+			return NULL;
 	}
 
 	/*
-	 * add edge from start node to current node. If there is already an edge do not go any further, because
-	 * we are sure that we have done this the first time we reached this node.
+	 * Replace the edges of each node with the closure. The inverse edge lists are rebuilt too, so no list has to be
+	 * searched for duplicates.
 	 */
-	if (smaeq)
+	for(i = 0; i < numNodes; i++)
 	{
-		if (list_member(start->lessEqThen, currentNode))
-			alreadyThere = true;
+		node = nodes[i];
 
-		start->lessEqThen = list_append_unique (start->lessEqThen, currentNode);
-		currentNode->greaterThen = list_append_unique (currentNode->greaterThen, start);
+		node->lessThen = NIL;
+		node->lessEqThen = NIL;
+		node->greaterThen = NIL;
+		node->greaterEqThen = NIL;
 	}
-	else
+
+	for(i = 0; i < numNodes; i++)
 	{
-		if (list_member(start->lessThen, currentNode))
-			alreadyThere = true;
+		node = nodes[i];
 
-		start->lessThen = list_append_unique (start->lessThen, currentNode);
-		currentNode->greaterEqThen = list_append_unique (currentNode->greaterEqThen, start);
+		for(j = 0; j < numNodes; j++)
+		{
+			if (bms_is_member(j, le[i]))
+			{
+				node->lessEqThen = lappend(node->lessEqThen, nodes[j]);
+				nodes[j]->greaterThen = lappend(nodes[j]->greaterThen, node);
+			}
+			if (bms_is_member(j, lt[i]))
+			{
+				node->lessThen = lappend(node->lessThen, nodes[j]);
+				nodes[j]->greaterEqThen = lappend(nodes[j]->greaterEqThen, node);
+			}
+		}
 	}
 
-	if (alreadyThere)
-		return false;
+	/*
+	 * Nodes that reach each other over "<="-paths are equal. Collect one merge list for each group of such nodes.
+	 */
+	done = NULL;
 
-	/* no cycle proceed with all directly connected nodes */
-	foreach(lc, currentNode->lessThen)
+	for(i = 0; i < numNodes; i++)
 	{
-		node = (InequalityGraphNode *) lfirst(lc);
-		newPath = list_copy(path);
-		newPath = lappend(newPath, node);
+		if (bms_is_member(i, done))
+			continue;
 
-		if (computeReachableNodes (graph, node, start, false, newPath, cycles))
-			return true;
-	}
+		cycle = list_make1(nodes[i]);
 
-	foreach(lc, currentNode->lessEqThen)
-	{
-		node = (InequalityGraphNode *) lfirst(lc);
-		newPath = list_copy(path);
-		newPath = lappend(newPath, node);
+		for(j = i + 1; j < numNodes; j++)
+		{
+			if (bms_is_member(j, le[i]) && bms_is_member(i, le[j]))
+			{
+				cycle = lappend(cycle, nodes[j]);
+				done = bms_add_member(done, j);
+			}
+		}
 
-		if (computeReachableNodes (graph, node, start, smaeq, newPath, cycles))
-			return true;
+		if (list_length(cycle) > 1)
+			cycles = lappend(cycles, cycle);
 	}
 
-	return false;
+	/* if has mergeable cycles then merge the nodes of each cycle */
+	mergeCycles(graph, cycles);
+
+	return graph;
+}
+
+/*
+ * Comparison function used to sort and search the node index of computeTransitiveClosure.
+ */
+
+static int
+compareIneqNodeIndex (const void *left, const void *right)
+{
+	const InequalityGraphNode *l = ((const IneqNodeIndex *) left)->node;
+	const InequalityGraphNode *r = ((const IneqNodeIndex *) right)->node;
+
+	if (l < r)
+		return -1;
+	if (l > r)
+		return 1;
+	return 0;
+}
+
+/*
+ * Returns the position of a node in the bit matrix.
+ */
+
+static int
+getIneqNodePos (IneqNodeIndex *index, int numNodes, InequalityGraphNode *node)
+{
+	IneqNodeIndex key;
+	IneqNodeIndex *result;
+
+	key.node = node;
+	result = (IneqNodeIndex *) bsearch(&key, index, numNodes, sizeof(IneqNodeIndex), compareIneqNodeIndex);
+
+	if (result == NULL)
+		elog(ERROR, "inequality graph edge points to a node that is not part of the graph");
+
+	return result->pos;
 }
 
 /*
@@ -276,6 +686,7 @@ mergeCycles (InequalityGraph *graph, List *mergeLists)
 {
 	List *mergeList;
 	List *curMergeList;
+	List *newMergeList;
 	ListCell *lc;
 	ListCell *innerLc;
 	InequalityGraphNode *node;
@@ -293,20 +704,17 @@ mergeCycles (InequalityGraph *graph, List *mergeLists)
 		node = mergeCycle (graph, mergeList);
 
 		/* adapt other merge lists and graph node list */
-		graph->nodes = list_difference(graph->nodes, mergeList);
+		graph->nodes = list_difference_ptr(graph->nodes, mergeList);
 		graph->nodes = lappend (graph->nodes, node);
 
-		foreachsince(innerLc, lc)
+		foreachsince(innerLc, lc->next)
 		{
 			curMergeList = (List *) lfirst(innerLc);
+			newMergeList = list_difference_ptr(curMergeList, mergeList);
 
-			if (list_overlap(curMergeList, mergeList))
-			{
-				curMergeList = list_difference(curMergeList, mergeList);
-				curMergeList = lappend(curMergeList, node);
-
-				lfirst(innerLc) = curMergeList;
-			}
+			/* overlaps with the merged nodes, replace them with the merged node */
+			if (list_length(newMergeList) != list_length(curMergeList))
+				lfirst(innerLc) = lappend(newMergeList, node);
 		}
 	}
 
@@ -333,34 +741,51 @@ mergeCycle (InequalityGraph *graph, List *path)
 	{
 		node = (InequalityGraphNode *) lfirst(lc);
 
-		mergedNode->lessThen = list_concat_unique (mergedNode->lessThen, node->lessThen);
-		mergedNode->lessEqThen = list_concat_unique (mergedNode->lessThen, node->lessEqThen);
-		mergedNode->greaterThen = list_concat_unique (mergedNode->greaterThen, node->greaterThen);
-		mergedNode->greaterEqThen = list_concat_unique (mergedNode->greaterEqThen, node->greaterEqThen);
+		mergedNode->lessThen = list_concat_unique_ptr (mergedNode->lessThen, node->lessThen);
+		mergedNode->lessEqThen = list_concat_unique_ptr (mergedNode->lessEqThen, node->lessEqThen);
+		mergedNode->greaterThen = list_concat_unique_ptr (mergedNode->greaterThen, node->greaterThen);
+		mergedNode->greaterEqThen = list_concat_unique_ptr (mergedNode->greaterEqThen, node->greaterEqThen);
 
 		mergedNode->equis = list_concat_unique(mergedNode->equis, node->equis);
 	}
 
-	mergedNode->lessThen = list_difference (mergedNode->lessThen, path);
-	mergedNode->lessEqThen = list_difference (mergedNode->lessEqThen, path);
-	mergedNode->greaterThen = list_difference (mergedNode->greaterThen, path);
-	mergedNode->greaterEqThen = list_difference (mergedNode->greaterEqThen, path);
+	mergedNode->lessThen = list_difference_ptr (mergedNode->lessThen, path);
+	mergedNode->lessEqThen = list_difference_ptr (mergedNode->lessEqThen, path);
+	mergedNode->greaterThen = list_difference_ptr (mergedNode->greaterThen, path);
+	mergedNode->greaterEqThen = list_difference_ptr (mergedNode->greaterEqThen, path);
+
+	/* adapt the edges of predecessors (A in X->greaterThen <-> X in A->lessEqThen and so on) */
+	foreach(lc, mergedNode->greaterThen)
+	{
+		node = (InequalityGraphNode *) lfirst(lc);
+
+		node->lessEqThen = list_difference_ptr (node->lessEqThen, path);
+		node->lessEqThen = lappend (node->lessEqThen, mergedNode);
+	}
 
-	/* adapt the edges of predecessors */
 	foreach(lc, mergedNode->greaterEqThen)
 	{
 		node = (InequalityGraphNode *) lfirst(lc);
 
-		node->lessEqThen = list_difference (node->lessEqThen, path);
-		node->lessEqThen = list_append_unique (node->lessEqThen, mergedNode);
+		node->lessThen = list_difference_ptr (node->lessThen, path);
+		node->lessThen = lappend (node->lessThen, mergedNode);
 	}
 
-	foreach(lc, mergedNode->greaterThen)
+	/* adapt the edges of successors */
+	foreach(lc, mergedNode->lessEqThen)
+	{
+		node = (InequalityGraphNode *) lfirst(lc);
+
+		node->greaterThen = list_difference_ptr (node->greaterThen, path);
+		node->greaterThen = lappend (node->greaterThen, mergedNode);
+	}
+
+	foreach(lc, mergedNode->lessThen)
 	{
 		node = (InequalityGraphNode *) lfirst(lc);
 
-		node->lessThen = list_difference (node->lessThen, path);
-		node->lessThen = list_append_unique (node->lessThen, mergedNode);
+		node->greaterEqThen = list_difference_ptr (node->greaterEqThen, path);
+		node->greaterEqThen = lappend (node->greaterEqThen, mergedNode);
 	}
 
 	return mergedNode;
@@ -371,16 +796,16 @@ mergeCycle (InequalityGraph *graph, List *path)
  */
 
 InequalityGraph *
-minimizeInEqualityGraph (PushdownInfo *info, InequalityGraph *graph)
+minimizeInEqualityGraph (SelScope *scope, InequalityGraph *graph)
 {
 	InequalityGraphNode *node;
 	ListCell *lc;
 
 	/* merge the equivalence lists of each node */
-	mergeGraphNodeEquivalenceLists (graph, info);
+	mergeGraphNodeEquivalenceLists (graph, scope);
 
 	/* compute constants lists for each node in the graph */
-	if (computeConstantsForGraph(graph, info))
+	if (computeConstantsForGraph(graph, scope))
 		return NULL;
 
 	/* check for redundent self edges and self edges that are contradictions */
@@ -406,11 +831,11 @@ minimizeInEqualityGraph (PushdownInfo *info, InequalityGraph *graph)
 }
 
 /*
- *	Merge all equivalence lists of each node in an inequality graph and adapt the pushdown info list of equivalence lists accordingly.
+ *	Merge all equivalence lists of each node in an inequality graph and adapt the list of equivalence lists of the scope accordingly.
  */
 
 static void
-mergeGraphNodeEquivalenceLists (InequalityGraph *graph, PushdownInfo *info)
+mergeGraphNodeEquivalenceLists (InequalityGraph *graph, SelScope *scope)
 {
 	ListCell *lc;
 	ListCell *innerLc;
@@ -427,18 +852,18 @@ mergeGraphNodeEquivalenceLists (InequalityGraph *graph, PushdownInfo *info)
 		{
 			mergedEqui = makeEquivalenceList ();
 
-			/* merge equivalence list and remove original lists from PushdownInfo */
+			/* merge equivalence list and remove original lists from SelScope */
 			foreach(innerLc, node->equis)
 			{
 				curEqui = (EquivalenceList *) lfirst(innerLc);
 
 				mergedEqui->exprs = list_union(mergedEqui->exprs, curEqui->exprs);
-				removeNodeElem(info->equiLists, (Node *) curEqui);
+				removeNodeElem(scope->equiLists, (Node *) curEqui);
 			}
 
-			/* add merge equivalence list from PushdownInfo */
+			/* add merge equivalence list to SelScope */
 			node->equis = list_make1(mergedEqui);
-			info->equiLists = lappend(info->equiLists, mergedEqui);
+			scope->equiLists = lappend(scope->equiLists, mergedEqui);
 		}
 	}
 }
@@ -449,7 +874,7 @@ mergeGraphNodeEquivalenceLists (InequalityGraph *graph, PushdownInfo *info)
  */
 
 static bool
-computeConstantsForGraph (InequalityGraph *graph, PushdownInfo *info)
+computeConstantsForGraph (InequalityGraph *graph, SelScope *scope)
 {
 	ListCell *lc;
 	ListCell *innerLc;
@@ -522,7 +947,7 @@ computeConstantsForGraph (InequalityGraph *graph, PushdownInfo *info)
 	mergeCycles(graph, mergeLists);
 
 	/* merge equivalence lists if necessary */
-	mergeGraphNodeEquivalenceLists (graph, info);
+	mergeGraphNodeEquivalenceLists (graph, scope);
 
 	return false;
 }
@@ -588,12 +1013,13 @@ examineSelfEdges (InequalityGraph *graph)
 		node = (InequalityGraphNode *) lfirst(lc);
 
 		/* remove self references from lessEqThen */
-		removeNodeElem(node->lessEqThen, (Node *) node);
+		node->lessEqThen = list_delete_ptr(node->lessEqThen, node);
+		node->greaterThen = list_delete_ptr(node->greaterThen, node);
 
 		/* if a node is a member of its lesser than list
 		 * we have a contradiction.
 		 */
-		if (list_member(node->lessThen, node))
+		if (list_member_ptr(node->lessThen, node))
 			return true;
 	}
 
@@ -608,26 +1034,21 @@ static void
 removeParalellEdges (InequalityGraph *graph)
 {
 	ListCell *lc;
-	ListCell *innerLc;
-	InequalityGraphNode *fromNode;
-	InequalityGraphNode *toNode;
+	InequalityGraphNode *node;
 
-	/* for each node search for paralell edges. (labeled with "<" and "<=") Remove the "<="-labeled edges. */
+	/*
+	 * for each node search for paralell edges. (labeled with "<" and "<=") Remove the "<="-labeled edges. The inverse
+	 * edges are handled the same way, so each edge list is only scanned once per node.
+	 */
 	foreach(lc, graph->nodes)
 	{
-		fromNode = (InequalityGraphNode *) lfirst(lc);
+		node = (InequalityGraphNode *) lfirst(lc);
 
-		/* walk through "<"-list */
-		foreach(innerLc, fromNode->lessThen)
-		{
-			toNode = (InequalityGraphNode *) lfirst(innerLc);
+		if (node->lessThen != NIL && node->lessEqThen != NIL)
+			node->lessEqThen = list_difference_ptr(node->lessEqThen, node->lessThen);
 
-			if (list_member(fromNode->lessEqThen, toNode))
-			{
-				removeNodeElem(fromNode->lessEqThen, (Node *) toNode);
-				removeNodeElem(toNode->greaterThen, (Node *) toNode);
-			}
-		}
+		if (node->greaterEqThen != NIL && node->greaterThen != NIL)
+			node->greaterThen = list_difference_ptr(node->greaterThen, node->greaterEqThen);
 	}
 }
 
@@ -708,9 +1129,10 @@ removeEdgesToConsts (InequalityGraphNode *node, ComparisonType edgeType, Inequal
 
 		if (IsAConstNode(toNode))
 		{
-			if (maxMinNode == NULL || checkInequality(*maxMinNode, toNode, checkType))
+			if (*maxMinNode == NULL || checkInequality(*maxMinNode, toNode, checkType))
 			{
-				*remove = lappend(*remove, *maxMinNode);
+				if (*maxMinNode != NULL)
+					*remove = lappend(*remove, *maxMinNode);
 				*maxMinNode = toNode;
 			}
 			else
@@ -730,25 +1152,35 @@ removeEdgesFromList (InequalityGraphNode *node, List *edges, bool bigger)
 	ListCell *lc;
 	InequalityGraphNode *toNode;
 
+	if (edges == NIL)
+		return;
+
+	/* remove the edges of the start node with one pass over each of its edge lists */
+	if (bigger)
+	{
+		node->greaterThen = list_difference_ptr(node->greaterThen, edges);
+		node->greaterEqThen = list_difference_ptr(node->greaterEqThen, edges);
+	}
+	else
+	{
+		node->lessThen = list_difference_ptr(node->lessThen, edges);
+		node->lessEqThen = list_difference_ptr(node->lessEqThen, edges);
+	}
+
+	/* remove the inverse edges */
 	foreach(lc, edges)
 	{
 		toNode = (InequalityGraphNode *) lfirst(lc);
 
 		if (bigger)
 		{
-			removeNodeElem(node->greaterThen, (Node *) toNode);
-			removeNodeElem(node->greaterEqThen, (Node *) toNode);
-
-			removeNodeElem(toNode->lessThen, (Node *) node);
-			removeNodeElem(toNode->lessEqThen, (Node *) node);
+			toNode->lessThen = list_delete_ptr(toNode->lessThen, node);
+			toNode->lessEqThen = list_delete_ptr(toNode->lessEqThen, node);
 		}
 		else
 		{
-			removeNodeElem(node->lessThen, (Node *) toNode);
-			removeNodeElem(node->lessEqThen, (Node *) toNode);
-
-			removeNodeElem(toNode->greaterThen, (Node *) node);
-			removeNodeElem(toNode->greaterEqThen, (Node *) node);
+			toNode->greaterThen = list_delete_ptr(toNode->greaterThen, node);
+			toNode->greaterEqThen = list_delete_ptr(toNode->greaterEqThen, node);
 		}
 	}
 
@@ -783,7 +1215,7 @@ checkInequality (InequalityGraphNode *left, InequalityGraphNode *right, Comparis
  */
 
 void
-generateInequalitiesFromGraph (PushdownInfo *info, InequalityGraph *graph)
+generateInequalitiesFromGraph (SelScope *scope, InequalityGraph *graph)
 {
 	ListCell *lc;
 	ListCell *innerLc;
@@ -792,10 +1224,10 @@ generateInequalitiesFromGraph (PushdownInfo *info, InequalityGraph *graph)
 	InequalityGraphNode *toNode;
 	SelectionInfo *newExpr;
 
-	ineqs = getSimpleInequalities (info);
+	ineqs = getSimpleInequalities (scope);
 
 	/* remove old inequalities */
-	info->conjuncts = list_difference(info->conjuncts, ineqs);
+	scope->selInfos = list_difference(scope->selInfos, ineqs);
 
 	/* generate new expressions for the edges in the inequality graph */
 	foreach(lc,graph->nodes)
@@ -806,16 +1238,16 @@ generateInequalitiesFromGraph (PushdownInfo *info, InequalityGraph *graph)
 		{
 			toNode = (InequalityGraphNode *) lfirst(innerLc);
 
-			newExpr = generateInequality (fromNode, toNode, COMP_SMALLER);
-			info->conjuncts = lappend(info->conjuncts, newExpr);
+			newExpr = generateInequality (scope, fromNode, toNode, COMP_SMALLER);
+			scope->selInfos = lappend(scope->selInfos, newExpr);
 		}
 
 		foreach(innerLc, fromNode->lessEqThen)
 		{
 			toNode = (InequalityGraphNode *) lfirst(innerLc);
 
-			newExpr = generateInequality (fromNode, toNode, COMP_SMALLEREQ);
-			info->conjuncts = lappend(info->conjuncts, newExpr);
+			newExpr = generateInequality (scope, fromNode, toNode, COMP_SMALLEREQ);
+			scope->selInfos = lappend(scope->selInfos, newExpr);
 		}
 	}
 }
@@ -825,14 +1257,13 @@ generateInequalitiesFromGraph (PushdownInfo *info, InequalityGraph *graph)
  */
 
 static SelectionInfo *
-generateInequality (InequalityGraphNode *from, InequalityGraphNode *to, ComparisonType type)
+generateInequality (SelScope *scope, InequalityGraphNode *from, InequalityGraphNode *to, ComparisonType type)
 {
 	Node *leftOp;
 	Node *rightOp;
 	EquivalenceList *left;
 	EquivalenceList *right;
 	Node *ineq;
-	SelectionInfo *result = NULL;
 
 	/* get one expression from the equivalence lists of left and right nodes */
 	if (list_length(from->consts) != 0)
@@ -843,56 +1274,57 @@ generateInequality (InequalityGraphNode *from, InequalityGraphNode *to, Comparis
 		leftOp = (Node *) linitial(left->exprs);
 	}
 	if (list_length(to->consts) != 0)
+		rightOp = (Node *) linitial(to->consts);
+	else
 	{
-		right = (EquivalenceList *) linitial(to->consts);
+		right = (EquivalenceList *) linitial(to->equis);
 		rightOp = (Node *) linitial(right->exprs);
 	}
 
 	/* create a smaller OpExpr */
-	switch (type)
-	{
-		case COMP_SMALLER:
-			ineq = createSmallerCondition (leftOp, rightOp);
-		break;
-		case COMP_SMALLEREQ:
-			ineq = createSmallerEqCondition (leftOp, rightOp);
-		break;
-		default:
-			//TODO error
-		break;
-	}
+	if (type == COMP_SMALLER)
+		ineq = createSmallerCondition (leftOp, rightOp);
+	else
+		ineq = createSmallerEqCondition (leftOp, rightOp);
 
 	/* create a selection info */
-	//result = createSelectionInfo(ineq);
-
-	return result;
+	return createSelectionInfo(ineq, scope->topIndex, true);
 }
 
-
-
-
 /*
- * Return a list of SelectionInfo's from a pushdown info that are inequalities.
+ * Return a list of SelectionInfo's from a scope that are inequalities between two Vars or Consts of the same type.
  */
 
 List *
-getSimpleInequalities (PushdownInfo *info)
+getSimpleInequalities (SelScope *scope)
 {
 	List *result;
 	SelectionInfo *sel;
 	ListCell *lc;
+	Node *left;
+	Node *right;
 
 	result = NIL;
 
 	/* search for inequalities */
-	foreach(lc, info->conjuncts)
+	foreach(lc, scope->selInfos)
 	{
 		sel = (SelectionInfo *) lfirst(lc);
 
-		if (selIsInequality(sel))
-		{
-			result = lappend(result, sel);
-		}
+		if (!selIsInequality(sel))
+			continue;
+
+		left = get_leftop((Expr *) sel->expr);
+		right = get_rightop((Expr *) sel->expr);
+
+		/* casts are not stripped, an inequality over a cast does not hold for the uncasted expression */
+		if (!(IsA(left, Var) || IsA(left, Const)) || !(IsA(right, Var) || IsA(right, Const)))
+			continue;
+
+		if (exprType(left) != exprType(right))
+			continue;
+
+		result = lappend(result, sel);
 	}
 
 	return result;
@@ -32,6 +32,7 @@
 #include "provrewrite/prov_restr_rewrite.h"
 #include "provrewrite/prov_restr_util.h"
 #include "provrewrite/prov_restr_final.h"
+#include "provrewrite/prov_restr_ineq.h"
 #include "provrewrite/prov_restr_scope.h"
 #include "provrewrite/prov_util.h"
 #include "provrewrite/provrewrite.h"
@@ -50,6 +51,7 @@ static void pushDownOneSetOp (PushdownInfo *pushdown, Query *query, Node *setOp,
 static void pushdownRTE (PushdownInfo *pushdown, Query *query, Index rtindex, ExprHandlers *handlers);
 static PushdownInfo *pushDownHaving (PushdownInfo *pushdown, Query *query, ExprHandlers *handlers);
 
+static void deduceInequalities (QueryPushdownInfo *info);
 static ExprHandlers *getExprHandlers (void);
 static bool replaceVarVarno (Node *node, Index *context);
 
@@ -78,6 +80,10 @@ pushdownSelections (Query *query)
 	/* generate data structures used for selection pushdown */
 	generateQueryPushdownInfos(query);
 
+	/* derive new inequalities and contradictions for each scope */
+	if (prov_use_inequality_deduction)
+		deduceInequalities(getQueryInfo(query));
+
 	/* rewrite and move around selections */
 	//pushdownQueryNode(query, getExprHandlers(), NULL);
 	LOGNODE(query,"selections pushed down");
@@ -92,6 +98,28 @@ pushdownSelections (Query *query)
 	return query;
 }
 
+/*
+ * Deduce inequalities for each scope of a query node and its subqueries.
+ */
+
+static void
+deduceInequalities (QueryPushdownInfo *info)
+{
+	ListCell *lc;
+	SelScope *scope;
+
+	foreach(lc, info->scopes)
+	{
+		scope = (SelScope *) lfirst(lc);
+
+		if (!scope->contradiction)
+			deduceScopeInequalities(scope);
+	}
+
+	foreach(lc, info->children)
+		deduceInequalities((QueryPushdownInfo *) lfirst(lc));
+}
+
 /*
  * try to pushdown the selections given as parameter pushdown into the Query node query.
  */
@@ -31,7 +31,6 @@
 
 #include "provrewrite/prov_restr_rewrite.h"
 #include "provrewrite/prov_restr_util.h"
-#include "provrewrite/prov_restr_ineq.h"
 
 /* prototypes */
 static RestricterInfo *createRestricterInfo (Query *query, Index rtindex, PushdownInfo *input);
@@ -39,7 +38,6 @@ static RestricterInfo *createRestricterInfo (Query *query, Index rtindex, Pushdo
 /* rewriters that use logical equivalences or implications to rewrite an expression */
 static void rewriteExpandEquivalenceLists (PushdownInfo *pushdown, ExprHandlers *handlers);
 static void rewriteRemoveDups (PushdownInfo *pushdown, ExprHandlers *handlers);
-static void rewriteDeduceInequalities (PushdownInfo *pushdown, ExprHandlers *handlers);
 
 /* restriction rewriters */
 static void restrictSimpleSelection (PushdownInfo *input, PushdownInfo *output, RestricterInfo *restrInfo, ExprHandlers *handlers);
@@ -167,7 +165,6 @@ getRewriters ()
 
 	//result = lappend(result, rewriteExpandEquivalenceClasses);
 	result = lappend(result, rewriteRemoveDups);
-	//result = lappend(result, rewriteDeduceInequalities);
 
 	return result;
 }
@@ -249,50 +246,6 @@ static void rewriteRemoveDups (PushdownInfo *pushdown, ExprHandlers *handlers)
 	removeElems(&(pushdown->conjuncts), remove);
 }
 
-/*
- *	Deduce new inequalities and remove redundent ones. The work is done by the prov_restr_ineq.h methods.
- *		E.g. a < c1 AND b < c2 with c1 < c2. If E(a) = E(b) we can safely remove b < c2.
- */
-/*
- * Derive new inequalities from existing ones. The following rules are used:
- * 		E1 < E2 && E2 < E1 ->	false
- * 		E1 < E2 && E2 < c  -> E1 < c
- * 		E1 < c1 && E1 > c2 with c1 < c2  -> false
- * 		E1 < E1 -> false
- */
-
-static void
-rewriteDeduceInequalities (PushdownInfo *pushdown, ExprHandlers *handlers)
-{
-	InequalityGraph *graph;
-
-	/* build inequality-EC graph */
-	graph = computeInequalityGraph(pushdown);
-	/* compute transitive closure */
-	graph = computeTransitiveClosure(graph);
-
-	if (graph == NULL)
-	{
-		pushdown->contradiction = true;
-		return;
-	}
-
-	/* remove redundend edges and merge ECs */
-	graph = minimizeInEqualityGraph(pushdown, graph);
-
-	if (graph == NULL)
-	{
-		pushdown->contradiction = true;
-		return;
-	}
-
-	/* delete old inequalities and add new inequalities for edges */
-	generateInequalitiesFromGraph(pushdown, graph);
-}
-
-
-
-
 /*
  * ----------------------------------------------------------------------------------------
  *		Restrict rewriters:
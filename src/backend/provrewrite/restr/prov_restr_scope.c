@@ -255,7 +255,7 @@ createOneJoinScope (Query *query, Node *joinNode, SelScope *currentScope)
 	/* an inner join, add join to current scope */
 	if (join->jointype == JOIN_INNER)
 	{
-		addRtindexToScope(newScope, join->rtindex, true);
+		addRtindexToScope(currentScope, join->rtindex, true);
 		addQualToScope(currentScope, join->quals, join->rtindex);
 
 		/* create scopes for children of join node */
@@ -270,8 +270,9 @@ createOneJoinScope (Query *query, Node *joinNode, SelScope *currentScope)
 	 */
 	switch(join->jointype)
 	{
-	/* its a left outer join */
+	/* its a left outer join or an anti join */
 	case JOIN_LEFT:
+	case JOIN_ANTI:
 		createOuterScope(SCOPE_OUTERLEFT);
 
 		createChildScope (SCOPE_NULLABLE_OUTER,join->larg);
@@ -24,6 +24,8 @@
 #include "utils/lsyscache.h"
 
 #include "provrewrite/prov_restr_pushdown.h"
+#include "provrewrite/prov_sublink_util_analyze.h"
+#include "provrewrite/prov_sublink_util_search.h"
 #include "provrewrite/prov_util.h"
 #include "provrewrite/provrewrite.h"
 #include "provrewrite/prov_nodes.h"
@@ -33,7 +35,7 @@
 
 /* prototypes */
 static EquivalenceList *getEquivalenceList (List *equis, Node *expr);
-static bool mergeEquivalenceLists (List *equis, EquivalenceList *left, EquivalenceList *right);
+static bool mergeEquivalenceLists (List **equis, EquivalenceList *left, EquivalenceList *right);
 static bool createSelInfoWalker (Node *node, SelectionInfo *context);
 static bool createEquivalenceList (SelScope *scope, SelectionInfo *sel);
 static void addSelectionInfos (SelScope *scope, List *sels);
@@ -188,7 +190,7 @@ createEquivalenceList (SelScope *scope, SelectionInfo *sel)
 			{
 				if (!equal(equiLeft, equiRight))
 				{
-					contra = contra || mergeEquivalenceLists (scope->equiLists, equiLeft, equiRight);
+					contra = contra || mergeEquivalenceLists (&(scope->equiLists), equiLeft, equiRight);
 				}
 			}
 		}
@@ -210,7 +212,7 @@ createEquivalenceList (SelScope *scope, SelectionInfo *sel)
  */
 
 static bool
-mergeEquivalenceLists (List *equis, EquivalenceList *left, EquivalenceList *right)
+mergeEquivalenceLists (List **equis, EquivalenceList *left, EquivalenceList *right)
 {
 	EquivalenceList *merged;
 
@@ -222,13 +224,13 @@ mergeEquivalenceLists (List *equis, EquivalenceList *left, EquivalenceList *righ
 	merged->scope = left->scope;
 
 	/* compute consts */
-	if(!computeEquivalenceListConsts (merged))
+	if(computeEquivalenceListConsts (merged))
 		return true;
 
 	/* adapt list of equivalence lists */
-	equis = list_delete(equis, left);
-	equis = list_delete(equis, right);
-	equis = lappend(equis, merged);
+	*equis = list_delete_ptr(*equis, left);
+	*equis = list_delete_ptr(*equis, right);
+	*equis = lappend(*equis, merged);
 	//TODO additional stuff to do
 	return false;
 }
@@ -601,7 +603,7 @@ computeEquivalenceListsConsts (SelScope *scope)
 	{
 		equi = (EquivalenceList *) lfirst(lc);
 
-		if (!computeEquivalenceListConsts(equi))
+		if (computeEquivalenceListConsts(equi))
 			scope->contradiction = true;
 	}
 }
@@ -609,7 +611,7 @@ computeEquivalenceListsConsts (SelScope *scope)
 /*
  *	Generates a list with constants that are contained in an equivalence list. If there is one constant set this constant as
  *	the "constant" field of the equivalence list. If there is more than one constant check that all constants are the same.
- *	If this is the case keep just one of them. If return false to indicate a contradiction.
+ *	If this is the case keep just one of them. Return true to indicate a contradiction.
  */
 
 static bool
@@ -640,7 +642,7 @@ computeEquivalenceListConsts (EquivalenceList *equi)
 
 			/* not same value, return true to indicate contradiction */
 			if (!equal(constLeft, constRight))
-				return false;
+				return true;
 		}
 
 		/* remove additional copies of constant */
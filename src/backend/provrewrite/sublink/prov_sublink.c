@@ -36,12 +36,14 @@
 #include "provrewrite/provlog.h"
 #include "provrewrite/prov_sublink_unnest.h"
 #include "provrewrite/prov_sublink_unn.h"
+#include "provrewrite/prov_stats.h"
 
 #define MAX_SUBLINK 100
 
 /* prototypes */
 static Query *unnestAndDecorrelate (Query *query, Index subList[], List *infos, List **rewritePos);
 static void setSublinkPositions (List *infos);
+static void adaptWhereExprRoots (Query *query, List *infos, Node *origQual);
 
 /*
  * rewrites a query with sublinks
@@ -57,6 +59,9 @@ rewriteSublinks (Query *query, List **subList)
 	Index subPos[MAX_SUBLINK];
 	List *rewritePos;
 	int numSublinks;
+	instr_time unnestStart;
+	Node *origQual;
+	Index maxRtindex;
 
 	rewritePos = NIL;
 
@@ -66,8 +71,15 @@ rewriteSublinks (Query *query, List **subList)
 	numSublinks = list_length(sublinkInfos);
 	setSublinkPositions (sublinkInfos);
 
+	/* the RTEs added by unnesting are rewritten by the unnest strategies */
+	maxRtindex = list_length(query->rtable);
+
 	/* try to unnest and decorrelate sublinks */
+	origQual = prov_use_sublink_move_to_target ?
+			copyObject(query->jointree->quals) : NULL;
+	ProvStatsBegin(unnestStart);
 	unnestAndDecorrelate (query, subPos, sublinkInfos, &rewritePos);
+	provStatsEnd(PROV_PHASE_SUBLINK_UNNEST, &unnestStart);
 
 	/*
 	 * if we are processing an uncorrelated sublinks and the move to target list optimization is
@@ -83,7 +95,10 @@ rewriteSublinks (Query *query, List **subList)
 
 		/* if there are uncorrelated sublinks that have not been unnested use MOVE strategy */
 		if (uncorrSublinks != NIL)
-			return rewriteSublinkQueryWithMoveToTarget(query, sublinkInfos, uncorrSublinks, subPos, &rewritePos);
+		{
+			adaptWhereExprRoots(query, sublinkInfos, origQual);
+			return rewriteSublinkQueryWithMoveToTarget(query, sublinkInfos, uncorrSublinks, subPos, &rewritePos, maxRtindex);
+		}
 	}
 
 
@@ -105,6 +120,30 @@ rewriteSublinks (Query *query, List **subList)
 }
 
 
+/*
+ * The JA and EXISTS strategies replace an unnested sublink in the WHERE qual
+ * of query, but not in the copies of this qual stored as exprRoot of the other
+ * WHERE sublinks. The MOVE strategy builds the qual of the new top query from
+ * these copies, so replace them with the current qual. Otherwise the unnested
+ * sublinks would be evaluated a second time in the new top query.
+ */
+
+static void
+adaptWhereExprRoots (Query *query, List *infos, Node *origQual)
+{
+	ListCell *lc;
+	SublinkInfo *info;
+
+	foreach(lc, infos)
+	{
+		info = (SublinkInfo *) lfirst(lc);
+
+		if (!info->unnested && info->location == SUBLOC_WHERE
+				&& equal(info->rootCopy, origQual))
+			info->exprRoot = copyObject(query->jointree->quals);
+	}
+}
+
 /*
  *
  */
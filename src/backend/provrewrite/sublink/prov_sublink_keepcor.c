@@ -30,6 +30,7 @@
 #include "provrewrite/provlog.h"
 #include "provrewrite/provstack.h"
 #include "provrewrite/prov_util.h"
+#include "provrewrite/prov_spj.h"
 #include "provrewrite/prov_sublink_util_search.h"
 #include "provrewrite/prov_sublink_util_mutate.h"
 #include "provrewrite/prov_sublink_util_analyze.h"
@@ -453,7 +454,7 @@ generateBaseRelQuery (RangeTblEntry *rte, List *provAttrs)
 
 	/* get attributes of base relation and add a target entry for each base
 	 * relation attr */
-	expandRTEWithParam(rte, 1, 0, false, false, &vars, &baseRelAttrs);
+	expandProvBaseRelation(rte, 1, provUseTupleIds, &vars, &baseRelAttrs);
 
 	resno = 1;
 	forboth(varLc, baseRelAttrs, nameLc, vars)
@@ -501,7 +502,7 @@ generateNullQuery (RangeTblEntry *rte)
 
 	/* get attributes of base relation and add a null constant for each base
 	 * relation attr */
-	expandRTEWithParam(rte, 1, 0, false, false, &attrNames, &baseRelAttrs);
+	expandProvBaseRelation(rte, 1, provUseTupleIds, &attrNames, &baseRelAttrs);
 
 	resno = 1;
 	forboth(varLc, baseRelAttrs, nameLc, attrNames)
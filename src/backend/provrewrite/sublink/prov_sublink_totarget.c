@@ -58,7 +58,7 @@ static void adaptTestExpressions (List *sublinksAndAggs, List *map, List *sublin
 static Node *adaptTestExpressionMutator (Node *node, AdaptTestExpressionMutatorContext *context);
 
 
-static void rewriteTargetSublinks (Query *newTop, Query *query, List *uncorrelated, List *correlated, List *sublinks, Index subList[], List **rewritePos);
+static void rewriteTargetSublinks (Query *newTop, Query *query, List *uncorrelated, List *correlated, List *sublinks, Index subList[], List **rewritePos, Index maxRtindex);
 static List *rewriteNormalSubqueries (Query *query, List **subList, Index maxRTindex);
 static void addProvenanceAttrsToNewTop (Query *newTop, List *sublinks, List *corrPstack, List *uncorrPstack, Index subList[]);
 static void addProvenanceAttr (Query *query, TargetEntry *te, List **pList, Index rtindex, Index *resno);
@@ -68,7 +68,7 @@ static void addProvenanceAttr (Query *query, TargetEntry *te, List **pList, Inde
  */
 
 Query *
-rewriteSublinkQueryWithMoveToTarget (Query *query, List *sublinks, List *uncorrelated, Index subList[], List **rewritePos)
+rewriteSublinkQueryWithMoveToTarget (Query *query, List *sublinks, List *uncorrelated, Index subList[], List **rewritePos, Index maxRtindex)
 {
 	Query *newTop;
 	List *correlatedSublinks;
@@ -90,7 +90,7 @@ rewriteSublinkQueryWithMoveToTarget (Query *query, List *sublinks, List *uncorre
 	newTop = moveSublinksToTargetList (query, uncorrCondTrue, correlatedSublinks);
 
 	/* rewriteSublinks */
-	rewriteTargetSublinks(newTop, query, uncorrelated, correlatedSublinks, sublinks, subList, rewritePos);
+	rewriteTargetSublinks(newTop, query, uncorrelated, correlatedSublinks, sublinks, subList, rewritePos, maxRtindex);
 
 	return newTop;
 }
@@ -789,7 +789,7 @@ adaptTestExpressionMutator (Node *node, AdaptTestExpressionMutatorContext *conte
 
 static void
 rewriteTargetSublinks (Query *newTop, Query *query, List *uncorrelated, List *correlated,
-						List *sublinks, Index subPos[], List **rewritePos)
+						List *sublinks, Index subPos[], List **rewritePos, Index maxRtindex)
 {
 	ListCell *lc;
 	SublinkInfo *info;
@@ -799,7 +799,6 @@ rewriteTargetSublinks (Query *newTop, Query *query, List *uncorrelated, List *co
 	List *bothPstack;
 	List *topPstack;
 	List *subList;
-	Index maxRTindex;
 
 	belowPStack = NIL;
 	topPstack = NIL;
@@ -807,8 +806,6 @@ rewriteTargetSublinks (Query *newTop, Query *query, List *uncorrelated, List *co
 	subList = NIL;
 	belowSubList = NIL;
 
-	maxRTindex = list_length(query->rtable);	//TODO get from subPos
-
 	/* rewrite all sublinks (except unnested ones) */
 	foreach(lc, sublinks)
 	{
@@ -846,7 +843,7 @@ rewriteTargetSublinks (Query *newTop, Query *query, List *uncorrelated, List *co
 	}
 
 	/* rewrite the modified original query */
-	belowPList = rewriteNormalSubqueries(query, &belowSubList, maxRTindex);
+	belowPList = rewriteNormalSubqueries(query, &belowSubList, maxRtindex);
 
 	correctRTEAlias((RangeTblEntry *) linitial(newTop->rtable));
 
@@ -225,6 +225,7 @@ inOuterJoin (SublinkInfo *info, Query *query)
 
 	joinExpr = (JoinExpr *) (*join);
 	return (joinExpr->jointype == JOIN_LEFT
+			|| joinExpr->jointype == JOIN_ANTI
 			|| joinExpr->jointype == JOIN_RIGHT
 			|| joinExpr->jointype == JOIN_FULL);
 }
@@ -36,6 +36,7 @@
 #include "provrewrite/prov_sublink_unnest.h"
 #include "provrewrite/provrewrite.h"
 #include "provrewrite/provstack.h"
+#include "utils/guc.h"
 
 /* prototypes */
 static bool checkCorrVarsInEqualityWhere (SublinkInfo *info);
@@ -348,6 +349,7 @@ rewriteNotToLeftJoin(Query *query, SublinkInfo *info, Index subList[],
 	Node *corrPred;
 	NullTest *nullTest;
 	TargetEntry *te;
+	Node *notReplacement;
 
 	/* rewrite the sublink query */
 	if (rewriteNeedsInject(info))
@@ -383,8 +385,12 @@ rewriteNotToLeftJoin(Query *query, SublinkInfo *info, Index subList[],
 	rtRef = makeNode(RangeTblRef);
 	rtRef->rtindex = sublinkIndex;
 
-	/* create left join with original query */
-	joinExpr = createJoinExpr(query, JOIN_LEFT);
+	/*
+	 * create left join with original query. If prov_use_anti_join is
+	 * activated, use an anti join instead, which only returns the tuples of
+	 * the original query that have no join partner.
+	 */
+	joinExpr = createJoinExpr(query, prov_use_anti_join ? JOIN_ANTI : JOIN_LEFT);
 	joinExpr->larg = (Node *) linitial(query->jointree->fromlist);
 	joinExpr->rarg = (Node *) copyObject(rtRef);
 	joinExpr->quals = corrPred;
@@ -392,17 +398,26 @@ rewriteNotToLeftJoin(Query *query, SublinkInfo *info, Index subList[],
 	query->jointree->fromlist = list_make1(joinExpr);//CHECK ok to add as top level join
 	recreateJoinRTEs(query);
 
-	/* add is null predicate */
-	te = (TargetEntry *) linitial((info->rewrittenSublinkQuery->targetList));
+	/*
+	 * For an anti join the NOT is already enforced by the join, so it is
+	 * replaced by true. Otherwise add an is null predicate.
+	 */
+	if (prov_use_anti_join)
+		notReplacement = makeBoolConst(true, false);
+	else
+	{
+		te = (TargetEntry *) linitial((info->rewrittenSublinkQuery->targetList));
 
-	nullTest = makeNode(NullTest);
-	nullTest->nulltesttype = IS_NULL;
-	nullTest->arg = (Expr *) makeVar(sublinkIndex, 1, exprType(
-			(Node *) te->expr), exprTypmod((Node *) te->expr), 0);
+		nullTest = makeNode(NullTest);
+		nullTest->nulltesttype = IS_NULL;
+		nullTest->arg = (Expr *) makeVar(sublinkIndex, 1, exprType(
+				(Node *) te->expr), exprTypmod((Node *) te->expr), 0);
+		notReplacement = (Node *) nullTest;
+	}
 
 	query->jointree = (FromExpr *) replaceSubExpression(
 			(Node *) query->jointree, list_make1(info->parent),
-			list_make1((Node *) nullTest), REPLACE_SUB_EXPR_QUERY);
+			list_make1(notReplacement), REPLACE_SUB_EXPR_QUERY);
 
 	return rtRef;
 }
@@ -751,6 +766,7 @@ checkInjectNeedsOnlyCorrelatedRTEs(Query *query, SublinkInfo *info) //TODO less
 				switch (rte->jointype)
 				{
 				case JOIN_LEFT:
+				case JOIN_ANTI:
 					if (lfirst_int(pathLc) == JCHILD_RIGHT)
 						return false;
 					break;
@@ -1119,16 +1135,16 @@ createCorrelationPredicates(SublinkInfo *info, List *corrVarPos,
 {
 	ListCell *lc;
 	ListCell *innerLc;
+	ListCell *posLc;
 	CorrVarInfo *corrVarInfo;
 	Node *predicate;
 	List *predicates;
 	Var *var;
 	Var *corrVar;
-	int i;
 
 	predicates = NIL;
 
-	i = 0;
+	posLc = list_head(corrVarPos);
 	foreach(lc, info->corrVarInfos)
 	{
 		corrVarInfo = (CorrVarInfo *) lfirst(lc);
@@ -1137,7 +1153,7 @@ createCorrelationPredicates(SublinkInfo *info, List *corrVarPos,
 		{
 			var = (Var *) lfirst(innerLc);
 			var = copyObject(var);
-			var->varattno = list_nth_int(corrVarPos, i);
+			var->varattno = lfirst_int(posLc);
 			var->varno = rangeTblPos;
 
 			corrVar = copyObject(corrVarInfo->corrVar);
@@ -1146,7 +1162,7 @@ createCorrelationPredicates(SublinkInfo *info, List *corrVarPos,
 			predicate = createEqualityConditionForVars(var, corrVar);
 
 			predicates = lappend(predicates, predicate);
-			i++;
+			posLc = lnext(posLc);
 		}
 	}
 
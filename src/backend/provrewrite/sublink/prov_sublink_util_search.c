@@ -316,6 +316,8 @@ findSublevelsUpVarWalker(Node *node, GetCorrelatedVarsWalkerContext *context)
 	newContext->exprRoot = context->exprRoot;
 	newContext->location = context->location;
 	newContext->parent = node;
+	newContext->belowAgg = context->belowAgg;
+	newContext->belowSet = context->belowSet;
 	newContext->realLevelsUp = list_copy(context->realLevelsUp);
 
 	// check for var nodes with sublevelsup
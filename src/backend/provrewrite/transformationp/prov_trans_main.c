@@ -35,6 +35,7 @@
 #include "provrewrite/prov_trans_bitset.h"
 #include "provrewrite/prov_util.h"
 #include "provrewrite/provstack.h"
+#include "provrewrite/prov_stats.h"
 
 
 /* methods */
@@ -57,6 +58,7 @@ rewriteQueryTransProv (Query *query, char *cursorName)
 {
 	int queryId;
 	ContributionType type;
+	instr_time indexStart;
 
 	type = ContributionType(query);
 	/* create ids for parts of the query and determine if parts
@@ -64,12 +66,14 @@ rewriteQueryTransProv (Query *query, char *cursorName)
 	 */
 	analyseStaticTransProv(query);
 
+	ProvStatsBegin(indexStart);
 	if(type == CONTR_TRANS_SQL)
 		queryId = generateTransProvQueryIndex(query, cursorName);
 	if(type == CONTR_TRANS_XML || type == CONTR_TRANS_XML_SIMPLE)
 		queryId = generateTransXmlQueryIndex(query, cursorName);
 	if(type == CONTR_MAP)
 		queryId = generateMapQueryIndex(query, cursorName);
+	provStatsEnd(PROV_PHASE_TRANS_INDEX, &indexStart);
 
 	/* rewrite query for transformation provenance computation */
 	query = rewriteQueryNodeTrans (query, NULL, NULL);
@@ -28,6 +28,9 @@ const char TransProvName[] = "trans_prov";
 static List *relRefCount;
 static List *queryRefCount;
 
+/* provenance attributes of each base relation access of the current rewrite (ProvAttrAccess) */
+static List *provAttrAccesses;
+
 /*
  *
  */
@@ -42,10 +45,37 @@ char *
 createProvAttrName (RangeTblEntry *rte, char *name)
 {
 	char *attrName;
-	char *provRelName;
+	char *relPrefix;
 	char *escapedName;
 	int newLength;
 
+	relPrefix = createProvAttrRelPrefix (rte);
+	escapedName = escapeAttrName (name);
+
+	newLength = strlen(relPrefix) + strlen(escapedName) + 2;
+	attrName = (char *) palloc (newLength);
+
+	attrName = strcpy(attrName, relPrefix);
+	attrName = strcat(attrName, "_");
+	attrName = strcat(attrName, escapedName);
+
+	pfree(relPrefix);
+	pfree(escapedName);
+
+	return attrName;
+}
+
+/*
+ * Creates the part of the provenance attribute names of a base relation access that identifies the access
+ * (ProvPraefix + relation name), e.g., prov_public_r_1 for the second access of relation r.
+ */
+
+char *
+createProvAttrRelPrefix (RangeTblEntry *rte)
+{
+	char *result;
+	char *provRelName;
+
 	if (rte->rtekind == RTE_RELATION)
 		provRelName = getRelationName (rte->relid);
 	else if (rte->rtekind == RTE_SUBQUERY)
@@ -55,20 +85,13 @@ createProvAttrName (RangeTblEntry *rte, char *name)
 		//TODO error
 	}
 
-	escapedName = escapeAttrName (name);
-
-	newLength = strlen(ProvPraefix) + strlen(provRelName) + strlen(escapedName) + 2;
-	attrName = (char *) palloc (newLength);
-
-	attrName = strcpy(attrName, ProvPraefix);
-	attrName = strcat(attrName, provRelName);
-	attrName = strcat(attrName, "_");
-	attrName = strcat(attrName, escapedName);
+	result = (char *) palloc (strlen(ProvPraefix) + strlen(provRelName) + 1);
+	result = strcpy(result, ProvPraefix);
+	result = strcat(result, provRelName);
 
 	pfree(provRelName);
-	pfree(escapedName);
 
-	return attrName;
+	return result;
 }
 
 /*
@@ -332,6 +355,60 @@ resetRelReferences (void)
 {
 	relRefCount = NIL;
 	queryRefCount = NIL;
+	provAttrAccesses = NIL;
+}
+
+/*
+ * Starts a new base relation access of the current rewrite whose provenance attributes are added with
+ * addProvAttrAccessAttr. The access is identified by accessName in the normalized provenance output.
+ */
+
+ProvAttrAccess *
+addProvAttrAccess (char *accessName)
+{
+	ProvAttrAccess *access;
+
+	access = (ProvAttrAccess *) palloc(sizeof(ProvAttrAccess));
+	access->accessName = pstrdup(accessName);
+	access->attrNames = NIL;
+
+	provAttrAccesses = lappend(provAttrAccesses, access);
+
+	return access;
+}
+
+/*
+ * Remembers that the provenance attribute attrName belongs to access.
+ */
+
+void
+addProvAttrAccessAttr (ProvAttrAccess *access, char *attrName)
+{
+	access->attrNames = lappend(access->attrNames, pstrdup(attrName));
+}
+
+/*
+ * Returns the base relation access of the current rewrite that produced the provenance attribute name or NULL
+ * if no access produced it.
+ */
+
+ProvAttrAccess *
+getProvAttrAccess (char *name)
+{
+	ProvAttrAccess *access;
+	ListCell *lc;
+	ListCell *nameLc;
+
+	foreach(lc, provAttrAccesses)
+	{
+		access = (ProvAttrAccess *) lfirst(lc);
+
+		foreach(nameLc, access->attrNames)
+			if (strcmp((char *) lfirst(nameLc), name) == 0)
+				return access;
+	}
+
+	return NULL;
 }
 
 /*
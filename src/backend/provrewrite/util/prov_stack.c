@@ -35,6 +35,11 @@ List *rewriteMethodStack;
 
 /* prototypes */
 static ListCell *popNthCell (List ** list, int n);
+static void **listToArray (List *list);
+static void mergeSortElems (void **elems, void **temp, int n,
+		int (*compare) (void *left, void *right), int factor);
+static int compareIntsIncreasing (const void *left, const void *right);
+static int compareIntsDecreasing (const void *left, const void *right);
 
 
 /*
@@ -235,6 +240,7 @@ List *
 getListAndReverse (List *stack, int numElem)
 {
 	List* result;
+	ListCell *lc;
 	int i;
 
 	Assert(list_length(stack) >= numElem);
@@ -242,9 +248,11 @@ getListAndReverse (List *stack, int numElem)
 	LOGDEBUG("gLaR    -- START");
 
 	result = NIL;
-	for (i = 0; i < numElem; i++)
+	foreachi(lc, i, stack)
 	{
-		result = lcons(list_nth(stack,i),result);
+		if (i == numElem)
+			break;
+		result = lcons(lfirst(lc),result);
 	}
 
 	logPList(result);
@@ -325,28 +333,11 @@ popAllInListAndReverse (List **stack, List *elements)
 List *
 popAllInList (List **stack, List *elements)
 {
-	ListCell *lc;
 	List *result;
-	List *remove;
-	int curElem;
-
-	result = NIL;
-
-	/* first build up result and then remove elements */
-	foreach(lc, elements)
-	{
-		curElem = lfirst_int(lc);
-		result = lappend(result, list_nth(*stack, curElem));
-	}
-
-	remove = copyObject(elements);
-	sortIntList(&remove, false);
 
-	foreach(lc, remove)
-	{
-		curElem = lfirst_int(lc);
-		popNth(stack, curElem);
-	}
+	/* first build up result and then remove elements in one pass */
+	result = getAllInList(*stack, elements);
+	removeElems(stack, list_copy(elements));
 
 	return result;
 }
@@ -359,16 +350,23 @@ getAllInList (List *list, List *elements)
 {
 	ListCell *lc;
 	List *result;
-	int element;
+	void **elems;
+
+	if (elements == NIL)
+		return NIL;
 
+	/* use an array to avoid walking the list once for each element */
+	elems = listToArray(list);
 	result = NIL;
 
 	foreach(lc, elements)
 	{
-		element = lfirst_int(lc);
-		result = lappend(result, list_nth(list, element));
+		Assert(lfirst_int(lc) >= 0 && lfirst_int(lc) < list_length(list));
+		result = lappend(result, elems[lfirst_int(lc)]);
 	}
 
+	pfree(elems);
+
 	return result;
 }
 
@@ -395,21 +393,9 @@ pop (List **list)
 void *
 deQueue (List **list)
 {
-	void *lastElem;
-	ListCell *lc;
-
 	Assert(*list != NIL);
 
-	lastElem = lfirst((*list)->tail);
-
-	/* find element before last element */
-	for(lc = (*list)->head; lc->next != NULL; lc = lc->next);
-
-	/* remove last element */
-	(*list)->tail = lc;
-	lc->next = NULL;
-
-	return lastElem;
+	return popNth(list, list_length(*list) - 1);
 }
 
 /*
@@ -462,7 +448,7 @@ popNthCell (List ** list, int n)
 		{
 			*list = NIL;
 		}
-		return lc->data.ptr_value;
+		return lc;
 	}
 	/* not head find nth element */
 	while (n > 1)
@@ -516,6 +502,10 @@ insert (List **list, void *newElem, int afterPos)
 	newCell->next = lc->next;
 	lc->next = newCell;
 
+	if ((*list)->tail == lc)
+		(*list)->tail = newCell;
+	(*list)->length++;
+
 	return *list;
 }
 
@@ -541,73 +531,135 @@ replaceNth (List *list, void *newElem, int pos)
  */
 
 List *
-sortIntList (List **list, bool increasing)	//OPTIMIZE use more efficient sort method instead of bubble sort
+sortIntList (List **list, bool increasing)
 {
 	ListCell *lc;
-	int i, j, sortTemp;
-	bool switchElems;
+	int *elems;
+	int i, len;
 
-	for (i = 0; i < list_length(*list); i++)
-	{
-		lc = (*list)->head;
-		for (j = 0; j < list_length(*list) - 1; j++)
-		{
-			if (increasing)
-			{
-				switchElems = lfirst_int(lc) > lfirst_int(lc->next);
-			}
-			else
-			{
-				switchElems = lfirst_int(lc) < lfirst_int(lc->next);
-			}
-
-			if (switchElems)
-			{
-				sortTemp = lfirst_int(lc);
-				lfirst_int(lc) = lfirst_int(lc->next);
-				lfirst_int(lc->next) = sortTemp;
-			}
-			lc = lc->next;
-		}
-	}
+	len = list_length(*list);
+	if (len < 2)
+		return *list;
+
+	elems = (int *) palloc(len * sizeof(int));
+	foreachi(lc, i, *list)
+		elems[i] = lfirst_int(lc);
+
+	qsort(elems, len, sizeof(int),
+			increasing ? compareIntsIncreasing : compareIntsDecreasing);
+
+	foreachi(lc, i, *list)
+		lfirst_int(lc) = elems[i];
+
+	pfree(elems);
 
 	return *list;
 }
 
+static int
+compareIntsIncreasing (const void *left, const void *right)
+{
+	int l = *((const int *) left);
+	int r = *((const int *) right);
+
+	if (l < r)
+		return -1;
+	if (l > r)
+		return 1;
+	return 0;
+}
+
+static int
+compareIntsDecreasing (const void *left, const void *right)
+{
+	return compareIntsIncreasing(right, left);
+}
+
 /*
- * sorts a pointer list using the provided comparison function to compare the list elements.
+ * sorts a pointer list using the provided comparison function to compare the list elements. The sort is stable, elements
+ * that compare equal keep their relative order (e.g., target entries with the same ressortgroupref).
  */
 
 List *
 sortList (List **list, int (*compare) (void *left, void *right), bool increasing)
 {
 	ListCell *lc;
-	int i,j;
-	void *sortTemp;
-	int comparison, factor;
+	void **elems;
+	void **temp;
+	int i, len;
+
+	len = list_length(*list);
+	if (len < 2)
+		return *list;
 
-	factor = increasing ? 1 : -1;
+	elems = listToArray(*list);
+	temp = (void **) palloc(len * sizeof(void *));
 
-	for (i = 0; i < list_length(*list); i++)
-	{
-		lc = (*list)->head;
+	mergeSortElems(elems, temp, len, compare, increasing ? 1 : -1);
 
-		for(j = 0; j < list_length(*list) - 1; j++)
-		{
-			comparison = compare (lfirst(lc), lfirst(lc->next)) * factor;
+	foreachi(lc, i, *list)
+		lfirst(lc) = elems[i];
 
-			if (comparison == 1)
-			{
-				sortTemp = lfirst(lc);
-				lfirst(lc) = lfirst(lc->next);
-				lfirst(lc->next) = sortTemp;
-			}
+	pfree(elems);
+	pfree(temp);
 
-			lc = lc->next;
-		}
+	return *list;
+}
+
+/*
+ * Stable merge sort of an array of n pointers. Temp has to provide space for n pointers.
+ */
+
+static void
+mergeSortElems (void **elems, void **temp, int n,
+		int (*compare) (void *left, void *right), int factor)
+{
+	int half, l, r, i;
+
+	if (n < 2)
+		return;
+
+	half = n / 2;
+	mergeSortElems(elems, temp, half, compare, factor);
+	mergeSortElems(elems + half, temp, n - half, compare, factor);
+
+	/* left half is already smaller than the right half */
+	if (compare(elems[half - 1], elems[half]) * factor <= 0)
+		return;
+
+	memcpy(temp, elems, n * sizeof(void *));
+
+	for (l = 0, r = half, i = 0; l < half && r < n; i++)
+	{
+		if (compare(temp[l], temp[r]) * factor <= 0)
+			elems[i] = temp[l++];
+		else
+			elems[i] = temp[r++];
 	}
 
-	return *list;
+	while (l < half)
+		elems[i++] = temp[l++];
+	while (r < n)
+		elems[i++] = temp[r++];
+}
+
+/*
+ * Returns the elements of a pointer list as a palloc'd array.
+ */
+
+static void **
+listToArray (List *list)
+{
+	ListCell *lc;
+	void **result;
+	int i;
+
+	result = (void **) palloc((list_length(list) + 1) * sizeof(void *));
+
+	foreachi(lc, i, list)
+		result[i] = lfirst(lc);
+
+	return result;
 }
 
 /*
@@ -682,7 +734,7 @@ reverseList (List *list)
 
 	result = NIL;
 
-	foreach(lc, result)
+	foreach(lc, list)
 	{
 		result = lcons(lfirst(lc), result);
 	}
@@ -778,7 +830,8 @@ addUsedMethod (char *method)
 }
 
 /*
- * Removes the elements from list specified as position in list "pos".
+ * Removes the elements from list specified as position in list "pos". The positions are sorted in place and may
+ * contain duplicates. The list is only walked once.
  */
 
 List *
@@ -794,28 +847,40 @@ removeElems (List **list, List *pos)
 		return *list;
 
 	/* sort ascending */
-	pos = sortIntList(&pos, false);
+	pos = sortIntList(&pos, true);
 	posLc = pos->head;
 	before = NULL;
+	lc = (*list)->head;
 
 	/* walk trough list, keeping track of current position, and remove any cell at a position from pos */
-	foreachi(lc, i, *list)
+	for (i = 0; lc != NULL && posLc != NULL; i++)
 	{
-		if (i == lfirst_int(posLc))	//TODO free cell
+		ListCell *next = lc->next;
+
+		if (i == lfirst_int(posLc))
 		{
 			if (before != NULL)
-				before->next = lc->next;
+				before->next = next;
 			else
-				(*list)->head = lc->next;
+				(*list)->head = next;
 
-			posLc = posLc->next;
-			if (posLc != NULL)
-				break;
+			if ((*list)->tail == lc)
+				(*list)->tail = before;
+			(*list)->length--;
+
+			/* skip duplicate positions */
+			while (posLc != NULL && lfirst_int(posLc) <= i)
+				posLc = posLc->next;
 		}
+		else
+			before = lc;
 
-		before = lc;
+		lc = next;
 	}
 
+	if ((*list)->length == 0)
+		*list = NIL;
+
 	return *list;
 }
 
@@ -843,6 +908,10 @@ removeNodeElem (List *list, Node *node)
 			else
 				list->head = lc->next;
 
+			if (list->tail == lc)
+				list->tail = before;
+			list->length--;
+
 			return;
 		}
 
@@ -874,6 +943,10 @@ removeNodeForPred (List *list, bool (*predicate) (Node *node, void *context), vo
 			else
 				list->head = lc->next;
 
+			if (list->tail == lc)
+				list->tail = before;
+			list->length--;
+
 			return;
 		}
 
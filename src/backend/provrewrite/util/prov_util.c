@@ -18,6 +18,7 @@
 #include "postgres.h"
 #include "access/heapam.h"
 #include "catalog/pg_operator.h"		// pg_operator system table for operator lookup
+#include "catalog/pg_type.h"
 #include "nodes/makefuncs.h"
 #include "parser/parsetree.h"			// rt_fetch
 #include "parser/parse_expr.h"
@@ -33,6 +34,7 @@
 #include "provrewrite/provrewrite.h"
 #include "provrewrite/prov_util.h"
 #include "provrewrite/prov_nodes.h"
+#include "provrewrite/prov_lineage.h"
 
 
 
@@ -54,6 +56,7 @@ static bool queryHasRewriteChildrenWalker (Node *node, bool *context);
 static Node *getJoinTreeNodeWalker (Node *node, Index rtindex);
 static Node *getCastedVarOrConst (Node *node);
 static bool containsOuterJoins (Node *join);
+static bool isOnNullableSide (Query *query, Index rtindex);
 static bool correctSublinkAliasWalker (Node *node, void *context);
 
 /*
@@ -117,6 +120,7 @@ addProvenanceAttrs (Query *query, List *subList, List *pList)
 	Expr *expr;
 	Index curSubquery;
 	AttrNumber curResno;
+	List *provVars;			/* Vars of the new TEs for the current pSet */
 
 	targetList = query->targetList;
 	curResno = list_length(query->targetList) + 1;
@@ -131,6 +135,7 @@ addProvenanceAttrs (Query *query, List *subList, List *pList)
 		/* pull next pSet from pStack */
 		curPSet = (List *) pop (&subPStack);
 		logPList(curPSet);
+		provVars = NIL;
 
 		/* add each element of pSet to targetList and pList */
 		foreach (pTeLc, curPSet)
@@ -139,14 +144,12 @@ addProvenanceAttrs (Query *query, List *subList, List *pList)
 
 			/* create new TE */
 			expr = (Expr *) makeVar (curSubquery,
-						te->resno,
+						getProvAttrAttno(query, curSubquery, te),
 						exprType ((Node *) te->expr),
 						exprTypmod ((Node *) te->expr),
 						0);
 			newTe = makeTargetEntry(expr, curResno, te->resname, false);
-
-			/* adapt varno und varattno if referenced rte is used in a join-RTE */
-			getRTindexForProvTE (query, (Var *) expr);
+			provVars = lappend (provVars, expr);
 
 			/* append to targetList and pList */
 			targetList = lappend (targetList, newTe);
@@ -156,6 +159,9 @@ addProvenanceAttrs (Query *query, List *subList, List *pList)
 			curResno++;
 		}
 
+		/* adapt varno und varattno if referenced rte is used in a join-RTE */
+		getRTindexForProvTEs (query, provVars);
+
 	}
 
 	/* replace old targetList of query */
@@ -310,63 +316,108 @@ correctRTEAlias (RangeTblEntry *rte)
 
 void
 getRTindexForProvTE (Query *query, Var* var)
+{
+	getRTindexForProvTEs (query, list_make1(var));
+}
+
+/*
+ * Adapt a list of provenance attribute vars that all reference the same RTE
+ * (see getRTindexForProvTE). The join-RTEs the RTE is used in are searched
+ * only once and the joinaliasvars of each join-RTE are scanned only once for
+ * all vars.
+ */
+
+void
+getRTindexForProvTEs (Query *query, List *vars)
 {
 	List *from;
 	ListCell *lc;
 	ListCell *aliasLc;
+	ListCell *varLc;
 	JoinExpr *joinExpr;
 	Index newRtindex;
-	Index rtindex;
+	Index varno;
 	AttrNumber newAttrNumber;
-	AttrNumber foundAttrNum;
+	AttrNumber maxAttrNum;
+	AttrNumber *attrMap;
+	int offset;
 	RangeTblEntry *rte;
+	Var *var;
 	Var *joinVar;
 	List *joinRTElist;
 
+	if (vars == NIL)
+		return;
+
 	from = query->jointree->fromlist;
-	rtindex = var->varno;
+	varno = ((Var *) linitial(vars))->varno;
 	joinRTElist = NIL;
 
-
-	/* search in all from items for a reference to the RTE of var */
+	/* search in all from items for a reference to the RTE of the vars */
 	foreach(lc, from)
 	{
 		if (IsA(lfirst(lc), JoinExpr))
 		{
 			joinExpr = (JoinExpr *) lfirst(lc);
-			if (findRTindexInJoin (rtindex, joinExpr, &joinRTElist, NULL))
+			if (findRTindexInJoin (varno, joinExpr, &joinRTElist, NULL))
 				break;
 		}
 	}
 
-	ereport (DEBUG1,
-			(errcode(ERRCODE_DIVISION_BY_ZERO),
-					errmsg("joinlistlength: %i", list_length(joinRTElist))));
-
 	/*
 	 * resolve the RT indirections induced by join operations.
-	 * for each join-RTE adapt var to point to the join-RTE.
+	 * for each join-RTE adapt the vars to point to the join-RTE.
 	 * Start with the original RTE at the bottom of the jointree.
 	 */
+	offset = -FirstLowInvalidHeapAttributeNumber;
+
 	foreach(lc,joinRTElist)
 	{
 		newRtindex = lfirst_int(lc);
 		rte = rt_fetch(newRtindex, query->rtable);
 
+		/*
+		 * map the attribute numbers of the RTE to their position in the
+		 * join-RTE. If an attribute is used more than once (provenance
+		 * attributes of base relations duplicate its attributes), the last
+		 * position is used.
+		 */
+		maxAttrNum = 0;
+		foreach (aliasLc, rte->joinaliasvars)
+		{
+			joinVar = (Var *) lfirst(aliasLc);
+			if (IsA(joinVar, Var) && joinVar->varno == varno)
+				maxAttrNum = Max(maxAttrNum, joinVar->varattno);
+		}
+
+		attrMap = (AttrNumber *) palloc0((maxAttrNum + offset + 1)
+				* sizeof(AttrNumber));
+
 		newAttrNumber = 1;
 		foreach (aliasLc, rte->joinaliasvars)
 		{
 			joinVar = (Var *) lfirst(aliasLc);
-			if ((joinVar->varno == var->varno)
-					&& (joinVar->varattno == var->varattno))
-			{
-				foundAttrNum = newAttrNumber;
-			}
+			if (IsA(joinVar, Var) && joinVar->varno == varno)
+				attrMap[joinVar->varattno + offset] = newAttrNumber;
 			newAttrNumber++;
 		}
 
-		var->varno = newRtindex;
-		var->varattno = foundAttrNum;
+		foreach(varLc, vars)
+		{
+			var = (Var *) lfirst(varLc);
+
+			if (var->varattno > maxAttrNum
+					|| attrMap[var->varattno + offset] == 0)
+				elog(ERROR, "provenance attribute %d of range table entry %u "
+						"is not used in join range table entry %u",
+						var->varattno, varno, newRtindex);
+
+			var->varno = newRtindex;
+			var->varattno = attrMap[var->varattno + offset];
+		}
+
+		pfree(attrMap);
+		varno = newRtindex;
 	}
 }
 
@@ -731,6 +782,16 @@ createBiggerCondition (Node *left, Node *right)
 	return createComparison(left,right, COMP_BIGGER);
 }
 
+/*
+ * Creates a biggerEqThan condition for two nodes.
+ */
+
+Node *
+createBiggerEqCondition (Node *left, Node *right)
+{
+	return createComparison(left, right, COMP_BIGGEREQ);
+}
+
 /*
  * Create an comparison condition.
  */
@@ -1158,7 +1219,8 @@ createJoinExpr (Query *query, JoinType joinType)
  * Joins two range table entries of a query on the attributes provide as
  * position list leftAttrs and RightAttrs. If parameter userNotDistinct is
  * true NOT DISTINCT conditions are used to compare the attributes. Otherwise
- * simple equality is used.
+ * simple equality is used. Attributes of a left subquery that can never be
+ * NULL are always compared with equality (see isNotNullExpr).
  */
 //TODO currently only for subquery rtes!
 JoinExpr *
@@ -1170,12 +1232,16 @@ createJoinOnAttrs (Query *query, JoinType joinType, Index leftRT,
 	Var *leftVar;
 	Var *rightVar;
 	RangeTblRef *rtRef;
+	RangeTblEntry *leftRte;
+	TargetEntry *leftTe;
 	ListCell *leftLc;
 	ListCell *rightLc;
 	List *leftVars;
 	List *rightVars;
+	bool attrNotDistinct;
 
 	comparisons = NIL;
+	leftRte = rt_fetch(leftRT, query->rtable);
 
 	/* create join node */
 	join = createJoinExpr(query, joinType);
@@ -1199,9 +1265,22 @@ createJoinOnAttrs (Query *query, JoinType joinType, Index leftRT,
 	{
 		leftVar = (Var *) lfirst(leftLc);
 		rightVar = (Var *) lfirst(rightLc);
+		attrNotDistinct = useNotDistinct;
 
-		comparisons = lappend(comparisons,
-				createNotDistinctConditionForVars(leftVar, rightVar));
+		if (attrNotDistinct && leftRte->rtekind == RTE_SUBQUERY)
+		{
+			leftTe = get_tle_by_resno(leftRte->subquery->targetList,
+					leftVar->varattno);
+			if (leftTe && isNotNullExpr(leftRte->subquery, (Node *) leftTe->expr))
+				attrNotDistinct = false;
+		}
+
+		if (attrNotDistinct)
+			comparisons = lappend(comparisons,
+					createNotDistinctConditionForVars(leftVar, rightVar));
+		else
+			comparisons = lappend(comparisons,
+					createEqualityConditionForVars(leftVar, rightVar));
 	}
 
 	join->quals = (Node *) makeBoolExpr(AND_EXPR,comparisons);
@@ -1674,6 +1753,67 @@ generateQueryFromBaseRelation (RangeTblEntry *rte)
 	return result;
 }
 
+/*
+ * Creates names and Vars for the attributes of a base relation RTE that are
+ * used as provenance attributes. Normally these are all attributes of the
+ * relation. For TUPLEID provenance (tupleIds is true) a base relation is
+ * represented by a single attribute that identifies its tuples: the oid if the
+ * relation has oids and the ctid otherwise (or when capturing lineage, see
+ * prov_lineage.c). RTEs that are not relations (e.g.
+ * subqueries marked as BASERELATION) have no tuple identifiers and are always
+ * expanded to all their attributes.
+ */
+
+void
+expandProvBaseRelation (RangeTblEntry *rte, int rtindex, bool tupleIds,
+		List **colnames, List **colvars)
+{
+	Relation rel;
+	bool hasOids;
+	Var *var;
+
+	if (!tupleIds || rte->rtekind != RTE_RELATION)
+	{
+		expandRTEWithParam(rte, rtindex, 0, false, false, colnames, colvars);
+		return;
+	}
+
+	/* lineage capture always records ctids */
+	rel = relation_open(rte->relid, AccessShareLock);
+	hasOids = rel->rd_rel->relhasoids && !provLineageCapture;
+	relation_close(rel, AccessShareLock);
+
+	if (hasOids)
+		var = makeVar(rtindex, ObjectIdAttributeNumber, OIDOID, -1, 0);
+	else
+		var = makeVar(rtindex, SelfItemPointerAttributeNumber, TIDOID, -1, 0);
+
+	if (colnames)
+		*colnames = list_make1(makeString(pstrdup(hasOids ? "oid" : "ctid")));
+	if (colvars)
+		*colvars = list_make1(var);
+}
+
+/*
+ * Returns the attribute number of the RTE with index rtindex that provides
+ * the provenance attribute te. For a base relation te->expr is the Var of the
+ * relation attribute (or its tuple identifier system attribute); for all other
+ * RTEs te is an entry of the target list of the RTE's subquery.
+ */
+
+AttrNumber
+getProvAttrAttno (Query *query, Index rtindex, TargetEntry *te)
+{
+	RangeTblEntry *rte;
+
+	rte = rt_fetch(rtindex, query->rtable);
+
+	if (rte->rtekind == RTE_RELATION)
+		return ((Var *) te->expr)->varattno;
+
+	return te->resno;
+}
+
 /*
  *
  */
@@ -1960,6 +2100,7 @@ containsOuterJoins (Node *node)
 	case JOIN_LEFT:
 	case JOIN_RIGHT:
 	case JOIN_FULL:
+	case JOIN_ANTI:
 		return true;
 	default:
 		break;
@@ -1974,6 +2115,119 @@ containsOuterJoins (Node *node)
 	return false;
 }
 
+/*
+ * Returns true if expression expr of query can never be NULL. This is the case
+ * for an attribute of a base relation with a NOT NULL constraint that is not
+ * accessed on the nullable side of an outer join and for such an attribute of
+ * a subquery. Attributes that are never NULL can be compared with equality
+ * instead of IS NOT DISTINCT FROM, which lets the planner use them as merge,
+ * hash and index conditions.
+ */
+
+bool
+isNotNullExpr (Query *query, Node *expr)
+{
+	Var *var;
+	RangeTblEntry *rte;
+	TargetEntry *te;
+	HeapTuple tp;
+	bool result;
+
+	if (!IsA(expr, Var))
+		return false;
+
+	var = (Var *) expr;
+	if (var->varlevelsup != 0 || var->varattno == InvalidAttrNumber)
+		return false;
+
+	rte = rt_fetch(var->varno, query->rtable);
+
+	/* join alias vars are checked on the attribute they stand for */
+	if (rte->rtekind == RTE_JOIN)
+		return var->varattno > 0 && isNotNullExpr(query,
+				(Node *) list_nth(rte->joinaliasvars, var->varattno - 1));
+
+	if (isOnNullableSide(query, var->varno))
+		return false;
+
+	switch (rte->rtekind)
+	{
+		case RTE_RELATION:
+			/* system attributes are never NULL */
+			if (var->varattno < 0)
+				return true;
+
+			tp = SearchSysCache(ATTNUM,
+						ObjectIdGetDatum(rte->relid),
+						Int16GetDatum(var->varattno),
+						0, 0);
+			if (!HeapTupleIsValid(tp))
+				return false;
+
+			result = ((Form_pg_attribute) GETSTRUCT(tp))->attnotnull;
+			ReleaseSysCache(tp);
+
+			return result;
+		case RTE_SUBQUERY:
+			if (rte->subquery->setOperations != NULL || var->varattno < 0)
+				return false;
+
+			te = get_tle_by_resno(rte->subquery->targetList, var->varattno);
+
+			return te != NULL && isNotNullExpr(rte->subquery, (Node *) te->expr);
+		default:
+			return false;
+	}
+}
+
+/*
+ * Returns true if the range table entry rtindex of query is accessed on the
+ * nullable side of an outer join or is not part of the join tree at all.
+ */
+
+static bool
+isOnNullableSide (Query *query, Index rtindex)
+{
+	List *rtList = NIL;
+	List *joinPath = NIL;
+	ListCell *rtLc;
+	ListCell *pathLc;
+	RangeTblEntry *joinRte;
+	JoinChild side;
+
+	if (!findRTindexInFrom(rtindex, query, &rtList, &joinPath))
+		return true;
+
+	forboth(rtLc, rtList, pathLc, joinPath)
+	{
+		side = (JoinChild) lfirst_int(pathLc);
+
+		if (side == JCHILD_RTREF)
+			continue;
+
+		joinRte = rt_fetch(lfirst_int(rtLc), query->rtable);
+
+		switch (joinRte->jointype)
+		{
+			case JOIN_LEFT:
+			case JOIN_ANTI:
+				if (side == JCHILD_RIGHT)
+					return true;
+				break;
+			case JOIN_RIGHT:
+				if (side == JCHILD_LEFT)
+					return true;
+				break;
+			case JOIN_FULL:
+				return true;
+			default:
+				break;
+		}
+	}
+
+	return false;
+}
+
 /*
  * If the TargetEntry is a single Var possible surrounded by casts then return
  * this Var. Return NULL otherwise.
@@ -54,6 +54,8 @@
 #include "postmaster/autovacuum.h"
 #include "provrewrite/provrewrite.h"
 #include "provrewrite/prov_plan_all.h"
+#include "provrewrite/prov_cache.h"
+#include "provrewrite/prov_shared_cache.h"
 #include "rewrite/rewriteHandler.h"
 #include "storage/freespace.h"
 #include "storage/ipc.h"
@@ -611,8 +613,16 @@ pg_analyze_and_rewrite(Node *parsetree, const char *query_string,
 	 * 		all rewrites, we must not rewrite the query here.
 	 */
 	if (!prov_use_optimizer)
+	{
+		if (log_parser_stats)
+			ResetUsage();
+
 		querytree_list = provenanceRewriteQueryList(querytree_list);
 
+		if (log_parser_stats)
+			ShowUsage("PROVENANCE REWRITER STATISTICS");
+	}
+
 	/* debug for rewritten provenance query trees */
 	if (Debug_print_rewritten)
 		elog_node_display(DEBUG1, "rewritten parse tree", querytree_list,
@@ -885,6 +895,11 @@ exec_simple_query(const char *query_string)
 		Portal		portal;
 		DestReceiver *receiver;
 		int16		format;
+		bool		useProvCache;
+		Node	   *cacheParsetree = NULL;
+		char	   *sharedTree = NULL;
+		CachedPlanSource *cachedSource = NULL;
+		CachedPlan *cplan = NULL;
 
 		/*
 		 * Get the command name for use in status display (it also becomes the
@@ -927,10 +942,63 @@ exec_simple_query(const char *query_string)
 		 */
 		oldcontext = MemoryContextSwitchTo(MessageContext);
 
-		querytree_list = pg_analyze_and_rewrite(parsetree, query_string,
-												NULL, 0);
+		/*
+		 * A single SELECT may be a provenance query that has already been
+		 * rewritten and planned in this session.  If so, reuse the cached
+		 * plan (the plan cache takes care of replanning it if it has been
+		 * invalidated in the meantime).
+		 */
+		useProvCache = prov_use_rewrite_cache && isTopLevel &&
+			IsA(parsetree, SelectStmt) &&
+			((SelectStmt *) parsetree)->intoClause == NULL;
+
+		if (useProvCache)
+			cachedSource = provCacheLookup(query_string);
+
+		if (cachedSource)
+		{
+			cplan = RevalidateCachedPlan(cachedSource, false);
+			plantree_list = cplan->stmt_list;
+		}
+		else
+		{
+			/* parse analysis scribbles on its input, keep a copy to cache */
+			if (useProvCache)
+			{
+				cacheParsetree = copyObject(parsetree);
+				provRewriteCacheable = false;
+			}
+
+			/*
+			 * Another session may have rewritten the query already.  With
+			 * prov_use_optimizer the rewrite happens in the planner, so there
+			 * is nothing to share.
+			 */
+			querytree_list = NIL;
+			if (useProvCache && !prov_use_optimizer)
+				querytree_list = provSharedCacheLookup(query_string);
+
+			if (querytree_list != NIL)
+				provRewriteCacheable = true;
+			else
+			{
+				querytree_list = pg_analyze_and_rewrite(parsetree, query_string,
+														NULL, 0);
+
+				/* the planner scribbles on the query trees, too */
+				if (useProvCache && provRewriteCacheable && !prov_use_optimizer)
+					sharedTree = nodeToString(querytree_list);
+			}
+
+			plantree_list = pg_plan_queries(querytree_list, 0, NULL, true);
 
-		plantree_list = pg_plan_queries(querytree_list, 0, NULL, true);
+			if (useProvCache && provRewriteCacheable)
+				provCacheStore(query_string, cacheParsetree, commandTag,
+							   plantree_list);
+
+			if (sharedTree)
+				provSharedCacheStore(query_string, sharedTree, plantree_list);
+		}
 
 		/* If we got a cancel signal in analysis or planning, quit */
 		CHECK_FOR_INTERRUPTS();
@@ -948,7 +1016,7 @@ exec_simple_query(const char *query_string)
 						  query_string,
 						  commandTag,
 						  plantree_list,
-						  NULL);
+						  cplan);
 
 		/*
 		 * Start the portal.  No parameters here.
@@ -1240,8 +1308,16 @@ exec_parse_message(const char *query_string,	/* string to execute */
 		 */
 
 		if (!prov_use_optimizer)
+		{
+			if (log_parser_stats)
+				ResetUsage();
+
 			querytree_list = provenanceRewriteQueryList(querytree_list);
 
+			if (log_parser_stats)
+				ShowUsage("PROVENANCE REWRITER STATISTICS");
+		}
+
 		/*
 		 * If this is the unnamed statement and it has parameters, defer query
 		 * planning until Bind.  Otherwise do it now.
@@ -55,6 +55,7 @@
 #include "utils/acl.h"
 #include "utils/guc.h"
 #include "utils/syscache.h"
+#include "provrewrite/prov_lazy.h"
 
 
 /*
@@ -1300,6 +1301,8 @@ UtilityTupleDescriptor(Node *parsetree)
 				portal = GetPortalByName(stmt->portalname);
 				if (!PortalIsValid(portal))
 					return NULL;	/* not our business to raise error */
+				if (getLazyProvCursorTupleDesc(portal) != NULL)
+					return CreateTupleDescCopy(getLazyProvCursorTupleDesc(portal));
 				return CreateTupleDescCopy(portal->tupDesc);
 			}
 
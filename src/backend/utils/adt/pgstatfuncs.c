@@ -14,9 +14,12 @@
  */
 #include "postgres.h"
 
+#include "access/heapam.h"
 #include "funcapi.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "catalog/pg_type.h"
+#include "provrewrite/prov_stats.h"
 #include "utils/builtins.h"
 #include "utils/inet.h"
 #include "libpq/ip.h"
@@ -70,6 +73,8 @@ extern Datum pg_stat_get_bgwriter_maxwritten_clean(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_written_backend(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_alloc(PG_FUNCTION_ARGS);
 
+extern Datum pg_stat_get_provenance(PG_FUNCTION_ARGS);
+
 extern Datum pg_stat_clear_snapshot(PG_FUNCTION_ARGS);
 extern Datum pg_stat_reset(PG_FUNCTION_ARGS);
 
@@ -827,6 +832,75 @@ pg_stat_get_buf_alloc(PG_FUNCTION_ARGS)
 	PG_RETURN_INT64(pgstat_fetch_global()->buf_alloc);
 }
 
+/*
+ * Returns one row for each provenance rewrite phase with the number of calls,
+ * the total time in milliseconds and, for the complete rewrite, the number of
+ * nodes and bytes of the rewritten query trees.
+ */
+Datum
+pg_stat_get_provenance(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	PgStat_GlobalStats *stats;
+	Datum		values[5];
+	bool		nulls[5];
+	HeapTuple	tuple;
+	int			phase;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		TupleDesc	tupdesc;
+		MemoryContext oldcontext;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		/* this had better match pg_stat_provenance view in system_views.sql */
+		tupdesc = CreateTemplateTupleDesc(5, false);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "phase",
+						   TEXTOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "calls",
+						   INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 3, "total_time",
+						   FLOAT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 4, "nodes",
+						   INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 5, "bytes",
+						   INT8OID, -1, 0);
+
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+		funcctx->max_calls = PGSTAT_NUM_PROV_PHASES;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+
+	if (funcctx->call_cntr >= funcctx->max_calls)
+		SRF_RETURN_DONE(funcctx);
+
+	phase = (int) funcctx->call_cntr;
+	stats = pgstat_fetch_global();
+
+	MemSet(nulls, false, sizeof(nulls));
+	values[0] = DirectFunctionCall1(textin,
+									CStringGetDatum(provStatsPhaseName(phase)));
+	values[1] = Int64GetDatum(stats->prov_calls[phase]);
+	values[2] = Float8GetDatum(stats->prov_time[phase] / 1000.0);
+
+	if (phase == PROV_PHASE_REWRITE)
+	{
+		values[3] = Int64GetDatum(stats->prov_nodes);
+		values[4] = Int64GetDatum(stats->prov_bytes);
+	}
+	else
+		nulls[3] = nulls[4] = true;
+
+	tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+
+	SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+}
+
 
 /* Discard the active statistics snapshot */
 Datum
@@ -276,13 +276,25 @@ char	   *session_authorization_string;
 /* provenance module configuration parameters */
 bool prov_use_set_optimization = true;
 bool prov_use_wl_union_semantics = false;
+bool prov_use_tagged_union = false;
 bool prov_use_sublink_optimization_left_join = true;
 bool prov_use_sublink_move_to_target = false;
 bool prov_use_sublink_transfrom_top_level_any_to_join = true;
 bool prov_use_unnest_JA = true;
 bool prov_use_optimizer = false;
 bool prov_use_selection_pushdown = false;
+bool prov_use_inequality_deduction = false;
+bool prov_use_aggr_single_pass = false;
+bool prov_use_rewrite_cache = false;
+bool prov_use_lazy_cursors = false;
+bool prov_use_sublink_memoization = false;
+bool prov_use_anti_join = false;
+int prov_rewrite_cache_size = 64;
+int prov_xml_query_cache_size = 64;
+int prov_shared_cache_size = 1024;
+double prov_optimizer_plan_share = 0.1;
 bool prov_xml_whitespace = false;
+char *prov_lineage_relation = NULL;
 
 /*
  * Displayable names for context types (enum GucContext)
@@ -1176,6 +1188,79 @@ static struct config_bool ConfigureNamesBool[] =
 		false, NULL, NULL
 	},
 
+	{
+		{"prov_use_inequality_deduction", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Deduce inequalities during selection pushdown."),
+			gettext_noop("If activated (and prov_use_selection_pushdown is on) the"
+						 " transitive closure of the inequalities of each selection scope"
+						 " is computed. A scope with contradicting inequalities gets a false"
+						 " condition and the bounds on constants implied by the closure are"
+						 " added as new selection conditions."),
+		},
+		&prov_use_inequality_deduction,
+		false, NULL, NULL
+	},
+
+	{
+		{"prov_use_aggr_single_pass", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Compute the provenance of aggregations in a single pass."),
+			gettext_noop("If activated aggregations without sublinks, LIMIT and DISTINCT"
+						 " are not rewritten into a join between the original aggregation"
+						 " and its rewritten input. Instead the aggregation node emits the"
+						 " provenance of each of its input tuples together with the"
+						 " aggregation results of the tuple's group."),
+		},
+		&prov_use_aggr_single_pass,
+		false, NULL, NULL
+	},
+
+	{
+		{"prov_use_rewrite_cache", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Cache the plans of provenance queries."),
+			gettext_noop("If activated the rewritten and planned form of each provenance"
+						 " SELECT is cached for the session. If the same query is issued again"
+						 " under the same provenance options the cached plan is executed"
+						 " without rewriting and planning the query. Cached plans are"
+						 " invalidated by schema changes of the relations they use."),
+		},
+		&prov_use_rewrite_cache,
+		false, NULL, NULL
+	},
+
+	{
+		{"prov_use_lazy_cursors", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Compute the provenance of cursors for fetched rows only."),
+			gettext_noop("If activated a cursor declared for a provenance query runs the"
+						 " original query. Each FETCH computes the provenance of the fetched"
+						 " rows only by restricting the provenance query to these rows."),
+		},
+		&prov_use_lazy_cursors,
+		false, NULL, NULL
+	},
+
+	{
+		{"prov_use_sublink_memoization", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Memoize the output of correlated sublinks."),
+			gettext_noop("If activated a correlated sublink that is not unnested is not"
+						 " re-executed for correlation values it has already been executed"
+						 " for. Its output rows are kept per combination of correlation"
+						 " values in work_mem, evicting the least recently used ones."),
+		},
+		&prov_use_sublink_memoization,
+		false, NULL, NULL
+	},
+
+	{
+		{"prov_use_anti_join", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Rewrite NOT EXISTS sublinks into anti joins."),
+			gettext_noop("If activated the provenance rewriter unnests uncorrelated"
+						 " NOT EXISTS sublinks into an anti join instead of a left"
+						 " outer join followed by an IS NULL test."),
+		},
+		&prov_use_anti_join,
+		false, NULL, NULL
+	},
+
 	{
 		{"prov_xml_whitespace", PGC_USERSET, CUSTOM_OPTIONS,
 			gettext_noop("nicely indents xml results using "),
@@ -1198,6 +1283,21 @@ static struct config_bool ConfigureNamesBool[] =
 		false, NULL, NULL
 	},
 
+	{
+		{"prov_use_tagged_union", PGC_USERSET, CUSTOM_OPTIONS,
+			gettext_noop("Represent the provenance of a union by a branch tag."),
+			gettext_noop("If activated together with prov_use_wl_union_semantics and the"
+						 " provenance attributes of all inputs of a union have the same"
+						 " types, the provenance of a union is a single set of provenance"
+						 " attributes preceded by the attribute prov_union_branch that"
+						 " identifies the input a tuple is derived from. Provenance"
+						 " queries used in the FROM clause of another query are not"
+						 " affected."),
+		},
+		&prov_use_tagged_union,
+		false, NULL, NULL
+	},
+
 
 
 	/* End-of-list marker */
@@ -1491,6 +1591,36 @@ static struct config_int ConfigureNamesInt[] =
 		5, 0, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"prov_rewrite_cache_size", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Sets the maximal number of provenance queries cached if prov_use_rewrite_cache is activated."),
+			NULL
+		},
+		&prov_rewrite_cache_size,
+		64, 1, INT_MAX, NULL, NULL
+	},
+
+	{
+		{"prov_xml_query_cache_size", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Sets the maximal number of queries whose query trees are cached by the query to XML functions."),
+			gettext_noop("Zero disables the cache.")
+		},
+		&prov_xml_query_cache_size,
+		64, 0, INT_MAX, NULL, NULL
+	},
+
+	{
+		{"prov_shared_cache_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the size of the shared memory cache of rewritten provenance queries."),
+			gettext_noop("If prov_use_rewrite_cache is activated, the rewritten provenance queries"
+						 " are also stored in this cache, so other sessions can skip their rewrite."
+						 " Zero disables the cache."),
+			GUC_UNIT_KB
+		},
+		&prov_shared_cache_size,
+		1024, 0, MAX_KILOBYTES, NULL, NULL
+	},
+
 #ifdef LOCK_DEBUG
 	{
 		{"trace_lock_oidmin", PGC_SUSET, DEVELOPER_OPTIONS,
@@ -1983,6 +2113,17 @@ static struct config_real ConfigureNamesReal[] =
 		0.1, 0.0, 100.0, NULL, NULL
 	},
 
+	{
+		{"prov_optimizer_plan_share", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Bounds the time spend on planning rewrites if prov_use_optimizer is activated."),
+			gettext_noop("The search for the cheapest rewrite stops, once the time spend on rewriting"
+						 " and planning exceeds this fraction of the estimated cost of the cheapest"
+						 " plan found so far. Zero disables the bound.")
+		},
+		&prov_optimizer_plan_share,
+		0.1, 0.0, DBL_MAX, NULL, NULL
+	},
+
 	{
 		{"checkpoint_completion_target", PGC_SIGHUP, WAL_CHECKPOINTS,
 			gettext_noop("Time spent flushing dirty buffers during checkpoint, as fraction of checkpoint interval."),
@@ -2556,6 +2697,18 @@ static struct config_string ConfigureNamesString[] =
 		"pg_catalog.simple", assignTSCurrentConfig, NULL
 	},
 
+	{
+		{"prov_lineage_relation", PGC_USERSET, QUERY_TUNING,
+			gettext_noop("Sets the relation that stores the lineage of rows written by provenance queries."),
+			gettext_noop("If set, INSERT ... SELECT PROVENANCE and SELECT PROVENANCE ... INTO"
+						 " store the result rows and record for each of them the tuple"
+						 " identifiers of the base tuples in its provenance in this relation."
+						 " An empty string disables lineage capture.")
+		},
+		&prov_lineage_relation,
+		"", NULL, NULL
+	},
+
 #ifdef USE_SSL
 	{
 		{"ssl_ciphers", PGC_POSTMASTER, CONN_AUTH_SECURITY,
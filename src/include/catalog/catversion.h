@@ -53,6 +53,6 @@
  */
 
 /*							yyyymmddN */
-#define CATALOG_VERSION_NO	200711281
+#define CATALOG_VERSION_NO	200711288
 
 #endif
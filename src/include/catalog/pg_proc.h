@@ -4431,6 +4431,18 @@ DATA(insert OID = 3781 (  bitset_contains	PGNSP PGUID 12 1  0 f f f f i 2 16 "15
 DESCR("Checks for two varbit parameters if the bitset represented by the right parameter is contained in the bitset represented by the left parameter");
 DATA(insert OID = 3782 (  bitset_nonzero_repeat	PGNSP PGUID 12 1  0 f f f f i 2 16 "1562 23" _null_ _null_ _null_ bitset_nonzero_repeat - _null_ _null_ ));
 DESCR("Checks for a varbit parameter if each consecutive group of bits contains has at least one bit set to 1. The length of the groups is given as the second parameter");
+DATA(insert OID = 3783 (  prov_fetch_tuples	PGNSP PGUID 12 1 100 f f f t s 2 2283 "2283 1010" _null_ _null_ _null_ prov_fetch_tuples_by_tid - _null_ _null_ ));
+DESCR("Fetch the tuples of the relation of the first parameter identified by the TUPLEID provenance ctids given as the second parameter.");
+DATA(insert OID = 3784 (  prov_fetch_tuples	PGNSP PGUID 12 1 100 f f f t s 2 2283 "2283 1028" _null_ _null_ _null_ prov_fetch_tuples_by_oid - _null_ _null_ ));
+DESCR("Fetch the tuples of the relation of the first parameter identified by the TUPLEID provenance oids given as the second parameter.");
+DATA(insert OID = 3785 (  bitset_set_bits_if	PGNSP PGUID 12 1  0 f f t f i 3 1562 "1562 1007 1000" _null_ _null_ _null_ bitset_set_bits_if - _null_ _null_ ));
+DESCR("Returns a copy of the varbit given as the first parameter with each bit from the second parameter set to 1 if the corresponding element of the third parameter is true");
+DATA(insert OID = 3786 (  prov_matview_maintain	PGNSP PGUID 12 1  0 f f t f v 0 2279 "" _null_ _null_ _null_ prov_matview_maintain - _null_ _null_ ));
+DESCR("Trigger function that maintains a materialized provenance view after a modification of one of its base relations");
+DATA(insert OID = 3787 (  pg_stat_get_provenance	PGNSP PGUID 12 1 8 f f t t s 0 2249 "" _null_ _null_ _null_ pg_stat_get_provenance - _null_ _null_ ));
+DESCR("statistics: calls and time of the provenance rewrite phases");
+DATA(insert OID = 3788 (  provenance_batch	PGNSP PGUID 12 1 1000 f f t t v 1 2249 "1009" "{1009,23,25}" "{i,o,o}" "{queries,query,result}" provenance_batch - _null_ _null_ ));
+DESCR("Execute a batch of provenance queries that share common subexpressions and return their result rows");
 
 
 /*
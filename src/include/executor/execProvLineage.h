@@ -0,0 +1,28 @@
+/*-------------------------------------------------------------------------
+ *
+ * execProvLineage.h
+ *	  Lineage capture of provenance queries that store their result
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ * $PostgreSQL: pgsql/src/include/executor/execProvLineage.h,v 1.1 2008/01/01 19:45:57 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef EXECPROVLINEAGE_H
+#define EXECPROVLINEAGE_H
+
+#include "nodes/execnodes.h"
+#include "provrewrite/prov_nodes.h"
+
+typedef struct ProvLineageState ProvLineageState;
+
+extern ProvLineageState *ExecInitProvLineage(ProvLineageInfo *info, PlanState *planstate,
+											 EState *estate);
+extern bool ExecProvLineageNewTarget(ProvLineageState *state, TupleTableSlot *planSlot);
+extern void ExecProvLineageSetTarget(ProvLineageState *state, Relation rel, ItemPointer tid);
+extern void ExecProvLineageRecord(ProvLineageState *state, TupleTableSlot *planSlot);
+extern void ExecEndProvLineage(ProvLineageState *state);
+
+#endif   /* EXECPROVLINEAGE_H */
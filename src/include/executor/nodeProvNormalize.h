@@ -0,0 +1,24 @@
+/*-------------------------------------------------------------------------
+ *
+ * nodeProvNormalize.h
+ *
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ *
+ * $PostgreSQL: pgsql/src/include/executor/nodeProvNormalize.h,v 1.1 2008/01/01 19:45:57 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef NODEPROVNORMALIZE_H
+#define NODEPROVNORMALIZE_H
+
+#include "nodes/execnodes.h"
+
+extern int	ExecCountSlotsProvNormalize(ProvNormalize *node);
+extern ProvNormalizeState *ExecInitProvNormalize(ProvNormalize *node, EState *estate, int eflags);
+extern TupleTableSlot *ExecProvNormalize(ProvNormalizeState *node);
+extern void ExecEndProvNormalize(ProvNormalizeState *node);
+extern void ExecReScanProvNormalize(ProvNormalizeState *node, ExprContext *exprCtxt);
+
+#endif   /* NODEPROVNORMALIZE_H */
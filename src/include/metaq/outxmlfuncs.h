@@ -17,5 +17,6 @@
 
 extern char *nodeToXml (void *obj);
 extern StringInfo nodeToXmlStringInfo(void *obj);
+extern struct varlena *nodeToXmlVarlena(void *obj);
 
 #endif /* OUTXMLFUNCS_H_ */
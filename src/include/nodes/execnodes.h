@@ -345,6 +345,9 @@ typedef struct EState
 	bool		es_select_into; /* true if doing SELECT INTO */
 	bool		es_into_oids;	/* true to generate OIDs in SELECT INTO */
 
+	/* Stuff used for provenance lineage capture (see execProvLineage.c): */
+	struct ProvLineageState *es_provLineage;
+
 	List	   *es_exprcontexts;	/* List of ExprContexts within EState */
 
 	List	   *es_subplanstates;		/* List of PlanState for SubPlans */
@@ -625,6 +628,11 @@ typedef struct SubPlanState
 	FmgrInfo   *tab_eq_funcs;	/* equality functions for table datatype(s) */
 	FmgrInfo   *lhs_hash_funcs; /* hash functions for lefthand datatype(s) */
 	FmgrInfo   *cur_eq_funcs;	/* equality functions for LHS vs. table */
+	/* these are used when memoizing the output of a correlated subselect: */
+	struct SubPlanMemo *memo;	/* memoized output rows by parameter values */
+	long		memoHits;		/* executions answered from memoized rows */
+	long		memoMisses;		/* executions that ran the subselect */
+	long		memoEvictions;	/* memoized outputs evicted to stay in work_mem */
 } SubPlanState;
 
 /* ----------------
@@ -1373,6 +1381,10 @@ typedef struct AggState
 	/* these fields are used in AGG_PLAIN and AGG_SORTED modes: */
 	AggStatePerGroup pergroup;	/* per-Aggref-per-group working state */
 	HeapTuple	grp_firstTuple; /* copy of first tuple of current group */
+	/* these fields are used if the plan node has provEmitInput set: */
+	Tuplestorestate *prov_store;	/* input tuples of current group */
+	TupleTableSlot *prov_slot;	/* slot for reading from prov_store */
+	bool		prov_emitting;	/* emitting tuples of prov_store? */
 	/* these fields are used in AGG_HASHED mode: */
 	TupleHashTable hashtable;	/* hash table with one entry per group */
 	TupleTableSlot *hashslot;	/* slot for loading hash table */
@@ -1467,4 +1479,35 @@ typedef struct LimitState
 	TupleTableSlot *subSlot;	/* tuple last obtained from subplan */
 } LimitState;
 
+/* ----------------
+ *	 ProvNormalizeState information
+ *
+ *		The distinct result tuples and the distinct base tuples of each base
+ *		relation access are stored in hash tables that map them to their ids.
+ *		Each table stores only the key attributes, which are copied from the
+ *		input tuple into a key slot before the lookup. For each input tuple
+ *		the node outputs a new result tuple, then the new base tuples of the
+ *		accesses and finally the witness row; nextOutput tracks the position
+ *		in this sequence (-1 is the result tuple, numGroups the witness).
+ * ----------------
+ */
+typedef struct ProvNormalizeState
+{
+	PlanState	ps;				/* its first field is NodeTag */
+	FmgrInfo   *eqfunctions;	/* per-column equality functions */
+	FmgrInfo   *hashfunctions;	/* per-column hash functions */
+	TupleHashTable *hashtables;	/* result table, then one per access */
+	TupleTableSlot **keyslots;	/* key slot of each hash table */
+	int		   *firstCols;		/* first column of each table in colIdx */
+	AttrNumber *keyColIdx;		/* 1 .. n, the key columns of a key slot */
+	int64	   *nextIds;		/* last id assigned in each hash table */
+	int64	   *curIds;			/* ids for the current input tuple, 0 for
+								 * an access without base tuple */
+	bool	   *curIsNew;		/* are these tuples output for the first time? */
+	TupleTableSlot *curSlot;	/* current input tuple, NULL if none */
+	int			nextOutput;		/* next output row for the current input */
+	MemoryContext tableContext; /* memory context of the hash tables */
+	Datum		kindValues[3];	/* 'r', 'b' and 'w' */
+} ProvNormalizeState;
+
 #endif   /* EXECNODES_H */
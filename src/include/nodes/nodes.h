@@ -70,6 +70,7 @@ typedef enum NodeTag
 	T_Hash,
 	T_SetOp,
 	T_Limit,
+	T_ProvNormalize,
 
 	/*
 	 * TAGS FOR PLAN STATE NODES (execnodes.h)
@@ -102,6 +103,7 @@ typedef enum NodeTag
 	T_HashState,
 	T_SetOpState,
 	T_LimitState,
+	T_ProvNormalizeState,
 
 	/*
 	 * TAGS FOR PRIMITIVE NODES (primnodes.h)
@@ -207,6 +209,7 @@ typedef enum NodeTag
 	T_InnerIndexscanInfo,
 	T_OuterJoinInfo,
 	T_InClauseInfo,
+	T_ProvJoinInfo,
 	T_AppendRelInfo,
 	T_PlannerParamItem,
 
@@ -386,7 +389,8 @@ typedef enum NodeTag
 	T_ThisExpr,
 	T_AttrInclusions,
 	T_InclusionCond,
-	T_CopyProvAttrInfo
+	T_CopyProvAttrInfo,
+	T_ProvLineageInfo
 } NodeTag;
 
 /*
@@ -520,7 +524,14 @@ typedef enum JoinType
 	JOIN_IN,					/* at most one result per outer row */
 	JOIN_REVERSE_IN,			/* at most one result per inner row */
 	JOIN_UNIQUE_OUTER,			/* outer path must be made unique */
-	JOIN_UNIQUE_INNER			/* inner path must be made unique */
+	JOIN_UNIQUE_INNER,			/* inner path must be made unique */
+
+	/*
+	 * Anti-join, emitted by the provenance rewriter for NOT EXISTS sublinks.
+	 * Returns the outer rows without a match, null-extended like a left
+	 * join.  There is no reverse form; the LHS is always the outer rel.
+	 */
+	JOIN_ANTI					/* unmatched outer rows only */
 
 	/*
 	 * We might need additional join types someday.
@@ -530,6 +541,7 @@ typedef enum JoinType
 #define IS_OUTER_JOIN(jointype) \
 	((jointype) == JOIN_LEFT || \
 	 (jointype) == JOIN_FULL || \
-	 (jointype) == JOIN_RIGHT)
+	 (jointype) == JOIN_RIGHT || \
+	 (jointype) == JOIN_ANTI)
 
 #endif   /* NODES_H */
@@ -1789,6 +1789,7 @@ typedef struct ViewStmt
 	List	   *aliases;		/* target column names */
 	Node	   *query;			/* the SELECT query */
 	bool		replace;		/* replace an existing view? */
+	bool		materialized;	/* materialized provenance view? */
 } ViewStmt;
 
 /* ----------------------
@@ -73,6 +73,8 @@ typedef struct PlannedStmt
 	List	   *relationOids;	/* OIDs of relations the plan depends on */
 
 	int			nParamExec;		/* number of PARAM_EXEC Params used */
+
+	Node	   *provLineage;	/* ProvLineageInfo for lineage capture, or NULL */
 } PlannedStmt;
 
 /* macro for fetching the Plan associated with a SubPlan node */
@@ -383,6 +385,11 @@ typedef struct ValuesScan
  * (But plan.qual is still applied before actually returning a tuple.)
  * For an outer join, only joinquals are allowed to be used as the merge
  * or hash condition of a merge or hash join.
+ *
+ * provGroups and provFanout are set if the join is the join of an operator
+ * result with its rewritten input created by the provenance rewriter. They
+ * are the estimates used for the size of the join (see ProvJoinInfo) and are
+ * only kept to be shown by EXPLAIN.
  * ----------------
  */
 typedef struct Join
@@ -390,6 +397,8 @@ typedef struct Join
 	Plan		plan;
 	JoinType	jointype;
 	List	   *joinqual;		/* JOIN quals (in addition to plan.qual) */
+	double		provGroups;		/* estimated groups of provenance input */
+	double		provFanout;		/* estimated tuples per result tuple */
 } Join;
 
 /* ----------------
@@ -480,6 +489,12 @@ typedef struct Group
  * executor startup.  (It is possible that there are no aggregate functions;
  * this could happen if they get optimized away by constant-folding, or if
  * we are using the Agg node to implement hash-based grouping.)
+ *
+ * If provEmitInput is set (only for AGG_PLAIN and AGG_SORTED) the node
+ * buffers the input tuples of each group and emits one output tuple per
+ * buffered input tuple instead of a single tuple per group. This is used by
+ * the single-pass provenance rewrite of aggregation queries, where the
+ * targetlist contains ungrouped provenance attributes of the input.
  * ---------------
  */
 typedef enum AggStrategy
@@ -497,6 +512,7 @@ typedef struct Agg
 	AttrNumber *grpColIdx;		/* their indexes in the target list */
 	Oid		   *grpOperators;	/* equality operators to compare with */
 	long		numGroups;		/* estimated number of groups in input */
+	bool		provEmitInput;	/* emit each input tuple of a group */
 } Agg;
 
 /* ----------------
@@ -558,4 +574,30 @@ typedef struct Limit
 	Node	   *limitCount;		/* COUNT parameter, or NULL if none */
 } Limit;
 
+/* ----------------
+ *		provenance normalize node
+ *
+ * Produces the normalized output of a provenance query (FORMAT NORMALIZED).
+ * The input tuples already have the layout of the output: the kind and id
+ * of the row, numResultCols result attributes and for each of the numGroups
+ * base relation accesses an id attribute followed by its provenance
+ * attributes. The kind and id attributes are null placeholders that are
+ * filled in by the node. Each input tuple is a witness of a result tuple.
+ * The node outputs each distinct result tuple and each distinct base tuple
+ * of an access once with an id, and one row per witness that references
+ * these ids. The kind of a row is 'r', 'b' or 'w', respectively.
+ * ----------------
+ */
+typedef struct ProvNormalize
+{
+	Plan		plan;
+	int			numResultCols;	/* number of result attributes */
+	int			numGroups;		/* number of base relation accesses */
+	int		   *groupNumCols;	/* number of provenance attributes of each
+								 * access */
+	int			numCols;		/* number of result and provenance attributes */
+	AttrNumber *colIdx;			/* their indexes in the target list */
+	Oid		   *eqOperators;	/* equality operators to compare them with */
+} ProvNormalize;
+
 #endif   /* PLANNODES_H */
@@ -479,6 +479,8 @@ typedef struct SubPlan
 	bool		unknownEqFalse; /* TRUE if it's okay to return FALSE when the
 								 * spec result is UNKNOWN; this allows much
 								 * simpler handling of null values */
+	bool		useMemoization;	/* TRUE to memoize the subselect output for
+								 * each combination of parParam values */
 	/* Information for passing params into and out of the subselect: */
 	/* setParam and parParam are lists of integers (param IDs) */
 	List	   *setParam;		/* initplan subqueries have to set these
@@ -1082,6 +1084,8 @@ typedef struct JoinExpr
 	Node	   *quals;			/* qualifiers on join, if any */
 	Alias	   *alias;			/* user-written alias clause, if any */
 	int			rtindex;		/* RT index assigned for join */
+	bool		isProvJoin;		/* join of an operator result with its
+								 * rewritten input (provenance rewriter) */
 } JoinExpr;
 
 /*----------
@@ -157,6 +157,8 @@ typedef struct PlannerInfo
 
 	List	   *in_info_list;	/* list of InClauseInfos */
 
+	List	   *prov_join_list;	/* list of ProvJoinInfos */
+
 	List	   *append_rel_list;	/* list of AppendRelInfos */
 
 	List	   *query_pathkeys; /* desired pathkeys for query_planner(), and
@@ -234,6 +236,10 @@ typedef struct PlannerInfo
  *			   clauses have been applied (ie, output rows of a plan for it)
  *		width - avg. number of bytes per tuple in the relation after the
  *				appropriate projections have been done (ie, output width)
+ *		prov_groups, prov_fanout - only set for the join of an operator
+ *				result with its rewritten input (see ProvJoinInfo): the
+ *				estimated number of groups of the input and the number of
+ *				join tuples per result side tuple, zero otherwise
  *		reltargetlist - List of Var nodes for the attributes we need to
  *						output from this relation (in no particular order)
  *						NOTE: in a child relation, may contain RowExprs
@@ -326,6 +332,8 @@ typedef struct RelOptInfo
 	/* size estimates generated by planner */
 	double		rows;			/* estimated number of result tuples */
 	int			width;			/* estimated avg width of result tuples */
+	double		prov_groups;	/* groups of rewritten provenance input */
+	double		prov_fanout;	/* join tuples per result side tuple */
 
 	/* materialization information */
 	List	   *reltargetlist;	/* needed Vars */
@@ -1080,6 +1088,8 @@ typedef struct InnerIndexscanInfo
  * RIGHT JOIN is handled by switching the inputs to make it a LEFT JOIN.
  * We make an OuterJoinInfo for FULL JOINs even though there is no flexibility
  * of planning for them, because this simplifies make_join_rel()'s API.
+ * Anti joins are represented like LEFT JOINs with is_anti_join set; we don't
+ * try to commute them with other outer joins either.
  */
 
 typedef struct OuterJoinInfo
@@ -1090,6 +1100,7 @@ typedef struct OuterJoinInfo
 	Relids		syn_lefthand;	/* base relids syntactically within LHS */
 	Relids		syn_righthand;	/* base relids syntactically within RHS */
 	bool		is_full_join;	/* it's a FULL OUTER JOIN */
+	bool		is_anti_join;	/* it's an anti join */
 	bool		lhs_strict;		/* joinclause is strict for some LHS rel */
 	bool		delay_upper_joins;		/* can't commute with upper RHS */
 } OuterJoinInfo;
@@ -1115,6 +1126,32 @@ typedef struct InClauseInfo
 	List	   *in_operators;	/* OIDs of the IN's equality operator(s) */
 } InClauseInfo;
 
+/*
+ * Provenance join info.
+ *
+ * The provenance rewriter joins the result of an aggregation or set
+ * operation with its rewritten input on the group-by (resp. all) attributes
+ * and marks these joins (JoinExpr.isProvJoin).  Each input tuple joins with
+ * the result tuple of its group, so the join produces about as many tuples as
+ * the input, but the generic join selectivity of the IS NOT DISTINCT FROM
+ * conditions does not know that.  deconstruct_jointree records the sides of
+ * each marked join in a ProvJoinInfo; set_joinrel_size_estimates uses it to
+ * estimate the selectivity of the join from the number of distinct values
+ * of input_exprs (the input side of the join condition).
+ *
+ * result_relids are the base relids referenced by the operator result side
+ * of the join condition, input_relids are the base relids syntactically
+ * within the input side of the join.
+ */
+
+typedef struct ProvJoinInfo
+{
+	NodeTag		type;
+	Relids		result_relids;	/* base relids of the operator result */
+	Relids		input_relids;	/* base relids of the rewritten input */
+	List	   *input_exprs;	/* Vars of the join condition from the input */
+} ProvJoinInfo;
+
 /*
  * Append-relation info.
  *
@@ -31,7 +31,8 @@ typedef enum StatMsgType
 	PGSTAT_MTYPE_AUTOVAC_START,
 	PGSTAT_MTYPE_VACUUM,
 	PGSTAT_MTYPE_ANALYZE,
-	PGSTAT_MTYPE_BGWRITER
+	PGSTAT_MTYPE_BGWRITER,
+	PGSTAT_MTYPE_PROVENANCE
 } StatMsgType;
 
 /* ----------
@@ -299,6 +300,24 @@ typedef struct PgStat_MsgBgWriter
 } PgStat_MsgBgWriter;
 
 
+/* ----------
+ * PgStat_MsgProvenance			Sent by backends to update the provenance
+ *								rewrite statistics (see provrewrite/prov_stats.h)
+ * ----------
+ */
+#define PGSTAT_NUM_PROV_PHASES 8
+
+typedef struct PgStat_MsgProvenance
+{
+	PgStat_MsgHdr m_hdr;
+
+	PgStat_Counter m_calls[PGSTAT_NUM_PROV_PHASES];
+	PgStat_Counter m_time[PGSTAT_NUM_PROV_PHASES];	/* in microseconds */
+	PgStat_Counter m_nodes;
+	PgStat_Counter m_bytes;
+} PgStat_MsgProvenance;
+
+
 /* ----------
  * PgStat_Msg					Union over all possible messages.
  * ----------
@@ -315,6 +334,7 @@ typedef union PgStat_Msg
 	PgStat_MsgVacuum msg_vacuum;
 	PgStat_MsgAnalyze msg_analyze;
 	PgStat_MsgBgWriter msg_bgwriter;
+	PgStat_MsgProvenance msg_provenance;
 } PgStat_Msg;
 
 
@@ -326,7 +346,7 @@ typedef union PgStat_Msg
  * ------------------------------------------------------------
  */
 
-#define PGSTAT_FILE_FORMAT_ID	0x01A5BC97
+#define PGSTAT_FILE_FORMAT_ID	0x01A5BC98
 
 /* ----------
  * PgStat_StatDBEntry			The collector's data per database
@@ -398,6 +418,10 @@ typedef struct PgStat_GlobalStats
 	PgStat_Counter maxwritten_clean;
 	PgStat_Counter buf_written_backend;
 	PgStat_Counter buf_alloc;
+	PgStat_Counter prov_calls[PGSTAT_NUM_PROV_PHASES];
+	PgStat_Counter prov_time[PGSTAT_NUM_PROV_PHASES];
+	PgStat_Counter prov_nodes;
+	PgStat_Counter prov_bytes;
 } PgStat_GlobalStats;
 
 
@@ -464,6 +488,12 @@ extern bool pgstat_track_counts;
  */
 extern PgStat_MsgBgWriter BgWriterStats;
 
+/*
+ * Provenance rewrite statistics counters are updated directly by the
+ * provenance rewriter
+ */
+extern PgStat_MsgProvenance ProvenanceStats;
+
 /* ----------
  * Functions called from postmaster
  * ----------
@@ -565,6 +595,7 @@ extern void pgstat_twophase_postabort(TransactionId xid, uint16 info,
 						  void *recdata, uint32 len);
 
 extern void pgstat_send_bgwriter(void);
+extern void pgstat_send_provenance(void);
 
 /* ----------
  * Support functions for the SQL-callable functions to
@@ -21,5 +21,6 @@ extern void addSubqueryTargetListToTargetList (Query *query, Index rtindex);
 extern void addJoinOnAttributes (Query *query, List *joinAttrsLeft, Query *rightSub);
 extern List *rewriteAggrSubqueryForRewrite (Query *query, bool returnMapping);
 extern void checkOrderClause (Query *newTop, Query *query);
+extern bool rewritePreservesInput (Query *query);
 
 #endif /*PROV_AGGR_H_*/
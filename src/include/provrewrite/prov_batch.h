@@ -0,0 +1,20 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_batch.h
+ *		External interface to the execution of batches of provenance queries.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_batch.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_BATCH_H_
+#define PROV_BATCH_H_
+
+#include "fmgr.h"
+
+extern Datum provenance_batch (PG_FUNCTION_ARGS);
+
+#endif /* PROV_BATCH_H_ */
@@ -0,0 +1,23 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_cache.h
+ *		External interface to the backend local cache of rewritten and planned provenance queries.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_cache.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_CACHE_H_
+#define PROV_CACHE_H_
+
+#include "nodes/parsenodes.h"
+#include "utils/plancache.h"
+
+extern CachedPlanSource *provCacheLookup (const char *queryString);
+extern void provCacheStore (const char *queryString, Node *rawParseTree, const char *commandTag, List *stmtList);
+extern char *buildProvCacheKey (const char *queryString);
+
+#endif /* PROV_CACHE_H_ */
@@ -0,0 +1,26 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_lazy.h
+ *		External interface to lazy provenance cursors that compute the provenance of fetched rows only.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_lazy.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_LAZY_H_
+#define PROV_LAZY_H_
+
+#include "nodes/parsenodes.h"
+#include "tcop/dest.h"
+#include "utils/portal.h"
+
+extern bool isLazyProvCursorQuery (Query *query);
+extern Query *defineLazyProvCursor (Query *query, char *cursorName);
+extern void releaseLazyProvCursor (Portal portal);
+extern TupleDesc getLazyProvCursorTupleDesc (Portal portal);
+extern long lazyProvCursorFetch (Portal portal, FetchStmt *stmt, DestReceiver *dest);
+
+#endif /* PROV_LAZY_H_ */
@@ -0,0 +1,23 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_lineage.h
+ *		External interface to lineage capture for INSERT ... SELECT PROVENANCE and SELECT PROVENANCE ... INTO.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_lineage.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_LINEAGE_H_
+#define PROV_LINEAGE_H_
+
+#include "nodes/parsenodes.h"
+
+extern bool provLineageCapture;
+
+extern bool isLineageCaptureQuery (Query *query);
+extern Query *rewriteLineageCaptureQuery (Query *query);
+
+#endif /* PROV_LINEAGE_H_ */
@@ -0,0 +1,24 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_matview.h
+ *		 : materialized provenance views that are maintained by triggers on their base relations:
+ *		 		- DefineMaterializedProvView: execute CREATE MATERIALIZED PROVENANCE VIEW.
+ *		 		- prov_matview_maintain (): trigger function that maintains the view.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: /postgres/src/include/provrewrite/prov_matview.h,v 1.29 02.09.2009 11:12:35 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_MATVIEW_H_
+#define PROV_MATVIEW_H_
+
+#include "fmgr.h"
+#include "nodes/parsenodes.h"
+
+extern void DefineMaterializedProvView (ViewStmt *stmt, const char *queryString);
+extern Datum prov_matview_maintain (PG_FUNCTION_ARGS);
+
+#endif /* PROV_MATVIEW_H_ */
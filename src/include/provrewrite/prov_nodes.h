@@ -41,7 +41,8 @@ typedef enum ContributionType
 	CONTR_TRANS_SQL,
 	CONTR_TRANS_XML,
 	CONTR_TRANS_XML_SIMPLE,
-	CONTR_MAP
+	CONTR_MAP,
+	CONTR_TUPLEID
 } ContributionType;
 
 
@@ -158,12 +159,30 @@ typedef struct ProvInfo
 	NodeTag	type;
 	bool provSublinkRewritten;
 	bool shouldRewrite;
+	bool aggSinglePass;			/* aggregation emits the provenance of its input */
+	bool normalized;			/* produce normalized output (FORMAT NORMALIZED) */
 	ContributionType contribution;
 	Node *copyInfo;
 	Node *rewriteInfo;
 	List *annotations;
+	Node *lineage;				/* ProvLineageInfo if the query captures lineage */
 } ProvInfo;
 
+/*
+ * Lineage capture of an INSERT ... SELECT PROVENANCE or SELECT PROVENANCE ... INTO query (see
+ * prov_lineage.c). The target list of the query has a junk attribute prov_lineage_<i> with the tuple
+ * identifier of the i-th base relation access and, if a result row has more than one witness, junk
+ * attributes prov_lineage_key_<i> with the values of the result row.
+ */
+
+typedef struct ProvLineageInfo
+{
+	NodeTag type;
+	Oid lineageRelid;			/* relation the lineage records are inserted into */
+	List *sourceRelids;			/* base relation of each prov_lineage_<i> attribute */
+	int numKeys;				/* number of prov_lineage_key_<i> attributes, 0 if each row is a result row */
+} ProvLineageInfo;
+
 /* enum representing the position of a sublink in a query */
 typedef enum SublinkLocation
 {
@@ -485,6 +504,7 @@ extern AttrInclusions *makeAttrInclusions (void);
 extern InclusionCond *makeInclusionCond (void);
 extern TransProvInfo *makeTransProvInfo (void);
 extern TransSubInfo *makeTransSubInfo (int id, SubOperationType opType);
+extern ProvLineageInfo *makeProvLineageInfo (void);
 
 /* copy functions */
 extern void *copyProvNode (void *from);
@@ -615,6 +635,35 @@ extern bool provNodesEquals(void *a, void *b);
  		((ProvInfo *) ((Query *) (query))->provInfo)->provSublinkRewritten = (value);  \
 	} while (0)
 
+/* true if an aggregation query has been rewritten to compute its provenance
+ * in a single pass (the Agg node emits each of its input tuples) */
+#define IsAggSinglePass(query) \
+	((((Query *) (query))->provInfo != NULL) && ((ProvInfo *) ((Query *) query)->provInfo)->aggSinglePass)
+
+/* mark or unmark an aggregation query for single pass provenance computation */
+#define SetAggSinglePass(query, value) \
+	do { \
+		if (!(query->provInfo)) \
+			query->provInfo = (Node *) makeProvInfo(); \
+		((ProvInfo *) ((Query *) (query))->provInfo)->aggSinglePass = (value);  \
+	} while (0)
+
+/* true if the provenance of a query should be output in normalized form (FORMAT NORMALIZED) */
+#define IsProvNormalized(query) \
+	((((Query *) (query))->provInfo != NULL) && ((ProvInfo *) ((Query *) query)->provInfo)->normalized)
+
+/* mark or unmark a query for normalized provenance output */
+#define SetProvNormalized(query, value) \
+	do { \
+		if (!(query->provInfo)) \
+			query->provInfo = (Node *) makeProvInfo(); \
+		((ProvInfo *) ((Query *) (query))->provInfo)->normalized = (value);  \
+	} while (0)
+
+/* get the lineage capture information of a query (NULL if the query does not capture lineage) */
+#define GetProvLineage(query) \
+	((((Query *) (query))->provInfo != NULL) ? ((ProvInfo *) ((Query *) query)->provInfo)->lineage : NULL)
+
 /* get ContributionType */
 #define ContributionType(query) \
 	(((ProvInfo *) ((Query *) query)->provInfo)->contribution)
@@ -0,0 +1,23 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_normalize.h
+ *		External interface to the normalized output of provenance queries (FORMAT NORMALIZED).
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_normalize.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_NORMALIZE_H_
+#define PROV_NORMALIZE_H_
+
+#include "nodes/parsenodes.h"
+#include "nodes/plannodes.h"
+
+extern Query *addNormalizedTopQuery (Query *query);
+extern ProvNormalize *makeProvNormalize (Query *query);
+extern Plan *addProvNormalizePlan (ProvNormalize *node, Plan *subplan);
+
+#endif /* PROV_NORMALIZE_H_ */
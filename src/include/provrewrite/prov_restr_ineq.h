@@ -16,10 +16,11 @@
 #include "provrewrite/prov_nodes.h"
 
 /* prototypes */
-extern List *getSimpleInequalities (PushdownInfo *info);
-extern InequalityGraph *computeInequalityGraph (PushdownInfo *info);
+extern void deduceScopeInequalities (SelScope *scope);
+extern List *getSimpleInequalities (SelScope *scope);
+extern InequalityGraph *computeInequalityGraph (SelScope *scope);
 extern InequalityGraph *computeTransitiveClosure (InequalityGraph *graph);
-extern InequalityGraph *minimizeInEqualityGraph (PushdownInfo *info, InequalityGraph *graph);
-extern void generateInequalitiesFromGraph (PushdownInfo *info, InequalityGraph *graph);
+extern InequalityGraph *minimizeInEqualityGraph (SelScope *scope, InequalityGraph *graph);
+extern void generateInequalitiesFromGraph (SelScope *scope, InequalityGraph *graph);
 
 #endif /* PROV_RESTR_INEQ_H_ */
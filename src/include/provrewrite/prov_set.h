@@ -15,6 +15,8 @@
 
 #include "nodes/parsenodes.h"
 
+extern bool provUseTaggedUnion;
+
 extern Query *rewriteSetQuery (Query *query);
 extern void removeDummyRewriterRTEs (Query *query);
 extern void createSetJoinCondition (Query *query, JoinExpr *join, Index leftIndex, Index rightIndex, bool neq);
@@ -0,0 +1,24 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_shared_cache.h
+ *		External interface to the shared memory cache of rewritten provenance queries.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_shared_cache.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_SHARED_CACHE_H_
+#define PROV_SHARED_CACHE_H_
+
+#include "nodes/pg_list.h"
+
+extern Size ProvSharedCacheShmemSize (void);
+extern void ProvSharedCacheShmemInit (void);
+extern void InitProvSharedCache (void);
+extern List *provSharedCacheLookup (const char *queryString);
+extern void provSharedCacheStore (const char *queryString, char *tree, List *stmtList);
+
+#endif /* PROV_SHARED_CACHE_H_ */
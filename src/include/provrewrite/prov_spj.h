@@ -15,6 +15,8 @@
 
 #include "nodes/parsenodes.h"
 
+extern bool provUseTupleIds;
+
 extern Query *rewriteSPJQuery (Query *query);
 extern Query *rewriteSPJrestrict (Query *query, List **subList, Index maxRtindex);
 extern List *rewriteRTEs (Query *query, List **subList, Index maxRtindex);
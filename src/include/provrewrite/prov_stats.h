@@ -0,0 +1,60 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_stats.h
+ *		External interface to the counters and timers of the provenance rewrite phases.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: pgsql/src/include/provrewrite/prov_stats.h,v 1.29 2008/01/01 19:45:58 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_STATS_H_
+#define PROV_STATS_H_
+
+#include "executor/instrument.h"
+#include "lib/stringinfo.h"
+#include "nodes/parsenodes.h"
+#include "pgstat.h"
+
+/*
+ * Phases of the provenance rewrite that are counted and timed. Phases may be nested (e.g., all other rewrite
+ * phases are part of PROV_PHASE_REWRITE). The number of phases has to match PGSTAT_NUM_PROV_PHASES.
+ */
+typedef enum ProvStatsPhase
+{
+	PROV_PHASE_REWRITE,				/* provenanceRewriteQuery for a query with provenance parts */
+	PROV_PHASE_THIS_EXPRS,			/* handleThisExprs */
+	PROV_PHASE_COPY_MAPS,			/* generateCopyMaps */
+	PROV_PHASE_SUBLINK_UNNEST,		/* unnesting and decorrelation of sublinks */
+	PROV_PHASE_PUSHDOWN,			/* pushdownSelections */
+	PROV_PHASE_TRANS_INDEX,			/* transformation provenance query index build */
+	PROV_PHASE_PLAN_ALL,			/* search for the cheapest rewrite (prov_use_optimizer) */
+	PROV_PHASE_PLAN_ALL_CANDIDATE	/* rewriting and planning of one candidate during this search */
+} ProvStatsPhase;
+
+#define PROV_NUM_PHASES PGSTAT_NUM_PROV_PHASES
+
+/* statistics of the provenance rewrite of the current statement */
+typedef struct ProvStatementStats
+{
+	int64 calls[PROV_NUM_PHASES];
+	double time[PROV_NUM_PHASES];		/* milliseconds */
+	int64 nodes;						/* nodes in the rewritten query trees */
+	int64 bytes;						/* bytes allocated for these nodes */
+} ProvStatementStats;
+
+extern ProvStatementStats provStatementStats;
+
+/* begin timing a phase */
+#define ProvStatsBegin(start) \
+	INSTR_TIME_SET_CURRENT(start)
+
+extern void provStatsResetStatement (void);
+extern void provStatsEnd (ProvStatsPhase phase, instr_time *start);
+extern void provStatsCountQuery (Query *query);
+extern const char *provStatsPhaseName (int phase);
+extern void provStatsExplain (StringInfo str);
+
+#endif /* PROV_STATS_H_ */
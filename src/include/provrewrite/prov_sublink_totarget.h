@@ -64,6 +64,6 @@ typedef struct AdaptTestExpressionMutatorContext
 
 
 /* functions */
-extern Query *rewriteSublinkQueryWithMoveToTarget (Query *query, List *sublinks, List *uncorrelated,  Index subList[], List **rewritePos);
+extern Query *rewriteSublinkQueryWithMoveToTarget (Query *query, List *sublinks, List *uncorrelated,  Index subList[], List **rewritePos, Index maxRtindex);
 
 #endif /*PROV_SUBLINK_TOTARGET_H_*/
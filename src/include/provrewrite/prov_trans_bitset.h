@@ -3,7 +3,8 @@
  * prov_trans_bitset.h
  *		 : bitset (varbit data type) functions needed for transformation provenance computation:
  *		 		- bitor_with_null: a variant of bitor that handles NULL arguments as if they were bitsets containing only 0's.
- *		 		- bitoragg:
+ *		 		- bitoragg: aggregate that ORs all non NULL input bitsets (uses bitor_with_null as transition function).
+ *		 		- bitset_set_bits_if: sets each bit of a list of bits whose condition is true.
  *
  *
  * Portions Copyright (c) 2008 Boris Glavic
@@ -18,6 +19,7 @@
 #include "fmgr.h"
 #include "utils/varbit.h"
 #include "nodes/parsenodes.h"
+#include "utils/hsearch.h"
 
 /* data structures */
 typedef struct TransRepQueryInfo
@@ -29,13 +31,17 @@ typedef struct TransRepQueryInfo
 	int		*ends;
 	char 	**stringPointers;
 	int numRanges;
+	int stringLength;
 	bool hold;
 	char *cusorName;
+	HTAB *repCache;				/* already generated representations hashed by bitset */
+	MemoryContext repCacheContext;
 } TransRepQueryInfo;
 
 typedef struct TransRepQueryIndex
 {
 	List *queryInfos;
+	HTAB *infoHash;				/* queryInfos hashed by queryId */
 } TransRepQueryIndex;
 
 /* macros */
@@ -51,6 +57,7 @@ extern Datum reconstructTransToSQL (PG_FUNCTION_ARGS);
 extern Datum reconstructMap (PG_FUNCTION_ARGS);
 extern Datum bitset_contains(PG_FUNCTION_ARGS);
 extern Datum bitset_nonzero_repeat(PG_FUNCTION_ARGS);
+extern Datum bitset_set_bits_if(PG_FUNCTION_ARGS);
 extern void dropTransProvQueryIndex (void);
 extern int generateTransProvQueryIndex (Query *query, char *cursorName);
 extern int generateTransXmlQueryIndex (Query *query, char *cursorName);
@@ -58,6 +65,7 @@ extern int generateMapQueryIndex (Query *query, char *cursorName);
 extern Datum varBitOr (Datum left, Datum right);
 extern VarBit *generateEmptyBitset (int n);
 extern Datum generateVarbitSetElem (int n, int value);
+extern void bitsetAddElem (VarBit *bitset, int value);
 extern void releaseAllHolds (void);
 extern void releaseHold (char *cursorName);
 
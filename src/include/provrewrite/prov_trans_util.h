@@ -62,6 +62,9 @@ typedef enum TransProjType
 #define MAKE_SETREPEAT_FUNC(argl,argr) \
 	(makeFuncExpr(F_BITSET_NONZERO_REPEAT, BOOLOID, list_make2(argl, argr), COERCE_EXPLICIT_CALL))
 
+#define MAKE_SETBITSIF_FUNC(set,bits,conds) \
+	(makeFuncExpr(F_BITSET_SET_BITS_IF, VARBITOID, list_make3(set, bits, conds), COERCE_EXPLICIT_CALL))
+
 #define TSET_LARG(sub) \
 	((TransSubInfo *) (((TransSubInfo *) sub)->children->head->data.ptr_value))
 
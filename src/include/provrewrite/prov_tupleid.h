@@ -0,0 +1,23 @@
+/*-------------------------------------------------------------------------
+ *
+ * prov_tupleid.h
+ *		 : functions that fetch the base relation tuples identified by TUPLEID provenance:
+ *		 		- prov_fetch_tuples (anyelement, tid[]): fetch the tuples with the given ctids.
+ *		 		- prov_fetch_tuples (anyelement, oid[]): fetch the tuples with the given oids.
+ *
+ *
+ * Portions Copyright (c) 2008 Boris Glavic
+ * $PostgreSQL: /postgres/src/include/provrewrite/prov_tupleid.h,v 1.29 31.08.2009 16:42:40 bglav Exp $
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef PROV_TUPLEID_H_
+#define PROV_TUPLEID_H_
+
+#include "fmgr.h"
+
+extern Datum prov_fetch_tuples_by_tid (PG_FUNCTION_ARGS);
+extern Datum prov_fetch_tuples_by_oid (PG_FUNCTION_ARGS);
+
+#endif /* PROV_TUPLEID_H_ */
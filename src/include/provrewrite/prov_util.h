@@ -129,9 +129,13 @@ extern List *findBaseRelationsForProvenanceQuery (Query *query);
 extern void findBaseRelationsForProvenanceRTE (RangeTblEntry *rte,
 		List **result);
 extern void getRTindexForProvTE (Query *query, Var* var);
+extern void getRTindexForProvTEs (Query *query, List *vars);
 
 /* node creation support functions */
 extern Query *generateQueryFromBaseRelation (RangeTblEntry *rte);
+extern void expandProvBaseRelation (RangeTblEntry *rte, int rtindex, bool tupleIds,
+		List **colnames, List **colvars);
+extern AttrNumber getProvAttrAttno (Query *query, Index rtindex, TargetEntry *te);
 extern RangeTblEntry *generateQueryRTEFromRelRTE (RangeTblEntry *rte);
 extern void addSubqueryToRTWithParam (Query *query, Query *subQuery,
 		char *aliasName, bool inFrom, AclMode reqPerms, bool append);
@@ -156,6 +160,7 @@ extern Node *createEqualityConditionForNodes (Node *left, Node *right);
 extern Node *createSmallerCondition (Node *left, Node *right);
 extern Node *createSmallerEqCondition (Node *left, Node *right);
 extern Node *createBiggerCondition (Node *left, Node *right);
+extern Node *createBiggerEqCondition (Node *left, Node *right);
 extern Node *createNotDistinctConditionForVars (Var *leftChild,
 		Var *rightChild);
 extern Node *createAndFromList (List *exprs);
@@ -181,6 +186,7 @@ extern ComparisonType getComparisonType (Node *node);
 extern bool isConstExpr (Node *node);
 extern TargetEntry *findTeForVar (Var *var, List *targetList);
 extern bool hasOuterJoins (Query *query);
+extern bool isNotNullExpr (Query *query, Node *expr);
 extern char *getAlias (RangeTblEntry *rte);
 extern Var *resolveToRteVar (Var *var, Query *query);
 
@@ -29,7 +29,14 @@ typedef struct RTEref {
 	int refCounter;
 } RTEref;
 
+/* the provenance attributes of a base relation access */
+typedef struct ProvAttrAccess {
+	char *accessName;
+	List *attrNames;
+} ProvAttrAccess;
+
 extern char *createProvAttrName (RangeTblEntry *rte, char *name);
+extern char *createProvAttrRelPrefix (RangeTblEntry *rte);
 extern char *getRelationName (Oid relid);
 extern char *getRelationNameUnqualified (Oid relid);
 extern char *getQueryName (RangeTblEntry *rte);
@@ -37,6 +44,9 @@ extern int getRelationRefNum (Oid relid, bool increment);
 extern int getQueryRefNum (RangeTblEntry *rte, bool increment);
 extern void resetRelReferences (void);
 extern bool isProvAttr (TargetEntry *te);
+extern ProvAttrAccess *addProvAttrAccess (char *accessName);
+extern void addProvAttrAccessAttr (ProvAttrAccess *access, char *attrName);
+extern ProvAttrAccess *getProvAttrAccess (char *name);
 extern char *createExternalProvAttrName (char *name);
 
 #endif /*PROVATTRNAME_H_*/
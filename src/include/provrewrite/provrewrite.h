@@ -18,6 +18,8 @@
 //#include "provrewrite/prov_set.h"
 
 
+/* global variables */
+extern bool provRewriteCacheable;
 
 /* function prototypes */
 extern List *provenanceRewriteQueryList (List *queries);
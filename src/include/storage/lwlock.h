@@ -27,6 +27,9 @@
 #define LOG2_NUM_LOCK_PARTITIONS  4
 #define NUM_LOCK_PARTITIONS  (1 << LOG2_NUM_LOCK_PARTITIONS)
 
+/* Number of partitions of the shared provenance rewrite cache */
+#define NUM_PROV_CACHE_PARTITIONS  16
+
 /*
  * We have a number of predefined LWLocks, plus a bunch of LWLocks that are
  * dynamically assigned (e.g., for shared buffers).  The LWLock structures
@@ -66,9 +69,10 @@ typedef enum LWLockId
 	/* Individual lock IDs end here */
 	FirstBufMappingLock,
 	FirstLockMgrLock = FirstBufMappingLock + NUM_BUFFER_PARTITIONS,
+	FirstProvCacheLock = FirstLockMgrLock + NUM_LOCK_PARTITIONS,
 
 	/* must be last except for MaxDynamicLWLock: */
-	NumFixedLWLocks = FirstLockMgrLock + NUM_LOCK_PARTITIONS,
+	NumFixedLWLocks = FirstProvCacheLock + NUM_PROV_CACHE_PARTITIONS,
 
 	MaxDynamicLWLock = 1000000000
 } LWLockId;
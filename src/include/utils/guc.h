@@ -148,13 +148,25 @@ extern int	tcp_keepalives_count;
 /* provenance module configuration parameters */
 extern bool prov_use_set_optimization;
 extern bool prov_use_wl_union_semantics;
+extern bool prov_use_tagged_union;
 extern bool prov_use_sublink_optimization_left_join;
 extern bool prov_use_sublink_move_to_target;
 extern bool prov_use_sublink_transfrom_top_level_any_to_join;
 extern bool prov_use_unnest_JA;
 extern bool prov_use_optimizer;
 extern bool prov_use_selection_pushdown;
+extern bool prov_use_inequality_deduction;
+extern bool prov_use_aggr_single_pass;
+extern bool prov_use_rewrite_cache;
+extern bool prov_use_lazy_cursors;
+extern bool prov_use_sublink_memoization;
+extern bool prov_use_anti_join;
+extern int prov_rewrite_cache_size;
+extern int prov_xml_query_cache_size;
+extern int prov_shared_cache_size;
+extern double prov_optimizer_plan_share;
 extern bool prov_xml_whitespace;
+extern char *prov_lineage_relation;
 
 extern void SetConfigOption(const char *name, const char *value,
 				GucContext context, GucSource source);
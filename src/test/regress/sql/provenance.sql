@@ -357,6 +357,28 @@ CREATE VIEW provview2 AS
 -- view with provenance subselect
 CREATE VIEW subprovview AS SELECT * FROM (SELECT PROVENANCE * FROM bagdiff1) AS prov WHERE prov_public_bagdiff1_id > 1; --check
 
+/******************************************************************************
+******* 	helper functions		   ****************************
+******************************************************************************/
+
+-- the lines of the plan of query that match pattern. Only the estimated
+-- number of rows is kept, costs, widths and run times are removed. query may
+-- start with ANALYZE.
+CREATE FUNCTION explain_filter(query text, pattern text) RETURNS SETOF text AS $$
+DECLARE
+	line record;
+BEGIN
+	FOR line IN EXECUTE 'EXPLAIN ' || query LOOP
+		IF line."QUERY PLAN" ~ pattern THEN
+			RETURN NEXT regexp_replace(regexp_replace(trim(line."QUERY PLAN"),
+				E'\\(cost=[0-9.]+ (rows=[0-9]+) width=[0-9]+\\)', E'(\\1)'),
+				E' \\(actual time=[^)]*\\)', '');
+		END IF;
+	END LOOP;
+	RETURN;
+END;
+$$ LANGUAGE plpgsql;
+
 /******************************************************************************
 *******************************************************************************
 *******************************************************************************
@@ -596,6 +618,23 @@ SELECT PROVENANCE DISTINCT sum(id) FROM employee;
 
 SELECT PROVENANCE DISTINCT * FROM (SELECT sum(id) FROM employee) AS sub;
 
+/************* single pass aggregation queries*************************/
+SET prov_use_aggr_single_pass TO on;
+
+SELECT * FROM (SELECT PROVENANCE sum(four) AS sum FROM muchcols GROUP BY one) AS p ORDER BY 1,2,3;
+
+SELECT * FROM (SELECT PROVENANCE sum(four) AS sum FROM muchcols GROUP BY one HAVING sum(four) > 1000) AS p ORDER BY 1,2,3;
+
+SELECT * FROM (SELECT PROVENANCE count(*) FROM bagdiff3) AS p ORDER BY 1,2;
+
+SELECT PROVENANCE count(*) FROM bagdiff5;
+
+SELECT * FROM (SELECT PROVENANCE sum(id) FROM bagdiff3 GROUP BY (id < 3)) AS p ORDER BY 1,2;
+
+SELECT * FROM (SELECT PROVENANCE sum(sub.sum) FROM (SELECT sum(id) AS sum FROM aggr GROUP BY (id / 8)) AS sub) AS p ORDER BY 2;
+
+RESET prov_use_aggr_single_pass;
+
 /******************************************************************************
 ******* 	set operation Queries		   ****************************
 ******************************************************************************/
@@ -1015,6 +1054,662 @@ SELECT PROVENANCE name || last_name
 				prov_public_shop_id , prov_public_shop_name, prov_public_shop_location_id , prov_public_shop_manager_id ,
 				prov_public_employee_works_at_shop_employee_id , prov_public_employee_works_at_shop_shop_id); 
 
+/******************************************************************************
+******* 	Cached provenance queries		   ****************************
+******************************************************************************/
+SET prov_use_rewrite_cache TO on;
+
+CREATE TABLE cachetest (id int, val int);
+INSERT INTO cachetest VALUES (1,10), (2,20), (2,30);
+
+SELECT PROVENANCE id, sum(val) FROM cachetest GROUP BY id ORDER BY id;
+
+SELECT PROVENANCE   id, sum(val)
+	FROM cachetest GROUP BY id ORDER BY id;
+
+-- invalidated by schema change
+ALTER TABLE cachetest ADD COLUMN other int;
+
+SELECT PROVENANCE id, sum(val) FROM cachetest GROUP BY id ORDER BY id;
+
+-- different rewriter options are cached separately
+SET prov_use_aggr_single_pass TO on;
+
+SELECT PROVENANCE id, sum(val) FROM cachetest GROUP BY id ORDER BY id;
+
+RESET prov_use_aggr_single_pass;
+
+DROP TABLE cachetest;
+RESET prov_use_rewrite_cache;
+
+/******************************************************************************
+******* 	TUPLEID provenance		   ****************************
+******************************************************************************/
+CREATE TABLE tupleidtest (id int, val int);
+INSERT INTO tupleidtest VALUES (1,10), (2,20), (2,30);
+CREATE TABLE tupleidoids (id int) WITH OIDS;
+INSERT INTO tupleidoids VALUES (1), (2), (3);
+
+SELECT PROVENANCE ON CONTRIBUTION (TUPLEID) * FROM tupleidtest WHERE id = 2;
+
+SELECT * FROM (SELECT PROVENANCE ON CONTRIBUTION (TUPLEID) id, sum(val) FROM tupleidtest GROUP BY id) AS p ORDER BY 1,3;
+
+SELECT PROVENANCE ON CONTRIBUTION (TUPLEID) a.id, b.val FROM tupleidtest a, tupleidtest b WHERE a.id = b.id AND a.val < b.val;
+
+SELECT count(*) FROM (SELECT PROVENANCE ON CONTRIBUTION (TUPLEID) id FROM tupleidoids) AS p, tupleidoids t WHERE p.prov_public_tupleidoids_oid = t.oid AND p.id = t.id;
+
+SELECT * FROM (SELECT PROVENANCE ON CONTRIBUTION (TUPLEID) a.id, b.val FROM tupleidtest a JOIN tupleidtest b ON (a.id = b.id) LEFT JOIN tupleidtest c ON (c.val = b.val + 10)) AS p ORDER BY 3,4,5;
+
+SELECT * FROM prov_fetch_tuples(NULL::tupleidtest, ARRAY['(0,3)','(0,1)','(0,1)','(5,1)',NULL]::tid[]);
+
+SELECT * FROM prov_fetch_tuples(NULL::tupleidoids, ARRAY(SELECT oid FROM tupleidoids WHERE id > 1)) ORDER BY id;
+
+SELECT * FROM prov_fetch_tuples(NULL::tupleidtest, ARRAY[1]::oid[]);
+
+DROP TABLE tupleidtest;
+DROP TABLE tupleidoids;
+
+/******************************************************************************
+******* 	transformation provenance bitsets	   ********************
+******************************************************************************/
+SELECT bitor_with_null(B'0001', NULL), bitor_with_null(NULL, B'0110'), bitor_with_null(B'0001', B'1000');
+
+SELECT bitor_with_null(B'100000000000000000000000000000000000000000000000000000000000000000001', B'000000000000000000000000000000000000000000000000000000000000000000010');
+
+SELECT bitoragg(x) FROM (VALUES (B'0001'::varbit), (NULL), (B'0100'::varbit), (B'0101'::varbit)) v(x);
+
+SELECT i % 2 AS g, bitoragg(CASE WHEN i % 3 = 0 THEN B'100000000000000000000000000000000000000000000000000000000000000000001'::varbit ELSE B'010000000000000000000000000000000000000000000000000000000000000000000'::varbit END) FROM generate_series(1,1000) i GROUP BY i % 2 ORDER BY 1;
+
+/******************************************************************************
+******* 	transformation provenance representation	   ************
+******************************************************************************/
+CREATE TABLE transtest (a int, b int);
+INSERT INTO transtest SELECT i % 3, i FROM generate_series(1,300) i;
+CREATE TABLE transtest2 (c int);
+INSERT INTO transtest2 VALUES (1), (2);
+
+SELECT TRANSSQL t.a, u.c FROM transtest t LEFT JOIN transtest2 u ON (t.a = u.c) WHERE t.b < 5 ORDER BY 1;
+
+SELECT trans_prov, count(*) FROM (SELECT TRANSSQL t.a, u.c FROM transtest t LEFT JOIN transtest2 u ON (t.a = u.c)) x GROUP BY trans_prov ORDER BY 2;
+
+DROP TABLE transtest;
+DROP TABLE transtest2;
+
+/******************************************************************************
+******* 	copy contribution semantics inclusion bitsets	   ************
+******************************************************************************/
+CREATE TABLE copyincl (a int, b int, c text);
+INSERT INTO copyincl VALUES (1,1,'x'), (2,3,'y'), (3,3,'z'), (4,NULL,'w');
+
+SELECT PROVENANCE ON CONTRIBUTION (COPY COMPLETE TRANSITIVE) x, z FROM (SELECT CASE WHEN a > 2 THEN b ELSE a END AS x, c AS z FROM copyincl) s ORDER BY 1;
+
+SELECT PROVENANCE ON CONTRIBUTION (COPY PARTIAL TRANSITIVE) x FROM (SELECT CASE WHEN a > 2 THEN b ELSE a END AS x, c FROM copyincl) s ORDER BY 1;
+
+SELECT bitset_set_bits_if(B'1000', ARRAY[2,3,4], ARRAY[true,NULL,false]);
+
+SELECT bitset_set_bits_if(B'0000', ARRAY[5], ARRAY[true]);
+
+DROP TABLE copyincl;
+
+/******************************************************************************
+ * materialized provenance views
+ *****************************************************************************/
+CREATE TABLE matr (a int, b int);
+CREATE TABLE mats (c int, d text);
+INSERT INTO matr VALUES (1,1), (2,1), (3,2);
+INSERT INTO mats VALUES (1,'x'), (2,'y'), (3,'z');
+
+-- incrementally maintained SPJ, self join and aggregation views, fully recomputed views
+CREATE MATERIALIZED PROVENANCE VIEW matspj AS SELECT a, d FROM matr JOIN mats ON (a = c);
+CREATE MATERIALIZED PROVENANCE VIEW matself AS SELECT x.a, y.a AS a2 FROM matr x, matr y WHERE x.b = y.b;
+CREATE MATERIALIZED PROVENANCE VIEW matagg AS SELECT b, sum(a) AS s FROM matr GROUP BY b;
+CREATE MATERIALIZED PROVENANCE VIEW matouter AS SELECT a, d FROM matr LEFT JOIN mats ON (a = c);
+
+SELECT c.relname, t.tgtype, t.tgnargs FROM pg_trigger t, pg_class c
+	WHERE t.tgrelid = c.oid AND t.tgname LIKE 'prov_matview_%' ORDER BY 1, 2, 3;
+
+SELECT * FROM matspj ORDER BY 1,2,3,4,5,6;
+SELECT * FROM matagg ORDER BY 1,2,3,4;
+
+-- views in the definition may contain any operator, the view is recomputed completely
+CREATE VIEW matrpos AS SELECT a, b FROM matr WHERE a > 0;
+CREATE VIEW matrdist AS SELECT DISTINCT b FROM matr;
+CREATE MATERIALIZED PROVENANCE VIEW matspjview AS SELECT a, d FROM matrpos JOIN mats ON (a = c);
+CREATE MATERIALIZED PROVENANCE VIEW matdistview AS SELECT b FROM matrdist;
+SELECT m.relname, c.relname, t.tgtype FROM pg_trigger t, pg_class c, pg_class m
+	WHERE t.tgrelid = c.oid AND t.tgname = 'prov_matview_' || m.oid::text
+	AND m.relname IN ('matspjview', 'matdistview') ORDER BY 1, 2;
+
+INSERT INTO matr VALUES (2,2), (NULL,1);
+INSERT INTO mats VALUES (2,'w');
+UPDATE matr SET b = 3 WHERE a = 1;
+DELETE FROM mats WHERE c = 3;
+DELETE FROM matr WHERE a = 2 AND b = 1;
+
+SELECT * FROM matspj ORDER BY 1,2,3,4,5,6;
+SELECT * FROM matagg ORDER BY 1,2,3,4;
+(SELECT * FROM matspj EXCEPT ALL SELECT * FROM matspj_provdef) UNION ALL (SELECT * FROM matspj_provdef EXCEPT ALL SELECT * FROM matspj);
+(SELECT * FROM matself EXCEPT ALL SELECT * FROM matself_provdef) UNION ALL (SELECT * FROM matself_provdef EXCEPT ALL SELECT * FROM matself);
+(SELECT * FROM matagg EXCEPT ALL SELECT * FROM matagg_provdef) UNION ALL (SELECT * FROM matagg_provdef EXCEPT ALL SELECT * FROM matagg);
+(SELECT * FROM matouter EXCEPT ALL SELECT * FROM matouter_provdef) UNION ALL (SELECT * FROM matouter_provdef EXCEPT ALL SELECT * FROM matouter);
+(SELECT * FROM matspjview EXCEPT ALL SELECT * FROM matspjview_provdef) UNION ALL (SELECT * FROM matspjview_provdef EXCEPT ALL SELECT * FROM matspjview);
+
+-- maintenance is serialized by a lock on the view that is held until commit
+BEGIN;
+INSERT INTO mats VALUES (4,'v');
+SELECT c.relname, l.mode FROM pg_locks l, pg_class c
+	WHERE l.relation = c.oid AND l.pid = pg_backend_pid() AND c.relname IN ('matspj', 'matouter')
+	ORDER BY 1, 2;
+COMMIT;
+
+-- dropping the view drops its definition and triggers
+DROP TABLE matspj, matself, matagg, matouter, matspjview, matdistview;
+SELECT count(*) FROM pg_class WHERE relname LIKE 'mat%_provdef';
+SELECT count(*) FROM pg_trigger WHERE tgname LIKE 'prov_matview_%';
+
+DROP VIEW matrpos, matrdist;
+DROP TABLE matr, mats;
+
+/******************************************************************************
+ * lazy provenance cursors
+ *****************************************************************************/
+CREATE TABLE lazyr (a int, b int);
+CREATE TABLE lazys (c int, d text);
+INSERT INTO lazyr VALUES (1,1), (1,2), (2,1), (3,NULL), (NULL,4);
+INSERT INTO lazys VALUES (1,'x'), (2,'y'), (3,'z'), (1,'w');
+
+SET prov_use_lazy_cursors TO on;
+
+-- SPJ query with duplicates and NULLs
+BEGIN;
+DECLARE lazyc CURSOR FOR SELECT PROVENANCE a FROM lazyr ORDER BY a;
+FETCH 2 FROM lazyc;
+FETCH 2 FROM lazyc;
+FETCH ALL FROM lazyc;
+FETCH 1 FROM lazyc;
+CLOSE lazyc;
+
+-- equal rows are distinguished by their identity, not by their values
+DECLARE lazyd CURSOR FOR SELECT PROVENANCE a FROM lazyr WHERE a = 1;
+FETCH 1 FROM lazyd;
+FETCH 1 FROM lazyd;
+DECLARE lazyg CURSOR FOR SELECT PROVENANCE count(*) AS cnt FROM lazyr GROUP BY b ORDER BY cnt, b;
+FETCH 2 FROM lazyg;
+DECLARE lazysq CURSOR FOR SELECT PROVENANCE x FROM (SELECT a AS x FROM lazyr WHERE a IS NOT NULL) s ORDER BY x;
+FETCH 3 FROM lazysq;
+
+-- join and aggregation
+DECLARE lazyj CURSOR FOR SELECT PROVENANCE a, d FROM lazyr JOIN lazys ON (a = c) ORDER BY d, b;
+FETCH 2 FROM lazyj;
+MOVE 1 IN lazyj;
+FETCH ALL FROM lazyj;
+DECLARE lazya CURSOR FOR SELECT PROVENANCE b, count(*) AS cnt FROM lazyr GROUP BY b ORDER BY b;
+FETCH 3 FROM lazya;
+COMMIT;
+
+-- copy contribution semantics
+BEGIN;
+DECLARE lazycp CURSOR FOR SELECT PROVENANCE ON CONTRIBUTION (COPY PARTIAL) a, d FROM lazyr JOIN lazys ON (a = c) ORDER BY d, b;
+FETCH 2 FROM lazycp;
+COMMIT;
+
+-- cursors closed at the end of a transaction
+BEGIN;
+DECLARE lazye CURSOR FOR SELECT PROVENANCE a FROM lazyr WHERE a = 2;
+ROLLBACK;
+DECLARE lazye CURSOR FOR SELECT PROVENANCE a FROM lazyr WHERE a = 2;
+BEGIN;
+DECLARE lazye CURSOR FOR SELECT PROVENANCE a FROM lazyr WHERE a = 3;
+FETCH ALL FROM lazye;
+COMMIT;
+
+-- the same cursors computed eagerly
+SET prov_use_lazy_cursors TO off;
+BEGIN;
+DECLARE lazyj CURSOR FOR SELECT PROVENANCE a, d FROM lazyr JOIN lazys ON (a = c) ORDER BY d, b;
+FETCH 2 FROM lazyj;
+COMMIT;
+
+RESET prov_use_lazy_cursors;
+DROP TABLE lazyr, lazys;
+
+/******************************************************************************
+ * provenance rewrite statistics
+ *****************************************************************************/
+SELECT phase FROM pg_stat_provenance;
+SELECT count(*) FROM pg_stat_provenance WHERE calls < 0 OR total_time < 0 OR nodes < 0 OR bytes < 0;
+
+/******************************************************************************
+ * list helpers of the rewriter (duplicate conjuncts, sorted group by, copy
+ * maps with equalities)
+ *****************************************************************************/
+CREATE TABLE lst1 (a int, b int);
+CREATE TABLE lst2 (c int, d int);
+INSERT INTO lst1 VALUES (1,1), (2,2), (3,3), (3,4);
+INSERT INTO lst2 VALUES (1,5), (2,6), (3,7);
+
+SET prov_use_selection_pushdown TO on;
+SELECT PROVENANCE * FROM (SELECT * FROM lst1 JOIN lst2 ON (a = c)) x WHERE a > 1 AND a > 1 AND b < 4 AND a > 1 AND b < 4 ORDER BY a;
+RESET prov_use_selection_pushdown;
+
+SELECT PROVENANCE b, a, count(*) FROM lst1 GROUP BY b, a ORDER BY a, b;
+SELECT PROVENANCE ON CONTRIBUTION (COPY COMPLETE TRANSITIVE) a, d FROM lst1 JOIN lst2 ON (a = c) WHERE b = a ORDER BY a;
+
+DROP TABLE lst1, lst2;
+
+/******************************************************************************
+ * inequality deduction: transitive closure of the inequalities of a
+ * selection scope (contradictions and derived constant bounds)
+ *****************************************************************************/
+CREATE TABLE ineq1 (a int, b int, c int);
+CREATE TABLE ineq2 (d int, e int);
+INSERT INTO ineq1 VALUES (1,2,3), (2,1,3), (3,4,5), (6,6,6);
+INSERT INTO ineq2 VALUES (1,2), (4,3), (5,7);
+
+SET prov_use_selection_pushdown TO on;
+SET prov_use_inequality_deduction TO on;
+
+-- "<"-cycles are contradictions, "<="-cycles are not
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a < b AND b < c AND c < a', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a <= b AND b < c AND c <= a', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a <= b AND b <= a', 'Filter');
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a <= b AND b <= a;
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a < b AND b < c AND c < a;
+
+-- constants are ordered by their values
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a < 5 AND a > 7', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a < 5 AND a >= 5', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a = 5 AND a = 7', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x WHERE a < 5 AND a < 3 AND a <= 3', 'Filter');
+
+-- derived bounds are pushed down to the other side of a join
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b < e) WHERE e < 5 AND 2 <= e', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b = e) WHERE e <= 3 AND a < b', 'Filter');
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b <= e AND e <= 3 AND e < 7)', 'Filter');
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b < e) WHERE e < 5 AND 2 <= e ORDER BY a, d;
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b = e) WHERE e <= 3 AND a < b ORDER BY a, d;
+
+-- a contradiction in the condition of an outer join only removes the matches
+SELECT * FROM explain_filter('SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x LEFT JOIN ineq2 ON (b < e AND e < 3 AND e > 4)', 'Filter');
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x LEFT JOIN ineq2 ON (b < e AND e < 3 AND e > 4) ORDER BY a, b;
+
+-- same results without deduction
+RESET prov_use_inequality_deduction;
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b < e) WHERE e < 5 AND 2 <= e ORDER BY a, d;
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x JOIN ineq2 ON (b = e) WHERE e <= 3 AND a < b ORDER BY a, d;
+SELECT * FROM (SELECT PROVENANCE * FROM ineq1) x LEFT JOIN ineq2 ON (b < e AND e < 3 AND e > 4) ORDER BY a, b;
+RESET prov_use_selection_pushdown;
+
+DROP TABLE ineq1, ineq2;
+
+/******************************************************************************
+ * normalized provenance output (FORMAT NORMALIZED)
+ *****************************************************************************/
+CREATE TABLE norm1 (a int, b text);
+CREATE TABLE norm2 (c int, my_d text);
+INSERT INTO norm1 VALUES (1,'x'), (1,'y'), (2,'x');
+INSERT INTO norm2 VALUES (1,'p'), (1,'q'), (3,'z');
+
+SELECT PROVENANCE FORMAT NORMALIZED a FROM norm1;
+SELECT PROVENANCE FORMAT NORMALIZED a, my_d FROM norm1 JOIN norm2 ON (a = c) ORDER BY a, my_d;
+SELECT PROVENANCE FORMAT NORMALIZED a, b, my_d FROM norm1 LEFT JOIN norm2 ON (a = c) ORDER BY a, b, my_d;
+SELECT PROVENANCE FORMAT NORMALIZED x.a, y.b FROM norm1 x, norm1 y WHERE x.a = y.a AND x.b = 'x' ORDER BY x.a, y.b;
+SELECT PROVENANCE ON CONTRIBUTION (COPY PARTIAL TRANSITIVE) FORMAT NORMALIZED a FROM norm1;
+
+-- a column named format
+SELECT PROVENANCE format FROM (SELECT 1 AS format) f;
+
+-- FORMAT NORMALIZED is only recognized after PROVENANCE
+CREATE TABLE format (a int);
+INSERT INTO format VALUES (1);
+SELECT normalized.a FROM format normalized;
+SELECT PROVENANCE FORMAT NORMALIZED normalized.a FROM format normalized;
+DROP TABLE format;
+
+-- provenance attribute names that are truncated to NAMEDATALEN
+CREATE TABLE norm_relation_with_a_name_of_nearly_sixty_three_characters (a_b int, c__d int);
+INSERT INTO norm_relation_with_a_name_of_nearly_sixty_three_characters VALUES (1,2), (1,3);
+SELECT PROVENANCE FORMAT NORMALIZED x.a_b, y.c__d FROM norm_relation_with_a_name_of_nearly_sixty_three_characters x, norm_relation_with_a_name_of_nearly_sixty_three_characters y WHERE x.c__d = 2;
+DROP TABLE norm_relation_with_a_name_of_nearly_sixty_three_characters;
+
+-- only allowed for a top-level query
+SELECT * FROM (SELECT PROVENANCE FORMAT NORMALIZED a FROM norm1) x;
+SELECT PROVENANCE FORMAT NORMALIZED a FROM norm1 UNION SELECT c FROM norm2;
+CREATE VIEW normview AS SELECT PROVENANCE FORMAT NORMALIZED a FROM norm1;
+SELECT PROVENANCE FORMAT NORMALIZED a FROM norm1 FOR UPDATE;
+
+/******************************************************************************
+ * size estimates of the joins of an operator result with its rewritten input
+ *****************************************************************************/
+CREATE TABLE provest1 (a int, b int, c int);
+CREATE TABLE provest2 (a int, b int);
+INSERT INTO provest1 SELECT i % 10, i % 7, i FROM generate_series(1,3000) i;
+INSERT INTO provest2 SELECT i % 50, i FROM generate_series(1,1000) i;
+ANALYZE provest1;
+ANALYZE provest2;
+
+SELECT * FROM explain_filter('SELECT PROVENANCE a, b, sum(c) FROM provest1 GROUP BY a, b', '^[^ ]|Provenance Join');
+SELECT * FROM explain_filter('SELECT PROVENANCE sum(c) FROM provest1', '^[^ ]|Provenance Join');
+SELECT * FROM explain_filter('SELECT PROVENANCE x.a, count(*) FROM provest1 x, provest2 y WHERE x.a = y.a GROUP BY x.a', '^[^ ]|Provenance Join');
+SELECT * FROM explain_filter('SELECT PROVENANCE x.a, y.b, count(*) FROM provest1 x, provest2 y, provest2 z WHERE x.a = y.a AND y.b = z.b GROUP BY x.a, y.b', '^[^ ]|Provenance Join');
+SELECT * FROM explain_filter('SELECT PROVENANCE * FROM (SELECT a FROM provest1 INTERSECT SELECT a FROM provest2) AS sub', '^[^ ]|Provenance Join');
+
+DROP TABLE provest1, provest2;
+
+/******************************************************************************
+ * top-k queries: join conditions on attributes that are never NULL
+ *****************************************************************************/
+CREATE TABLE provtopk (id int PRIMARY KEY, g int NOT NULL, h int, v int);
+INSERT INTO provtopk SELECT i, i % 30, CASE WHEN i % 7 = 0 THEN NULL ELSE i % 5 END, i FROM generate_series(1,3000) i;
+CREATE INDEX provtopk_g ON provtopk (g);
+ANALYZE provtopk;
+
+-- group by attribute is never NULL, the input is probed with the top groups
+SELECT g, s, count(*) FROM (SELECT PROVENANCE g, sum(v) AS s FROM provtopk GROUP BY g ORDER BY g LIMIT 2) p GROUP BY g, s ORDER BY g;
+SELECT * FROM explain_filter('SELECT PROVENANCE g, sum(v) FROM provtopk GROUP BY g ORDER BY g LIMIT 2', 'Nested Loop|Join|Filter|Cond');
+
+-- nullable group by attribute, the NULL group keeps its provenance
+SELECT h, c, count(*) FROM (SELECT PROVENANCE h, count(*) AS c FROM provtopk GROUP BY h ORDER BY h LIMIT 2 OFFSET 4) p GROUP BY h, c ORDER BY h;
+SELECT * FROM explain_filter('SELECT PROVENANCE h, count(*) FROM provtopk GROUP BY h ORDER BY h LIMIT 2 OFFSET 4', 'Nested Loop|Join|Filter|Cond');
+
+-- SPJ query with LIMIT
+SELECT g, count(*) FROM (SELECT PROVENANCE DISTINCT g FROM provtopk ORDER BY g LIMIT 2) p GROUP BY g ORDER BY g;
+SELECT * FROM explain_filter('SELECT PROVENANCE DISTINCT g FROM provtopk ORDER BY g LIMIT 2', 'Nested Loop|Join|Filter|Cond');
+
+-- NOT NULL attribute followed by a nullable attribute, the rows with a NULL h keep their provenance
+SELECT g, h, count(*) FROM (SELECT PROVENANCE DISTINCT g, h FROM provtopk ORDER BY g, h LIMIT 4) p GROUP BY g, h ORDER BY g, h;
+
+DROP TABLE provtopk;
+
+/******************************************************************************
+ * rewritten provenance queries shared between sessions
+ *****************************************************************************/
+CREATE TABLE sharedcache (id int, val int);
+INSERT INTO sharedcache VALUES (1,10), (2,20), (2,30);
+
+SET prov_use_rewrite_cache TO on;
+SELECT PROVENANCE id, sum(val) FROM sharedcache GROUP BY id ORDER BY id;
+
+-- a new session uses the query rewritten by the first one
+\c -
+SET prov_use_rewrite_cache TO on;
+SELECT PROVENANCE id, sum(val) FROM sharedcache GROUP BY id ORDER BY id;
+
+-- invalidated by schema change
+ALTER TABLE sharedcache ADD COLUMN other int;
+\c -
+SET prov_use_rewrite_cache TO on;
+SELECT PROVENANCE id, sum(val) FROM sharedcache GROUP BY id ORDER BY id;
+
+-- a temporary table hides the shared table, the shared entry is not used
+\c -
+SET prov_use_rewrite_cache TO on;
+SELECT id, s FROM (SELECT PROVENANCE id, sum(val) AS s FROM sharedcache GROUP BY id) p ORDER BY id;
+\c -
+SET prov_use_rewrite_cache TO on;
+CREATE TEMP TABLE sharedcache (id int, val int);
+INSERT INTO sharedcache VALUES (5,50);
+SELECT id, s FROM (SELECT PROVENANCE id, sum(val) AS s FROM sharedcache GROUP BY id) p ORDER BY id;
+\c -
+SET prov_use_rewrite_cache TO on;
+SELECT id, s FROM (SELECT PROVENANCE id, sum(val) AS s FROM sharedcache GROUP BY id) p ORDER BY id;
+
+DROP TABLE sharedcache;
+RESET prov_use_rewrite_cache;
+
+/******************************************************************************
+ * lineage of stored provenance query results
+ *****************************************************************************/
+CREATE TABLE linsrc (a int, b int);
+CREATE TABLE linsrc2 (c int, d int) WITH OIDS;
+INSERT INTO linsrc VALUES (1,10), (1,20), (2,30), (3,40);
+INSERT INTO linsrc2 VALUES (1,100), (2,200), (2,201);
+CREATE TABLE lineage (target_rel oid, target_tid tid, source_rel oid, source_tid tid);
+CREATE INDEX lineage_target ON lineage (target_rel, target_tid);
+CREATE TABLE lintgt (a int, s int);
+
+SET prov_lineage_relation TO 'lineage';
+
+-- SPJ query, one record per result tuple
+INSERT INTO lintgt SELECT PROVENANCE a, b FROM linsrc WHERE a < 3;
+SELECT t.a, t.s, l.source_rel::regclass, l.source_tid FROM lintgt t, lineage l WHERE l.target_rel = 'lintgt'::regclass AND l.target_tid = t.ctid ORDER BY t.a, t.s, 3, 4;
+DELETE FROM lineage;
+DELETE FROM lintgt;
+
+-- aggregation, records are not repeated for the same result tuple
+INSERT INTO lintgt SELECT PROVENANCE a, sum(b) FROM linsrc JOIN linsrc2 ON (a = c) GROUP BY a;
+SELECT t.a, t.s, l.source_rel::regclass, l.source_tid FROM lintgt t, lineage l WHERE l.target_rel = 'lintgt'::regclass AND l.target_tid = t.ctid ORDER BY t.a, t.s, 3, 4;
+DELETE FROM lineage;
+
+-- set operation and DISTINCT with SELECT INTO
+INSERT INTO lintgt SELECT PROVENANCE * FROM (SELECT a FROM linsrc UNION SELECT c FROM linsrc2) u;
+SELECT t.a, l.source_rel::regclass, l.source_tid FROM lintgt t, lineage l WHERE l.target_rel = 'lintgt'::regclass AND l.target_tid = t.ctid ORDER BY t.a, 2, 3;
+SELECT PROVENANCE DISTINCT a INTO lincopy FROM linsrc;
+SELECT t.a, l.source_rel::regclass, l.source_tid FROM lincopy t, lineage l WHERE l.target_rel = 'lincopy'::regclass AND l.target_tid = t.ctid ORDER BY t.a, 2, 3;
+
+-- unsupported queries
+INSERT INTO lintgt SELECT PROVENANCE a, b FROM linsrc LIMIT 1;
+INSERT INTO lintgt SELECT PROVENANCE ON CONTRIBUTION (COPY PARTIAL TRANSITIVE) a, b FROM linsrc;
+INSERT INTO lintgt SELECT PROVENANCE * FROM (SELECT a FROM linsrc UNION ALL SELECT c FROM linsrc2) u;
+
+-- nothing is recorded without a lineage relation
+RESET prov_lineage_relation;
+DELETE FROM lineage;
+INSERT INTO lintgt SELECT PROVENANCE a, b FROM linsrc WHERE a = 3;
+SELECT count(*) FROM lineage;
+
+DROP TABLE linsrc, linsrc2, lineage, lintgt, lincopy;
+
+/******************************************************************************
+ * batches of provenance queries with shared subexpressions
+ *****************************************************************************/
+CREATE TABLE batchr (a int, b int);
+CREATE TABLE batchs (c int, d int);
+INSERT INTO batchr SELECT i, i % 10 FROM generate_series(1,200) i;
+INSERT INTO batchs SELECT i % 10, i FROM generate_series(1,20) i;
+ANALYZE batchr;
+ANALYZE batchs;
+
+-- queries with the same FROM clause share the join and the common conjuncts
+SELECT * FROM provenance_batch(ARRAY[
+	'SELECT PROVENANCE a, d FROM batchr JOIN batchs ON (b = c) WHERE b < 3 AND a < 12',
+	'SELECT PROVENANCE d FROM batchr JOIN batchs ON (b = c) WHERE b < 3 AND d > a',
+	'SELECT count(*) FROM batchr',
+	'SELECT PROVENANCE DISTINCT b FROM batchr JOIN batchs ON (b = c) WHERE b < 3 AND a < 5']) ORDER BY query, result;
+
+-- same results as the queries executed one by one
+SELECT * FROM (SELECT PROVENANCE a, d FROM batchr JOIN batchs ON (b = c) WHERE b < 3 AND a < 12) p ORDER BY 1, 2, 3, 4, 5, 6;
+SELECT * FROM (SELECT PROVENANCE d FROM batchr JOIN batchs ON (b = c) WHERE b < 3 AND d > a) p ORDER BY 1, 2, 3, 4, 5;
+
+-- the result rows of each query keep their order
+SELECT * FROM provenance_batch(ARRAY[
+	'SELECT PROVENANCE a FROM batchr JOIN batchs ON (b = c) WHERE d = 3 ORDER BY a DESC LIMIT 3',
+	'SELECT PROVENANCE a FROM batchr JOIN batchs ON (b = c) WHERE d = 3 ORDER BY a LIMIT 3']);
+
+-- the shared subexpressions are not kept
+SELECT count(*) FROM pg_class WHERE relname LIKE 'prov_batch_shared%';
+
+-- only single SELECT queries
+SELECT * FROM provenance_batch(ARRAY['SELECT 1; SELECT 2']);
+SELECT * FROM provenance_batch(ARRAY['INSERT INTO batchr VALUES (1,1)']);
+SELECT * FROM provenance_batch(ARRAY['SELECT 1', NULL]);
+
+DROP TABLE batchr, batchs;
+
+/******************************************************************************
+ * memoized correlated sublinks
+ *****************************************************************************/
+CREATE TABLE memoo (a int, b int);
+CREATE TABLE memoi (c int, d text);
+INSERT INTO memoo SELECT i, i % 4 FROM generate_series(1,12) i;
+INSERT INTO memoo VALUES (13, NULL);
+INSERT INTO memoi SELECT i % 3, 'v' || i FROM generate_series(1,9) i;
+ANALYZE memoo;
+ANALYZE memoi;
+
+SET prov_use_sublink_memoization TO on;
+
+-- same results as without memoization, also for NULL correlation values
+SELECT a, b,
+	EXISTS (SELECT 1 FROM memoi WHERE c = memoo.b) AS e,
+	(SELECT max(d) FROM memoi WHERE c = memoo.b) AS x,
+	b IN (SELECT c + 0 FROM memoi WHERE d > 'v' || memoo.b) AS y,
+	b < ALL (SELECT c FROM memoi WHERE c >= memoo.b) AS w,
+	array(SELECT d FROM memoi WHERE c = memoo.b ORDER BY d) AS z
+FROM memoo ORDER BY a;
+
+-- provenance of a query with a memoized sublink
+SELECT * FROM (SELECT PROVENANCE a FROM memoo WHERE EXISTS (SELECT 1 FROM memoi WHERE c = memoo.b) AND a < 6) p ORDER BY a, prov_public_memoi_d;
+
+-- errors of the sublink are still raised for memoized output
+SELECT a, (SELECT d FROM memoi WHERE c = memoo.b) FROM memoo;
+
+-- the subplan is executed once per distinct correlation value
+SELECT * FROM explain_filter('ANALYZE SELECT a, (SELECT max(d) FROM memoi WHERE c = memoo.b) FROM memoo', 'SubPlan|Memoized');
+
+-- the least recently used output is evicted if the memo exceeds work_mem
+CREATE TABLE memoe (k int);
+INSERT INTO memoe SELECT i % 1000 FROM generate_series(1,3000) i;
+ANALYZE memoe;
+SET work_mem TO 64;
+SELECT regexp_replace(p, 'evictions=[1-9][0-9]*', 'evictions=N') FROM explain_filter('ANALYZE SELECT k, (SELECT max(d) FROM memoi WHERE c = memoe.k % 3) FROM memoe', 'SubPlan|Memoized') p;
+SELECT x, count(*) FROM (SELECT k, (SELECT max(d) FROM memoi WHERE c = memoe.k % 3) AS x FROM memoe) s GROUP BY x ORDER BY x;
+RESET work_mem;
+RESET prov_use_sublink_memoization;
+SELECT x, count(*) FROM (SELECT k, (SELECT max(d) FROM memoi WHERE c = memoe.k % 3) AS x FROM memoe) s GROUP BY x ORDER BY x;
+
+DROP TABLE memoo, memoi, memoe;
+
+/******************************************************************************
+ * NOT EXISTS sublinks rewritten into anti joins
+ *****************************************************************************/
+CREATE TABLE antir (a int, b int);
+CREATE TABLE antis (c int, d int);
+INSERT INTO antir VALUES (1,1), (2,2), (3,NULL), (4,4);
+INSERT INTO antis VALUES (NULL,1), (2,2), (5,5), (NULL,4);
+ANALYZE antir;
+ANALYZE antis;
+
+SELECT PROVENANCE * FROM antir WHERE a < 4 AND NOT EXISTS (SELECT d FROM antis WHERE d = b AND c = 2) ORDER BY a;
+
+SET prov_use_anti_join TO on;
+
+SELECT PROVENANCE * FROM antir WHERE a < 4 AND NOT EXISTS (SELECT d FROM antis WHERE d = b AND c = 2) ORDER BY a;
+
+-- the first attribute of the sublink may be NULL for tuples that have a join partner
+SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b) ORDER BY a;
+SELECT * FROM explain_filter('SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b)', 'Join');
+
+SET enable_hashjoin TO off;
+SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b) ORDER BY a;
+SELECT * FROM explain_filter('SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b)', 'Join');
+
+SET enable_mergejoin TO off;
+SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b) ORDER BY a;
+SELECT * FROM explain_filter('SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b)', 'Join');
+
+RESET enable_mergejoin;
+RESET enable_hashjoin;
+
+-- anti joins are deparsed as a left join filtered by NOT EXISTS
+CREATE VIEW antiv AS SELECT PROVENANCE * FROM antir WHERE NOT EXISTS (SELECT c FROM antis WHERE d = b);
+SELECT pg_get_viewdef('antiv');
+SELECT pg_get_viewdef('antiv', true);
+-- the deparsed query returns the result of the anti join
+SELECT antir.a, antir.b, "rewrittenSublink1".prov_public_antis_c, "rewrittenSublink1".prov_public_antis_d, antir.a AS prov_public_antir_a, antir.b AS prov_public_antir_b FROM ((antir LEFT JOIN (SELECT antis.c, antis.d AS "groupForDecorr1", antis.c AS prov_public_antis_c, antis.d AS prov_public_antis_d FROM antis WHERE true) "rewrittenSublink1" ON false) JOIN (SELECT 1) anti_join_5 ON (NOT EXISTS (SELECT 1 FROM (SELECT antis.c, antis.d AS "groupForDecorr1", antis.c AS prov_public_antis_c, antis.d AS prov_public_antis_d FROM antis WHERE true) "rewrittenSublink1" WHERE ("rewrittenSublink1"."groupForDecorr1" = antir.b)))) WHERE true ORDER BY a;
+DROP VIEW antiv;
+
+RESET prov_use_anti_join;
+
+DROP TABLE antir, antis;
+
+/******************************************************************************
+ * union provenance represented by a branch tag
+ *****************************************************************************/
+CREATE TABLE tagu1 (a int, b text);
+CREATE TABLE tagu2 (a int, b text);
+CREATE TABLE tagu3 (a int, b varchar(5));
+INSERT INTO tagu1 VALUES (1,'x'), (2,'y');
+INSERT INTO tagu2 VALUES (2,'y'), (3,'z');
+INSERT INTO tagu3 VALUES (4,'w');
+
+SET prov_use_wl_union_semantics TO on;
+SET prov_use_tagged_union TO on;
+
+-- inputs with the same provenance attribute types share the provenance attributes
+SELECT PROVENANCE * FROM (SELECT * FROM tagu1 UNION SELECT * FROM tagu2) u ORDER BY a;
+SELECT PROVENANCE a FROM (SELECT * FROM tagu1 UNION ALL SELECT * FROM tagu2 UNION ALL SELECT * FROM tagu1) u WHERE a > 1 ORDER BY a;
+SELECT PROVENANCE sum(a) FROM (SELECT * FROM tagu1 UNION SELECT * FROM tagu2) u;
+SELECT PROVENANCE * FROM tagu1 WHERE a IN (SELECT a FROM tagu2 UNION SELECT a FROM tagu1) ORDER BY a;
+
+-- different provenance attribute types, each input has its own provenance attributes
+SELECT PROVENANCE * FROM (SELECT a, b FROM tagu1 UNION SELECT a, b FROM tagu3) u ORDER BY a;
+
+-- the provenance attributes of a provenance query in FROM are not affected
+SELECT * FROM (SELECT PROVENANCE * FROM (SELECT * FROM tagu1 UNION SELECT * FROM tagu2) u) AS p ORDER BY 1,3,5;
+
+RESET prov_use_tagged_union;
+RESET prov_use_wl_union_semantics;
+
+DROP TABLE tagu1, tagu2, tagu3;
+
+/******************************************************************************
+ * cheapest rewrite chosen by prov_use_optimizer
+ *****************************************************************************/
+CREATE TABLE opt1 (a int, b int);
+CREATE TABLE opt2 (c int, d int);
+CREATE TABLE opt3 (e int, f int);
+INSERT INTO opt1 VALUES (1,1), (2,1), (3,2), (4,3), (5,NULL);
+INSERT INTO opt2 VALUES (1,10), (1,11), (2,20), (4,40);
+INSERT INTO opt3 VALUES (2,0), (5,1);
+ANALYZE opt1;
+ANALYZE opt2;
+ANALYZE opt3;
+
+-- each query returns the same result with and without the optimizer
+SET prov_use_optimizer TO off;
+
+SELECT * FROM (SELECT PROVENANCE a, (SELECT max(d) FROM opt2 WHERE c = a) AS m FROM opt1 WHERE EXISTS (SELECT * FROM opt2 WHERE c = b) AND a NOT IN (SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7,8,9,10;
+SELECT * FROM (SELECT PROVENANCE a FROM opt1 WHERE a IN (SELECT c FROM opt2) AND b NOT IN (SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7;
+SELECT * FROM (SELECT PROVENANCE b, count(*) FROM opt1 WHERE a NOT IN (SELECT e FROM opt3) GROUP BY b) p ORDER BY 1,2,3,4,5,6;
+SELECT * FROM (SELECT PROVENANCE b, sum(a) FROM opt1 GROUP BY b HAVING sum(a) > (SELECT max(f) FROM opt3)) p ORDER BY 1,2,3,4,5,6;
+SELECT * FROM (SELECT PROVENANCE * FROM (SELECT a FROM opt1 UNION SELECT c FROM opt2) u) p ORDER BY 1,2,3,4,5;
+SELECT * FROM (SELECT PROVENANCE * FROM (SELECT a FROM opt1 INTERSECT SELECT c FROM opt2) u) p ORDER BY 1,2,3,4,5;
+SELECT * FROM (SELECT PROVENANCE a FROM opt1 WHERE a IN (SELECT c FROM opt2 UNION SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7;
+
+SET prov_use_optimizer TO on;
+
+SELECT * FROM (SELECT PROVENANCE a, (SELECT max(d) FROM opt2 WHERE c = a) AS m FROM opt1 WHERE EXISTS (SELECT * FROM opt2 WHERE c = b) AND a NOT IN (SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7,8,9,10;
+SELECT * FROM (SELECT PROVENANCE a FROM opt1 WHERE a IN (SELECT c FROM opt2) AND b NOT IN (SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7;
+SELECT * FROM (SELECT PROVENANCE b, count(*) FROM opt1 WHERE a NOT IN (SELECT e FROM opt3) GROUP BY b) p ORDER BY 1,2,3,4,5,6;
+SELECT * FROM (SELECT PROVENANCE b, sum(a) FROM opt1 GROUP BY b HAVING sum(a) > (SELECT max(f) FROM opt3)) p ORDER BY 1,2,3,4,5,6;
+SELECT * FROM (SELECT PROVENANCE * FROM (SELECT a FROM opt1 UNION SELECT c FROM opt2) u) p ORDER BY 1,2,3,4,5;
+SELECT * FROM (SELECT PROVENANCE * FROM (SELECT a FROM opt1 INTERSECT SELECT c FROM opt2) u) p ORDER BY 1,2,3,4,5;
+SELECT * FROM (SELECT PROVENANCE a FROM opt1 WHERE a IN (SELECT c FROM opt2 UNION SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7;
+
+RESET prov_use_optimizer;
+
+-- the EXISTS sublink is unnested before the NOT IN sublink is moved to the target list
+SET prov_use_sublink_move_to_target TO on;
+SET prov_use_sublink_transfrom_top_level_any_to_join TO off;
+SELECT * FROM (SELECT PROVENANCE a, (SELECT max(d) FROM opt2 WHERE c = a) AS m FROM opt1 WHERE EXISTS (SELECT * FROM opt2 WHERE c = b) AND a NOT IN (SELECT e FROM opt3)) p ORDER BY 1,2,3,4,5,6,7,8,9,10;
+RESET prov_use_sublink_transfrom_top_level_any_to_join;
+RESET prov_use_sublink_move_to_target;
+
+DROP TABLE opt1, opt2, opt3;
+
+--
+-- cached query trees of the query to XML functions
+--
+CREATE TABLE xmlq (a int, b text);
+SELECT query_sql_to_simple_xml('SELECT PROVENANCE a FROM xmlq');
+SELECT query_sql_to_simple_xml('SELECT PROVENANCE a FROM xmlq');
+SELECT query_sql_to_xml('SELECT a FROM xmlq')::text = query_sql_to_xml('SELECT a FROM xmlq')::text;
+SELECT query_sql_to_simple_xml('SELECT * FROM xmlq');
+ALTER TABLE xmlq ADD COLUMN c int;
+SELECT query_sql_to_simple_xml('SELECT * FROM xmlq');
+DROP TABLE xmlq;
+
 /******************************************************************************
 *******************************************************************************
 *******************************************************************************
@@ -1037,4 +1732,6 @@ DROP TABLE IF EXISTS muchcols CASCADE;
 DROP TABLE IF EXISTS arraytest;
 DROP TABLE IF EXISTS structtest;
 
-DROP TYPE IF EXISTS testtype;*/
\ No newline at end of file
+DROP TYPE IF EXISTS testtype;*/
+
+DROP FUNCTION explain_filter(text, text);
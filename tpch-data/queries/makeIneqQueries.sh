@@ -0,0 +1,67 @@
+#!/bin/bash
+# Create a workload of selections with many range predicates over the
+# replicas of relation lineitem (see ../makeDupTableSchema.sh) to measure
+# the rewrite time of the selection pushdown. Run it with mybench, e.g.:
+#
+#   makeIneqQueries.sh 4 "10 50 100 200" > ineq.txt
+#   mybenchpsql -d tpch -i ineq.txt -V plain -g prov_use_selection_pushdown \
+#       -g prov_use_inequality_deduction -w 2 -r 20 -S
+#
+# and compare the rewrite column of the settings of the two options.
+
+# check input
+if [ ! $# = 2 ]
+then
+    echo "wrong number of parameters."
+    echo "correct syntax is:"
+    echo "makeIneqQueries.sh numberOfReplicas \"numberOfPredicates ...\""
+    exit 1
+fi
+
+# Get parameters
+numRepl=${1}
+numPreds=${2}
+attrs=(l_orderkey l_partkey l_suppkey l_linenumber l_quantity l_extendedprice l_discount l_tax)
+numAttrs=${#attrs[@]}
+let "numCols=numRepl * numAttrs"
+
+# select list and FROM clause of the provenance subquery, the attributes of
+# replica i are renamed to <attr>_<i>
+select=""
+from=""
+for (( i=1; i<=${numRepl}; i++ ))
+do
+    for attr in ${attrs[@]}
+    do
+	select="${select}${select:+, }l${i}.${attr} AS ${attr}_${i}"
+    done
+    from="${from}${from:+, }lineitem${i} l${i}"
+done
+
+# the selection pushdown is only applied if the provenance query is used in
+# the FROM clause of a normal query. Every fourth predicate compares an
+# attribute with a constant, the others compare two attributes and build
+# chains of inequalities across the replicas.
+for n in ${numPreds}
+do
+    echo "-- ${n} predicates over ${numRepl} replicas of lineitem"
+    where=""
+    for (( k=0; k<${n}; k++ ))
+    do
+	let "l=k % numCols"
+	let "r=(k * 7 + 3) % numCols"
+	let "li=l / numAttrs + 1"
+	let "ri=r / numAttrs + 1"
+	lhs="${attrs[$((l % numAttrs))]}_${li}"
+	rhs="${attrs[$((r % numAttrs))]}_${ri}"
+	case $((k % 4)) in
+	    0) pred="${lhs} > $((k % 50))" ;;
+	    1) pred="${lhs} < ${rhs}" ;;
+	    2) pred="${lhs} <= ${rhs}" ;;
+	    3) pred="${lhs} >= ${rhs}" ;;
+	esac
+	where="${where}${where:+ AND }${pred}"
+    done
+    echo "SELECT * FROM (SELECT PROVENANCE ${select} FROM ${from}) p WHERE ${where};"
+done
+echo "--"